@@ -60,6 +60,25 @@ void DotProduct::updateJDot()
 }
 } // namespace tvm::example
 
+#include <tvm/function/abstract/AutoDiffFunction.h>
+
+namespace tvm::example
+{
+// The same function, with derivatives obtained by automatic differentiation: only
+// the value needs to be written, as a template over the scalar type.
+class AutoDiffDotProduct : public function::abstract::AutoDiffFunction<AutoDiffDotProduct>
+{
+public:
+  AutoDiffDotProduct(VariablePtr x, VariablePtr y) : AutoDiffFunction(1, {x, y}) {}
+
+  template<typename T>
+  void evaluate(const Inputs<T> & x, Vector<T> & f) const
+  {
+    f[0] = x[0].dot(x[1]);
+  }
+};
+} // namespace tvm::example
+
 #include <tvm/graph/abstract/OutputSelector.h>
 #include <vector>
 
@@ -223,6 +242,31 @@ TEST_CASE("DotProduct")
   FAST_CHECK_UNARY(Jdy.isApprox(dot(x)->value().transpose()));
 }
 
+TEST_CASE("AutoDiffDotProduct")
+{
+  Space R3(3);
+  VariablePtr x = R3.createVariable("x");
+  x << 1, 2, 3;
+  dot(x) << -1, -2, -3;
+  VariablePtr y = R3.createVariable("y");
+  y << 4, 5, 6;
+  dot(y) << -4, -5, -6;
+
+  auto dp = std::make_shared<AutoDiffDotProduct>(x, y);
+  auto gl = utils::generateUpdateGraph(dp, AutoDiffDotProduct::Output::Value, AutoDiffDotProduct::Output::Jacobian,
+                                       AutoDiffDotProduct::Output::Velocity,
+                                       AutoDiffDotProduct::Output::NormalAcceleration, AutoDiffDotProduct::Output::JDot);
+  gl->execute();
+
+  FAST_CHECK_EQ(dp->value()[0], 32);
+  FAST_CHECK_UNARY(dp->jacobian(*x).isApprox(y->value().transpose()));
+  FAST_CHECK_UNARY(dp->jacobian(*y).isApprox(x->value().transpose()));
+  FAST_CHECK_EQ(dp->velocity()[0], -64);
+  FAST_CHECK_EQ(dp->normalAcceleration()[0], 64);
+  FAST_CHECK_UNARY(dp->JDot(*x).isApprox(dot(y)->value().transpose()));
+  FAST_CHECK_UNARY(dp->JDot(*y).isApprox(dot(x)->value().transpose()));
+}
+
 // An identity function whose Velocity output was disabled
 class DummyFunction : public function::IdentityFunction
 {
@@ -26,6 +26,7 @@ class ControlProblem;
 class TVM_DLLAPI Clock : public graph::abstract::Outputs
 {
   friend class ControlProblem;
+  friend class utils::CloneMap;
 
 public:
   SET_OUTPUTS(Clock, Time)
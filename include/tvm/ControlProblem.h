@@ -23,8 +23,36 @@ class TVM_DLLAPI TaskWithRequirements : public tvm::internal::ObjWithId
 public:
   TaskWithRequirements(const Task & task, requirements::SolvingRequirements req);
 
+  /** Enable the task (tasks are enabled by default).*/
+  void enable() { enabled_ = true; }
+
+  /** Disable the task.
+   *
+   * A disabled task stays in the problems it was added to, and keeps its rows
+   * and assignments in the solvers, but these rows are replaced by trivially
+   * satisfied ones (zero objectives, relaxed constraints) when the problem is
+   * assembled. Contrary to removing the task and adding it back, this does
+   * not trigger any structural change, so that a task can be toggled at
+   * each iteration at no cost.
+   *
+   * \throws std::runtime_error if the constraint of the task is used by a
+   * substitution (see hint::Substitution): the substitution would keep using
+   * the task. Remove the substitution first.
+   */
+  void disable();
+
+  /** Whether the task is enabled.*/
+  bool isEnabled() const { return enabled_; }
+
   Task task;
   requirements::SolvingRequirementsWithCallbacks requirements;
+
+private:
+  friend class LinearizedControlProblem;
+
+  bool enabled_ = true;
+  /** Number of substitutions using the constraint of this task.*/
+  int substitutionUses_ = 0;
 };
 
 using TaskWithRequirementsPtr = std::shared_ptr<TaskWithRequirements>;
@@ -85,6 +113,14 @@ protected:
 
     /** Manually calls for an update of the call graph, if needed.*/
     void refresh();
+    /** Reuse the call graph of \p other, in which each source is replaced by
+     * its image through \p map, instead of computing it at the next refresh.
+     * This assumes that the inputs of this object are the images of those of
+     * \p other. Nothing is done if the graph of \p other is not up to date
+     * or if a source has no image.
+     */
+    void copyGraph(const Updater & other,
+                   const std::function<graph::abstract::Outputs *(const graph::abstract::Outputs *)> & map);
     /** Execute the call graph.*/
     void run();
 
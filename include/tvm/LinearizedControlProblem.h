@@ -26,6 +26,38 @@ public:
   LinearizedControlProblem();
   LinearizedControlProblem(const ControlProblem & pb);
 
+  /** Create an independent copy of this problem, e.g. to update and solve
+   * several variants of the same problem on different threads.
+   *
+   * The tasks are recreated in the same order with the same requirements and
+   * enabled state, on clones of their functions and task dynamics. Those are
+   * obtained through \p map, which preserves the sharing of variables and
+   * functions between tasks, and gives access afterwards to the clones of the
+   * variables, functions and tasks of this problem. The variables of the clone
+   * start with the current values of the original ones. Merged tasks stay
+   * merged, and the substitutions are cloned along with their calculators.
+   * Robots and frames used by the functions are cloned through \p map as
+   * well (see utils::CloneMap::robot), sharing their model with the originals.
+   *
+   * If this problem is finalized, so is the clone, and the update plan of
+   * this problem is reused instead of being recomputed. The substitutions are
+   * finalized again. The resolution schemes data are not copied: they refer
+   * to the constraints of this problem and are built at the first resolution
+   * of the clone.
+   *
+   * The cloning must happen on a single thread, but the clone does not share
+   * any mutable data with this problem afterwards.
+   *
+   * \throws std::runtime_error if a function, task dynamics or substitution
+   * calculator does not support cloning (see
+   * function::abstract::Function::clone).
+   */
+  std::unique_ptr<LinearizedControlProblem> clone(utils::CloneMap & map) const;
+  /** Same as clone(utils::CloneMap &), for when the correspondence with the
+   * cloned objects is not needed.
+   */
+  std::unique_ptr<LinearizedControlProblem> clone() const;
+
   TaskWithRequirementsPtr add(const Task & task, const requirements::SolvingRequirements & req = {});
   template<constraint::Type T>
   TaskWithRequirementsPtr add(utils::ProtoTask<T> proto,
@@ -44,6 +76,42 @@ public:
   void remove(const hint::Substitution & s);
   const hint::internal::Substitutions & substitutions() const;
   void removeSubstitutionFor(const constraint::abstract::LinearConstraint & cstr);
+  /** Set the number of threads used to update the substitutions. Independent
+   * groups of substitutions (e.g. the substitutions of different robots) are
+   * then updated concurrently.
+   *
+   * \param n Number of threads. 1 (the default) means a serial update.
+   */
+  void substitutionThreads(int n);
+
+  /** Enable or disable the merge of tasks forming double-sided constraints
+   * (disabled by default).
+   *
+   * When enabled, a GREATER_THAN task and a LOWER_THAN task on the same
+   * function, with the same task dynamics order and both at priority level
+   * 0, are linearized into a single DOUBLE_SIDED constraint, e.g. the lower
+   * and upper joint limits given as two tasks. This halves the number of
+   * rows for solvers handling double-sided constraints natively. If the
+   * resulting constraint has a diagonal jacobian, it is used as a bound by
+   * the resolution schemes.
+   *
+   * The merged constraint is attached to the first of the two tasks: it is
+   * returned by constraint() and constraintWithRequirements() for both tasks,
+   * and appears once in constraints(). The merge is undone if one of the
+   * tasks is removed or if the priority level of one of them changes.
+   * Disabling one of the tasks relaxes the corresponding bound.
+   *
+   * This setting only affects the tasks added after the call.
+   */
+  void mergeDoubleSidedTasks(bool merge);
+
+  /** Total number of rows of the tasks in the problem.*/
+  int taskRows() const;
+
+  /** Total number of rows of the linearized constraints. This is lower than
+   * taskRows() when some tasks have been merged (see mergeDoubleSidedTasks).
+   */
+  int constraintRows() const;
 
   /** Access to the variables of the problem.
    *
@@ -60,6 +128,9 @@ public:
   /** Access to the linear constraint corresponding to the task \p t
    *
    * \param t TaskWithRequirements object as return by add.
+   *
+   * \note If \p t has been merged with another task (see
+   * mergeDoubleSidedTasks), this is the merged constraint.
    */
   LinearConstraintPtr constraint(const TaskWithRequirements & t) const;
 
@@ -74,6 +145,10 @@ public:
   /** Access to the linear constraint and requirements corresponding to the task \p t
    *
    * \param t TaskWithRequirements object as return by add.
+   *
+   * \note If \p t has been merged with another task (see
+   * mergeDoubleSidedTasks), this is the merged constraint, with the
+   * requirements of the task it is attached to.
    */
   const LinearConstraintWithRequirements & constraintWithRequirements(const TaskWithRequirements & t) const;
 
@@ -82,7 +157,8 @@ public:
    * \param t TaskWithRequirements object as return by add.
    *
    * \return An std::optional containing a const reference on LinearConstraintWithRequirements
-   * if \p t is in the problem.
+   * if \p t is in the problem and has a constraint of its own, i.e. is not the
+   * second task of a merged pair (see mergeDoubleSidedTasks).
    */
   std::optional<std::reference_wrapper<const LinearConstraintWithRequirements>> constraintWithRequirementsNoThrow(
       const TaskWithRequirements & t) const;
@@ -99,8 +175,34 @@ protected:
   void finalize_() override;
 
 private:
+  /** Create the linear constraint for a single task.*/
+  LinearConstraintWithRequirements linearize(const TaskWithRequirementsPtr & tr) const;
+  /** Create the double-sided linear constraint for a pair of tasks.*/
+  LinearConstraintWithRequirements linearize(const TaskWithRequirementsPtr & owner,
+                                             const TaskWithRequirementsPtr & partner) const;
+  /** Register \p lcr as the constraint of \p tr and add it to the update graph.*/
+  void registerConstraint(const TaskWithRequirements & tr, const LinearConstraintWithRequirements & lcr);
+  /** Remove the constraint of \p tr from the update graph and from the constraint map.*/
+  void unregisterConstraint(const TaskWithRequirements & tr);
+  /** Find a task that can be merged with \p tr into a double-sided constraint.*/
+  TaskWithRequirementsPtr findDoubleSidedPartner(const TaskWithRequirements & tr) const;
+  /** Record the merge of \p partner into the constraint of \p owner.*/
+  void registerMerge(const TaskWithRequirementsPtr & owner, const TaskWithRequirementsPtr & partner);
+  /** Undo the merge of \p owner with its partner: both get back a constraint of their own.*/
+  void unmerge(const TaskWithRequirements & owner);
+
   utils::internal::map<TaskWithRequirements const *, LinearConstraintWithRequirements> constraints_;
   hint::internal::Substitutions substitutions_;
+
+  bool mergeDoubleSided_ = false;
+  /** For merged tasks, owner of the merged constraint -> other task.*/
+  utils::internal::map<TaskWithRequirements const *, TaskWithRequirementsPtr> partners_;
+  /** For merged tasks, task without a constraint of its own -> owner of the merged constraint.*/
+  utils::internal::map<TaskWithRequirements const *, TaskWithRequirementsPtr> owners_;
+  /** Constraint used by a substitution -> task of this constraint.*/
+  utils::internal::map<constraint::abstract::LinearConstraint const *, TaskWithRequirementsPtr> substitutedTasks_;
+  /** For merged tasks, owner -> tokens of the callbacks on the priority levels of the two tasks.*/
+  utils::internal::map<TaskWithRequirements const *, std::vector<internal::PairElementToken>> mergeCallbackTokens_;
 };
 
 template<constraint::Type T>
@@ -6,6 +6,7 @@
 #include <tvm/Variable.h>
 #include <tvm/VariableVector.h>
 #include <tvm/graph/abstract/Node.h>
+#include <tvm/robot/enums.h>
 
 #include <RBDyn/FD.h>
 #include <RBDyn/MultiBody.h>
@@ -14,6 +15,8 @@
 
 #include <RBDyn/parsers/urdf.h>
 
+#include <memory>
+
 namespace tvm
 {
 
@@ -44,6 +47,10 @@ namespace tvm
  * - Geometry: depends on CoM (i.e. CoM + FK)
  * - Dynamics: depends on FA + normalAcceleration (i.e. everything)
  *
+ * A robot can be cloned, along with a problem using it, through
+ * utils::CloneMap::robot. The clone has its own state, variables and clock,
+ * but shares the model (mb()) of the original robot.
+ *
  */
 class TVM_DLLAPI Robot : public graph::abstract::Node<Robot>
 {
@@ -100,9 +107,12 @@ public:
   inline VariablePtr & tau() { return tau_; }
 
   /** Access the robot's related rbd::MultiBody (const) */
-  inline const rbd::MultiBody & mb() const { return mb_; }
-  /** Access the robot's related rbd::MultiBody */
-  inline rbd::MultiBody & mb() { return mb_; }
+  inline const rbd::MultiBody & mb() const { return *mb_; }
+  /** Access the robot's related rbd::MultiBody
+   *
+   * \note The rbd::MultiBody is shared with the clones of this robot.
+   */
+  inline rbd::MultiBody & mb() { return *mb_; }
 
   /** Access the robot's related rbd::MultiBodyConfig (const) */
   inline const rbd::MultiBodyConfig & mbc() const { return mbc_; }
@@ -146,6 +156,12 @@ public:
 
   /** Access the inertia matrix */
   inline const Eigen::MatrixXd & H() const { return fd_.H(); }
+  /** Parent array of the dof: the i-th element is the index of the dof preceding
+   * the i-th dof in the kinematic tree, or -1 for the first dof of the root.
+   * It describes the branch-induced sparsity of H, and can be given to a
+   * hint::internal::LTDLCalculator when substituting the accelerations.
+   */
+  std::vector<int> dofParents() const;
   /** Access the non-linear effect vector */
   /** Access the non-linear effect vector (Coriolis, gravity, external force).*/
   inline const Eigen::VectorXd & C() const { return fd_.C(); }
@@ -156,12 +172,23 @@ public:
   /** Access the transformation that allows to retrieve the original base of a body */
   inline const sva::PTransformd & bodyTransform(const std::string & b) const { return bodyTransforms_.at(b); }
 
+  /** Integration scheme used when the clock ticks */
+  inline robot::Integration integration() const { return integration_; }
+  /** Set the integration scheme used when the clock ticks */
+  inline void integration(robot::Integration scheme) { integration_ = scheme; }
+
 private:
+  /** Clone of \p other on \p clock (see utils::CloneMap::robot).*/
+  Robot(ClockPtr clock, const Robot & other, utils::CloneMap & map);
+
+  friend class utils::CloneMap;
+
   Clock & clock_;
   uint64_t last_tick_ = 0;
   std::string name_;
   double mass_;
-  rbd::MultiBody mb_;
+  /** Shared with the clones of this robot */
+  std::shared_ptr<rbd::MultiBody> mb_;
   rbd::MultiBodyConfig mbc_;
   std::vector<sva::MotionVecd> normalAccB_;
   Eigen::VectorXd lQBound_;
@@ -179,19 +206,29 @@ private:
   VariableVector ddq_;
   VariablePtr tau_;
   Eigen::Vector3d com_;
+  robot::Integration integration_ = robot::Integration::Euler;
+  /** Zero acceleration, used to integrate q alone in the semi-implicit scheme */
+  std::vector<std::vector<double>> zeroAlphaD_;
+  /** For a clone, its clock, which it owns */
+  ClockPtr clockOwner_;
 
 private:
+  /** Register the updates and the dependencies of the robot */
+  void registerUpdatesAndDependencies();
+
   void computeNormalAccB();
 
   /** Update the Robot's variables based on the output of the solver
    *
    * It will:
    * 1. Put dot(q,2) into mbc.alphaD
-   * 2. Run rbd::eulerIntegration with dt
+   * 2. Integrate mbc.q and mbc.alpha with dt, according to integration()
    * 3. Output mbc.alpha into dot(q)
    * 4. Output mbc.q into q
    *
-   * \param dt Integration timestep
+   * The copies are made joint by joint between the variables' buffers and the
+   * MultiBodyConfig, without going through the concatenated value of the
+   * VariableVector q, dot(q) and dot(q,2).
    *
    */
   void updateTimeDependency();
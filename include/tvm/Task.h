@@ -48,7 +48,12 @@ public:
   template<typename T, typename TDImpl = typename T::Impl>
   std::shared_ptr<TDImpl> secondBoundTaskDynamics() const;
 
+  /** The same task, on the clone of its function given by \p map.*/
+  Task clone(utils::CloneMap & map) const;
+
 private:
+  Task(FunctionPtr f, constraint::Type t, TaskDynamicsPtr td, TaskDynamicsPtr td2);
+
   FunctionPtr f_;
   constraint::Type type_;
   TaskDynamicsPtr td_;
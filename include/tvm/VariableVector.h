@@ -5,11 +5,13 @@
 #include <tvm/api.h>
 #include <tvm/defs.h>
 
+#include <tvm/Range.h>
 #include <tvm/internal/MatrixWithProperties.h>
 #include <tvm/internal/ObjWithId.h>
 
 #include <tvm/deprecated.hh>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -31,6 +33,8 @@ namespace tvm
  * fastest option. However it will be slow if querying alternatively
  * mapping w.r.t different VariableVector on the same variable or set of
  * variables.
+ * When the index of the variable in the vector is known, rangeOf gives its
+ * mapping directly, from a table of offsets maintained by the vector.
  *
  * A given variable can only appear once in a vector. Variables appear in the
  * order they were added, ignoring duplicates.
@@ -176,6 +180,14 @@ public:
    */
   Range getMappingOf(const Variable & v) const;
 
+  /** Return the mapping of the \p i-th variable of this vector.
+   *
+   * This is a constant-time access to a table of offsets kept up to date when
+   * variables are added or removed, and is the preferred way to get mappings
+   * in loops over the variables of the vector.
+   */
+  Range rangeOf(int i) const;
+
   /** A timestamp, used internally to determine if a cached mapping needs to be
    * recomputed or not.
    */
@@ -195,11 +207,16 @@ private:
   void remove_(std::vector<VariablePtr>::const_iterator it);
   void getNewStamp() const;
 
-  static int counter;
+  /** Source of the stamps. Atomic since vectors can be created concurrently,
+   * e.g. when solving clones of a problem on different threads.
+   */
+  static std::atomic<int> counter;
 
   mutable int stamp_;
   int size_;
   std::vector<VariablePtr> variables_;
+  /** Start of each variable in the vector, followed by size_.*/
+  std::vector<int> starts_;
 
   mutable Eigen::VectorXd value_;
 };
@@ -226,6 +243,13 @@ VariableVector::VariableVector(VarPtr &&... variables) : VariableVector()
  */
 VariableVector TVM_DLLAPI dot(const VariableVector & vars, int ndiff = 1);
 
+inline Range VariableVector::rangeOf(int i) const
+{
+  assert(i >= 0 && i < numberOfVariables());
+  auto k = static_cast<size_t>(i);
+  return {starts_[k], starts_[k + 1] - starts_[k]};
+}
+
 inline std::vector<VariablePtr>::const_iterator tvm::VariableVector::begin() const { return variables_.begin(); }
 
 inline std::vector<VariablePtr>::const_iterator tvm::VariableVector::end() const { return variables_.end(); }
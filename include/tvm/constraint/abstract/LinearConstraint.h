@@ -62,6 +62,41 @@ public:
    */
   void updateValue();
 
+  /** Whether the constraint is taken into account by the solvers.
+   *
+   * A disabled constraint keeps its place in the solvers, but the
+   * corresponding rows are made trivially satisfied when the solver data are
+   * assembled (see TaskWithRequirements::disable).
+   */
+  bool isEnabled() const { return !enabled_ || *enabled_; }
+
+  /** Make the enabled state of the constraint follow the value pointed to by
+   * \p flag. If \p flag is \p nullptr, the constraint is always enabled.
+   */
+  void enabledFlag(std::shared_ptr<const bool> flag) { enabled_ = std::move(flag); }
+
+  /** For a double-sided constraint, whether its lower bound is taken into
+   * account. A disabled bound is set to -infinity by the constraint, and
+   * replaced by the big number of the solver when the solver data are
+   * assembled (see scheme::internal::Assignment).
+   */
+  bool isLowerEnabled() const { return !lowerEnabled_ || *lowerEnabled_; }
+
+  /** For a double-sided constraint, whether its upper bound is taken into
+   * account. See isLowerEnabled.
+   */
+  bool isUpperEnabled() const { return !upperEnabled_ || *upperEnabled_; }
+
+  /** Make the enabled state of the lower and upper bounds follow the values
+   * pointed to by \p lower and \p upper. A \p nullptr flag means the bound is
+   * always enabled.
+   */
+  void boundsEnabledFlags(std::shared_ptr<const bool> lower, std::shared_ptr<const bool> upper)
+  {
+    lowerEnabled_ = std::move(lower);
+    upperEnabled_ = std::move(upper);
+  }
+
 protected:
   /** Constructor. Only available to derived classes.
    * \param ct The constraint type
@@ -69,6 +104,11 @@ protected:
    * \param The (output) size of the constraint
    */
   LinearConstraint(Type ct, RHS cr, int m);
+
+private:
+  std::shared_ptr<const bool> enabled_;
+  std::shared_ptr<const bool> lowerEnabled_;
+  std::shared_ptr<const bool> upperEnabled_;
 };
 
 } // namespace abstract
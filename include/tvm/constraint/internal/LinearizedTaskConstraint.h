@@ -142,6 +142,12 @@ namespace internal
  * }
  * \enddot
  *
+ * When the constraint is disabled (see abstract::LinearConstraint::isEnabled),
+ * the updates of the rhs are skipped. The function and the task dynamics are
+ * still updated, as they may be shared with other tasks. For a constraint
+ * obtained from two tasks, a disabled bound (see
+ * abstract::LinearConstraint::isLowerEnabled) is set to -/+infinity.
+ *
  * \internal FIXME Consider the case where the TaskDynamics has its own variables?
  */
 class TVM_DLLAPI LinearizedTaskConstraint : public abstract::LinearConstraint
@@ -156,6 +162,13 @@ public:
   template<constraint::Type T>
   LinearizedTaskConstraint(const utils::ProtoTask<T> & pt, const task_dynamics::abstract::TaskDynamics & td);
 
+  /** Constructor of the DOUBLE_SIDED constraint obtained by merging a
+   * GREATER_THAN task \p lower and a LOWER_THAN task \p upper on the same
+   * function. The lower (resp. upper) bound is given by the task dynamics of
+   * \p lower (resp. \p upper).
+   */
+  LinearizedTaskConstraint(const Task & lower, const Task & upper);
+
   /** Update the \p l vector, for kinematic tasks.*/
   void updateLKin();
   /** Update the \p l vector, for dynamic tasks.*/
@@ -175,8 +188,19 @@ public:
 
   /** Return the jacobian matrix corresponding to \p x */
   tvm::internal::MatrixConstRefWithProperties jacobian(const Variable & x) const override;
+  /** The i-th variable of this constraint is the derivative of the i-th
+   * variable of the function: the index is forwarded to the function.
+   */
+  tvm::internal::MatrixConstRefWithProperties jacobianAt(int i) const override;
+  using LinearConstraint::jacobianAt;
+
+  /** Forward to the function, with the variables of the same derivation order as this function.*/
+  bool jacobianParentArray(const std::vector<VariablePtr> & x, std::vector<int> & lambda) const override;
 
 private:
+  /** Build the update graph of the constraint, once f_, td_ and td2_ are set.*/
+  void build();
+
   FunctionPtr f_;
   TaskDynamicsPtr td_;
   TaskDynamicsPtr td2_; // for double sided constraints only;
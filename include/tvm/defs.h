@@ -38,6 +38,10 @@ namespace abstract
 class TaskDynamicsImpl;
 }
 } // namespace task_dynamics
+namespace utils
+{
+class CloneMap;
+} // namespace utils
 class Clock;
 class Range;
 class Robot;
@@ -24,6 +24,8 @@
 
 namespace tvm::diagnostic
 {
+class ProbeSubscription;
+
 /** A class to explore the value computed in a call graph.
  *
  * Because the tvm nodes only declare the dependencies between inputs, updates and outputs, but not
@@ -122,6 +124,30 @@ public:
       const graph::CallGraph * const g,
       const std::function<bool(const Eigen::MatrixXd &)> & select = [](const Eigen::MatrixXd &) { return true; }) const;
 
+  /** Subscribe to the values of the outputs \p outputs (if the associated methods were registered).
+   *
+   * The accessors are looked up once here, and the values are copied by the returned object into a
+   * preallocated ring buffer each time ProbeSubscription::sample is called, to be consumed by another
+   * thread. See ProbeSubscription for details.
+   *
+   * \param capacity Number of samples in the ring buffer.
+   * \param period A sample is taken every \p period calls to ProbeSubscription::sample.
+   * \param verbose If \c true, display the outputs for which no methods were registered to retrieve
+   * their values.
+   */
+  std::unique_ptr<ProbeSubscription> subscribe(const std::vector<Output> & outputs,
+                                               int capacity = 64,
+                                               int period = 1,
+                                               bool verbose = false) const;
+
+  /** Subscribe to the values of all the outputs present in the call graph \p g (if the associated
+   * methods were registered).
+   */
+  std::unique_ptr<ProbeSubscription> subscribe(const graph::CallGraph * const g,
+                                               int capacity = 64,
+                                               int period = 1,
+                                               bool verbose = false) const;
+
   /** Print in \p os the tree starting at \p root.*/
   void print(std::ostream & os, const std::unique_ptr<ProbeNode> & root) const;
   /** Print in \p os the trees starting each at an element of \p root.*/
@@ -163,6 +189,13 @@ private:
   std::unordered_map<OutputKey, std::function<Eigen::MatrixXd(uintptr_t)>, internal::PairHasher> outputAccessor_;
   std::unordered_map<OutputKey, std::function<std::vector<VarMatrixPair>(uintptr_t)>, internal::PairHasher>
       varDepOutputAccessor_;
+  /** Non-allocating counterparts of outputAccessor_ and varDepOutputAccessor_, used by subscriptions.*/
+  std::unordered_map<OutputKey, std::function<bool(uintptr_t, Eigen::Ref<Eigen::MatrixXd>)>, internal::PairHasher>
+      outputCopy_;
+  std::unordered_map<OutputKey,
+                     std::function<bool(uintptr_t, const Variable &, Eigen::Ref<Eigen::MatrixXd>)>,
+                     internal::PairHasher>
+      varDepOutputCopy_;
 };
 
 template<typename T, typename MethodT, typename EnumOutput, typename ConvertT>
@@ -172,13 +205,18 @@ inline void GraphProbe::registerAccessor(EnumOutput o, MethodT method, ConvertT
   if constexpr(CheckAccessor::isVoidAccessor)
   {
     using ReturnT = typename CheckAccessor::ReturnT;
+    auto copy = internal::MakeCopy<ReturnT>(convertIn);
     auto convert = internal::MakeConvert<ReturnT>(std::move(convertIn));
     OutputKey k{std::type_index(typeid(T)).hash_code(), tvm::graph::internal::Log::EnumValue(o)};
     outputAccessor_[k] = [method, convert](uintptr_t t) { return convert((reinterpret_cast<T *>(t)->*method)()); };
+    outputCopy_[k] = [method, copy](uintptr_t t, Eigen::Ref<Eigen::MatrixXd> out) {
+      return copy((reinterpret_cast<T *>(t)->*method)(), out);
+    };
   }
   else if constexpr(CheckAccessor::isVariableAccessor)
   {
     using ReturnT = typename CheckAccessor::ReturnT;
+    auto copy = internal::MakeCopy<ReturnT>(convertIn);
     auto convert = internal::MakeConvert<ReturnT>(std::move(convertIn));
     OutputKey k{std::type_index(typeid(T)).hash_code(), tvm::graph::internal::Log::EnumValue(o)};
     varDepOutputAccessor_[k] = [method, convert](uintptr_t t) {
@@ -188,6 +226,9 @@ inline void GraphProbe::registerAccessor(EnumOutput o, MethodT method, ConvertT
         ret.emplace_back(v, convert((ptr->*method)(*v)));
       return ret;
     };
+    varDepOutputCopy_[k] = [method, copy](uintptr_t t, const Variable & v, Eigen::Ref<Eigen::MatrixXd> out) {
+      return copy((reinterpret_cast<T *>(t)->*method)(v), out);
+    };
   }
   else
   {
@@ -0,0 +1,126 @@
+/** Copyright 2017-2021 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/api.h>
+
+#include <tvm/diagnostic/GraphProbe.h>
+
+#include <Eigen/Core>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace tvm::diagnostic
+{
+/** A set of outputs of a call graph whose values are sampled into a ring buffer, for continuous
+ * monitoring. Instances are created by GraphProbe::subscribe.
+ *
+ * The control loop calls ::sample (typically once per tick, after the resolution), which copies the
+ * current values of the outputs into the next slot of the buffer. This does not allocate nor lock.
+ * Another thread (e.g. a logger) retrieves the samples in order with ::next. This is a single
+ * producer, single consumer queue: ::sample must always be called from the same thread, and ::next
+ * from the same (possibly different) thread. If the buffer is full, the new samples are dropped
+ * (and counted by ::dropped) rather than blocking the control loop.
+ *
+ * A sample is the concatenation of the values of the entries (see ::entries) stored column-major.
+ * The size of the values is fixed at subscription: if the size of an output changes afterwards, its
+ * value is replaced by NaN in the samples.
+ */
+class TVM_DLLAPI ProbeSubscription
+{
+public:
+  /** A value in the samples.*/
+  struct Entry
+  {
+    /** The output.*/
+    GraphProbe::Output output;
+    /** For a variable-dependent output (e.g. Jacobian), the variable. \a nullptr otherwise.*/
+    VariablePtr variable;
+    /** Size of the value.*/
+    Eigen::DenseIndex rows;
+    Eigen::DenseIndex cols;
+    /** Position of the value in the samples.*/
+    Eigen::DenseIndex offset;
+  };
+
+  /** A sample, as returned by ::next.*/
+  struct Sample
+  {
+    /** Number of calls to ::sample before this one was taken.*/
+    uint64_t index = 0;
+    /** Concatenated values of the entries.*/
+    Eigen::VectorXd data;
+  };
+
+  ProbeSubscription(const ProbeSubscription &) = delete;
+  ProbeSubscription & operator=(const ProbeSubscription &) = delete;
+
+  /** The values composing a sample.*/
+  const std::vector<Entry> & entries() const { return entries_; }
+  /** Number of doubles in a sample.*/
+  Eigen::DenseIndex sampleSize() const { return size_; }
+  /** Number of samples the buffer can hold.*/
+  int capacity() const { return capacity_; }
+  /** A sample is taken every \a period calls to ::sample.*/
+  int period() const { return period_; }
+
+  /** Producer side: take a sample of the current values if this call is a multiple of the period.
+   *
+   * \return \c false if no sample was taken, either because of the period or because the buffer is
+   * full.
+   */
+  bool sample();
+
+  /** Consumer side: retrieve the oldest sample not yet read into \p s.
+   *
+   * \p s.data is resized if needed, so that reusing the same object does not allocate.
+   * \return \c false if there is no sample to read.
+   */
+  bool next(Sample & s);
+
+  /** The value of entry \p i in the sample \p s.*/
+  Eigen::Map<const Eigen::MatrixXd> value(const Sample & s, size_t i) const
+  {
+    const auto & e = entries_[i];
+    return {s.data.data() + e.offset, e.rows, e.cols};
+  }
+
+  /** Number of samples dropped because the buffer was full.*/
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  friend class GraphProbe;
+
+  using CopyFunction = std::function<bool(Eigen::Ref<Eigen::MatrixXd>)>;
+
+  ProbeSubscription(int capacity, int period);
+
+  /** Add an entry of size \p rows x \p cols whose value is written by \p copy.*/
+  void addEntry(const GraphProbe::Output & o,
+                VariablePtr var,
+                Eigen::DenseIndex rows,
+                Eigen::DenseIndex cols,
+                CopyFunction copy);
+  /** Allocate the buffer, once all the entries are added.*/
+  void allocate();
+
+  std::vector<Entry> entries_;
+  std::vector<CopyFunction> copies_;
+  Eigen::DenseIndex size_ = 0;
+  int capacity_;
+  int period_;
+
+  /** capacity_ samples, one per column.*/
+  Eigen::MatrixXd buffer_;
+  std::vector<uint64_t> indices_;
+  uint64_t calls_ = 0;
+
+  std::atomic<uint64_t> head_{0}; // number of samples written
+  std::atomic<uint64_t> tail_{0}; // number of samples read
+  std::atomic<uint64_t> dropped_{0};
+};
+
+} // namespace tvm::diagnostic
@@ -92,4 +92,35 @@ std::function<Eigen::MatrixXd(const ArgT &)> MakeConvert(ConvertT && convertIn)
   }
 }
 
+/** Given an argument type, returns a function copying an argument into a preallocated matrix, possibly through a
+ * convert function. The copy returns \c false if the sizes do not match.
+ *
+ * Without convert function, the copy does not allocate.
+ */
+template<typename ArgT, typename ConvertT>
+std::function<bool(const ArgT &, Eigen::Ref<Eigen::MatrixXd>)> MakeCopy(const ConvertT & convertIn)
+{
+  using ConvertFunT = std::function<Eigen::MatrixXd(const ArgT &)>;
+  if constexpr(std::is_constructible_v<ConvertFunT, const ConvertT &>)
+  {
+    ConvertFunT convert(convertIn);
+    return [convert](const ArgT & u, Eigen::Ref<Eigen::MatrixXd> out) {
+      Eigen::MatrixXd M = convert(u);
+      if(M.rows() != out.rows() || M.cols() != out.cols())
+        return false;
+      out = M;
+      return true;
+    };
+  }
+  else
+  {
+    return [](const ArgT & u, Eigen::Ref<Eigen::MatrixXd> out) {
+      if(u.rows() != out.rows() || u.cols() != out.cols())
+        return false;
+      out = u;
+      return true;
+    };
+  }
+}
+
 } // namespace tvm::diagnostic::internal
@@ -67,6 +67,8 @@ public:
 
   using LinearFunction::b;
 
+  FunctionPtr clone(utils::CloneMap & map) const override;
+
 private:
   template<typename Derived>
   void add(const Eigen::MatrixBase<Derived> & A, VariablePtr x);
@@ -17,6 +17,8 @@ public:
   /** Build an identity function on variable \p x*/
   IdentityFunction(VariablePtr x);
 
+  FunctionPtr clone(utils::CloneMap & map) const override;
+
 protected:
   void updateValue_() override;
   void updateVelocity_() override;
@@ -0,0 +1,130 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/function/abstract/Function.h>
+#include <tvm/utils/Dual.h>
+
+#include <Eigen/Core>
+
+#include <utility>
+#include <vector>
+
+namespace tvm
+{
+
+namespace function
+{
+
+namespace abstract
+{
+
+/** Base class for functions whose derivatives are computed by forward mode
+ * automatic differentiation of their value.
+ *
+ * The value is given by evaluate_, which is implemented for several scalar
+ * types: \c double for the value itself, and dual numbers (see utils::Dual)
+ * for the derivatives. Derived classes should not implement it directly but
+ * derive from AutoDiffFunction, which only requires a template of the value
+ * expression.
+ *
+ * The jacobian is computed by chunks of \a Lanes columns, each chunk requiring
+ * one evaluation of the expression. The velocity, normal acceleration and
+ * JDot are obtained by seeding the dual numbers with the derivatives of the
+ * variables, with one evaluation for the first two and one per chunk of
+ * columns for JDot.
+ *
+ * All the variables must be Euclidean, and are considered as non-linear.
+ */
+class TVM_DLLAPI AutoDiffFunctionBase : public Function
+{
+public:
+  SET_UPDATES(AutoDiffFunctionBase, Value, Jacobian, Velocity, NormalAcceleration, JDot)
+
+  /** Number of directional derivatives computed by one evaluation.*/
+  static constexpr int Lanes = 4;
+
+  template<typename T>
+  using Vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+  /** The values of the variables, in the order of variables().*/
+  template<typename T>
+  using Inputs = std::vector<Vector<T>>;
+
+  void updateValue();
+  void updateJacobian();
+  void updateVelocity();
+  void updateNormalAcceleration();
+  void updateJDot();
+
+protected:
+  using DualN = utils::Dual<Lanes>;
+  using Dual1 = utils::Dual<1>;
+  using Dual11 = utils::Dual<1, Dual1>;
+  using DualN1 = utils::Dual<Lanes, Dual1>;
+
+  /** Constructor for a function of \p x with values in \f$ \mathbb{R}^m \f$.*/
+  AutoDiffFunctionBase(int m, const std::vector<VariablePtr> & x);
+
+  /** Compute \p f from the values \p x of the variables.
+   * \p f has the size of the function.
+   */
+  virtual void evaluate_(const Inputs<double> & x, Vector<double> & f) const = 0;
+  virtual void evaluate_(const Inputs<Dual1> & x, Vector<Dual1> & f) const = 0;
+  virtual void evaluate_(const Inputs<DualN> & x, Vector<DualN> & f) const = 0;
+  virtual void evaluate_(const Inputs<Dual11> & x, Vector<Dual11> & f) const = 0;
+  virtual void evaluate_(const Inputs<DualN1> & x, Vector<DualN1> & f) const = 0;
+
+private:
+  std::vector<VariablePtr> dx_;
+  /** For each column of the full jacobian, the index of the corresponding
+   * variable and the index of the column in its jacobian.
+   */
+  std::vector<std::pair<int, int>> columns_;
+
+  // Evaluation buffers
+  Inputs<double> x_;
+  Inputs<Dual1> x1_;
+  Vector<Dual1> f1_;
+  Inputs<DualN> xN_;
+  Vector<DualN> fN_;
+  Inputs<Dual11> x11_;
+  Vector<Dual11> f11_;
+  Inputs<DualN1> xN1_;
+  Vector<DualN1> fN1_;
+};
+
+/** Base class for a function whose derivatives are obtained by automatic
+ * differentiation (see AutoDiffFunctionBase).
+ *
+ * \p Derived needs to implement the value of the function as a public
+ * template over the scalar type:
+ * \code
+ * template<typename T>
+ * void evaluate(const Inputs<T> & x, Vector<T> & f) const;
+ * \endcode
+ * where \c x[i] is the value of the i-th variable, as given to the
+ * constructor. The expression can use the arithmetic operators, the usual
+ * elementary functions and Eigen operations. Constant matrices need to be
+ * cast to \c T (e.g. \c A.cast<T>() \c * \c x[0]).
+ */
+template<typename Derived>
+class AutoDiffFunction : public AutoDiffFunctionBase
+{
+protected:
+  using AutoDiffFunctionBase::AutoDiffFunctionBase;
+
+  void evaluate_(const Inputs<double> & x, Vector<double> & f) const override { derived().evaluate(x, f); }
+  void evaluate_(const Inputs<Dual1> & x, Vector<Dual1> & f) const override { derived().evaluate(x, f); }
+  void evaluate_(const Inputs<DualN> & x, Vector<DualN> & f) const override { derived().evaluate(x, f); }
+  void evaluate_(const Inputs<Dual11> & x, Vector<Dual11> & f) const override { derived().evaluate(x, f); }
+  void evaluate_(const Inputs<DualN1> & x, Vector<DualN1> & f) const override { derived().evaluate(x, f); }
+
+private:
+  const Derived & derived() const { return static_cast<const Derived &>(*this); }
+};
+
+} // namespace abstract
+
+} // namespace function
+
+} // namespace tvm
@@ -55,6 +55,16 @@ public:
   virtual const Eigen::VectorXd & normalAcceleration() const;
   virtual MatrixConstRef JDot(const Variable & x) const;
 
+  /** Create a function identical to this one, but on the clones of its
+   * variables as given by \p map.
+   *
+   * Use utils::CloneMap::function rather than calling this method directly.
+   * Functions depending on other functions should get the clones of those
+   * through \p map as well. The default implementation throws: a derived
+   * class needs to override this method to be cloneable.
+   */
+  virtual FunctionPtr clone(utils::CloneMap & map) const;
+
 protected:
   struct slice_jdot
   {
@@ -6,6 +6,9 @@
 
 #include <tvm/graph/internal/AbstractNode.h>
 #include <tvm/graph/internal/DependencyGraph.h>
+#include <tvm/utils/Tracer.h>
+
+#include <functional>
 
 namespace tvm
 {
@@ -34,13 +37,33 @@ public:
   /** Clear the object.*/
   void clear();
 
+  /** Make this graph a copy of \p other in which each source (node or
+   * output) is replaced by its image through \p map, and whose inputs are
+   * \p inputs, which should be the image of the inputs of \p other.
+   *
+   * The plan of \p other is reused as is, instead of being computed again by
+   * update().
+   *
+   * \return false if a source of \p other has no image (\p map returns
+   * \a nullptr). The graph is then left cleared.
+   */
+  bool copy(const CallGraph & other,
+            std::shared_ptr<internal::Inputs> inputs,
+            const std::function<abstract::Outputs *(const abstract::Outputs *)> & map);
+
 protected:
   /** A call is formed by the combination of a Node and id */
   struct Call
   {
     internal::AbstractNode * node;
     int id;
-    inline void operator()() const { node->update(id); }
+    inline void operator()() const
+    {
+      if(node->isUpdateDue(id))
+      {
+        node->update(id);
+      }
+    }
   };
 
   /** Similar to a specialization of std::less for Call */
@@ -59,9 +82,21 @@ protected:
     /** Clear the plan*/
     void clear();
 
+    /** Make this plan a copy of \p other, the plan of \p graph, in which
+     * each call is replaced by the call with the same id in \p calls.
+     */
+    void copy(const Plan & other, const CallGraph & graph, const std::vector<Call> & calls);
+
     /** Execute the plan */
     inline void execute() const
     {
+#ifdef TVM_WITH_TRACING
+      if(utils::Tracer::tracer().enabled())
+      {
+        executeTraced();
+        return;
+      }
+#endif
       for(auto & c : plan_)
       {
         c();
@@ -69,6 +104,11 @@ protected:
     }
 
   private:
+    /** Execute the plan, recording the time taken by each call in
+     * utils::Tracer::tracer().
+     */
+    void executeTraced() const;
+
     /** The calls in the correct call order */
     std::vector<Call> plan_;
   };
@@ -6,10 +6,13 @@
 
 #include <tvm/api.h>
 
+#include <tvm/Clock.h>
 #include <tvm/graph/internal/Inputs.h>
 
 #include <cassert>
 #include <functional>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 
 namespace tvm
@@ -108,6 +111,41 @@ public:
     updates_[i](*this);
   }
 
+  /** Have the call graphs run the update \p u at most once every \p period
+   * ticks of \p clock, instead of at each execution. In between, the outputs
+   * depending on \p u keep the values computed at the last run, and the
+   * updates depending on them are still run at full rate.
+   *
+   * This is meant for quantities that vary slowly with respect to the control
+   * rate (e.g. collision distances or the mass matrix of a robot). A period
+   * of 1 restores the default behavior.
+   *
+   * The lifetime of \p clock should be guaranteed by the caller.
+   */
+  template<typename EnumT>
+  void setUpdatePeriod(EnumT u, const Clock & clock, int period);
+
+  /** The period of the update \p u, in ticks of its clock (1 if no period
+   * was set).
+   */
+  template<typename EnumT>
+  int updatePeriod(EnumT u) const
+  {
+    auto it = updatePeriods_.find(static_cast<int>(u));
+    return it == updatePeriods_.end() ? 1 : static_cast<int>(it->second.period);
+  }
+
+  /** Check if the update \p i is to be run by a call graph at this tick, and
+   * if so, take note that it is.
+   */
+  inline bool isUpdateDue(int i)
+  {
+    if(updatePeriods_.empty())
+      return true;
+    auto it = updatePeriods_.find(i);
+    return it == updatePeriods_.end() || it->second.due();
+  }
+
 protected:
   /** Map from a update id to  corresponding dependency function.*/
   std::map<int, std::function<void(AbstractNode &)>> updates_;
@@ -122,10 +160,56 @@ protected:
   /** Map from an output to the input it directly uses, without requiring an update (expressed by the respective ids).*/
   std::map<int, std::pair<Outputs *, int>> directDependencies_;
 
+  /** Period of an update, in ticks of a clock */
+  struct UpdatePeriod
+  {
+    const Clock * clock;
+    uint64_t period;
+    uint64_t lastTick = 0;
+    bool ran = false;
+
+    bool due()
+    {
+      uint64_t t = clock->ticks();
+      if(ran && t - lastTick < period)
+        return false;
+      lastTick = t;
+      ran = true;
+      return true;
+    }
+  };
+  /** Map from an update id to its period, for the updates that are not run at each execution of the graph.*/
+  std::map<int, UpdatePeriod> updatePeriods_;
+
 private:
   AbstractNode() { is_node_ = true; }
 };
 
+template<typename EnumT>
+void AbstractNode::setUpdatePeriod(EnumT u, const Clock & clock, int period)
+{
+  static_assert(std::is_enum<EnumT>::value, "The update should be given as an enumeration value");
+  int i = static_cast<int>(u);
+  if(!updates_.count(i))
+  {
+    std::stringstream ss;
+    ss << "[AbstractNode::setUpdatePeriod] Update " << i << " is not registered for this node";
+    throw std::runtime_error(ss.str());
+  }
+  if(period < 1)
+  {
+    throw std::runtime_error("[AbstractNode::setUpdatePeriod] The period must be at least 1");
+  }
+  if(period == 1)
+  {
+    updatePeriods_.erase(i);
+  }
+  else
+  {
+    updatePeriods_[i] = {&clock, static_cast<uint64_t>(period)};
+  }
+}
+
 /** Add new update signals for a given entity SelfT.
  *
  * Read the meta-information available at construction for SelfT to start the
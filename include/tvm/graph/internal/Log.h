@@ -207,6 +207,11 @@ public:
    */
   const std::type_index & getPromotedType(const Pointer & p) const;
 
+  /** A readable name for \p update, made of the name of the class of its
+   * owner and the name of the update, e.g. "BasicLinearFunction::Value".
+   */
+  std::string readableName(const Update & update) const;
+
   // raw logs
   std::vector<Update> updates_;
   std::vector<Input> inputs_;
@@ -7,8 +7,10 @@
 #include <tvm/graph/internal/Log.h>
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <memory>
+#include <mutex>
 
 namespace tvm
 {
@@ -25,6 +27,13 @@ namespace internal
 {
 class Inputs;
 
+/** Record the structure of the update graphs (updates, dependencies,
+ * inputs, ...) as they are built, for display and tracing purposes.
+ *
+ * The logging functions can be called concurrently, e.g. when problems are
+ * built or solved on several threads. log() must not be called while a graph
+ * is being built.
+ */
 class TVM_DLLAPI Logger
 {
 public:
@@ -65,9 +74,15 @@ public:
 private:
   Logger() = default;
 
+  /** Same as registerType, for when mutex_ is already locked.*/
+  template<typename U>
+  void registerType_(U * node);
+
   // raw log
   Log log_;
-  bool disabled_;
+  std::atomic<bool> disabled_{false};
+  /** Protects log_ */
+  std::mutex mutex_;
 };
 
 // Helper function for pointer-to-member-function
@@ -86,9 +101,11 @@ inline void Logger::registerUpdate(U * node, EnumT u, void (U::*fn)())
   if(disabled_)
     return;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   Log::Update up{Log::EnumValue(u), U::UpdateName(u), getPointerValue<U>(fn), Log::Pointer(node)};
   log_.updates_.push_back(up);
-  registerType(node);
+  registerType_(node);
 }
 
 template<typename S, typename EnumO>
@@ -97,10 +114,12 @@ inline void Logger::addInput(Inputs * node, S * source, EnumO i)
   if(disabled_)
     return;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   Log::Input in = {Log::EnumValue(i), S::OutputName(i), Log::Pointer(source), Log::Pointer(node)};
   log_.inputs_.push_back(in);
-  registerType(node);
-  registerType(source);
+  registerType_(node);
+  registerType_(source);
 }
 
 template<typename U, typename EnumO, typename EnumU>
@@ -109,12 +128,14 @@ inline void Logger::addOutputDependency(U * node, EnumO o, EnumU u)
   if(disabled_)
     return;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   Log::Output out = {Log::EnumValue(o), U::OutputName(o), Log::Pointer(node)};
   log_.outputs_.push_back(out);
 
   Log::OutputDependency dep = {Log::EnumValue(u), Log::EnumValue(o), Log::Pointer(node)};
   log_.outputDependencies_.push_back(dep);
-  registerType(node);
+  registerType_(node);
 }
 
 template<typename U, typename EnumU1, typename EnumU2>
@@ -123,9 +144,11 @@ inline void Logger::addInternalDependency(U * node, EnumU1 uDependent, EnumU2 u)
   if(disabled_)
     return;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   Log::InternalDependency dep = {Log::EnumValue(u), Log::EnumValue(uDependent), Log::Pointer(node)};
   log_.internalDependencies_.push_back(dep);
-  registerType(node);
+  registerType_(node);
 }
 
 template<typename U, typename EnumU, typename S, typename EnumO>
@@ -134,10 +157,12 @@ inline void Logger::addInputDependency(U * node, EnumU u, S * source, EnumO i)
   if(disabled_)
     return;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   Log::InputDependency dep = {Log::EnumValue(i), Log::EnumValue(u), Log::Pointer(source), Log::Pointer(node)};
   log_.inputDependencies_.push_back(dep);
-  registerType(node);
-  registerType(source);
+  registerType_(node);
+  registerType_(source);
 }
 
 template<typename U, typename EnumO, typename S, typename EnumI>
@@ -146,13 +171,15 @@ inline void Logger::addDirectDependency(U * node, EnumO o, S * source, EnumI i)
   if(disabled_)
     return;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   Log::Output out = {Log::EnumValue(o), U::OutputName(o), Log::Pointer(node)};
   log_.outputs_.push_back(out);
 
   Log::DirectDependency dep = {Log::EnumValue(i), Log::EnumValue(o), Log::Pointer(source), Log::Pointer(node)};
   log_.directDependencies_.push_back(dep);
-  registerType(node);
-  registerType(source);
+  registerType_(node);
+  registerType_(source);
 }
 
 template<typename U>
@@ -161,6 +188,13 @@ inline void Logger::registerType(U * node)
   if(disabled_)
     return;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+  registerType_(node);
+}
+
+template<typename U>
+inline void Logger::registerType_(U * node)
+{
   std::type_index t(typeid(*node));
   std::uintptr_t val = reinterpret_cast<std::uintptr_t>(node);
   auto & types = log_.types_[val];
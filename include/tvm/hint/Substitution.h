@@ -116,6 +116,17 @@ public:
   /** Return the calculator used by this substitution.*/
   std::shared_ptr<abstract::SubstitutionCalculatorImpl> calculator() const;
 
+  /** The same substitution, on the constraints \p cstr and on the clones of
+   * the variables given by \p map.
+   *
+   * \param cstr The clones of constraints(), in the same order.
+   * \param map Correspondence between the variables and their clones.
+   *
+   * \throws std::runtime_error if the calculator of this substitution does not
+   * support cloning (see abstract::SubstitutionCalculatorImpl::clone).
+   */
+  Substitution clone(const std::vector<LinearConstraintPtr> & cstr, utils::CloneMap & map) const;
+
 private:
   /** Check the validity and coherence of the parameters passed to the
    * constructor.
@@ -8,6 +8,7 @@
 #include <tvm/Range.h>
 #include <tvm/VariableVector.h>
 
+#include <memory>
 #include <vector>
 
 namespace tvm
@@ -35,6 +36,10 @@ public:
   virtual ~SubstitutionCalculatorImpl() = default;
   /** Update the internal computations based on the current value of A, i.e
    * the current values of the constraints' jacobian matrices.
+   *
+   * If A is constant, the computations are only carried out the first time,
+   * and afterward only if the values of the jacobian matrices are changed
+   * (e.g. by explicitly setting a new matrix in a BasicLinearFunction).
    */
   void update();
   /** If \minus = \false, perform \p outA = A^# * \p in and \p outS = S^T * \p in
@@ -59,6 +64,21 @@ public:
   /** Rank of A*/
   Eigen::DenseIndex r() const;
 
+  /** Number of times the computations were actually performed by update().
+   * For a constant A, this stays at 1 as long as A is not modified.
+   */
+  int updateCount() const;
+
+  /** Create a calculator of the same type and with the same parameters as
+   * this one, for the constraints \p cstr and the variables \p x (typically
+   * the clones of those of this calculator, see Substitution::clone).
+   *
+   * The default implementation throws: a derived class needs to override
+   * this method to be cloneable.
+   */
+  virtual std::unique_ptr<SubstitutionCalculatorImpl> clone(const std::vector<LinearConstraintPtr> & cstr,
+                                                            const std::vector<VariablePtr> & x) const;
+
 protected:
   /** Constructor
    * \param cstr the list of constraints
@@ -97,6 +117,13 @@ protected:
   /** Copy in A_ the values of the relevant jacobian matrices.*/
   void fillA();
 
+  /** Return true if the jacobian matrices differ from the ones used for the
+   * last computations. Only meaningful when A is constant.
+   */
+  bool sourceChanged() const;
+  /** Save the current jacobian matrices for later use by sourceChanged().*/
+  void saveSource();
+
   /** The matrix N*/
   Eigen::MatrixXd N_;
   /** The list of constraints.*/
@@ -111,6 +138,7 @@ private:
     VariablePtr x;
     LinearConstraintPtr cstr;
     Eigen::Block<Eigen::MatrixXd> block;
+    std::pair<int, Range> loc; // location of the jacobian matrix w.r.t. x in cstr
   };
 
   Eigen::DenseIndex m_; // row size of A
@@ -119,7 +147,10 @@ private:
   bool constant_;       // constness of A
   bool init_;           // used to perform update_() only once if A is constant
   bool simple_;         // true if there is only one variable and one constraint
+  int updateCount_;     // number of times update_() was called
   Eigen::MatrixXd A_;   // aggregated matrix for non-simple case;
+  Eigen::MatrixXd A0_;  // copy of A used for the last computations, simple and constant case only
+  std::pair<int, Range> loc0_; // location of A in the constraint, simple case only
   /** All the pairs (x,c) with x in variables_ and c in constraints_ for which
    * c.contains(x), and the block of A in which to copy c.jacobian(x)
    */
@@ -134,6 +165,8 @@ inline Eigen::DenseIndex SubstitutionCalculatorImpl::n() const { return n_; }
 
 inline Eigen::DenseIndex SubstitutionCalculatorImpl::r() const { return r_; }
 
+inline int SubstitutionCalculatorImpl::updateCount() const { return updateCount_; }
+
 inline bool SubstitutionCalculatorImpl::isSimple() const { return simple_; }
 
 } // namespace abstract
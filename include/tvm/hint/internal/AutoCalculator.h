@@ -20,8 +20,17 @@ namespace internal
  * constraints and variables.
  *
  * Current rules:
+ * - for a substitution with a single constraint whose jacobian matrix w.r.t.
+ *   the substituted variables taken together is declared symmetric positive
+ *   definite with a branch-induced sparsity pattern (see
+ *   FirstOrderProvider::jacobianParentArray), generates a LTDLCalculator using
+ *   this pattern (this is the case of the inertia matrix when substituting the
+ *   accelerations of a robot, even with a free-flyer)
  * - for a simple substitution with invertible diagonal matrix, generates a
- *   DiagonalCalculator
+ *   DiagonalCalculator (this includes the -I block of the dynamic equation
+ *   when substituting the torques)
+ * - for a simple substitution with positive definite matrix, generates a
+ *   (dense) LTDLCalculator
  * - otherwise generates a GenericCalculator
  *
  * \note You need to ensure that the matrix properties used when applying the
@@ -38,6 +38,9 @@ public:
          const std::vector<Eigen::DenseIndex> & nnzRows,
          const std::vector<Eigen::DenseIndex> & zeroRows);
 
+    std::unique_ptr<abstract::SubstitutionCalculatorImpl> clone(const std::vector<LinearConstraintPtr> & cstr,
+                                                                const std::vector<VariablePtr> & x) const override;
+
     virtual void update_() override;
     virtual void premultiplyByASharpAndSTranspose_(MatrixRef outA,
                                                    MatrixRef outS,
@@ -28,6 +28,9 @@ namespace internal
  * A^# = P1 R1^-1 Q1^T
  * N = P2 - P1 R1^-1 R2
  * S = Q2
+ *
+ * If A is constant, A^# and S^T are formed explicitly once, so that the
+ * premultiplications are simple matrix products.
  */
 class TVM_DLLAPI GenericCalculator : public abstract::SubstitutionCalculator
 {
@@ -37,6 +40,9 @@ public:
   public:
     Impl(const std::vector<LinearConstraintPtr> & cstr, const std::vector<VariablePtr> & x, int rank);
 
+    std::unique_ptr<abstract::SubstitutionCalculatorImpl> clone(const std::vector<LinearConstraintPtr> & cstr,
+                                                                const std::vector<VariablePtr> & x) const override;
+
     virtual void update_() override;
     virtual void premultiplyByASharpAndSTranspose_(MatrixRef outA,
                                                    MatrixRef outS,
@@ -47,6 +53,10 @@ public:
     Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr_;
     Eigen::MatrixXd invR1R2_;                     // inv(R1)*R2
     mutable utils::internal::BufferedMatrix tmp_; // temporary for the premultiplication by Asharp and S^T
+    bool explicit_;                               // true if Asharp_ and St_ are up to date
+    Eigen::MatrixXd Asharp_;                      // explicit A^#, for constant A
+    Eigen::MatrixXd St_;                          // explicit S^T, for constant A
+    Eigen::MatrixXd Im_;                          // identity of size m, for constant A
   };
 
 protected:
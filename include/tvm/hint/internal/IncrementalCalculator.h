@@ -0,0 +1,134 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/api.h>
+#include <tvm/defs.h>
+
+#include <tvm/hint/abstract/SubstitutionCalculator.h>
+#include <tvm/hint/abstract/SubstitutionCalculatorImpl.h>
+#include <tvm/utils/internal/BufferedMatrix.h>
+
+#include <Eigen/QR>
+
+#include <vector>
+
+namespace tvm
+{
+
+namespace hint
+{
+
+namespace internal
+{
+/** A substitution calculator for matrices A that change little from one
+ * update to the next, e.g. when only a few rows or columns of the jacobian
+ * matrices are modified.
+ *
+ * It works with the same decomposition as GenericCalculator,
+ * A | P1  P2 | = | Q1  Q2 | | R1  R2 |
+ *                           |  0   0 |
+ * but keeps Q explicitly so that the factorization can be updated. When
+ * k <= maxRank rows or columns of A have changed since the last update, the
+ * change is a rank-k modification of A, and Q and R are updated by k rank-1
+ * updates using Givens rotations, in O(kmn) instead of O(m^2n). The column
+ * permutation P is kept from the last full factorization.
+ *
+ * A full factorization is performed instead
+ *  - if more than maxRank rows and columns have changed,
+ *  - after refreshPeriod consecutive incremental updates,
+ *  - if the updated factorization does not reproduce A with a relative
+ *    accuracy of tol, or if R1 becomes badly conditioned,
+ *  - if A is not full row rank (the incremental update is only used for
+ *    r = m).
+ */
+class TVM_DLLAPI IncrementalCalculator : public abstract::SubstitutionCalculator
+{
+public:
+  class TVM_DLLAPI Impl : public abstract::SubstitutionCalculatorImpl
+  {
+  public:
+    Impl(const std::vector<LinearConstraintPtr> & cstr,
+         const std::vector<VariablePtr> & x,
+         int rank,
+         int maxRank,
+         int refreshPeriod,
+         double tol);
+
+    std::unique_ptr<abstract::SubstitutionCalculatorImpl> clone(const std::vector<LinearConstraintPtr> & cstr,
+                                                                const std::vector<VariablePtr> & x) const override;
+
+    virtual void update_() override;
+    virtual void premultiplyByASharpAndSTranspose_(MatrixRef outA,
+                                                   MatrixRef outS,
+                                                   const MatrixConstRef & in,
+                                                   bool minus) const override;
+
+    /** Number of full factorizations performed so far.*/
+    int factorizations() const { return factorizations_; }
+
+  private:
+    /** Full factorization of A.*/
+    void factorize(const MatrixConstRef & A);
+    /** Try to update the factorization for the change from Aprev_ to A.
+     * Return false if the update was not performed or failed.
+     */
+    bool updateFactorization(const MatrixConstRef & A);
+    /** Update the factorization for A P + u vp^T (vp is given in the permuted
+     * order).
+     */
+    void rank1Update(const Eigen::VectorXd & u, const Eigen::VectorXd & vp);
+    /** Check that Q R is close to A P and that R1 is well conditioned.*/
+    bool check(const MatrixConstRef & A) const;
+    /** Compute N from R and P.*/
+    void computeN();
+
+    int maxRank_;       // maximum number of rank-1 updates per call to update_()
+    int refreshPeriod_; // maximum number of incremental updates between two full factorizations
+    double tol_;        // relative accuracy required for Q R = A P
+    int sinceRefresh_;  // number of incremental updates since the last full factorization
+    int factorizations_;
+
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr_;
+    Eigen::MatrixXd Q_;
+    Eigen::MatrixXd R_;
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic> P_;
+    Eigen::VectorXi Pinv_;    // Pinv_[j] is the position of column j of A in A P
+    Eigen::MatrixXd Aprev_;   // A used for the current factorization
+    Eigen::MatrixXd invR1R2_; // inv(R1)*R2
+    Eigen::VectorXd u_;       // temporaries for the rank-1 updates
+    Eigen::VectorXd vp_;
+    Eigen::VectorXd w_;
+    Eigen::VectorXd work_;
+    Eigen::VectorXd checkX_; // vectors for the accuracy check
+    mutable Eigen::VectorXd checkY_;
+    mutable Eigen::VectorXd checkZ_;
+    std::vector<Eigen::DenseIndex> changed_;      // indices of the changed rows or columns
+    mutable utils::internal::BufferedMatrix tmp_; // temporary for the premultiplication by Asharp and S^T
+  };
+
+  /** \param maxRank Maximum rank of the change of A for which an incremental
+   * update is attempted. If negative, m/4 (but at least 1) is used.
+   * \param refreshPeriod Number of consecutive incremental updates after
+   * which a full factorization is performed.
+   * \param tol Relative accuracy of the factorization under which a full
+   * factorization is performed.
+   */
+  IncrementalCalculator(int maxRank = -1, int refreshPeriod = 50, double tol = 1e-10);
+
+protected:
+  std::unique_ptr<abstract::SubstitutionCalculatorImpl> impl_(const std::vector<LinearConstraintPtr> & cstr,
+                                                              const std::vector<VariablePtr> & x,
+                                                              int rank) const override;
+
+private:
+  int maxRank_;
+  int refreshPeriod_;
+  double tol_;
+};
+
+} // namespace internal
+
+} // namespace hint
+
+} // namespace tvm
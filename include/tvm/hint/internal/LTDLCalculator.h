@@ -0,0 +1,86 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/api.h>
+#include <tvm/defs.h>
+
+#include <tvm/hint/abstract/SubstitutionCalculator.h>
+#include <tvm/hint/abstract/SubstitutionCalculatorImpl.h>
+
+#include <vector>
+
+namespace tvm
+{
+
+namespace hint
+{
+
+namespace internal
+{
+/** A calculator for symmetric positive definite matrices A with a
+ * branch-induced sparsity pattern, such as the joint-space inertia matrix of
+ * a robot.
+ *
+ * The pattern is described by a parent array \p lambda: lambda[i] < i is the
+ * index of the parent of column i, or -1 if i has no parent. A(i,j) can only
+ * be non-zero if i is an ancestor of j or j is an ancestor of i. The
+ * coefficients of A outside of this pattern are ignored.
+ *
+ * A is decomposed as A = L^T D L, with L unit lower triangular and D
+ * diagonal, where L has the same sparsity pattern as the lower part of A (see
+ * Featherstone, Rigid Body Dynamics Algorithms, Chap. 6). The
+ * factorization costs O(n d^2) and each solve O(n d), where d is the depth
+ * of the tree described by lambda.
+ *
+ * A being invertible, A^# = A^-1 and N and S are empty.
+ *
+ * For a robot, the parent array can be obtained with Robot::dofParents(), in
+ * which case the variables to substitute must be given in the order of the
+ * robot's dof (e.g. the free-flyer before the joints).
+ */
+class TVM_DLLAPI LTDLCalculator : public abstract::SubstitutionCalculator
+{
+public:
+  class TVM_DLLAPI Impl : public abstract::SubstitutionCalculatorImpl
+  {
+  public:
+    Impl(const std::vector<LinearConstraintPtr> & cstr,
+         const std::vector<VariablePtr> & x,
+         int rank,
+         const std::vector<int> & lambda);
+
+    std::unique_ptr<abstract::SubstitutionCalculatorImpl> clone(const std::vector<LinearConstraintPtr> & cstr,
+                                                                const std::vector<VariablePtr> & x) const override;
+
+    virtual void update_() override;
+    virtual void premultiplyByASharpAndSTranspose_(MatrixRef outA,
+                                                   MatrixRef outS,
+                                                   const MatrixConstRef & in,
+                                                   bool minus) const override;
+
+  private:
+    std::vector<int> lambda_; // parent array
+    Eigen::MatrixXd LD_;      // L (strictly lower part) and D (diagonal)
+  };
+
+  /** \param lambda The parent array describing the sparsity pattern. If
+   * empty, the matrix is considered as dense (i.e. lambda[i] = i-1) and the
+   * calculator performs a regular LDL^T decomposition.
+   */
+  LTDLCalculator(const std::vector<int> & lambda = {});
+
+protected:
+  std::unique_ptr<abstract::SubstitutionCalculatorImpl> impl_(const std::vector<LinearConstraintPtr> & cstr,
+                                                              const std::vector<VariablePtr> & x,
+                                                              int rank) const override;
+
+private:
+  std::vector<int> lambda_;
+};
+
+} // namespace internal
+
+} // namespace hint
+
+} // namespace tvm
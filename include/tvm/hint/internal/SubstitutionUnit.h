@@ -118,6 +118,14 @@ private:
   std::vector<std::vector<int>> constraintsY_;
   /** constraints_[i] depends on x_[CXdependencies_[i][j]].*/
   std::vector<std::vector<int>> CXdependencies_;
+  /** Location in constraints_[i] of its jacobian matrix w.r.t.
+   * y_[constraintsY_[i][j]] (see FirstOrderProvider::jacobianLocation).
+   */
+  std::vector<std::vector<std::pair<int, Range>>> constraintsYLocations_;
+  /** Location in constraints_[i] of its jacobian matrix w.r.t.
+   * x_[CXdependencies_[i][j]].
+   */
+  std::vector<std::vector<std::pair<int, Range>>> CXLocations_;
   /** x_[i] depends on y_[XYdependencies_[i][j]].*/
   std::vector<std::vector<int>> XYdependencies_;
   /** x_[i] depends on z_[XZdependencies_[i][j]].*/
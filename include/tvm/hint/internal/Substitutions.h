@@ -8,7 +8,9 @@
 #include <tvm/graph/internal/DependencyGraph.h>
 #include <tvm/hint/Substitution.h>
 #include <tvm/hint/internal/SubstitutionUnit.h>
+#include <tvm/utils/internal/ThreadPool.h>
 
+#include <memory>
 #include <vector>
 
 namespace tvm
@@ -43,12 +45,25 @@ public:
    * Needs to be called after all the call to \p add or \p remove, and before
    * the calls to \p variables, \p variableSubstitutions and
    * \p additionalConstraints.
+   *
+   * Groups of substitutions that were not affected by the calls to \p add
+   * and \p remove since the last call are kept as is, so that their
+   * variables, functions and additional constraints remain the same objects.
    */
   void finalize();
 
   /** Update the data for the substitutions*/
   void updateSubstitutions();
 
+  /** Set the number of threads used by \p updateSubstitutions.
+   * The groups of dependent substitutions (units) are independent from one
+   * another, so that they can be updated concurrently. With \p n = 1 (the
+   * default), the update is serial.
+   */
+  void threads(int n);
+  /** Number of threads used by \p updateSubstitutions.*/
+  int threads() const;
+
   /** Update the value of the substituted variables according to the values of
    * the non-substituted ones.*/
   void updateVariableValues() const;
@@ -67,6 +82,13 @@ public:
    * replaced by. Otherwise, return \p x
    */
   VariableVector substitute(const VariablePtr & x) const;
+  /** Same as \p substitute(x), for the substituted variables \p xs and the
+   * corresponding functions \p fs, as given by \p variables() and
+   * \p variableSubstitutions().
+   */
+  static VariableVector substitute(const VariablePtr & x,
+                                   const std::vector<VariablePtr> & xs,
+                                   const std::vector<std::shared_ptr<function::BasicLinearFunction>> & fs);
 
   /** Get the substitution using the constraint*/
   Substitution const * getSubstitutionFor(const constraint::abstract::LinearConstraint & cstr);
@@ -83,6 +105,17 @@ private:
   /** Group of dependent substitutions*/
   std::vector<SubstitutionUnit> units_;
 
+  /** For each unit, the constraints, variables and calculators of its
+   * substitutions, used to identify the units that can be reused.
+   */
+  std::vector<std::vector<const void *>> unitKeys_;
+
+  /** Pool of threads to update units_ concurrently (null for a serial update)*/
+  std::shared_ptr<tvm::utils::internal::ThreadPool> pool_;
+
+  /** True if units_ have not been updated since the last call to finalize.*/
+  bool firstUpdate_ = true;
+
   /** The variables substituted (x).*/
   std::vector<VariablePtr> variables_;
 
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace tvm::internal
@@ -56,6 +57,56 @@ public:
    */
   virtual MatrixConstRefWithProperties jacobian(const Variable & x) const;
 
+  /** Return the jacobian matrix of this entity corresponding to the \p i-th
+   * variable of variables().
+   *
+   * With the flat storage (see useFlatJacobian), this is a constant-time
+   * access. Otherwise, it is equivalent to jacobian(*variables()[i]).
+   *
+   * This is virtual for the same reason as jacobian(): an entity returning
+   * the jacobian matrices of another one can forward the index.
+   */
+  virtual MatrixConstRefWithProperties jacobianAt(int i) const;
+
+  /** Return the index in variables() of the variable containing \p x, and the
+   * range of the columns of \p x in the jacobian matrix w.r.t. this variable.
+   *
+   * This is a linear search over the variables. It is meant to be done once,
+   * e.g. when building a solver, the jacobian matrix w.r.t. \p x being then
+   * accessed with jacobianAt(const std::pair<int, Range> &).
+   *
+   * \throws std::out_of_range if no variable contains \p x.
+   */
+  std::pair<int, Range> jacobianLocation(const Variable & x) const;
+
+  /** Return the jacobian matrix at the location \p loc given by
+   * jacobianLocation. This is as fast as jacobianAt(int).
+   */
+  MatrixConstRefWithProperties jacobianAt(const std::pair<int, Range> & loc) const;
+
+  /** Whether the jacobian matrices are stored in a single matrix (see
+   * useFlatJacobian).
+   */
+  bool hasFlatJacobian() const;
+
+  /** Return the jacobian matrices w.r.t. all the variables, concatenated
+   * column-wise in the order of variables().
+   *
+   * Only available with the flat storage (see useFlatJacobian).
+   */
+  const Eigen::MatrixXd & flatJacobian() const;
+
+  /** Check whether the jacobian matrix w.r.t. the variables \p x taken
+   * together, i.e. [J_x1 ... J_xk], is symmetric positive definite with a
+   * branch-induced sparsity pattern (see hint::internal::LTDLCalculator), and
+   * if so, write in \p lambda the parent array describing this pattern.
+   *
+   * The properties of each jacobian matrix cannot express this when the
+   * matrix is split over several variables, as is the case for the inertia
+   * matrix of a floating-base robot. By default, this returns false.
+   */
+  virtual bool jacobianParentArray(const std::vector<VariablePtr> & x, std::vector<int> & lambda) const;
+
   /** Linearity w.r.t \p x*/
   bool linearIn(const Variable & x) const;
 
@@ -174,9 +225,37 @@ protected:
   inline void splitJacobian(const MatrixConstRef & J, const VariableVector & vars, bool keepProperties = false)
   { splitJacobian(J, vars.variables(), keepProperties); }
 
+  /** Store the jacobian matrices in a single matrix instead of one matrix per
+   * variable.
+   *
+   * The jacobian matrix w.r.t. the \a i-th variable of variables_ is then the
+   * block of columns \a i of ::jacobianMatrix_, and is accessed in constant
+   * time with jacobianSlot or jacobianAt, while the whole jacobian can be
+   * processed at once through ::jacobianMatrix_. Lookups with jacobian(x) are
+   * done by a linear search over the (typically few) variables instead of a
+   * search in a map.
+   *
+   * The existing jacobian matrices are moved to the new storage. Afterwards,
+   * ::jacobian_ is not used anymore, and derived classes must access the
+   * jacobian matrices through jacobianSlot or ::jacobianMatrix_.
+   * Adding or removing a variable invalidates the references to any of the
+   * jacobian matrices.
+   */
+  void useFlatJacobian();
+
+  /** Jacobian matrix w.r.t. the \p i-th variable of variables_, with its
+   * properties.
+   *
+   * This works with both storages, but is only a constant-time access with
+   * the flat storage.
+   */
+  slice_matrix::Type jacobianSlot(int i);
+
   // cache
   Eigen::VectorXd value_;
   utils::internal::MapWithVariableAsKey<MatrixWithProperties, slice_matrix, true> jacobian_;
+  /** Flat storage of the jacobian matrices (see useFlatJacobian).*/
+  Eigen::MatrixXd jacobianMatrix_;
 
 protected:
   /** Resize the function */
@@ -185,12 +264,70 @@ protected:
   Space imageSpace_; // output space
   VariableVector variables_;
   utils::internal::MapWithVariableAsKey<bool, slice_linear> linear_;
+
+private:
+  /** Jacobian w.r.t. \p x (or a variable containing it) with the flat storage.*/
+  MatrixConstRefWithProperties flatJacobian(const Variable & x) const;
+  /** Recompute jacobianOffsets_ from variables_.*/
+  void computeJacobianOffsets();
+
+  bool flat_ = false;
+  /** Properties of the jacobian matrices with the flat storage.*/
+  std::vector<MatrixProperties> jacobianProperties_;
+  /** Start column of the jacobian matrix of each variable in jacobianMatrix_,
+   * followed by the total number of columns.
+   */
+  std::vector<Eigen::DenseIndex> jacobianOffsets_;
 };
 
 inline const Eigen::VectorXd & FirstOrderProvider::value() const { return value_; }
 
 inline MatrixConstRefWithProperties FirstOrderProvider::jacobian(const Variable & x) const
-{ return jacobian_.at(&x, tvm::utils::internal::with_sub{}); }
+{
+  if(flat_)
+    return flatJacobian(x);
+  return jacobian_.at(&x, tvm::utils::internal::with_sub{});
+}
+
+inline MatrixConstRefWithProperties FirstOrderProvider::jacobianAt(int i) const
+{
+  assert(i >= 0 && i < variables_.numberOfVariables());
+  if(flat_)
+  {
+    auto k = static_cast<size_t>(i);
+    return {jacobianMatrix_.middleCols(jacobianOffsets_[k], jacobianOffsets_[k + 1] - jacobianOffsets_[k]),
+            jacobianProperties_[k]};
+  }
+  return jacobian(*variables_[i]);
+}
+
+inline MatrixConstRefWithProperties FirstOrderProvider::jacobianAt(const std::pair<int, Range> & loc) const
+{
+  auto J = jacobianAt(loc.first);
+  if(loc.second.start == 0 && loc.second.dim == J.cols())
+    return J;
+  return {J.middleCols(loc.second.start, loc.second.dim), slice_matrix::slice(J.properties())};
+}
+
+inline bool FirstOrderProvider::hasFlatJacobian() const { return flat_; }
+
+inline const Eigen::MatrixXd & FirstOrderProvider::flatJacobian() const
+{
+  assert(flat_ && "The jacobian matrices are not stored in a single matrix.");
+  return jacobianMatrix_;
+}
+
+inline FirstOrderProvider::slice_matrix::Type FirstOrderProvider::jacobianSlot(int i)
+{
+  assert(i >= 0 && i < variables_.numberOfVariables());
+  if(flat_)
+  {
+    auto k = static_cast<size_t>(i);
+    return {jacobianMatrix_.middleCols(jacobianOffsets_[k], jacobianOffsets_[k + 1] - jacobianOffsets_[k]),
+            jacobianProperties_[k]};
+  }
+  return jacobian_.at(variables_[i].get());
+}
 
 inline bool FirstOrderProvider::linearIn(const Variable & x) const
 { return linear_.at(&x, tvm::utils::internal::with_sub{}); }
@@ -27,6 +27,8 @@ public:
    */
   CoMFunction(RobotPtr robot);
 
+  FunctionPtr clone(utils::CloneMap & map) const override;
+
   /** Set the target CoM to the current robot's CoM */
   void reset();
 
@@ -56,6 +56,8 @@ protected:
     {
       Eigen::Vector3d nearestPoint_; // In body coordinates
       rbd::Jacobian jac_;
+      int ffSlot_;     // Index of the robot's free-flyer in variables_, -1 if it has none
+      int jointsSlot_; // Index of the robot's joints in variables_, -1 if it has none
     };
     std::vector<ObjectData> objects_;
     ConvexHullPtr ch_[2];
@@ -75,6 +75,16 @@ public:
   const std::string & body() const;
 
 private:
+  /** Copy of \p other attached to \p robot, a clone of other.robot() (see
+   * utils::CloneMap::frame).
+   */
+  Frame(const Frame & other, RobotPtr robot);
+
+  friend class utils::CloneMap;
+
+  /** Register the updates and the dependencies of the frame */
+  void registerUpdatesAndDependencies();
+
   std::string name_;
   RobotPtr robot_;
   unsigned int bodyId_;
@@ -53,6 +53,8 @@ public:
   const Eigen::VectorXd & velocity() const override { return f_->velocity(); }
   const Eigen::VectorXd & normalAcceleration() const override { return f_->normalAcceleration(); }
 
+  FunctionPtr clone(utils::CloneMap & map) const override;
+
 protected:
   /** Constructor
    *
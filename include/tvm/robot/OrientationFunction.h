@@ -24,6 +24,8 @@ public:
    */
   OrientationFunction(FramePtr frame);
 
+  FunctionPtr clone(utils::CloneMap & map) const override;
+
   /** Set the target orientation to the current frame orientation */
   void reset();
 
@@ -24,6 +24,8 @@ public:
    */
   PositionFunction(FramePtr frame);
 
+  FunctionPtr clone(utils::CloneMap & map) const override;
+
   /** Set the target position to the current frame position */
   void reset();
 
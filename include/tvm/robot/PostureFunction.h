@@ -25,6 +25,8 @@ public:
    */
   PostureFunction(RobotPtr robot);
 
+  FunctionPtr clone(utils::CloneMap & map) const override;
+
   /** Set the target posture to the current robot's posture */
   void reset();
 
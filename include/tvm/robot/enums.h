@@ -42,6 +42,25 @@ enum class ContactType
   Geometric
 };
 
+/** Scheme used by a Robot to integrate its configuration at each new clock
+ * tick, given the acceleration dot(q,2) computed by the solver:
+ *
+ * - Euler: rbd::eulerIntegration, i.e. q is integrated with the velocity and
+ *   acceleration of the previous tick (second order for Euclidean joints)
+ *   before dot(q) is updated
+ * - SemiImplicitEuler: dot(q) is integrated first, and q is then integrated
+ *   with the new velocity. This is the symplectic Euler scheme, that better
+ *   preserves the energy of the system for large time steps.
+ *
+ * In both cases the integration reads and writes the value of the robot's
+ * variables directly.
+ */
+enum class Integration
+{
+  Euler,
+  SemiImplicitEuler
+};
+
 } // namespace robot
 
 } // namespace tvm
@@ -91,6 +91,12 @@ public:
    */
   void addPositiveLambdaToProblem(ControlProblem & problem);
 
+  /** The jacobian matrix w.r.t. the accelerations of the robot, taken in the
+   * order of the robot's dof, is the inertia matrix, with the parent array
+   * given by Robot::dofParents().
+   */
+  bool jacobianParentArray(const std::vector<VariablePtr> & x, std::vector<int> & lambda) const override;
+
 protected:
   void updateb();
 
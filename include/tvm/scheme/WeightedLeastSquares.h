@@ -25,6 +25,10 @@ class TVM_DLLAPI WeightedLeastSquaresOptions
    * priority 2, the weighted least-squares problem will be assembled with weights
    * \p scalarizationWeight * w1 and w2 for T1 and T2 respectively. */
   TVM_ADD_NON_DEFAULT_OPTION(scalarizationWeight, 1000.)
+  /** If set, the data of each resolution of the underlying solver are recorded
+   * with this recorder (see LeastSquareSolver::recorder).
+   */
+  TVM_ADD_DEFAULT_OPTION(recorder, std::shared_ptr<solver::QPRecorder>)
 };
 
 /** This class implements the classic weighted least square scheme. */
@@ -37,10 +41,22 @@ private:
 
     void reset(std::unique_ptr<solver::abstract::LeastSquareSolver> solver);
 
+    /** Record the state of \p subs used to build the solver data.*/
+    void saveSubstitutions(const hint::internal::Substitutions & subs);
+
     std::unique_ptr<solver::abstract::LeastSquareSolver> solver;
 
     int maxp = 0;
 
+    /** State of the substitutions the solver data were built with: the
+     * substituted variables and their substitution functions, the additional
+     * constraints, and the constraints used by the substitutions.
+     */
+    std::vector<VariablePtr> substitutedVariables;
+    std::vector<std::shared_ptr<function::BasicLinearFunction>> substitutionFunctions;
+    std::vector<std::shared_ptr<constraint::BasicLinearConstraint>> substitutionConstraints;
+    std::vector<LinearConstraintPtr> substitutionUses;
+
   protected:
     void setVariablesToSolution_(tvm::internal::VariableCountingVector & x) override;
   };
@@ -127,6 +143,14 @@ protected:
                   Memory * memory,
                   const TaskWithRequirements & task,
                   solver::internal::SolverEvents & se) const;
+  /** Update the solver data for the changes of the substitutions since they
+   * were last processed. Only the constraints whose variables are substituted
+   * differently, or that started or stopped being used by a substitution, are
+   * processed.
+   */
+  void updateSubstitutions(const LinearizedControlProblem & problem,
+                           Memory * memory,
+                           solver::internal::SolverEvents & se) const;
 
   WeightedLeastSquaresOptions options_;
   /** The factory to create solvers attached to each problem. */
@@ -61,20 +61,28 @@ public:
    * the target matrix.
    * \param scalarizationWeight An additional scalar weight to apply on the
    * constraint, used by the solver to emulate priority.
+   * \param big The value used by the solver as infinity, for the missing or
+   * disabled bounds of the target.
    */
   Assignment(LinearConstraintPtr source,
              SolvingRequirementsPtr req,
              const AssignmentTarget & target,
              const VariableVector & variables,
              const hint::internal::Substitutions * const subs = nullptr,
-             double scalarizationWeight = 1);
+             double scalarizationWeight = 1,
+             double big = constant::big_number);
 
   /** Version for bounds
    * \param first whether this is the first assignment of bounds for this
    * variable (first assignment just copy vectors while the following ones
    * need to perform min/max operations).
+   * \param big The value used by the solver as infinity.
    */
-  Assignment(LinearConstraintPtr source, const AssignmentTarget & target, const VariablePtr & variables, bool first);
+  Assignment(LinearConstraintPtr source,
+             const AssignmentTarget & target,
+             const VariablePtr & variables,
+             bool first,
+             double big = constant::big_number);
 
   Assignment(const Assignment &) = delete;
   Assignment(Assignment &&) = default;
@@ -98,19 +106,32 @@ public:
   /** To be called after changing the weights.*/
   void onUpdateWeights(bool scalar = true, bool vector = true);
 
-  /** Perform the assignment.*/
+  /** Perform the assignment. If the source is disabled, the target is filled
+   * with a trivially satisfied constraint instead. If only one of the bounds
+   * of the source is disabled, this bound is set to -/+big in the target.
+   */
   void run();
 
-  static double big_;
-
 private:
   /** Check that the convention and size of the target are compatible with the
-   * convention and size of the source.
+   * convention and size of the source. Quadratic targets are not supported.
    */
   void checkTarget();
 
   void checkBounds();
 
+  /** Fill the target with a trivially satisfied constraint (zero rows and
+   * infinite bounds). Used in place of the assignment when the source is
+   * disabled.
+   */
+  void runDisabled();
+
+  /** Replace the (infinite) disabled side of a double-sided source by the big
+   * number of the solver in the target. Used after the assignment when only
+   * one of the bounds of the source is enabled.
+   */
+  void relaxDisabledSides();
+
   /** Generates the assignments for the general case.
    * \param variables the set of variables for the problem.
    */
@@ -244,6 +265,15 @@ private:
   template<typename T, AssignType A, typename U>
   CompiledAssignmentWrapper<T> createAssignment(const U & from, const Eigen::Ref<T> & to, bool flip = false);
 
+  /** Same as createAssignment for a matrix \p from with a diagonal shape:
+   * only its diagonal is assigned, the rest of \p to being set to zero if
+   * A = COPY.
+   */
+  template<AssignType A>
+  CompiledAssignmentWrapper<Eigen::MatrixXd> createDiagonalAssignment(const MatrixConstRef & from,
+                                                                      const MatrixRef & to,
+                                                                      bool flip = false);
+
   /** Create the compiled substitution assignment to = Mult * from (vector
    * case) or to = from * mult (matrix case) taking into account the
    * requirements and \p flip
@@ -260,12 +290,19 @@ private:
   AssignmentTarget target_;
   /** The weight used to emulate hierarchy in a weight scheme.*/
   double scalarizationWeight_;
+  /** The value used by the solver as infinity.*/
+  double big_;
   /** The requirements attached to the source.*/
   SolvingRequirementsPtr requirements_;
   /** Indicates if the requirements use a default weight AND the scalarizationWeight is 1.*/
   bool useDefaultScalarWeight_;
   /** Indicates if the requirements use a default anisotropic weight.*/
   bool useDefaultAnisotropicWeight_;
+  /** Indicates if this is a bound assignment, and if so, if it is the first
+   * one for its variable.
+   */
+  bool bound_ = false;
+  bool first_ = false;
   /** All the assignments that are setting the initial values of the targeted blocks*/
   std::vector<MatrixAssignment> matrixAssignments_;
   /** All assignments due to substitutions. We separate them from matrixAssignments_
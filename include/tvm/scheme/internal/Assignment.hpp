@@ -87,24 +87,58 @@ inline CompiledAssignmentWrapper<T> Assignment::createAssignment(const U & from,
     if(useDefaultScalarWeight_)
     {
       if(flip)
-        return Wrapper::template make<A, MINUS, IDENTITY, F>(to, from);
+        return Wrapper::template makeForSize<A, MINUS, IDENTITY, F>(to, from);
       else
-        return Wrapper::template make<A, NONE, IDENTITY, F>(to, from);
+        return Wrapper::template makeForSize<A, NONE, IDENTITY, F>(to, from);
     }
     else
     {
       if(flip)
-        return Wrapper::template make<A, SCALAR, IDENTITY, F>(to, from, data_->minusScalarWeight_);
+        return Wrapper::template makeForSize<A, SCALAR, IDENTITY, F>(to, from, data_->minusScalarWeight_);
       else
-        return Wrapper::template make<A, SCALAR, IDENTITY, F>(to, from, data_->scalarWeight_);
+        return Wrapper::template makeForSize<A, SCALAR, IDENTITY, F>(to, from, data_->scalarWeight_);
     }
   }
   else
   {
     if(flip)
-      return Wrapper::template make<A, DIAGONAL, IDENTITY, F>(to, from, data_->minusAnisotropicWeight_);
+      return Wrapper::template makeForSize<A, DIAGONAL, IDENTITY, F>(to, from, data_->minusAnisotropicWeight_);
     else
-      return Wrapper::template make<A, DIAGONAL, IDENTITY, F>(to, from, data_->anisotropicWeight_);
+      return Wrapper::template makeForSize<A, DIAGONAL, IDENTITY, F>(to, from, data_->anisotropicWeight_);
+  }
+}
+
+template<AssignType A>
+inline CompiledAssignmentWrapper<Eigen::MatrixXd> Assignment::createDiagonalAssignment(const MatrixConstRef & from,
+                                                                                       const MatrixRef & to,
+                                                                                       bool flip)
+{
+  using Wrapper = CompiledAssignmentWrapper<Eigen::MatrixXd>;
+
+  if(useDefaultAnisotropicWeight_)
+  {
+    if(useDefaultScalarWeight_)
+    {
+      if(flip)
+        return Wrapper::template make<A, MINUS, IDENTITY, EXTERNAL_DIAGONAL>(to, from);
+      else
+        return Wrapper::template make<A, NONE, IDENTITY, EXTERNAL_DIAGONAL>(to, from);
+    }
+    else
+    {
+      if(flip)
+        return Wrapper::template make<A, SCALAR, IDENTITY, EXTERNAL_DIAGONAL>(to, from, data_->minusScalarWeight_);
+      else
+        return Wrapper::template make<A, SCALAR, IDENTITY, EXTERNAL_DIAGONAL>(to, from, data_->scalarWeight_);
+    }
+  }
+  else
+  {
+    if(flip)
+      return Wrapper::template make<A, DIAGONAL, IDENTITY, EXTERNAL_DIAGONAL>(to, from,
+                                                                              data_->minusAnisotropicWeight_);
+    else
+      return Wrapper::template make<A, DIAGONAL, IDENTITY, EXTERNAL_DIAGONAL>(to, from, data_->anisotropicWeight_);
   }
 }
 
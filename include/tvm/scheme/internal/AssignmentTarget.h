@@ -64,6 +64,8 @@ public:
   /** Return the (range.dim x colDim) block of A starting at
    *(range.start,colStart) */
   MatrixRef A(int colStart, int colDim) const;
+  /** Return the rows of A defined by range. */
+  MatrixRef A() const;
   /** Return the whole quadratic matrix*/
   MatrixRef Q() const;
   /** Return the segment of l defined by range. */
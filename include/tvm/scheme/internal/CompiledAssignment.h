@@ -68,7 +68,11 @@ enum Source
   /** source is zero */
   ZERO,
   /** source is a (non-zero) constant */
-  CONSTANT
+  CONSTANT,
+  /** source is an external square matrix known to be diagonal: only its
+   * diagonal is read (matrix only, with M = IDENTITY)
+   */
+  EXTERNAL_DIAGONAL
 };
 
 /** trait-like definition to detect if an Eigen expression \p MatrixType is describing
@@ -764,6 +768,58 @@ private:
   friend class CompiledAssignmentWrapper;
 };
 
+/** Specialization for F=EXTERNAL_DIAGONAL: to = op(to, w*from) where from is
+ * a diagonal matrix. Only the diagonal of from is read, and for A=COPY the
+ * off-diagonal part of to is set to zero, so that the dense matrix never
+ * needs to be copied.
+ */
+template<typename MatrixType, AssignType A, WeightMult W>
+class CompiledAssignment<MatrixType, A, W, IDENTITY, EXTERNAL_DIAGONAL> : public AssignBase<A>,
+                                                                          public WeightMultBase<W>,
+                                                                          public SourceBase<MatrixType, EXTERNAL>
+{
+private:
+  using WBase = WeightMultBase<W>;
+  using SBase = SourceBase<MatrixType, EXTERNAL>;
+  using WParse = typename std::conditional<hasNoArgCtor<WBase>::value, ParseArg<-1>, ParseArg<0>>::type;
+
+  /** Constructor.
+   * \param to output matrix.
+   * \param from input diagonal matrix.
+   * \param w weight (only for W = SCALAR or DIAGONAL).
+   */
+  template<typename... Args>
+  CompiledAssignment(const Eigen::Ref<MatrixType> & to, const Eigen::Ref<const MatrixType> & from, Args &&... args)
+  : WBase(WParse::get(std::forward<Args>(args)...)), SBase(from), to_(to)
+  {
+    static_assert(isMatrix<MatrixType>::value, "Diagonal source is only for matrices.");
+    static_assert(A == COPY || A == ADD || A == SUB, "Diagonal source is only for COPY, ADD and SUB assignments.");
+    assert(from.rows() == from.cols() && to.rows() == from.rows() && to.cols() == from.cols());
+  }
+
+public:
+  void run()
+  {
+    if constexpr(A == COPY)
+      to_.setZero();
+    auto d = to_.diagonal();
+    this->assign(d, this->applyWeightMult(this->from().diagonal()));
+  }
+
+  void to(const Eigen::Ref<MatrixType> & to)
+  {
+    // We want to do to_ = to but there is no operator= for Eigen::Ref,
+    // so we need to use a placement new.
+    new(&to_) Eigen::Ref<MatrixType>(to);
+  }
+
+private:
+  Eigen::Ref<MatrixType> to_;
+
+  template<typename MatrixType_>
+  friend class CompiledAssignmentWrapper;
+};
+
 } // namespace internal
 
 } // namespace scheme
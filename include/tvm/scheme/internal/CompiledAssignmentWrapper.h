@@ -64,6 +64,21 @@ public:
   template<AssignType A, WeightMult W, MatrixMult M, Source F = EXTERNAL, typename... Args>
   static CompiledAssignmentWrapper make(Args &&... args);
 
+  /** Same as make, but the assignment is compiled for matrices with \p Rows
+   * rows, so that Eigen can unroll and vectorize the operations along the
+   * columns. \p to (and the source) must have \p Rows rows.
+   *
+   * This is only for matrices with F = EXTERNAL.
+   */
+  template<int Rows, AssignType A, WeightMult W, MatrixMult M, Source F = EXTERNAL, typename... Args>
+  static CompiledAssignmentWrapper makeFixedRows(const Eigen::Ref<MatrixType> & to, Args &&... args);
+
+  /** Same as make, but relying on makeFixedRows for matrices with a number of
+   * rows typical of robotics functions (3 and 6).
+   */
+  template<AssignType A, WeightMult W, MatrixMult M, Source F = EXTERNAL, typename... Args>
+  static CompiledAssignmentWrapper makeForSize(const Eigen::Ref<MatrixType> & to, Args &&... args);
+
 private:
   CompiledAssignmentWrapper(void (*deleter)(void *));
 
@@ -79,6 +94,12 @@ private:
   /** call ca->to*/
   template<typename T>
   static void sto(void * ca, const Eigen::Ref<MatrixType> & from);
+  /** call ca->from for an assignment T on fixed-size matrices*/
+  template<typename T>
+  static void sfromFixed(void * ca, const Eigen::Ref<const MatrixType> & f);
+  /** call ca->to for an assignment T on fixed-size matrices*/
+  template<typename T>
+  static void stoFixed(void * ca, const Eigen::Ref<MatrixType> & t);
   /** return a copy of ca*/
   template<typename T>
   static void * sclone(void * ca);
@@ -121,6 +142,20 @@ template<typename T>
 inline void CompiledAssignmentWrapper<MatrixType>::sto(void * ca, const Eigen::Ref<MatrixType> & t)
 { static_cast<T *>(ca)->to(t); }
 
+template<typename MatrixType>
+template<typename T>
+inline void CompiledAssignmentWrapper<MatrixType>::sfromFixed(void * ca, const Eigen::Ref<const MatrixType> & f)
+{
+  // The conversion to T::SourceType is done without copy: it only differs from
+  // Eigen::Ref<const MatrixType> by the compile-time number of rows.
+  static_cast<T *>(ca)->from(typename T::SourceType(f));
+}
+
+template<typename MatrixType>
+template<typename T>
+inline void CompiledAssignmentWrapper<MatrixType>::stoFixed(void * ca, const Eigen::Ref<MatrixType> & t)
+{ static_cast<T *>(ca)->to(t); }
+
 template<typename MatrixType>
 template<typename T>
 inline void * CompiledAssignmentWrapper<MatrixType>::sclone(void * ca)
@@ -149,6 +184,47 @@ inline CompiledAssignmentWrapper<MatrixType> CompiledAssignmentWrapper<MatrixTyp
   return w;
 }
 
+template<typename MatrixType>
+template<int Rows, AssignType A, WeightMult W, MatrixMult M, Source F, typename... Args>
+inline CompiledAssignmentWrapper<MatrixType> CompiledAssignmentWrapper<MatrixType>::makeFixedRows(
+    const Eigen::Ref<MatrixType> & to,
+    Args &&... args)
+{
+  static_assert(isMatrix<MatrixType>::value && F == EXTERNAL, "Only for matrices with an external source.");
+  assert(to.rows() == Rows);
+  using FixedType = Eigen::Matrix<typename MatrixType::Scalar, Rows, MatrixType::ColsAtCompileTime>;
+  using CA = CompiledAssignment<FixedType, A, W, M, F>;
+  CompiledAssignmentWrapper<MatrixType> w(sdelete<CA>);
+  w.run_ = srun<CA>;
+  w.fromd_ = nullptr;
+  w.fromm_ = &sfromFixed<CA>;
+  w.to_ = stoFixed<CA>;
+  w.clone_ = sclone<CA>;
+  w.ca_.reset(new CA(to, std::forward<Args>(args)...));
+  return w;
+}
+
+template<typename MatrixType>
+template<AssignType A, WeightMult W, MatrixMult M, Source F, typename... Args>
+inline CompiledAssignmentWrapper<MatrixType> CompiledAssignmentWrapper<MatrixType>::makeForSize(
+    const Eigen::Ref<MatrixType> & to,
+    Args &&... args)
+{
+  if constexpr(isMatrix<MatrixType>::value && F == EXTERNAL)
+  {
+    switch(to.rows())
+    {
+      case 3:
+        return makeFixedRows<3, A, W, M, F>(to, std::forward<Args>(args)...);
+      case 6:
+        return makeFixedRows<6, A, W, M, F>(to, std::forward<Args>(args)...);
+      default:
+        break;
+    }
+  }
+  return make<A, W, M, F>(to, std::forward<Args>(args)...);
+}
+
 template<typename MatrixType>
 inline CompiledAssignmentWrapper<MatrixType>::CompiledAssignmentWrapper()
 : ca_(nullptr, nullptr), run_(nullptr), fromd_(nullptr), fromm_(nullptr), to_(nullptr), clone_(nullptr)
@@ -51,6 +51,10 @@ public:
       return {};
   }
 
+  /** The mapping task -> constraint.*/
+  const tvm::utils::internal::map<TaskWithRequirements const *, LinearConstraintWithRequirements> & constraintMap() const
+  { return task2Constraint_; }
+
 protected:
   /** Constructor, using the id of the solver.*/
   LinearizedProblemComputationData(int solverId) : ProblemComputationData(solverId) {}
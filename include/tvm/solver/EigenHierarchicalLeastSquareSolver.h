@@ -0,0 +1,265 @@
+/* Copyright 2022 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/solver/abstract/HierarchicalLeastSquareSolver.h>
+
+#include <Eigen/Core>
+#include <Eigen/QR>
+
+#include <vector>
+
+namespace tvm::solver
+{
+class EigenHLSSolverFactory;
+
+/** A set of options for EigenHierarchicalLeastSquareSolver */
+class TVM_DLLAPI EigenHLSSolverOptions
+{
+  TVM_ADD_NON_DEFAULT_OPTION(big_number, constant::big_number)
+  /** Maximum number of iterations of the active-set method, for each level.*/
+  TVM_ADD_NON_DEFAULT_OPTION(maxIterations, 1000)
+  /** If \a true and singlePrecision is \a true, the solution found in single
+   * precision is refined by a resolution in double precision starting from
+   * the active sets it found. This gives the accuracy of a resolution in
+   * double precision, but is slower than the latter alone.
+   */
+  TVM_ADD_NON_DEFAULT_OPTION(refineSolution, false)
+  /** If \a true, the computations made for the top levels whose data did not
+   * change since the previous resolution are reused.
+   */
+  TVM_ADD_NON_DEFAULT_OPTION(reuseUnchangedLevels, false)
+  /** If \a true, the levels are solved with single precision floating-point
+   * numbers. The tolerance used is then at least 1e-5.
+   */
+  TVM_ADD_NON_DEFAULT_OPTION(singlePrecision, false)
+  /** Tolerance on the constraint violations and on the sign of the multipliers.*/
+  TVM_ADD_NON_DEFAULT_OPTION(tolerance, 1e-9)
+  TVM_ADD_NON_DEFAULT_OPTION(verbose, false)
+  /** If \a true, the active set of each level is initialized with the one of
+   * the previous resolution.
+   */
+  TVM_ADD_NON_DEFAULT_OPTION(warmStart, true)
+
+public:
+  using Factory = EigenHLSSolverFactory;
+};
+
+/** A hierarchical least-squares solver implemented with Eigen only.
+ *
+ * The levels are solved one after the other. Level i is solved in the set of
+ * optimal solutions of the levels above it, described by a particular
+ * solution x_i, a basis Z_i of the nullspace of the constraints that are
+ * fixed by the upper levels, and the inequality constraints of the upper
+ * levels that must remain satisfied. The problem of each level
+ *
+ *   min. ||w||^2 s.t. l <= A (x_i + Z_i y) + w <= u
+ *                     (inequalities of the upper levels)
+ *
+ * is solved with a primal active-set method. Then, the rows of the level with
+ * a non-zero violation (and its equality constraints) are fixed by
+ * projecting Z_i onto their nullspace, and the other ones are kept as
+ * inequalities for the lower levels.
+ *
+ * The data of each level are in the same [A l u] layout as for
+ * LexLSHierarchicalLeastSquareSolver, the bounds being the first rows of the
+ * first level.
+ *
+ * The computations are dense: this solver is meant for problems of moderate
+ * size, or when LexLS is not available.
+ *
+ * With the option singlePrecision, the levels are solved with floats. The
+ * data are stored in double precision and converted at each resolution, so
+ * that the gain comes only from the factorizations and products done in the
+ * active-set iterations, which are twice as wide when vectorized. It is
+ * worth it for large levels, when an accuracy of about 1e-5 is enough.
+ * The option refineSolution adds a resolution in double precision warm
+ * started with the active sets found with floats. It usually needs a single
+ * iteration per level, but comes on top of the resolution in single
+ * precision: it is only useful to check or debug the latter.
+ */
+class TVM_DLLAPI EigenHierarchicalLeastSquareSolver : public abstract::HierarchicalLeastSquareSolver
+{
+public:
+  EigenHierarchicalLeastSquareSolver(const EigenHLSSolverOptions & options = {});
+
+  /** Number of iterations of the active-set method for each level during the
+   * last resolution (0 for the levels that were reused).
+   */
+  const std::vector<int> & iterations() const { return iterations_; }
+
+  /** Number of iterations of the double precision refinement for each level
+   * during the last resolution (see EigenHLSSolverOptions::singlePrecision).
+   */
+  const std::vector<int> & refinementIterations() const { return refinementIterations_; }
+
+protected:
+  void initializeBuild_(const std::vector<int> & nEq, const std::vector<int> & nIneq, bool useBounds) override;
+  ImpactFromChanges resize_(const std::vector<int> & nEq, const std::vector<int> & nIneq, bool useBounds) override;
+  void addBound_(LinearConstraintPtr bound, RangePtr range, bool first) override;
+  void addEqualityConstraint_(LinearConstraintPtr cstr, SolvingRequirementsPtr req) override;
+  void addIneqalityConstraint_(LinearConstraintPtr cstr, SolvingRequirementsPtr req) override;
+  void setMinimumNorm_() override;
+  void resetBounds_() override;
+  bool solve_() override;
+  const Eigen::VectorXd & result_() const override;
+  bool handleDoubleSidedConstraint_() const override { return true; }
+  Range nextEqualityConstraintRange_(int lvl, const constraint::abstract::LinearConstraint & cstr) const override;
+  Range nextInequalityConstraintRange_(int lvl, const constraint::abstract::LinearConstraint & cstr) const override;
+
+  void removeBounds_(const Range & range) override;
+  void updateEqualityTargetData(int lvl, scheme::internal::AssignmentTarget & target) override;
+  void updateInequalityTargetData(int lvl, scheme::internal::AssignmentTarget & target) override;
+  void updateBoundTargetData(scheme::internal::AssignmentTarget & target) override;
+
+  void applyImpactLogic(ImpactFromChanges & impact) override;
+
+  void printProblemData_() const override;
+  void printDiagnostic_() const override;
+
+  MatrixConstRef levelData_(int lvl) const override { return data_[static_cast<size_t>(lvl)]; }
+
+private:
+  /** A row of the data of a level, as lower or upper bound.*/
+  struct RowBound
+  {
+    int level;
+    int row;
+    bool upper;
+    bool operator==(const RowBound & other) const
+    {
+      return level == other.level && row == other.row && upper == other.upper;
+    }
+  };
+
+  /** Description of the solutions of the levels solved so far.*/
+  template<typename Scalar>
+  struct State
+  {
+    /** A particular solution.*/
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 1> x;
+    /** Basis of the directions in which x can still move.*/
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Z;
+    /** Rows (level, row) of the inequality constraints that must remain satisfied.*/
+    std::vector<std::pair<int, int>> inequalities;
+
+    template<typename Other>
+    State<Other> cast() const
+    {
+      return {x.template cast<Other>(), Z.template cast<Other>(), inequalities};
+    }
+  };
+
+  /** Buffers used by solveLevel. They are sized by resize_ for the largest
+   * level, so that the resolutions do not allocate them. The decompositions
+   * keep their storage as long as the size of their input does not change.
+   */
+  template<typename Scalar>
+  struct Workspace
+  {
+    using MatrixX = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using VectorX = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+
+    /** Size the buffers for \p n variables, levels with at most \p maxRows
+     * rows and \p totalRows rows over all the levels.
+     */
+    void resize(Eigen::DenseIndex n, Eigen::DenseIndex maxRows, Eigen::DenseIndex totalRows);
+
+    /** Copy of the matrix of the level (in single precision only).*/
+    MatrixX A;
+    /** Product of the matrix of the level with the basis Z of the state.*/
+    MatrixX AZ;
+    /** Objective ||M z - q||^2, and its residual.*/
+    MatrixX M;
+    VectorX q;
+    VectorX res;
+    /** Constraints G z >= beta, with their origin.*/
+    MatrixX G;
+    std::vector<Scalar> beta;
+    std::vector<RowBound> ids;
+    /** Working set, and the corresponding rows of G.*/
+    std::vector<size_t> W;
+    MatrixX GW;
+    /** Current point, step, and multipliers of the working set.*/
+    VectorX z;
+    VectorX dz;
+    VectorX lambda;
+    /** Row of G being built, and row of an upper level.*/
+    VectorX g;
+    VectorX ah;
+    /** Rows of AZ fixed by the level.*/
+    MatrixX FZ;
+    /** Nullspace basis, objective restricted to it, and solutions in it.*/
+    MatrixX N;
+    MatrixX MN;
+    VectorX t;
+    VectorX rhs;
+    Eigen::ColPivHouseholderQR<MatrixX> qr;
+    Eigen::CompleteOrthogonalDecomposition<MatrixX> cod;
+    /** Equality, inequality, and fixed rows of the level.*/
+    std::vector<int> eq;
+    std::vector<int> ineq;
+    std::vector<int> fixed;
+  };
+
+  /** Workspace for the resolutions with scalar type \p Scalar.*/
+  template<typename Scalar>
+  Workspace<Scalar> & workspace();
+
+  /** Solve level \p lvl starting from \p s, and update \p s accordingly.
+   *
+   * \param tol Tolerance of the resolution.
+   * \param warmStart Whether to start from the active set in activeSets_.
+   * \param iterations Set to the number of iterations.
+   */
+  template<typename Scalar>
+  bool solveLevel(int lvl, State<Scalar> & s, double tol, bool warmStart, int & iterations);
+
+  std::vector<Eigen::MatrixXd> data_;
+  /** Referenced by xl_ and xu_ when there are no bounds.*/
+  Eigen::VectorXd noBounds_;
+
+  VectorRef xl_;
+  VectorRef xu_;
+  std::vector<MatrixRef> A_;
+  std::vector<VectorRef> l_;
+  std::vector<VectorRef> u_;
+
+  Eigen::VectorXd x_;
+  /** State after each level during the last resolution.*/
+  std::vector<State<double>> states_;
+  /** Active set of each level at the end of the last resolution.*/
+  std::vector<std::vector<RowBound>> activeSets_;
+  std::vector<int> iterations_;
+  std::vector<int> refinementIterations_;
+  Workspace<double> workspaceD_;
+  Workspace<float> workspaceF_;
+  bool success_;
+
+  bool autoMinNorm_;
+  double big_number_;
+  int maxIterations_;
+  bool refineSolution_;
+  bool reuseUnchangedLevels_;
+  bool singlePrecision_;
+  double tol_;
+  bool warmStart_;
+};
+
+/** A factory class to create EigenHierarchicalLeastSquareSolver instances with a given
+ * set of options.
+ */
+class TVM_DLLAPI EigenHLSSolverFactory : public abstract::HLSSolverFactory
+{
+public:
+  /** Creation of a configuration from a set of options*/
+  EigenHLSSolverFactory(const EigenHLSSolverOptions & options = {});
+
+  std::unique_ptr<abstract::HLSSolverFactory> clone() const override;
+  std::unique_ptr<abstract::HierarchicalLeastSquareSolver> createSolver() const override;
+
+private:
+  EigenHLSSolverOptions options_;
+};
+
+} // namespace tvm::solver
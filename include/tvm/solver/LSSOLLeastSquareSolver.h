@@ -7,6 +7,8 @@
 #include <eigen-lssol/LSSOL_FP.h>
 #include <eigen-lssol/LSSOL_LS.h>
 
+#include <array>
+
 namespace tvm
 {
 
@@ -27,6 +29,10 @@ class TVM_DLLAPI LSSOLLSSolverOptions
   TVM_ADD_DEFAULT_OPTION(persistence, bool)
   TVM_ADD_DEFAULT_OPTION(printLevel, int)
   TVM_ADD_DEFAULT_OPTION(rankTol, double)
+  /** Number of objective rows to reserve (see LeastSquareSolver::reserve).*/
+  TVM_ADD_NON_DEFAULT_OPTION(reserveObjectives, 0)
+  /** Number of constraint rows to reserve (see LeastSquareSolver::reserve).*/
+  TVM_ADD_NON_DEFAULT_OPTION(reserveConstraints, 0)
   TVM_ADD_NON_DEFAULT_OPTION(verbose, false)
   TVM_ADD_NON_DEFAULT_OPTION(warm, true)
 
@@ -59,15 +65,21 @@ protected:
   Range nextObjectiveRange_(const constraint::abstract::LinearConstraint & cstr) const override;
 
   void removeBounds_(const Range & range) override;
+  void resetObjectiveRows_(int start) override;
+  void resetEqualityConstraintRows_(int start) override;
+  void resetInequalityConstraintRows_(int start) override;
   void updateEqualityTargetData(scheme::internal::AssignmentTarget & target) override;
   void updateInequalityTargetData(scheme::internal::AssignmentTarget & target) override;
   void updateBoundTargetData(scheme::internal::AssignmentTarget & target) override;
   void updateObjectiveTargetData(scheme::internal::AssignmentTarget & target) override;
 
   void applyImpactLogic(ImpactFromChanges & impact);
+  /** Reset the rows of C_, cl_ and cu_ from \p start on.*/
+  void resetConstraintRows(int start);
 
   void printProblemData_() const override;
   void printDiagnostic_() const override;
+  void exportProblem_(QPRecord & record) const override;
 
 private:
   using VectorXdTail = decltype(Eigen::VectorXd().tail(1));
@@ -86,6 +98,7 @@ private:
 
   bool autoMinNorm_;
   double big_number_;
+  std::array<int, 3> lssolDims_; // dimensions ls_ or fp_ is set up for (n, nCstr, 1 if ls_ / 0 if fp_)
 };
 
 /** A factory class to create LSSOLLeastSquareSolver instances with a given
@@ -26,7 +26,19 @@ public:
   using Factory = LexLSHLSSolverFactory;
 };
 
-/** An encapsulation of the LexLS solver, to solve linear least-squares problems. */
+/** An encapsulation of the LexLS solver, to solve linear least-squares problems.
+ *
+ * The assignments write the data of each level directly in the [A l u] layout
+ * expected by LexLS. These data are then handed to LexLS with
+ * \c LexLSI::setData, which copies them into the objectives owned by LexLS:
+ * LexLS does not give access to its storage, so that this copy (one matrix of
+ * size m_i x (n+2) per level, i.e. ~40kB for a 100-row level on a 50-variable
+ * humanoid problem) cannot be avoided without changes in LexLS itself.
+ *
+ * For the same reason, the factorizations of the unchanged top levels cannot
+ * be reused from one resolution to the other, and the changes of the levels
+ * are not tracked.
+ */
 class TVM_DLLAPI LexLSHierarchicalLeastSquareSolver : public abstract::HierarchicalLeastSquareSolver
 {
 public:
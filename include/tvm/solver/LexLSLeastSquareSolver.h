@@ -56,6 +56,7 @@ protected:
 
   void printProblemData_() const override;
   void printDiagnostic_() const override;
+  void exportProblem_(QPRecord & record) const override;
 
 private:
   using MatrixXdCol = decltype(Eigen::MatrixXd().col(0));
@@ -3,11 +3,14 @@
 #pragma once
 
 #include <tvm/solver/abstract/LeastSquareSolver.h>
+#include <tvm/solver/internal/QPPresolve.h>
 
 #include <eigen-qld/QLDDirect.h>
 
 #include <Eigen/QR>
 
+#include <array>
+
 namespace tvm
 {
 
@@ -22,6 +25,15 @@ class TVM_DLLAPI QLDLSSolverOptions
   TVM_ADD_NON_DEFAULT_OPTION(cholesky, false)
   TVM_ADD_NON_DEFAULT_OPTION(choleskyDamping, 1e-8)
   TVM_ADD_NON_DEFAULT_OPTION(eps, 1e-6)
+  /** Remove the trivially satisfied constraints and the fixed variables
+   * before calling QLD (see internal::QPPresolve). The number of removed rows
+   * and variables is given by LeastSquareSolver::presolveStatistics.
+   */
+  TVM_ADD_NON_DEFAULT_OPTION(presolve, false)
+  /** Number of objective rows to reserve (see LeastSquareSolver::reserve).*/
+  TVM_ADD_NON_DEFAULT_OPTION(reserveObjectives, 0)
+  /** Number of constraint rows to reserve (see LeastSquareSolver::reserve).*/
+  TVM_ADD_NON_DEFAULT_OPTION(reserveConstraints, 0)
   TVM_ADD_NON_DEFAULT_OPTION(verbose, false)
 public:
   using Factory = QLDLSSolverFactory;
@@ -51,6 +63,9 @@ protected:
   Range nextInequalityConstraintRange_(const constraint::abstract::LinearConstraint & cstr) const override;
   Range nextObjectiveRange_(const constraint::abstract::LinearConstraint & cstr) const override;
   void removeBounds_(const Range & r) override;
+  void resetObjectiveRows_(int start) override;
+  void resetEqualityConstraintRows_(int start) override;
+  void resetInequalityConstraintRows_(int start) override;
   void updateEqualityTargetData(scheme::internal::AssignmentTarget & target) override;
   void updateInequalityTargetData(scheme::internal::AssignmentTarget & target) override;
   void updateBoundTargetData(scheme::internal::AssignmentTarget & target) override;
@@ -60,8 +75,18 @@ protected:
 
   void printProblemData_() const override;
   void printDiagnostic_() const override;
+  void exportProblem_(QPRecord & record) const override;
 
 private:
+  /** Solve the problem reduced by the presolve step.*/
+  bool solvePresolved();
+  /** Set up qld_ for the (unreduced) problem of the given dimensions, if it is
+   * not already. The problems reduced by the presolve step are smaller and
+   * reuse the same workspace: QLD takes their dimensions and leading
+   * dimensions from the matrices passed to its solve method.
+   */
+  void setupQLD(int n, int nEq, int nIneq, int ldq);
+
   using VectorXdTail = decltype(Eigen::VectorXd().tail(1));
   using MatrixXdBottom = decltype(Eigen::MatrixXd().bottomRows(1));
 
@@ -82,6 +107,7 @@ private:
 
   bool autoMinNorm_;
   bool underspecifiedObj_; // true when nObj<n
+  int ldq_;                // leading dimension of the quadratic matrix passed to QLD
 
   // options
   double big_number_;
@@ -89,6 +115,11 @@ private:
   bool cholesky_;          // compute the Cholesky decomposition before calling the solver.
   double choleskyDamping_; // if nObj<n, the cholesky factor R is trapezoidal. A multiple of
                            // the identity is used to make it triangular using this value.
+  bool usePresolve_;
+
+  internal::QPPresolve presolve_;
+  bool presolved_;  // true if the last call to solve_ used the reduced problem
+  std::array<int, 4> qldDims_; // dimensions qld_ is currently set up for (n, nEq, nIneq, ldq)
 };
 
 /** A factory class to create QLDLeastSquareSolver instances with a given
@@ -0,0 +1,206 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/api.h>
+#include <tvm/defs.h>
+
+#include <Eigen/Core>
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tvm
+{
+
+namespace solver
+{
+
+namespace abstract
+{
+class LeastSquareSolver;
+class LSSolverFactory;
+} // namespace abstract
+
+/** The data of one resolution of a least-squares solver, in the form
+ *
+ * min. ||A x - b||^2
+ * s.t. l <= C x <= u
+ *      xl <= x <= xu
+ *
+ * where the rows of C with l = u are equality constraints, and infinite bounds
+ * are represented by +/- the big number of the solver. The data are the ones
+ * assembled for the backend, so that they are independent of the problem and
+ * of the resolution scheme that produced them.
+ */
+struct TVM_DLLAPI QPRecord
+{
+  /** Index of the resolution among the ones seen by the recorder.*/
+  int64_t tick = 0;
+  Eigen::MatrixXd A;
+  Eigen::VectorXd b;
+  Eigen::MatrixXd C;
+  Eigen::VectorXd l;
+  Eigen::VectorXd u;
+  Eigen::VectorXd xl;
+  Eigen::VectorXd xu;
+  /** Solution returned by the solver.*/
+  Eigen::VectorXd x;
+  /** Whether the resolution was successful.*/
+  bool success = false;
+};
+
+/** Record the problems solved by one or several LeastSquareSolver into a
+ * binary log file (see LeastSquareSolver::recorder).
+ *
+ * The records are copied into a ring buffer of slots by the solving thread, and written to the file by a background thread, so that the
+ * cost for the solving thread is the copy of the data. If the writer thread
+ * cannot keep up and the buffer is full, the new records are dropped (and
+ * counted by ::dropped) rather than blocking the resolution.
+ *
+ * A recorder can be shared by solvers running on different threads: each call
+ * to ::acquire reserves its own slot. The records are written in the order of
+ * the calls to ::acquire.
+ *
+ * If writing to the file fails, the following records are dropped, ::failed
+ * returns true and ::flush throws.
+ *
+ * The log is a header of 16 bytes (the 8 characters "TVMQPLOG" and a 64-bit
+ * version number), followed by the records. Each record is made of six 64-bit
+ * integers (size in bytes of the record, tick, n, rows of A, rows of C,
+ * success) followed by the coefficients of A, b, C, l, u, xl, xu and x as
+ * doubles, the matrices being stored column-major. All fields are 8 bytes
+ * long, so that the file can be memory-mapped and read in place. The numbers
+ * are written in the byte order of the machine.
+ */
+class TVM_DLLAPI QPRecorder
+{
+public:
+  /** Open \p path for writing, with a buffer of \p capacity records.*/
+  QPRecorder(const std::string & path, int capacity = 64);
+
+  QPRecorder(const QPRecorder &) = delete;
+  QPRecorder & operator=(const QPRecorder &) = delete;
+
+  /** Write the pending records and close the file.*/
+  ~QPRecorder();
+
+  /** Reserve a slot to fill with the next record, or return \a nullptr if the
+   * buffer is full. The slot must be handed back with ::commit or ::discard.
+   */
+  QPRecord * acquire();
+
+  /** Queue \p record, obtained from ::acquire, for writing.*/
+  void commit(QPRecord * record);
+
+  /** Give back \p record, obtained from ::acquire, without writing it.*/
+  void discard(QPRecord * record);
+
+  /** Size the slots that are not in use like \p prototype, so that filling
+   * them with the data of a problem of the same size does not allocate memory.
+   * The solvers call it when their problem is built or resized.
+   */
+  void reserve(const QPRecord & prototype);
+
+  /** Wait until the committed records are written. A record committed after a
+   * slot that is still being filled is written once this slot is handed back.
+   *
+   * \throws std::runtime_error if writing to the file failed.
+   */
+  void flush();
+
+  /** Number of records written or queued for writing.*/
+  int64_t recorded() const;
+  /** Number of records dropped because the buffer was full or the file could
+   * not be written.
+   */
+  int64_t dropped() const;
+  /** Whether writing to the file failed.*/
+  bool failed() const;
+
+private:
+  enum class SlotState
+  {
+    Filling,
+    Committed,
+    Discarded
+  };
+
+  /** Loop of the writer thread.*/
+  void write();
+  /** Write \p r to the file. Return false if the write failed.*/
+  bool write(const QPRecord & r);
+  /** Index of \p record in slots_.*/
+  size_t slotIndex(const QPRecord * record) const;
+
+  std::ofstream file_;
+  std::vector<QPRecord> slots_;
+  std::vector<SlotState> states_;
+  std::thread writer_;
+  mutable std::mutex mutex_;
+  std::condition_variable pending_;
+  std::condition_variable written_;
+
+  int64_t tick_;      // number of calls to acquire
+  uint64_t reserved_; // number of reserved slots
+  uint64_t tail_;     // number of handed back slots processed by the writer thread
+  int64_t recorded_;  // number of committed records
+  int64_t dropped_;   // number of dropped records
+  bool failed_;
+  bool stop_;
+};
+
+/** Read the records of a log written by a QPRecorder.*/
+class TVM_DLLAPI QPLogReader
+{
+public:
+  /** Open the log \p path. Throw if this is not a valid log.*/
+  QPLogReader(const std::string & path);
+
+  /** Read the next record into \p record.
+   * \return false if there are no more records.
+   */
+  bool next(QPRecord & record);
+
+private:
+  std::ifstream file_;
+};
+
+/** Solve recorded problems with a given solver.
+ *
+ * The problem of a record is rebuilt in a solver created by the factory
+ * given at construction, with one objective, one equality constraint, one
+ * (double-sided) inequality constraint and possibly bounds. When the sizes of
+ * the problem do not change from one record to the next, the same solver is
+ * reused and only its data are updated, as would be the case during a control
+ * loop.
+ */
+class TVM_DLLAPI QPReplay
+{
+public:
+  QPReplay(const abstract::LSSolverFactory & factory, double big = constant::big_number);
+  ~QPReplay();
+
+  /** Solve the problem of \p record.*/
+  bool solve(const QPRecord & record);
+
+  /** Solution of the last call to ::solve.*/
+  const Eigen::VectorXd & result() const;
+
+private:
+  struct Problem;
+
+  std::unique_ptr<abstract::LSSolverFactory> factory_;
+  double big_;
+  std::unique_ptr<Problem> pb_;
+};
+
+} // namespace solver
+
+} // namespace tvm
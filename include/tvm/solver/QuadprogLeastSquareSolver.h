@@ -61,6 +61,7 @@ protected:
 
   void printProblemData_() const override;
   void printDiagnostic_() const override;
+  void exportProblem_(QPRecord & record) const override;
 
 private:
   using VectorXdSeg = decltype(Eigen::VectorXd().segment(0, 1));
@@ -30,11 +30,18 @@ namespace abstract
  *
  * When deriving this class, also remember to derive the factory class
  * HLSSolverFactory as well.
+ *
+ * If \p trackLevelChanges is true, the solver keeps track of the levels whose
+ * data changed since the previous resolution, because of the constraints
+ * added (or removed) or because the values written by the assignments are
+ * different. A derived class can then reuse the computations made for the
+ * unchanged top levels (see ::firstChangedLevel). This requires the derived
+ * class to give access to the data of each level through ::levelData_.
  */
 class TVM_DLLAPI HierarchicalLeastSquareSolver
 {
 public:
-  HierarchicalLeastSquareSolver(bool verbose = false);
+  HierarchicalLeastSquareSolver(bool verbose = false, bool trackLevelChanges = false);
   HierarchicalLeastSquareSolver(const HierarchicalLeastSquareSolver &) = delete;
   HierarchicalLeastSquareSolver & operator=(const HierarchicalLeastSquareSolver &) = delete;
   virtual ~HierarchicalLeastSquareSolver() = default;
@@ -98,6 +105,21 @@ public:
   /** Number of priority levels*/
   int numberOfLevels() const { return useBounds_ ? static_cast<int>(nEq_.size()) + 1 : static_cast<int>(nEq_.size()); }
 
+  /** Whether the changes of the levels' data are tracked.*/
+  bool trackLevelChanges() const { return trackLevelChanges_; }
+
+  /** For each priority level i (i.e. the levels of nEq and nIneq in
+   * ::startBuild), whether its data changed for the last call to ::solve.
+   * All levels are considered as changed if the changes are not tracked.
+   */
+  const std::vector<bool> & changedLevels() const { return changedLevels_; }
+
+  /** Index of the first priority level that changed for the last call to
+   * ::solve, or the number of priority levels if none did. Levels above this
+   * one are identical to the previous resolution.
+   */
+  int firstChangedLevel() const;
+
 protected:
   struct ImpactFromChanges
   {
@@ -155,6 +177,14 @@ protected:
   virtual void printProblemData_() const = 0;
   virtual void printDiagnostic_() const = 0;
 
+  /** Data of priority level \p lvl, as written by the assignments, in any
+   * layout chosen by the derived class. The bounds are considered as part of
+   * level 0. This is used to detect the levels whose data did not change when
+   * ::trackLevelChanges() is true. The default implementation returns an
+   * empty matrix, meaning that the level is always considered as changed.
+   */
+  virtual MatrixConstRef levelData_(int lvl) const;
+
   const VariableVector & variables() const { return *variables_; }
   const hint::internal::Substitutions * substitutions() const { return subs_; }
 
@@ -162,6 +192,11 @@ protected:
   void addAssignement(Args &&... args);
 
 private:
+  /** Mark level \p lvl as changed, independently of its data.*/
+  void markLevelChanged(int lvl);
+  /** Compare the data of each level to the one of the previous resolution.*/
+  void updateChangedLevels();
+
   void updateWeights(const internal::SolverEvents & se);
   bool updateVariables(const internal::SolverEvents & se);
   ImpactFromChanges processRemovedConstraints(const internal::SolverEvents & se);
@@ -204,6 +239,13 @@ private:
   std::vector<MapToAssignment> inequalityConstraintToAssignments_;
   MapToAssignment boundToAssignments_;
   const hint::internal::Substitutions * subs_;
+
+  bool trackLevelChanges_;
+  /** Levels whose layout changed since the last resolution.*/
+  std::vector<bool> structuralChanges_;
+  std::vector<bool> changedLevels_;
+  /** Data of each level at the last resolution.*/
+  std::vector<Eigen::MatrixXd> previousLevelData_;
 };
 
 /** A base class for HierarchicalLeastSquareSolver factory.
@@ -11,12 +11,17 @@
 #include <tvm/solver/internal/SolverEvents.h>
 #include <tvm/utils/internal/map.h>
 
+#include <limits>
+
 namespace tvm
 {
 
 namespace solver
 {
 
+struct QPRecord;
+class QPRecorder;
+
 namespace abstract
 {
 /** Base class for a (constrained) least-square solver.
@@ -106,6 +111,60 @@ public:
    */
   void process(const internal::SolverEvents & se);
 
+  /** Reserve memory for at least \p nObj rows of objectives and \p nCstr rows
+   * of constraints (equality and inequality constraints together).
+   *
+   * After this call, the matrices of the solvers supporting it are sized to
+   * the high-water mark of the problem sizes, so that adding an objective or a
+   * constraint that fits in the reserved capacity, or removing one, does not
+   * reallocate memory. The unused rows are filled with trivial objectives and
+   * unbounded constraints.
+   *
+   * \note This is currently supported by the LSSOL and QLD solvers, and
+   * ignored by the others.
+   */
+  void reserve(int nObj, int nCstr);
+
+  /** Number of times the matrices of the solver were reallocated while
+   * processing changes of the problem. This also counts the changes that
+   * required all the assignments of a kind of constraints to be re-targeted,
+   * e.g. when the inequality constraints of QLD are shifted by a change of the
+   * number of equality constraints.
+   */
+  int reallocations() const { return reallocations_; }
+
+  /** Statistics of the presolve step of a solver.*/
+  struct PresolveStatistics
+  {
+    /** Number of constraint rows removed before calling the solver.*/
+    int removedConstraints = 0;
+    /** Number of variables removed before calling the solver.*/
+    int removedVariables = 0;
+  };
+
+  /** Presolve statistics of the last call to ::solve. All the values are zero
+   * if the solver has no presolve step or if it is disabled.
+   *
+   * \note A presolve step is currently offered by the QLD solver.
+   */
+  const PresolveStatistics & presolveStatistics() const { return presolveStatistics_; }
+
+  /** Record the data of each subsequent resolution with \p recorder. Pass
+   * \a nullptr to stop recording. A recorder can be shared by several solvers,
+   * including solvers running on different threads.
+   *
+   * The slots of the recorder are sized for the problem of the solver when it
+   * is set and whenever the problem is built or resized (see
+   * QPRecorder::reserve).
+   *
+   * \note Recording is currently supported by the LSSOL, QLD, Quadprog and
+   * LexLS solvers. For the others, setting a recorder on a built solver,
+   * building or solving with a recorder set throws.
+   */
+  void recorder(std::shared_ptr<QPRecorder> recorder);
+  /** The recorder currently used, if any.*/
+  const std::shared_ptr<QPRecorder> & recorder() const { return recorder_; }
+
 protected:
   struct ImpactFromChanges
   {
@@ -145,6 +204,23 @@ protected:
    * solver (e.g. set the bounds to -/+Inf).
    */
   virtual void removeBounds_(const Range & range) = 0;
+  /** Reset the objective rows, starting from row \p start (as given by the
+   * objective ranges) to the end of the objective data, to zero objectives.
+   *
+   * This and the two methods below are called by ::process with the first row
+   * whose content changes (because a constraint was removed or moved), before
+   * the assignments write in them. The default implementation does nothing,
+   * which is correct for solvers resetting their data in ::resize_.
+   */
+  virtual void resetObjectiveRows_(int /*start*/) {}
+  /** Reset the equality constraint rows, starting from row \p start, to
+   * trivial constraints (see ::resetObjectiveRows_).
+   */
+  virtual void resetEqualityConstraintRows_(int /*start*/) {}
+  /** Reset the inequality constraint rows, starting from row \p start, to
+   * trivially satisfied constraints (see ::resetObjectiveRows_).
+   */
+  virtual void resetInequalityConstraintRows_(int /*start*/) {}
   virtual void updateEqualityTargetData(scheme::internal::AssignmentTarget & target) = 0;
   virtual void updateInequalityTargetData(scheme::internal::AssignmentTarget & target) = 0;
   virtual void updateBoundTargetData(scheme::internal::AssignmentTarget & target) = 0;
@@ -157,6 +233,12 @@ protected:
 
   virtual void printProblemData_() const = 0;
   virtual void printDiagnostic_() const = 0;
+  /** Copy the data assembled for the backend into \p record, in the form
+   * described by QPRecord (the solution and success flag are set by ::solve).
+   * This is called after the assignments and before ::postAssignmentProcess_.
+   * The default implementation throws.
+   */
+  virtual void exportProblem_(QPRecord & record) const;
 
   const VariableVector & variables() const { return *variables_; }
   const hint::internal::Substitutions * substitutions() const { return subs_; }
@@ -164,10 +246,30 @@ protected:
   template<typename... Args>
   void addAssignement(Args &&... args);
 
+  /** Number of rows to allocate for \p nObj rows of objectives, taking into
+   * account the reserved capacity (see ::reserve).
+   */
+  int objectiveRows(int nObj);
+  /** Number of rows to allocate for \p nCstr rows of constraints, taking into
+   * account the reserved capacity (see ::reserve).
+   */
+  int constraintRows(int nCstr);
+
 private:
+  /** First row of each category of data whose content changes while
+   * processing events, or ::none.
+   */
+  struct ChangedRows
+  {
+    static constexpr int none = std::numeric_limits<int>::max();
+    int objectives = none;
+    int equalityConstraints = none;
+    int inequalityConstraints = none;
+  };
+
   void updateWeights(const internal::SolverEvents & se);
   bool updateVariables(const internal::SolverEvents & se);
-  ImpactFromChanges processRemovedConstraints(const internal::SolverEvents & se);
+  ImpactFromChanges processRemovedConstraints(const internal::SolverEvents & se, ChangedRows & changedRows);
   ImpactFromChanges previewAddedConstraints(const internal::SolverEvents & se);
   void processAddedConstraints(const internal::SolverEvents & se);
 
@@ -175,10 +277,13 @@ public:
   struct MarkedAssignment
   {
     template<typename... Args>
-    MarkedAssignment(Args &&... args) : assignment(std::forward<Args>(args)...), markedForRemoval(false)
+    MarkedAssignment(Args &&... args)
+    : assignment(std::forward<Args>(args)...), markedForRemoval(false), rangeChanged(false)
     {}
     scheme::internal::Assignment assignment;
     bool markedForRemoval;
+    /** Whether the range of the target moved while processing events.*/
+    bool rangeChanged;
   };
   template<typename K, typename T>
   using map = utils::internal::map<K, T>;
@@ -193,8 +298,12 @@ protected:
   int objSize_;
   int eqSize_;
   int ineqSize_;
+  PresolveStatistics presolveStatistics_;
 
 private:
+  /** Size the slots of the recorder, if any, for the current problem.*/
+  void reserveRecords();
+
   bool buildInProgress_;
   bool verbose_;
   VariableVector const * variables_;
@@ -209,6 +318,11 @@ private:
   MapToAssignment inequalityConstraintToAssignments_;
   MapToAssignment boundToAssignments_;
   const hint::internal::Substitutions * subs_;
+  /** Reserved capacities. A negative value means there is no reservation.*/
+  int objCapacity_;
+  int cstrCapacity_;
+  int reallocations_;
+  std::shared_ptr<QPRecorder> recorder_;
 };
 
 /** A base class for LeastSquareSolver factory.
@@ -0,0 +1,145 @@
+/* Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/api.h>
+#include <tvm/defs.h>
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace tvm
+{
+
+namespace solver
+{
+
+namespace internal
+{
+/** A presolve step for quadratic problems of the form
+ *
+ * min. 1/2 x^T Q x + c^T x
+ * s.t.  A_e x + b_e  = 0
+ *       A_i x + b_i >= 0
+ *       xl <= x <= xu
+ *
+ * where the first \p nEq rows of (A,b) are the equality constraints (A_e,b_e)
+ * and the others the inequality constraints (A_i,b_i). This is the form used
+ * by QLD.
+ *
+ * The presolve removes
+ *  - the inequality constraints whose bound is the big number used to
+ *    represent an infinite bound (b_i >= bigNumber), as they are trivially
+ *    satisfied,
+ *  - the variables whose lower and upper bounds are equal, by substituting
+ *    their value in the problem,
+ *  - the constraints that no longer depend on any variable and are satisfied
+ *    (up to eps) once the fixed variables have been substituted.
+ *
+ * A typical use is
+ * \code
+ * if(presolve.analyze(A, b, xl, xu, nEq))
+ * {
+ *   presolve.reduceConstraints(A, b, xl, xu);
+ *   presolve.reduceObjective(Q, c);
+ *   // solve the problem given by presolve.Q(), presolve.c(), ...
+ *   presolve.expand(y);
+ * }
+ * \endcode
+ * after which presolve.x() is the solution of the original problem.
+ *
+ * The data of the reduced problem is stored in buffers that are only
+ * reallocated when they are too small. Calling ::reserve with the dimensions
+ * of the original problem ensures that the steps above do not allocate.
+ */
+class TVM_DLLAPI QPPresolve
+{
+public:
+  QPPresolve(double bigNumber = constant::big_number, double eps = 1e-12);
+
+  /** Allocate the memory needed to presolve problems with up to \p m
+   * constraints and \p n variables.
+   */
+  void reserve(int m, int n);
+
+  /** Determine the constraints and variables that can be removed.
+   *
+   * \param fixedVariables If false, the variables with equal bounds are kept.
+   * This is needed when the objective is not given as (Q,c) but e.g. as a
+   * factorization of Q.
+   * \return true if something can be removed.
+   */
+  bool analyze(const MatrixConstRef & A,
+               const VectorConstRef & b,
+               const VectorConstRef & xl,
+               const VectorConstRef & xu,
+               int nEq,
+               bool fixedVariables = true);
+
+  /** Compute the constraints and bounds of the reduced problem. Must be
+   * called after ::analyze with the same data.
+   */
+  void reduceConstraints(const MatrixConstRef & A,
+                         const VectorConstRef & b,
+                         const VectorConstRef & xl,
+                         const VectorConstRef & xu);
+
+  /** Compute the objective of the reduced problem. Must be called after
+   * ::analyze.
+   */
+  void reduceObjective(const MatrixConstRef & Q, const VectorConstRef & c);
+
+  /** Compute the solution of the original problem from the solution \p y of
+   * the reduced one.
+   */
+  void expand(const VectorConstRef & y);
+
+  /** Data of the reduced problem.*/
+  Eigen::Map<const Eigen::MatrixXd> Q() const { return {Q_.data(), freeVariables(), freeVariables()}; }
+  Eigen::Map<const Eigen::VectorXd> c() const { return {c_.data(), freeVariables()}; }
+  Eigen::Map<const Eigen::MatrixXd> A() const { return {A_.data(), constraints(), freeVariables()}; }
+  Eigen::Map<const Eigen::VectorXd> b() const { return {b_.data(), constraints()}; }
+  Eigen::Map<const Eigen::VectorXd> xl() const { return {xl_.data(), freeVariables()}; }
+  Eigen::Map<const Eigen::VectorXd> xu() const { return {xu_.data(), freeVariables()}; }
+  /** Number of equality constraints in the reduced problem.*/
+  int nEq() const { return nEq_; }
+  /** Number of variables of the reduced problem.*/
+  int freeVariables() const { return static_cast<int>(free_.size()); }
+  /** Number of constraints of the reduced problem.*/
+  int constraints() const { return static_cast<int>(rows_.size()); }
+
+  /** Solution of the original problem.*/
+  const Eigen::VectorXd & x() const { return x_; }
+
+  /** Number of constraints removed by the last call to ::analyze.*/
+  int removedConstraints() const { return removedConstraints_; }
+  /** Number of variables removed by the last call to ::analyze.*/
+  int removedVariables() const { return static_cast<int>(fixed_.size()); }
+
+private:
+  double bigNumber_;
+  double eps_;
+  int nEq_;
+  int removedConstraints_;
+  std::vector<Eigen::DenseIndex> free_;  // indices of the remaining variables
+  std::vector<Eigen::DenseIndex> fixed_; // indices of the fixed variables
+  std::vector<Eigen::DenseIndex> rows_;  // indices of the remaining constraints
+
+  // Buffers for the data of the reduced problem, possibly larger than needed.
+  // The matrices are stored column-major with a leading dimension equal to
+  // their actual number of rows.
+  Eigen::VectorXd Q_;
+  Eigen::VectorXd c_;
+  Eigen::VectorXd A_;
+  Eigen::VectorXd b_;
+  Eigen::VectorXd xl_;
+  Eigen::VectorXd xu_;
+  Eigen::VectorXd x_; // also holds the values of the fixed variables
+};
+
+} // namespace internal
+
+} // namespace solver
+
+} // namespace tvm
@@ -5,6 +5,8 @@
 #include <tvm/api.h>
 #include <tvm/defs.h>
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 namespace tvm::solver::internal
@@ -37,6 +39,18 @@ public:
   void addObjective(const Objective & o);
   void removeObjective(LinearConstraintPtr o);
 
+  /** Ask for the assignments of constraint \p c to be rebuilt, e.g. because
+   * the substitutions of some of its variables changed. This is equivalent to
+   * removing and adding \p c, which cannot be expressed with removeConstraint
+   * and addConstraint, as they cancel each other.
+   *
+   * A subsequent call to removeConstraint cancels the reprocessing, and a call
+   * to addConstraint cancelling this removal restores it.
+   */
+  void reprocessConstraint(LinearConstraintPtr c);
+  /** Same as reprocessConstraint, for an objective.*/
+  void reprocessObjective(const Objective & o);
+
   void addVariable(VariablePtr v);
   void removeVariable(VariablePtr v);
 
@@ -47,6 +61,8 @@ public:
   const std::vector<LinearConstraintPtr> & removedConstraints() const { return removedConstraints_; }
   const std::vector<LinearConstraintPtr> & removedBounds() const { return removedBounds_; }
   const std::vector<LinearConstraintPtr> & removedObjectives() const { return removedObjectives_; }
+  const std::vector<LinearConstraintPtr> & reprocessedConstraints() const { return reprocessedConstraints_; }
+  const std::vector<Objective> & reprocessedObjectives() const { return reprocessedObjectives_; }
 
   const std::vector<VariablePtr> & addedVariables() const { return addedVariables_; }
   const std::vector<VariablePtr> & removedVariables() const { return removedVariables_; }
@@ -63,6 +79,12 @@ private:
   template<typename T>
   bool addIfPair(T & c, std::vector<T> & addVec, std::vector<T> & removeVec);
 
+  /** If \p c is to be reprocessed, cancel the reprocessing and return true.*/
+  template<typename T>
+  bool cancelReprocessing(const LinearConstraintPtr & c, std::vector<T> & reprocessVec);
+  /** Whether \p c was to be reprocessed before being removed. The record is erased.*/
+  bool wasReprocessed(const LinearConstraintPtr & c);
+
   /** \internal We don't anticipate to have many events at the same time so
    * that searching in the vector will be fast. If it was not the case, we can
    * change the data structure, or add one to speed up search.*/
@@ -74,6 +96,10 @@ private:
   std::vector<LinearConstraintPtr> removedConstraints_;
   std::vector<LinearConstraintPtr> removedBounds_;
   std::vector<LinearConstraintPtr> removedObjectives_;
+  std::vector<LinearConstraintPtr> reprocessedConstraints_;
+  std::vector<Objective> reprocessedObjectives_;
+  /** Constraints and objectives whose reprocessing was cancelled by a removal.*/
+  std::vector<LinearConstraintPtr> reprocessedThenRemoved_;
 
   std::vector<VariablePtr> addedVariables_;
   std::vector<VariablePtr> removedVariables_;
@@ -108,10 +134,19 @@ inline void SolverEvents::addVectorWeightEvent(constraint::abstract::LinearConst
   weightEvents_.push_back({c, false, true});
 }
 
-inline void SolverEvents::addConstraint(LinearConstraintPtr c) { addIfPair(c, addedConstraints_, removedConstraints_); }
+inline void SolverEvents::addConstraint(LinearConstraintPtr c)
+{
+  if(!addIfPair(c, addedConstraints_, removedConstraints_) && wasReprocessed(c))
+    reprocessedConstraints_.push_back(c);
+}
 
 inline void SolverEvents::removeConstraint(LinearConstraintPtr c)
-{ addIfPair(c, removedConstraints_, addedConstraints_); }
+{
+  // A constraint cannot be both removed and reprocessed, as it would be removed twice.
+  if(cancelReprocessing(c, reprocessedConstraints_))
+    reprocessedThenRemoved_.push_back(c);
+  addIfPair(c, removedConstraints_, addedConstraints_);
+}
 
 inline void SolverEvents::addBound(LinearConstraintPtr b) { addIfPair(b, addedBounds_, removedBounds_); }
 
@@ -123,11 +158,17 @@ inline void SolverEvents::addObjective(const Objective & o)
   if(it == removedObjectives_.end())
     addedObjectives_.push_back(o);
   else
+  {
     removedObjectives_.erase(it);
+    if(wasReprocessed(o.c))
+      reprocessedObjectives_.push_back(o);
+  }
 }
 
 inline void SolverEvents::removeObjective(LinearConstraintPtr o)
 {
+  if(cancelReprocessing(o, reprocessedObjectives_))
+    reprocessedThenRemoved_.push_back(o);
   auto it = std::find_if(addedObjectives_.begin(), addedObjectives_.end(), [&o](const auto & it) { return it.c == o; });
   if(it == addedObjectives_.end())
     removedObjectives_.push_back(o);
@@ -135,6 +176,20 @@ inline void SolverEvents::removeObjective(LinearConstraintPtr o)
     addedObjectives_.erase(it);
 }
 
+inline void SolverEvents::reprocessConstraint(LinearConstraintPtr c)
+{
+  if(std::find(reprocessedConstraints_.begin(), reprocessedConstraints_.end(), c) == reprocessedConstraints_.end())
+    reprocessedConstraints_.push_back(c);
+}
+
+inline void SolverEvents::reprocessObjective(const Objective & o)
+{
+  auto it = std::find_if(reprocessedObjectives_.begin(), reprocessedObjectives_.end(),
+                         [&o](const auto & it) { return it.c == o.c; });
+  if(it == reprocessedObjectives_.end())
+    reprocessedObjectives_.push_back(o);
+}
+
 inline void SolverEvents::addVariable(VariablePtr v)
 {
   if(!addIfPair(v, addedVariables_, removedVariables_))
@@ -158,4 +213,28 @@ inline bool SolverEvents::addIfPair(T & c, std::vector<T> & addVec, std::vector<
     removeVec.erase(it);
   return notFound;
 }
+
+template<typename T>
+inline bool SolverEvents::cancelReprocessing(const LinearConstraintPtr & c, std::vector<T> & reprocessVec)
+{
+  auto it = std::find_if(reprocessVec.begin(), reprocessVec.end(), [&c](const T & r) {
+    if constexpr(std::is_same_v<T, Objective>)
+      return r.c == c;
+    else
+      return r == c;
+  });
+  if(it == reprocessVec.end())
+    return false;
+  reprocessVec.erase(it);
+  return true;
+}
+
+inline bool SolverEvents::wasReprocessed(const LinearConstraintPtr & c)
+{
+  auto it = std::find(reprocessedThenRemoved_.begin(), reprocessedThenRemoved_.end(), c);
+  if(it == reprocessedThenRemoved_.end())
+    return false;
+  reprocessedThenRemoved_.erase(it);
+  return true;
+}
 } // namespace tvm::solver::internal
@@ -21,6 +21,7 @@ public:
   public:
     Impl(FunctionPtr f, constraint::Type t, const Eigen::VectorXd & rhs);
     void updateValue() override;
+    std::unique_ptr<abstract::TaskDynamicsImpl> clone(FunctionPtr f, utils::CloneMap & map) const override;
     ~Impl() override = default;
 
   private:
@@ -27,6 +27,7 @@ public:
   public:
     Impl(FunctionPtr f, constraint::Type t, const Eigen::VectorXd & rhs, Order d, double dt);
     void updateValue() override;
+    std::unique_ptr<abstract::TaskDynamicsImpl> clone(FunctionPtr f, utils::CloneMap & map) const override;
 
     ~Impl() override = default;
 
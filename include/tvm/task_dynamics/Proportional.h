@@ -30,6 +30,7 @@ public:
   public:
     Impl(FunctionPtr f, constraint::Type t, const Eigen::VectorXd & rhs, const Gain & kp);
     void updateValue() override;
+    std::unique_ptr<abstract::TaskDynamicsImpl> clone(FunctionPtr f, utils::CloneMap & map) const override;
 
     ~Impl() override = default;
 
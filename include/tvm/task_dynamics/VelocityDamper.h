@@ -131,6 +131,7 @@ public:
          double big);
 
     void updateValue() override;
+    std::unique_ptr<abstract::TaskDynamicsImpl> clone(FunctionPtr f, utils::CloneMap & map) const override;
 
     ~Impl() override = default;
 
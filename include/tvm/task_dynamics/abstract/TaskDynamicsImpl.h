@@ -42,6 +42,15 @@ public:
 
   virtual void updateValue() = 0;
 
+  /** Create a task dynamics with the same parameters as this one, for the
+   * function \p f (typically the clone of the function of this task dynamics).
+   *
+   * \p map provides the clones of the other functions this task dynamics
+   * may depend on. The default implementation throws: a derived class needs
+   * to override this method to be cloneable.
+   */
+  virtual std::unique_ptr<TaskDynamicsImpl> clone(FunctionPtr f, utils::CloneMap & map) const;
+
   /** Check if this is an instance of T::Impl */
   template<typename T>
   bool checkType() const;
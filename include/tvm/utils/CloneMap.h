@@ -0,0 +1,122 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/api.h>
+#include <tvm/defs.h>
+
+#include <memory>
+#include <unordered_map>
+
+namespace tvm
+{
+class TaskWithRequirements;
+
+namespace graph::abstract
+{
+class Outputs;
+} // namespace graph::abstract
+
+namespace robot
+{
+class Frame;
+} // namespace robot
+
+namespace utils
+{
+
+/** Correspondence between objects and their clones, used to duplicate a
+ * problem (see LinearizedControlProblem::clone).
+ *
+ * Each object is cloned at most once: asking twice for the clone of the same
+ * variable or function returns the same clone, so that the structure of the
+ * original (shared variables, functions used by several tasks, ...) is
+ * preserved. After the cloning, the map is the way to retrieve the clone of a
+ * given object.
+ *
+ * The map also records the correspondence between the nodes of the update
+ * graphs (functions, task dynamics, constraints, robots, ...), so that the
+ * update plan computed for a problem can be reused for its clone.
+ *
+ * A CloneMap is not thread-safe and cloning should happen on a single thread.
+ * The resulting clones are independent from the original objects, except for
+ * the immutable data they share (e.g. the model of a robot).
+ */
+class TVM_DLLAPI CloneMap
+{
+public:
+  /** Get the clone of \p x, creating it if needed.
+   *
+   * The clone of a base primitive is a new variable on the same space, with
+   * the same name and value. The clones of subvariables and derivatives are
+   * obtained from the clone of their supervariable and primitive, so that
+   * they keep the same relations.
+   */
+  VariablePtr variable(const VariablePtr & x);
+
+  /** Get the clone of \p f, creating it with Function::clone if needed.
+   *
+   * \throws std::runtime_error if the actual type of \p f does not support
+   * cloning.
+   */
+  FunctionPtr function(const FunctionPtr & f);
+
+  /** Get the clone of \p f, with its actual type.*/
+  template<typename F>
+  std::shared_ptr<F> function(const std::shared_ptr<F> & f);
+
+  /** Get the clone of clock \p c, creating it if needed.
+   *
+   * The clone has the same time step and number of ticks. It is owned by the
+   * clones of the robots using it, and can be advanced independently of \p c.
+   */
+  Clock & clock(const Clock & c);
+
+  /** Get the clone of robot \p r, creating it if needed.
+   *
+   * The clone runs on the clone of the clock of \p r, on clones of its
+   * variables, and starts from the current state of \p r. It shares the
+   * model (Robot::mb()) of \p r. Only available if TVM is built with robots.
+   */
+  RobotPtr robot(const RobotPtr & r);
+
+  /** Get the clone of frame \p f, attached to the clone of its robot.
+   * Only available if TVM is built with robots.
+   */
+  std::shared_ptr<robot::Frame> frame(const std::shared_ptr<robot::Frame> & f);
+
+  /** Get the clone of task \p tr, as registered by the clone of a problem.
+   *
+   * \throws std::out_of_range if no clone of \p tr was registered.
+   */
+  const std::shared_ptr<TaskWithRequirements> & task(const TaskWithRequirements & tr) const;
+
+  /** Register \p clone as the clone of \p tr.*/
+  void task(const TaskWithRequirements & tr, std::shared_ptr<TaskWithRequirements> clone);
+
+  /** Get the clone of the source \p s of an update graph (function, task
+   * dynamics, constraint, robot, clock, ...), or \a nullptr if \p s was not
+   * cloned.
+   */
+  graph::abstract::Outputs * source(const graph::abstract::Outputs & s) const;
+
+  /** Register \p clone as the clone of the source \p s of an update graph.*/
+  void source(const graph::abstract::Outputs & s, graph::abstract::Outputs & clone);
+
+private:
+  std::unordered_map<const Variable *, VariablePtr> variables_;
+  std::unordered_map<const function::abstract::Function *, FunctionPtr> functions_;
+  std::unordered_map<const TaskWithRequirements *, std::shared_ptr<TaskWithRequirements>> tasks_;
+  std::unordered_map<const Clock *, ClockPtr> clocks_;
+  std::unordered_map<const Robot *, RobotPtr> robots_;
+  std::unordered_map<const robot::Frame *, std::shared_ptr<robot::Frame>> frames_;
+  std::unordered_map<const graph::abstract::Outputs *, graph::abstract::Outputs *> sources_;
+};
+
+template<typename F>
+inline std::shared_ptr<F> CloneMap::function(const std::shared_ptr<F> & f)
+{ return std::static_pointer_cast<F>(function(std::static_pointer_cast<function::abstract::Function>(f))); }
+
+} // namespace utils
+
+} // namespace tvm
@@ -0,0 +1,297 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include <cmath>
+#include <type_traits>
+
+namespace tvm
+{
+
+namespace utils
+{
+
+/** A dual number v + d_1 e_1 + ... + d_N e_N, where e_i e_j = 0, for forward
+ * mode automatic differentiation.
+ *
+ * Evaluating an expression on dual numbers whose derivative lanes \a d are
+ * seeded with directions yields the value of the expression together with its
+ * derivatives along these N directions at once. The lanes are stored in a
+ * fixed-size Eigen vector so that the operations on them are vectorized.
+ *
+ * \p S can itself be a dual number, to get second-order derivatives.
+ *
+ * See function::abstract::AutoDiffFunction for the main use.
+ */
+template<int N, typename S = double>
+class Dual
+{
+public:
+  using Scalar = S;
+  using Lanes = Eigen::Matrix<S, N, 1>;
+
+  Dual() : v(0), d(Lanes::Zero()) {}
+
+  /** A constant.*/
+  template<typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+  Dual(T c) : v(static_cast<double>(c)), d(Lanes::Zero())
+  {}
+
+  /** A constant, for nested dual numbers.*/
+  template<typename T = S, typename std::enable_if_t<!std::is_arithmetic_v<T>, int> = 0>
+  Dual(const S & value) : v(value), d(Lanes::Zero())
+  {}
+
+  Dual(const S & value, const Lanes & derivatives) : v(value), d(derivatives) {}
+
+  Dual & operator+=(const Dual & other)
+  {
+    v += other.v;
+    d += other.d;
+    return *this;
+  }
+
+  Dual & operator-=(const Dual & other)
+  {
+    v -= other.v;
+    d -= other.d;
+    return *this;
+  }
+
+  Dual & operator*=(const Dual & other)
+  {
+    d = d * other.v + other.d * v;
+    v *= other.v;
+    return *this;
+  }
+
+  Dual & operator/=(const Dual & other)
+  {
+    S inv = S(1) / other.v;
+    v *= inv;
+    d = (d - other.d * v) * inv;
+    return *this;
+  }
+
+  /** Value.*/
+  S v;
+  /** Derivatives along the N directions.*/
+  Lanes d;
+};
+
+template<int N, typename S>
+inline Dual<N, S> operator-(const Dual<N, S> & a)
+{ return {-a.v, -a.d}; }
+
+template<int N, typename S>
+inline Dual<N, S> operator+(Dual<N, S> a, const Dual<N, S> & b)
+{ return a += b; }
+
+template<int N, typename S>
+inline Dual<N, S> operator-(Dual<N, S> a, const Dual<N, S> & b)
+{ return a -= b; }
+
+template<int N, typename S>
+inline Dual<N, S> operator*(Dual<N, S> a, const Dual<N, S> & b)
+{ return a *= b; }
+
+template<int N, typename S>
+inline Dual<N, S> operator/(Dual<N, S> a, const Dual<N, S> & b)
+{ return a /= b; }
+
+template<int N, typename S, typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline Dual<N, S> operator+(const Dual<N, S> & a, T b)
+{ return {a.v + b, a.d}; }
+
+template<int N, typename S, typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline Dual<N, S> operator+(T a, const Dual<N, S> & b)
+{ return {a + b.v, b.d}; }
+
+template<int N, typename S, typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline Dual<N, S> operator-(const Dual<N, S> & a, T b)
+{ return {a.v - b, a.d}; }
+
+template<int N, typename S, typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline Dual<N, S> operator-(T a, const Dual<N, S> & b)
+{ return {a - b.v, -b.d}; }
+
+template<int N, typename S, typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline Dual<N, S> operator*(const Dual<N, S> & a, T b)
+{ return {a.v * b, a.d * S(b)}; }
+
+template<int N, typename S, typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline Dual<N, S> operator*(T a, const Dual<N, S> & b)
+{ return {a * b.v, b.d * S(a)}; }
+
+template<int N, typename S, typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline Dual<N, S> operator/(const Dual<N, S> & a, T b)
+{ return {a.v / b, a.d / S(b)}; }
+
+template<int N, typename S, typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline Dual<N, S> operator/(T a, const Dual<N, S> & b)
+{
+  S inv = S(1) / b.v;
+  return {a * inv, b.d * (-a * inv * inv)};
+}
+
+/** Comparisons are on the values, so that expressions can branch on them.*/
+#define TVM_DUAL_COMPARISON(op)                                                    \
+  template<int N, typename S>                                                      \
+  inline bool operator op(const Dual<N, S> & a, const Dual<N, S> & b)              \
+  {                                                                                \
+    return a.v op b.v;                                                             \
+  }                                                                                \
+  template<int N, typename S, typename T,                                          \
+           typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>            \
+  inline bool operator op(const Dual<N, S> & a, T b)                               \
+  {                                                                                \
+    return a.v op b;                                                               \
+  }                                                                                \
+  template<int N, typename S, typename T,                                          \
+           typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>            \
+  inline bool operator op(T a, const Dual<N, S> & b)                               \
+  {                                                                                \
+    return a op b.v;                                                               \
+  }
+
+TVM_DUAL_COMPARISON(<)
+TVM_DUAL_COMPARISON(<=)
+TVM_DUAL_COMPARISON(>)
+TVM_DUAL_COMPARISON(>=)
+TVM_DUAL_COMPARISON(==)
+TVM_DUAL_COMPARISON(!=)
+
+#undef TVM_DUAL_COMPARISON
+
+// Elementary functions: f(v + d e) = f(v) + f'(v) d e.
+// The std functions are brought in scope so that nested dual numbers use these overloads.
+
+template<int N, typename S>
+inline Dual<N, S> sin(const Dual<N, S> & a)
+{
+  using std::cos;
+  using std::sin;
+  return {sin(a.v), a.d * cos(a.v)};
+}
+
+template<int N, typename S>
+inline Dual<N, S> cos(const Dual<N, S> & a)
+{
+  using std::cos;
+  using std::sin;
+  return {cos(a.v), a.d * -sin(a.v)};
+}
+
+template<int N, typename S>
+inline Dual<N, S> tan(const Dual<N, S> & a)
+{
+  using std::tan;
+  S t = tan(a.v);
+  return {t, a.d * (1 + t * t)};
+}
+
+template<int N, typename S>
+inline Dual<N, S> asin(const Dual<N, S> & a)
+{
+  using std::asin;
+  using std::sqrt;
+  return {asin(a.v), a.d * (1 / sqrt(1 - a.v * a.v))};
+}
+
+template<int N, typename S>
+inline Dual<N, S> acos(const Dual<N, S> & a)
+{
+  using std::acos;
+  using std::sqrt;
+  return {acos(a.v), a.d * (-1 / sqrt(1 - a.v * a.v))};
+}
+
+template<int N, typename S>
+inline Dual<N, S> atan(const Dual<N, S> & a)
+{
+  using std::atan;
+  return {atan(a.v), a.d * (1 / (1 + a.v * a.v))};
+}
+
+template<int N, typename S>
+inline Dual<N, S> atan2(const Dual<N, S> & y, const Dual<N, S> & x)
+{
+  using std::atan2;
+  S inv = 1 / (x.v * x.v + y.v * y.v);
+  return {atan2(y.v, x.v), (y.d * x.v - x.d * y.v) * inv};
+}
+
+template<int N, typename S>
+inline Dual<N, S> exp(const Dual<N, S> & a)
+{
+  using std::exp;
+  S e = exp(a.v);
+  return {e, a.d * e};
+}
+
+template<int N, typename S>
+inline Dual<N, S> log(const Dual<N, S> & a)
+{
+  using std::log;
+  return {log(a.v), a.d * (1 / a.v)};
+}
+
+template<int N, typename S>
+inline Dual<N, S> sqrt(const Dual<N, S> & a)
+{
+  using std::sqrt;
+  S s = sqrt(a.v);
+  return {s, a.d * (0.5 / s)};
+}
+
+template<int N, typename S>
+inline Dual<N, S> pow(const Dual<N, S> & a, double p)
+{
+  using std::pow;
+  return {pow(a.v, p), a.d * (p * pow(a.v, p - 1))};
+}
+
+template<int N, typename S>
+inline Dual<N, S> abs(const Dual<N, S> & a)
+{ return a.v < 0 ? -a : a; }
+
+} // namespace utils
+
+} // namespace tvm
+
+namespace Eigen
+{
+/** Allow the use of dual numbers as the scalar type of Eigen matrices.*/
+template<int N, typename S>
+struct NumTraits<tvm::utils::Dual<N, S>> : NumTraits<double>
+{
+  using Real = tvm::utils::Dual<N, S>;
+  using NonInteger = Real;
+  using Nested = Real;
+  using Literal = Real;
+  enum
+  {
+    IsComplex = 0,
+    IsInteger = 0,
+    IsSigned = 1,
+    RequireInitialization = 1,
+    ReadCost = (N + 1) * NumTraits<S>::ReadCost,
+    AddCost = (N + 1) * NumTraits<S>::AddCost,
+    MulCost = (2 * N + 1) * NumTraits<S>::MulCost
+  };
+};
+
+template<int N, typename S, typename BinaryOp>
+struct ScalarBinaryOpTraits<tvm::utils::Dual<N, S>, double, BinaryOp>
+{
+  using ReturnType = tvm::utils::Dual<N, S>;
+};
+
+template<int N, typename S, typename BinaryOp>
+struct ScalarBinaryOpTraits<double, tvm::utils::Dual<N, S>, BinaryOp>
+{
+  using ReturnType = tvm::utils::Dual<N, S>;
+};
+} // namespace Eigen
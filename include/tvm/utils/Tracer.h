@@ -0,0 +1,144 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/api.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace tvm
+{
+
+namespace utils
+{
+
+/** An event recorded by the Tracer: something named that started at a given
+ * time and lasted for some duration.
+ */
+struct TraceEvent
+{
+  /** Name of the event, or \a nullptr for the update of a node of a call
+   * graph, whose name is retrieved from the graph log when exporting.
+   */
+  const char * name;
+  /** For an update, address of the (most derived) node object.*/
+  std::uintptr_t object;
+  /** For an update, id of the update.*/
+  int id;
+  /** Small integer identifying the thread that recorded the event.*/
+  int thread;
+  /** Start of the event, in nanoseconds since an arbitrary origin.*/
+  int64_t start;
+  /** Duration of the event, in nanoseconds.*/
+  int64_t duration;
+};
+
+/** Record the timing of the updates executed by the call graphs and of the
+ * phases of the least-square solvers, and export them in the Chrome trace
+ * format (to be opened in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * Tracing is off by default. Once enabled by ::enable, every
+ * CallGraph::execute records one event per update it calls, and every
+ * LeastSquareSolver::solve one event per phase. The events are written in a
+ * ring buffer allocated by ::enable: recording an event does not allocate nor
+ * lock, and when the buffer is full, the oldest events are overwritten.
+ *
+ * The events can be recorded concurrently from several threads, but ::enable,
+ * ::clear, ::events and ::writeChromeTrace must not be called while events
+ * are being recorded.
+ *
+ * The instrumentation is compiled only if TVM_WITH_TRACING is defined (CMake
+ * option of the same name, OFF by default). Otherwise, nothing is ever
+ * recorded and the instrumentation has no cost.
+ */
+class TVM_DLLAPI Tracer
+{
+public:
+  /** The tracer used by the call graphs and solvers.*/
+  static Tracer & tracer();
+
+  /** Start recording, with a buffer of \p capacity events (rounded up to a
+   * power of 2). Previously recorded events are discarded.
+   */
+  void enable(int capacity = 1 << 16);
+  /** Stop recording. The recorded events are kept.*/
+  void disable();
+  /** Whether events are being recorded.*/
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /** Discard the recorded events.*/
+  void clear();
+
+  /** Record an event. Does nothing if the tracer is disabled.*/
+  void record(const char * name, std::uintptr_t object, int id, int64_t start, int64_t end);
+
+  /** The events still in the buffer, in the order they were recorded.*/
+  std::vector<TraceEvent> events() const;
+  /** Number of events overwritten because the buffer was full.*/
+  uint64_t overwritten() const;
+
+  /** Write the events in the Chrome trace JSON format. The updates of the
+   * call graphs are named after the class of their node and the name of the
+   * update given to TVM_GRAPH_LOG_REGISTER_UPDATE.
+   */
+  void writeChromeTrace(std::ostream & os) const;
+  /** Write the events in the Chrome trace JSON format to the file \p path.*/
+  void writeChromeTrace(const std::string & path) const;
+
+  /** Current time, in nanoseconds, as used for the events.*/
+  static int64_t now();
+
+private:
+  Tracer() = default;
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint64_t> next_{0};
+  uint64_t mask_ = 0;
+  std::vector<TraceEvent> buffer_;
+};
+
+/** Record an event from construction to destruction, if the tracer is
+ * enabled.
+ */
+class TraceScope
+{
+public:
+  TraceScope(const char * name)
+  : name_(name), start_(Tracer::tracer().enabled() ? Tracer::now() : -1)
+  {}
+
+  ~TraceScope()
+  {
+    if(start_ >= 0)
+    {
+      Tracer::tracer().record(name_, 0, 0, start_, Tracer::now());
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope & operator=(const TraceScope &) = delete;
+
+private:
+  const char * name_;
+  int64_t start_;
+};
+
+} // namespace utils
+
+} // namespace tvm
+
+#define TVM_TRACE_CONCAT_(a, b) a##b
+#define TVM_TRACE_CONCAT(a, b) TVM_TRACE_CONCAT_(a, b)
+
+/** Record the time spent in the enclosing scope under the name \p name
+ * (a string literal), if tracing is compiled in and enabled.
+ */
+#ifdef TVM_WITH_TRACING
+#  define TVM_TRACE_SCOPE(name) tvm::utils::TraceScope TVM_TRACE_CONCAT(tvmTraceScope, __LINE__)(name)
+#else
+#  define TVM_TRACE_SCOPE(name)
+#endif
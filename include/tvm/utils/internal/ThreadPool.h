@@ -0,0 +1,76 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#pragma once
+
+#include <tvm/api.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tvm
+{
+
+namespace utils
+{
+
+namespace internal
+{
+/** A minimal pool of threads to run batches of independent jobs.
+ *
+ * The threads are created once at construction and sleep between two calls to
+ * run(). The calling thread takes part in the computations, so that a pool of
+ * size n only creates n-1 threads.
+ */
+class TVM_DLLAPI ThreadPool
+{
+public:
+  /** Create a pool running jobs on \p n threads (including the calling one).*/
+  ThreadPool(int n);
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+
+  ~ThreadPool();
+
+  /** Number of threads running the jobs, including the calling thread.*/
+  int size() const;
+
+  /** Call \p job(i) for i = 0 to \p n-1, dispatching the calls over the
+   * threads of the pool. Return once all the calls are done.
+   *
+   * If one of the calls throws, the remaining calls are still performed and
+   * the (first) exception is rethrown in the calling thread.
+   */
+  void run(size_t n, const std::function<void(size_t)> & job);
+
+private:
+  /** Loop of the worker threads.*/
+  void work();
+  /** Process the jobs of the current batch until there are none left.*/
+  void process();
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+
+  const std::function<void(size_t)> * job_; // current job
+  size_t n_;                                // number of calls in the current batch
+  std::atomic<size_t> next_;                // next call to perform
+  size_t busy_;                             // number of workers still working on the current batch
+  uint64_t batch_;                          // id of the current batch
+  bool stop_;
+  std::exception_ptr error_;
+};
+
+} // namespace internal
+
+} // namespace utils
+
+} // namespace tvm
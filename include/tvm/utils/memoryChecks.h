@@ -61,7 +61,10 @@ inline bool set_is_malloc_allowed(bool allow)
 }
 
 /** Record whether dynamic allocation of memory in Eigen objects is allowed or not and set \p allow instead.
- * Records are made with a stack.
+ * Records are made with a stack, one per thread.
+ *
+ * \note When EIGEN_RUNTIME_NO_MALLOC is defined, the flag itself is a global
+ * of Eigen: the checks are then meant for single-threaded programs.
  *
  * Any call to this function should be mirrored by a call to restore_is_malloc_allowed().
  * It is advised to call restore_is_malloc_allowed() in the same scope.
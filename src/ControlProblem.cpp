@@ -9,6 +9,16 @@ TaskWithRequirements::TaskWithRequirements(const Task & t, requirements::Solving
 : task(t), requirements(req)
 {}
 
+void TaskWithRequirements::disable()
+{
+  if(substitutionUses_ > 0)
+  {
+    throw std::runtime_error("[TaskWithRequirements::disable] This task is used by a substitution and cannot be "
+                             "disabled. Remove the substitution first.");
+  }
+  enabled_ = false;
+}
+
 TaskWithRequirementsPtr ControlProblem::add(const Task & task, const requirements::SolvingRequirements & req)
 {
   auto tr = std::make_shared<TaskWithRequirements>(task, req);
@@ -98,6 +108,16 @@ void ControlProblem::Updater::refresh()
   }
 }
 
+void ControlProblem::Updater::copyGraph(
+    const Updater & other,
+    const std::function<graph::abstract::Outputs *(const graph::abstract::Outputs *)> & map)
+{
+  if(other.upToDate_ && updateGraph_.copy(other.updateGraph_, inputs_, map))
+  {
+    upToDate_ = true;
+  }
+}
+
 void ControlProblem::Updater::run() { updateGraph_.execute(); }
 
 const graph::CallGraph & ControlProblem::Updater::updateGraph() const { return updateGraph_; }
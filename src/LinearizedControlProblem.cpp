@@ -5,6 +5,10 @@
 #include <tvm/constraint/internal/LinearizedTaskConstraint.h>
 #include <tvm/scheme/internal/LinearizedProblemComputationData.h>
 #include <tvm/scheme/internal/helpers.h>
+#include <tvm/utils/CloneMap.h>
+
+#include <algorithm>
+#include <unordered_map>
 
 namespace tvm
 {
@@ -16,6 +20,78 @@ LinearizedControlProblem::LinearizedControlProblem(const ControlProblem & pb) :
     add(tr);
 }
 
+std::unique_ptr<LinearizedControlProblem> LinearizedControlProblem::clone(utils::CloneMap & map) const
+{
+  auto pb = std::make_unique<LinearizedControlProblem>();
+  pb->mergeDoubleSided_ = mergeDoubleSided_;
+  pb->substitutionThreads(substitutions_.threads());
+
+  // The tasks are not added through add: the constraints and merges of this
+  // problem are replicated instead of being searched again.
+  pb->tr_.reserve(tr_.size());
+  for(const auto & tr : tasks())
+  {
+    const auto & r = tr->requirements;
+    auto c = std::make_shared<TaskWithRequirements>(
+        tr->task.clone(map),
+        requirements::SolvingRequirements(r.priorityLevel(), r.weight(), r.anisotropicWeight(), r.violationEvaluation()));
+    c->enabled_ = tr->enabled_;
+    pb->tr_.push_back(c);
+    pb->addCallBackToTask(c);
+    map.task(*tr, c);
+  }
+
+  std::unordered_map<const constraint::abstract::LinearConstraint *, LinearConstraintPtr> constraints;
+  for(const auto & c : constraints_)
+  {
+    const auto & owner = map.task(*c.first);
+    LinearConstraintWithRequirements lcr;
+    auto it = partners_.find(c.first);
+    if(it != partners_.end())
+    {
+      const auto & partner = map.task(*it->second);
+      lcr = pb->linearize(owner, partner);
+      pb->registerMerge(owner, partner);
+    }
+    else
+    {
+      lcr = pb->linearize(owner);
+    }
+    pb->registerConstraint(*owner, lcr);
+    map.source(*c.second.constraint, *lcr.constraint);
+    constraints[c.second.constraint.get()] = lcr.constraint;
+  }
+
+  for(const auto & s : substitutions_.substitutions())
+  {
+    std::vector<LinearConstraintPtr> cstr;
+    for(const auto & c : s.constraints())
+    {
+      auto it = constraints.find(c.get());
+      if(it == constraints.end())
+      {
+        throw std::runtime_error("[LinearizedControlProblem::clone] A substitution uses a constraint that is not the "
+                                 "constraint of a task of this problem.");
+      }
+      cstr.push_back(it->second);
+    }
+    pb->add(s.clone(cstr, map));
+  }
+
+  if(finalized_)
+  {
+    pb->updater_.copyGraph(updater_, [&map](const graph::abstract::Outputs * s) { return map.source(*s); });
+    pb->finalize();
+  }
+  return pb;
+}
+
+std::unique_ptr<LinearizedControlProblem> LinearizedControlProblem::clone() const
+{
+  utils::CloneMap map;
+  return clone(map);
+}
+
 TaskWithRequirementsPtr LinearizedControlProblem::add(const Task & task, const requirements::SolvingRequirements & req)
 {
   auto tr = std::make_shared<TaskWithRequirements>(task, req);
@@ -27,19 +103,147 @@ void LinearizedControlProblem::add(TaskWithRequirementsPtr tr)
 {
   ControlProblem::add(tr);
 
-  // FIXME A lot of work can be done here based on the properties of the task's jacobian.
-  // In particular, we could detect bounds, pairs of tasks forming a double-sided constraints...
+  if(mergeDoubleSided_)
+  {
+    auto owner = findDoubleSidedPartner(*tr);
+    if(owner)
+    {
+      // The constraint of owner is replaced by the merged constraint. For the
+      // resolution schemes, this amounts to the removal and addition of owner,
+      // while tr has no constraint of its own.
+      unregisterConstraint(*owner);
+      registerConstraint(*owner, linearize(owner, tr));
+      registerMerge(owner, tr);
+      notify({scheme::internal::ProblemDefinitionEvent::Type::TaskRemoval, *owner});
+      notify({scheme::internal::ProblemDefinitionEvent::Type::TaskAddition, *owner});
+      return;
+    }
+  }
+
+  registerConstraint(*tr, linearize(tr));
+}
+
+void LinearizedControlProblem::remove(const TaskWithRequirements & tr)
+{
+  ControlProblem::remove(tr);
+
+  // If tr was merged into the constraint of another task, this task gets back
+  // its own constraint.
+  auto itOwner = owners_.find(&tr);
+  if(itOwner != owners_.end())
+  {
+    auto owner = itOwner->second;
+    owners_.erase(itOwner);
+    partners_.erase(owner.get());
+    mergeCallbackTokens_.erase(owner.get());
+    unregisterConstraint(*owner);
+    registerConstraint(*owner, linearize(owner));
+    notify({scheme::internal::ProblemDefinitionEvent::Type::TaskRemoval, *owner});
+    notify({scheme::internal::ProblemDefinitionEvent::Type::TaskAddition, *owner});
+    return;
+  }
+
+  auto it = constraints_.find(&tr);
+  if(it == constraints_.end())
+  {
+    return;
+  }
+  removeSubstitutionFor(*it->second.constraint);
+  unregisterConstraint(tr);
+
+  // If the constraint of tr was a merged constraint, the other task gets its
+  // own constraint.
+  auto itPartner = partners_.find(&tr);
+  if(itPartner != partners_.end())
+  {
+    auto partner = itPartner->second;
+    partners_.erase(itPartner);
+    owners_.erase(partner.get());
+    mergeCallbackTokens_.erase(&tr);
+    registerConstraint(*partner, linearize(partner));
+    notify({scheme::internal::ProblemDefinitionEvent::Type::TaskAddition, *partner});
+  }
+}
+
+void LinearizedControlProblem::unmerge(const TaskWithRequirements & owner)
+{
+  auto itPartner = partners_.find(&owner);
+  assert(itPartner != partners_.end());
+  auto partner = itPartner->second;
+  auto o = owners_.at(partner.get());
+  partners_.erase(itPartner);
+  owners_.erase(partner.get());
+  // This might be called from one of the callbacks: the tokens are destroyed,
+  // not the callbacks themselves.
+  mergeCallbackTokens_.erase(&owner);
+  unregisterConstraint(owner);
+  registerConstraint(owner, linearize(o));
+  registerConstraint(*partner, linearize(partner));
+  notify({scheme::internal::ProblemDefinitionEvent::Type::TaskRemoval, owner});
+  notify({scheme::internal::ProblemDefinitionEvent::Type::TaskAddition, owner});
+  notify({scheme::internal::ProblemDefinitionEvent::Type::TaskAddition, *partner});
+  needFinalize();
+}
+
+void LinearizedControlProblem::registerMerge(const TaskWithRequirementsPtr & owner,
+                                             const TaskWithRequirementsPtr & partner)
+{
+  partners_[owner.get()] = partner;
+  owners_[partner.get()] = owner;
+  // The merge is only valid at priority level 0: it is undone if the
+  // priority of one of the tasks changes.
+  const TaskWithRequirements * o = owner.get();
+  auto unmergeIfNotZero = [this, o]() {
+    auto it = partners_.find(o);
+    if(it != partners_.end()
+       && (o->requirements.priorityLevel().value() != 0 || it->second->requirements.priorityLevel().value() != 0))
+    {
+      unmerge(*o);
+    }
+  };
+  std::vector<internal::PairElementToken> tokens;
+  tokens.emplace_back(owner->requirements.priorityLevel().registerCallback(unmergeIfNotZero));
+  tokens.emplace_back(partner->requirements.priorityLevel().registerCallback(unmergeIfNotZero));
+  mergeCallbackTokens_[o] = std::move(tokens);
+}
+
+LinearConstraintWithRequirements LinearizedControlProblem::linearize(const TaskWithRequirementsPtr & tr) const
+{
   LinearConstraintWithRequirements lcr;
   lcr.constraint = std::make_shared<constraint::internal::LinearizedTaskConstraint>(tr->task);
   // we use the aliasing constructor of std::shared_ptr to ensure that
   // lcr.requirements points to and doesn't outlive tr->requirements.
   lcr.requirements = std::shared_ptr<requirements::SolvingRequirementsWithCallbacks>(tr, &tr->requirements);
+  // Same for the enabled state of the task.
+  lcr.constraint->enabledFlag(std::shared_ptr<const bool>(tr, &tr->enabled_));
+  lcr.bound = scheme::internal::isBound(lcr.constraint);
+  return lcr;
+}
+
+LinearConstraintWithRequirements LinearizedControlProblem::linearize(const TaskWithRequirementsPtr & owner,
+                                                                     const TaskWithRequirementsPtr & partner) const
+{
+  const auto & lower = owner->task.type() == constraint::Type::GREATER_THAN ? owner : partner;
+  const auto & upper = owner->task.type() == constraint::Type::GREATER_THAN ? partner : owner;
+  auto c = std::make_shared<constraint::internal::LinearizedTaskConstraint>(lower->task, upper->task);
+  c->boundsEnabledFlags(std::shared_ptr<const bool>(lower, &lower->enabled_),
+                        std::shared_ptr<const bool>(upper, &upper->enabled_));
+
+  LinearConstraintWithRequirements lcr;
+  lcr.constraint = c;
+  lcr.requirements = std::shared_ptr<requirements::SolvingRequirementsWithCallbacks>(owner, &owner->requirements);
   lcr.bound = scheme::internal::isBound(lcr.constraint);
-  constraints_[tr.get()] = lcr;
+  return lcr;
+}
+
+void LinearizedControlProblem::registerConstraint(const TaskWithRequirements & tr,
+                                                  const LinearConstraintWithRequirements & lcr)
+{
+  constraints_[&tr] = lcr;
 
   using CstrOutput = internal::FirstOrderProvider::Output;
   updater_.addInput(lcr.constraint, CstrOutput::Jacobian);
-  switch(tr->task.type())
+  switch(lcr.constraint->type())
   {
     case constraint::Type::EQUAL:
       updater_.addInput(lcr.constraint, constraint::abstract::Constraint::Output::E);
@@ -57,28 +261,77 @@ void LinearizedControlProblem::add(TaskWithRequirementsPtr tr)
   }
 }
 
-void LinearizedControlProblem::remove(const TaskWithRequirements & tr)
+void LinearizedControlProblem::unregisterConstraint(const TaskWithRequirements & tr)
 {
-  ControlProblem::remove(tr);
   auto it = constraints_.find(&tr);
-  if(it == constraints_.end())
-  {
-    return;
-  }
-  removeSubstitutionFor(*it->second.constraint);
+  assert(it != constraints_.end());
   updater_.removeInput(it->second.constraint.get());
   constraints_.erase(it);
 }
 
+TaskWithRequirementsPtr LinearizedControlProblem::findDoubleSidedPartner(const TaskWithRequirements & tr) const
+{
+  using constraint::Type;
+  const auto & task = tr.task;
+  if((task.type() != Type::GREATER_THAN && task.type() != Type::LOWER_THAN)
+     || tr.requirements.priorityLevel().value() != 0)
+  {
+    return nullptr;
+  }
+
+  Type complement = task.type() == Type::GREATER_THAN ? Type::LOWER_THAN : Type::GREATER_THAN;
+  for(const auto & other : tasks())
+  {
+    if(other->task.function() == task.function() && other->task.type() == complement
+       && other->requirements.priorityLevel().value() == 0
+       && other->task.taskDynamics()->order() == task.taskDynamics()->order() && constraints_.count(other.get())
+       && !partners_.count(other.get()) && !substitutions_.uses(constraints_.at(other.get()).constraint))
+    {
+      return other;
+    }
+  }
+  return nullptr;
+}
+
 void LinearizedControlProblem::add(const hint::Substitution & s)
 {
+  // The tasks whose constraints are used by s cannot be disabled while s is
+  // in the problem.
+  std::vector<TaskWithRequirementsPtr> substitutedTasks;
+  for(const auto & tr : tasks())
+  {
+    auto c = constraintNoThrow(*tr);
+    if(c && std::find(s.constraints().begin(), s.constraints().end(), c) != s.constraints().end())
+    {
+      if(!tr->isEnabled())
+      {
+        throw std::runtime_error("[LinearizedControlProblem::add] A substitution cannot use the constraint of a "
+                                 "disabled task.");
+      }
+      substitutedTasks.push_back(tr);
+    }
+  }
   substitutions_.add(s);
+  for(const auto & tr : substitutedTasks)
+  {
+    ++tr->substitutionUses_;
+    substitutedTasks_[constraint(*tr).get()] = tr;
+  }
   notify({scheme::internal::ProblemDefinitionEvent::Type::SubstitutionAddition, &s});
   needFinalize();
 }
 
 void LinearizedControlProblem::remove(const hint::Substitution & s)
 {
+  for(const auto & c : s.constraints())
+  {
+    auto it = substitutedTasks_.find(c.get());
+    if(it != substitutedTasks_.end())
+    {
+      --it->second->substitutionUses_;
+      substitutedTasks_.erase(it);
+    }
+  }
   substitutions_.remove(s);
   notify({scheme::internal::ProblemDefinitionEvent::Type::SubstitutionRemoval, &s});
   needFinalize();
@@ -86,6 +339,26 @@ void LinearizedControlProblem::remove(const hint::Substitution & s)
 
 const hint::internal::Substitutions & LinearizedControlProblem::substitutions() const { return substitutions_; }
 
+void LinearizedControlProblem::substitutionThreads(int n) { substitutions_.threads(n); }
+
+void LinearizedControlProblem::mergeDoubleSidedTasks(bool merge) { mergeDoubleSided_ = merge; }
+
+int LinearizedControlProblem::taskRows() const
+{
+  int n = 0;
+  for(const auto & t : tasks())
+    n += t->task.function()->size();
+  return n;
+}
+
+int LinearizedControlProblem::constraintRows() const
+{
+  int n = 0;
+  for(const auto & c : constraints_)
+    n += c.second.constraint->size();
+  return n;
+}
+
 void LinearizedControlProblem::removeSubstitutionFor(const constraint::abstract::LinearConstraint & cstr)
 {
   auto s = substitutions_.getSubstitutionFor(cstr);
@@ -125,11 +398,17 @@ std::vector<LinearConstraintWithRequirements> LinearizedControlProblem::constrai
 }
 
 LinearConstraintPtr LinearizedControlProblem::constraint(const TaskWithRequirements & t) const
-{ return constraints_.at(&t).constraint; }
+{
+  auto it = owners_.find(&t);
+  if(it != owners_.end())
+    return constraints_.at(it->second.get()).constraint;
+  return constraints_.at(&t).constraint;
+}
 
 LinearConstraintPtr LinearizedControlProblem::constraintNoThrow(const TaskWithRequirements & t) const
 {
-  auto it = constraints_.find(&t);
+  auto ito = owners_.find(&t);
+  auto it = constraints_.find(ito != owners_.end() ? ito->second.get() : &t);
   if(it != constraints_.end())
     return it->second.constraint;
   else
@@ -138,7 +417,12 @@ LinearConstraintPtr LinearizedControlProblem::constraintNoThrow(const TaskWithRe
 
 const LinearConstraintWithRequirements & LinearizedControlProblem::constraintWithRequirements(
     const TaskWithRequirements & t) const
-{ return constraints_.at(&t); }
+{
+  auto it = owners_.find(&t);
+  if(it != owners_.end())
+    return constraints_.at(it->second.get());
+  return constraints_.at(&t);
+}
 
 std::optional<std::reference_wrapper<const LinearConstraintWithRequirements>>
     LinearizedControlProblem::constraintWithRequirementsNoThrow(const TaskWithRequirements & t) const
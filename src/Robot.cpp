@@ -3,6 +3,7 @@
 #include <tvm/Robot.h>
 
 #include <tvm/Space.h>
+#include <tvm/utils/CloneMap.h>
 
 #include <RBDyn/CoM.h>
 #include <RBDyn/EulerIntegration.h>
@@ -10,6 +11,68 @@
 #include <RBDyn/FK.h>
 #include <RBDyn/FV.h>
 
+#include <algorithm>
+
+namespace
+{
+/** Copy the values of \p ff and \p joints, seen as a single vector, into the
+ * joints' parameters \p param. \p pos gives the position of each joint in the
+ * concatenated vector.
+ */
+void variablesToParam(const tvm::Variable & ff,
+                      const tvm::Variable & joints,
+                      const std::vector<int> & pos,
+                      std::vector<std::vector<double>> & param)
+{
+  const auto ffSize = ff.size();
+  for(size_t i = 0; i < param.size(); ++i)
+  {
+    auto & p = param[i];
+    if(p.empty())
+    {
+      continue;
+    }
+    auto n = static_cast<Eigen::DenseIndex>(p.size());
+    Eigen::Map<Eigen::VectorXd> pi(p.data(), n);
+    if(pos[i] < ffSize)
+    {
+      pi = ff.value().segment(pos[i], n);
+    }
+    else
+    {
+      pi = joints.value().segment(pos[i] - ffSize, n);
+    }
+  }
+}
+
+/** Inverse operation of variablesToParam*/
+void paramToVariables(const std::vector<std::vector<double>> & param,
+                      const std::vector<int> & pos,
+                      tvm::Variable & ff,
+                      tvm::Variable & joints)
+{
+  const auto ffSize = ff.size();
+  for(size_t i = 0; i < param.size(); ++i)
+  {
+    const auto & p = param[i];
+    if(p.empty())
+    {
+      continue;
+    }
+    auto n = static_cast<Eigen::DenseIndex>(p.size());
+    Eigen::Map<const Eigen::VectorXd> pi(p.data(), n);
+    if(pos[i] < ffSize)
+    {
+      ff.set(pos[i], n, pi);
+    }
+    else
+    {
+      joints.set(pos[i] - ffSize, n, pi);
+    }
+  }
+}
+} // namespace
+
 namespace tvm
 {
 
@@ -19,9 +82,9 @@ Robot::Robot(Clock & clock,
              rbd::MultiBody mb,
              rbd::MultiBodyConfig mbc,
              const rbd::parsers::Limits & limits)
-: clock_(clock), last_tick_(clock.ticks()), name_(name), mb_(mb), mbc_(mbc), normalAccB_(mbc_.bodyAccB.size()),
-  fd_(mb_), bodyTransforms_(mbg.bodiesBaseTransform(mb_.body(0).name())),
-  tau_(tvm::Space(mb_.nrDof()).createVariable("tau"))
+: clock_(clock), last_tick_(clock.ticks()), name_(name), mb_(std::make_shared<rbd::MultiBody>(mb)), mbc_(mbc),
+  normalAccB_(mbc_.bodyAccB.size()), fd_(*mb_), bodyTransforms_(mbg.bodiesBaseTransform(mb_->body(0).name())),
+  tau_(tvm::Space(mb_->nrDof()).createVariable("tau"))
 {
   if(mb.nrJoints() > 0 && mb.joint(0).type() == rbd::Joint::Free)
   {
@@ -46,7 +109,7 @@ Robot::Robot(Clock & clock,
   uTauBound_ = -lTauBound_;
   /** Bounds initialization based on provided limits */
   {
-    const auto & jIndexByName = mb_.jointIndexByName();
+    const auto & jIndexByName = mb_->jointIndexByName();
     auto map2bound = [this, &jIndexByName](const std::map<std::string, std::vector<double>> & bound, double mul,
                                            Eigen::VectorXd & out, int ffOffset,
                                            int (rbd::MultiBody::*posMethod)(int) const) {
@@ -57,7 +120,7 @@ Robot::Robot(Clock & clock,
           continue;
         }
         auto jIndex = jIndexByName.at(qi.first);
-        auto pos = (mb_.*posMethod)(jIndex)-ffOffset;
+        auto pos = ((*mb_).*posMethod)(jIndex)-ffOffset;
         for(size_t i = 0; i < qi.second.size(); ++i)
         {
           out(pos + i) = mul * qi.second[i];
@@ -82,6 +145,50 @@ Robot::Robot(Clock & clock,
   dq_.value(Eigen::VectorXd::Zero(dq_.value().size()));
   ddq_.value(Eigen::VectorXd::Zero(ddq_.value().size()));
   tau_->value(Eigen::VectorXd::Zero(tau_->value().size()));
+  zeroAlphaD_ = mbc_.alphaD;
+  for(auto & a : zeroAlphaD_)
+  {
+    std::fill(a.begin(), a.end(), 0.);
+  }
+  registerUpdatesAndDependencies();
+
+  // Compute mass
+  mass_ = 0;
+  for(const auto & b : mb_->bodies())
+  {
+    mass_ += b.inertia().mass();
+  }
+
+  // Make sure initial robot quantities are well initialized
+  updateFK();
+  updateFV();
+  updateFA();
+  updateNormalAcceleration();
+  if(mass_ > 0)
+  {
+    updateCoM();
+  }
+}
+
+Robot::Robot(ClockPtr clock, const Robot & other, utils::CloneMap & map)
+: clock_(*clock), last_tick_(other.last_tick_), name_(other.name_), mass_(other.mass_), mb_(other.mb_),
+  mbc_(other.mbc_), normalAccB_(other.normalAccB_), lQBound_(other.lQBound_), uQBound_(other.uQBound_),
+  lVelBound_(other.lVelBound_), uVelBound_(other.uVelBound_), lTauBound_(other.lTauBound_),
+  uTauBound_(other.uTauBound_), fd_(other.fd_), bodyTransforms_(other.bodyTransforms_),
+  q_ff_(map.variable(other.q_ff_)), q_joints_(map.variable(other.q_joints_)), tau_(map.variable(other.tau_)),
+  com_(other.com_), integration_(other.integration_), zeroAlphaD_(other.zeroAlphaD_), clockOwner_(clock)
+{
+  q_.add(q_ff_);
+  q_.add(q_joints_);
+  dq_ = dot(q_, 1);
+  ddq_ = dot(q_, 2);
+  dq_.value(other.dq_.value());
+  ddq_.value(other.ddq_.value());
+  registerUpdatesAndDependencies();
+}
+
+void Robot::registerUpdatesAndDependencies()
+{
   /** Signals */
   // clang-format off
   registerUpdates(Update::Time, &Robot::updateTimeDependency,
@@ -116,58 +223,55 @@ Robot::Robot(Clock & clock,
   addInternalDependency(Update::C, Update::FV);
   addInternalDependency(Update::FA, Update::FV);
   addInternalDependency(Update::NormalAcceleration, Update::FV);
-
-  // Compute mass
-  mass_ = 0;
-  for(const auto & b : mb_.bodies())
-  {
-    mass_ += b.inertia().mass();
-  }
-
-  // Make sure initial robot quantities are well initialized
-  updateFK();
-  updateFV();
-  updateFA();
-  updateNormalAcceleration();
-  if(mass_ > 0)
-  {
-    updateCoM();
-  }
 }
 
 void Robot::updateTimeDependency()
 {
   if(last_tick_ != clock_.ticks())
   {
-    auto ddq = ddq_.value();
-    rbd::vectorToParam(ddq, mbc_.alphaD);
-    rbd::eulerIntegration(mb_, mbc_, clock_.dt());
-    auto dq = dq_.value();
-    rbd::paramToVector(mbc_.alpha, dq);
-    dq_.value(dq);
-    auto q = q_.value();
-    rbd::paramToVector(mbc_.q, q);
-    q_.value(q);
+    const auto & dq = dq_.variables();
+    const auto & ddq = ddq_.variables();
+    variablesToParam(*ddq[0], *ddq[1], mb_->jointsPosInDof(), mbc_.alphaD);
+    switch(integration_)
+    {
+      case robot::Integration::Euler:
+        rbd::eulerIntegration(*mb_, mbc_, clock_.dt());
+        break;
+      case robot::Integration::SemiImplicitEuler:
+        for(int i = 0; i < mb_->nrJoints(); ++i)
+        {
+          auto & alpha = mbc_.alpha[i];
+          const auto & alphaD = mbc_.alphaD[i];
+          for(size_t j = 0; j < alpha.size(); ++j)
+          {
+            alpha[j] += alphaD[j] * clock_.dt();
+          }
+          rbd::eulerJointIntegration(mb_->joint(i).type(), alpha, zeroAlphaD_[i], clock_.dt(), mbc_.q[i]);
+        }
+        break;
+    }
+    paramToVariables(mbc_.alpha, mb_->jointsPosInDof(), *dq[0], *dq[1]);
+    paramToVariables(mbc_.q, mb_->jointsPosInParam(), *q_ff_, *q_joints_);
     last_tick_ = clock_.ticks();
   }
 }
 
-void Robot::updateFK() { rbd::forwardKinematics(mb_, mbc_); }
+void Robot::updateFK() { rbd::forwardKinematics(*mb_, mbc_); }
 
-void Robot::updateFV() { rbd::forwardVelocity(mb_, mbc_); }
+void Robot::updateFV() { rbd::forwardVelocity(*mb_, mbc_); }
 
-void Robot::updateFA() { rbd::forwardAcceleration(mb_, mbc_); }
+void Robot::updateFA() { rbd::forwardAcceleration(*mb_, mbc_); }
 
 void Robot::updateNormalAcceleration() { computeNormalAccB(); }
 
 void Robot::computeNormalAccB()
 {
   // No need to compute that if the robot is not actuated
-  if(mb_.nrDof() > 0)
+  if(mb_->nrDof() > 0)
   {
-    const auto & pred = mb_.predecessors();
-    const auto & succ = mb_.successors();
-    for(int i = 0; i < mb_.nrJoints(); ++i)
+    const auto & pred = mb_->predecessors();
+    const auto & succ = mb_->successors();
+    for(int i = 0; i < mb_->nrJoints(); ++i)
     {
       const auto & X_p_i = mbc_.parentToSon[i];
       const auto & vj_i = mbc_.jointVelocity[i];
@@ -184,10 +288,50 @@ void Robot::computeNormalAccB()
   }
 }
 
-void Robot::updateH() { fd_.computeH(mb_, mbc_); }
+void Robot::updateH() { fd_.computeH(*mb_, mbc_); }
+
+std::vector<int> Robot::dofParents() const
+{
+  std::vector<int> parents(static_cast<size_t>(mb_->nrDof()), -1);
+  // Last dof of each joint, or of its closest ancestor having a dof
+  std::vector<int> lastDof(static_cast<size_t>(mb_->nrJoints()), -1);
+  for(int i = 0; i < mb_->nrJoints(); ++i)
+  {
+    int p = mb_->parent(i);
+    int prev = p < 0 ? -1 : lastDof[static_cast<size_t>(p)];
+    int start = mb_->jointPosInDof(i);
+    for(int k = 0; k < mb_->joint(i).dof(); ++k)
+    {
+      parents[static_cast<size_t>(start + k)] = prev;
+      prev = start + k;
+    }
+    lastDof[static_cast<size_t>(i)] = prev;
+  }
+  return parents;
+}
+
+void Robot::updateC() { fd_.computeC(*mb_, mbc_); }
+
+void Robot::updateCoM() { com_ = rbd::computeCoM(*mb_, mbc_); }
+
+namespace utils
+{
 
-void Robot::updateC() { fd_.computeC(mb_, mbc_); }
+RobotPtr CloneMap::robot(const RobotPtr & r)
+{
+  auto it = robots_.find(r.get());
+  if(it != robots_.end())
+  {
+    return it->second;
+  }
+
+  clock(r->clock_);
+  RobotPtr c(new Robot(clocks_.at(&r->clock_), *r, *this));
+  robots_[r.get()] = c;
+  source(*r, *c);
+  return c;
+}
 
-void Robot::updateCoM() { com_ = rbd::computeCoM(mb_, mbc_); }
+} // namespace utils
 
 } // namespace tvm
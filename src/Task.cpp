@@ -3,8 +3,27 @@
 #include <tvm/Task.h>
 
 #include <tvm/task_dynamics/abstract/TaskDynamics.h>
+#include <tvm/utils/CloneMap.h>
 
 #include <stdexcept>
+#include <typeinfo>
+
+namespace
+{
+tvm::TaskDynamicsPtr cloneTaskDynamics(const tvm::TaskDynamicsPtr & td, tvm::FunctionPtr f, tvm::utils::CloneMap & map)
+{
+  if(!td)
+    return nullptr;
+  tvm::TaskDynamicsPtr c = td->clone(f, map);
+  if(!c || typeid(*c) != typeid(*td))
+  {
+    throw std::runtime_error(std::string("[Task::clone] Task dynamics of type ") + typeid(*td).name()
+                             + " cannot be cloned.");
+  }
+  map.source(*td, *c);
+  return c;
+}
+} // namespace
 
 namespace tvm
 {
@@ -70,6 +89,16 @@ Task::Task(utils::ProtoTaskDS proto, const task_dynamics::abstract::TaskDynamics
        proto.u_.toVector(proto.f_->size()))
 {}
 
+Task::Task(FunctionPtr f, constraint::Type t, TaskDynamicsPtr td, TaskDynamicsPtr td2)
+: f_(f), type_(t), td_(td), td2_(td2)
+{}
+
+Task Task::clone(utils::CloneMap & map) const
+{
+  auto f = map.function(f_);
+  return {f, type_, cloneTaskDynamics(td_, f, map), cloneTaskDynamics(td2_, f, map)};
+}
+
 FunctionPtr Task::function() const { return f_; }
 
 constraint::Type Task::type() const { return type_; }
@@ -6,9 +6,9 @@
 
 namespace tvm
 {
-int VariableVector::counter = 0;
+std::atomic<int> VariableVector::counter{0};
 
-VariableVector::VariableVector() : size_(0) { getNewStamp(); }
+VariableVector::VariableVector() : size_(0), starts_(1, 0) { getNewStamp(); }
 
 VariableVector::VariableVector(const VariableVector & other) : VariableVector(other.variables()) {}
 
@@ -115,6 +115,7 @@ void VariableVector::clear()
     v->startIn_.erase(id());
   variables_.clear();
   size_ = 0;
+  starts_.assign(1, 0);
   getNewStamp();
 }
 
@@ -210,6 +211,7 @@ void VariableVector::add_(VariablePtr v)
   variables_.push_back(v);
   v->startIn_[id()] = {size_, -1}; // Variables added directly to the vector do no need a stamp
   size_ += v->size();
+  starts_.push_back(size_);
   getNewStamp();
 }
 
@@ -218,6 +220,9 @@ void VariableVector::remove_(std::vector<VariablePtr>::const_iterator it)
   int si = (*it)->size();
   for(auto iti = it + 1; iti != end(); ++iti)
     (*iti)->startIn_[id()].start -= si;
+  auto k = starts_.erase(starts_.begin() + (it - variables_.begin()) + 1);
+  for(; k != starts_.end(); ++k)
+    *k -= si;
   size_ -= si;
   (*it)->startIn_.erase(id());
   variables_.erase(it);
@@ -226,8 +231,7 @@ void VariableVector::remove_(std::vector<VariablePtr>::const_iterator it)
 
 void VariableVector::getNewStamp() const
 {
-  stamp_ = counter;
-  counter++;
+  stamp_ = counter.fetch_add(1);
 }
 
 VariableVector TVM_DLLAPI dot(const VariableVector & vars, int ndiff)
@@ -6,6 +6,8 @@
 #include <tvm/function/abstract/Function.h>
 #include <tvm/task_dynamics/abstract/TaskDynamics.h>
 
+#include <limits>
+
 namespace tvm
 {
 
@@ -19,10 +21,34 @@ LinearizedTaskConstraint::LinearizedTaskConstraint(const Task & task)
 : LinearConstraint(task.type(), constraint::RHS::AS_GIVEN, task.function()->size()), f_(task.function()),
   td_(task.taskDynamics())
 {
-  assert(f_->imageSpace().isEuclidean());
   if(type() == constraint::Type::DOUBLE_SIDED)
   {
     td2_ = task.secondBoundTaskDynamics();
+  }
+  build();
+}
+
+LinearizedTaskConstraint::LinearizedTaskConstraint(const Task & lower, const Task & upper)
+: LinearConstraint(constraint::Type::DOUBLE_SIDED, constraint::RHS::AS_GIVEN, lower.function()->size()),
+  f_(lower.function()), td_(lower.taskDynamics()), td2_(upper.taskDynamics())
+{
+  if(lower.type() != constraint::Type::GREATER_THAN || upper.type() != constraint::Type::LOWER_THAN)
+  {
+    throw std::runtime_error("[LinearizedTaskConstraint] The lower task must be of type GREATER_THAN and the upper "
+                             "task of type LOWER_THAN.");
+  }
+  if(lower.function() != upper.function())
+  {
+    throw std::runtime_error("[LinearizedTaskConstraint] Both tasks must be on the same function.");
+  }
+  build();
+}
+
+void LinearizedTaskConstraint::build()
+{
+  assert(f_->imageSpace().isEuclidean());
+  if(type() == constraint::Type::DOUBLE_SIDED)
+  {
     if(td_->order() != td2_->order())
     {
       throw std::runtime_error("For double-sided task, the dynamic of both sides must have the same order.");
@@ -34,7 +60,7 @@ LinearizedTaskConstraint::LinearizedTaskConstraint(const Task & task)
   void (LTC::*kin)();
   void (LTC::*dyn)();
 
-  switch(task.type())
+  switch(type())
   {
     case constraint::Type::GREATER_THAN:
       output = Constraint::Output::L;
@@ -128,21 +154,69 @@ LinearizedTaskConstraint::LinearizedTaskConstraint(const Task & task)
   }
 }
 
-void LinearizedTaskConstraint::updateLKin() { lRef() = td_->value(); }
+void LinearizedTaskConstraint::updateLKin()
+{
+  if(!isEnabled())
+    return;
+  if(isLowerEnabled())
+    lRef() = td_->value();
+  else
+    lRef().setConstant(-std::numeric_limits<double>::infinity());
+}
 
-void LinearizedTaskConstraint::updateLDyn() { lRef() = td_->value() - f_->normalAcceleration(); }
+void LinearizedTaskConstraint::updateLDyn()
+{
+  if(!isEnabled())
+    return;
+  if(isLowerEnabled())
+    lRef() = td_->value() - f_->normalAcceleration();
+  else
+    lRef().setConstant(-std::numeric_limits<double>::infinity());
+}
 
-void LinearizedTaskConstraint::updateUKin() { uRef() = td_->value(); }
+void LinearizedTaskConstraint::updateUKin()
+{
+  if(isEnabled())
+    uRef() = td_->value();
+}
 
-void LinearizedTaskConstraint::updateUDyn() { uRef() = td_->value() - f_->normalAcceleration(); }
+void LinearizedTaskConstraint::updateUDyn()
+{
+  if(isEnabled())
+    uRef() = td_->value() - f_->normalAcceleration();
+}
 
-void LinearizedTaskConstraint::updateEKin() { eRef() = td_->value(); }
+void LinearizedTaskConstraint::updateEKin()
+{
+  if(isEnabled())
+    eRef() = td_->value();
+}
 
-void LinearizedTaskConstraint::updateEDyn() { eRef() = td_->value() - f_->normalAcceleration(); }
+void LinearizedTaskConstraint::updateEDyn()
+{
+  if(isEnabled())
+    eRef() = td_->value() - f_->normalAcceleration();
+}
 
-void LinearizedTaskConstraint::updateU2Kin() { uRef() = td2_->value(); }
+void LinearizedTaskConstraint::updateU2Kin()
+{
+  if(!isEnabled())
+    return;
+  if(isUpperEnabled())
+    uRef() = td2_->value();
+  else
+    uRef().setConstant(std::numeric_limits<double>::infinity());
+}
 
-void LinearizedTaskConstraint::updateU2Dyn() { uRef() = td2_->value() - f_->normalAcceleration(); }
+void LinearizedTaskConstraint::updateU2Dyn()
+{
+  if(!isEnabled())
+    return;
+  if(isUpperEnabled())
+    uRef() = td2_->value() - f_->normalAcceleration();
+  else
+    uRef().setConstant(std::numeric_limits<double>::infinity());
+}
 
 tvm::internal::MatrixConstRefWithProperties LinearizedTaskConstraint::jacobian(const Variable & x) const
 {
@@ -162,6 +236,40 @@ tvm::internal::MatrixConstRefWithProperties LinearizedTaskConstraint::jacobian(c
   }
 }
 
+tvm::internal::MatrixConstRefWithProperties LinearizedTaskConstraint::jacobianAt(int i) const
+{
+  assert(f_->variables().numberOfVariables() == variables().numberOfVariables());
+  return f_->jacobianAt(i);
+}
+
+bool LinearizedTaskConstraint::jacobianParentArray(const std::vector<VariablePtr> & x,
+                                                   std::vector<int> & lambda) const
+{
+  int order;
+  switch(td_->order())
+  {
+    case task_dynamics::Order::Zero:
+      return f_->jacobianParentArray(x, lambda);
+    case task_dynamics::Order::One:
+      order = 1;
+      break;
+    case task_dynamics::Order::Two:
+      order = 2;
+      break;
+    default:
+      throw std::runtime_error("Unimplemented case.");
+  }
+  std::vector<VariablePtr> primitives;
+  primitives.reserve(x.size());
+  for(const auto & xi : x)
+  {
+    if(xi->derivativeNumber() < order)
+      return false;
+    primitives.push_back(order == 1 ? xi->primitive() : xi->primitive<2>());
+  }
+  return f_->jacobianParentArray(primitives, lambda);
+}
+
 } // namespace internal
 
 } // namespace constraint
@@ -1,6 +1,7 @@
 /** Copyright 2017-2021 CNRS-AIST JRL and CNRS-UM LIRMM */
 
 #include <tvm/diagnostic/GraphProbe.h>
+#include <tvm/diagnostic/ProbeSubscription.h>
 #include <tvm/diagnostic/internal/details.h>
 
 #include <iomanip>
@@ -152,6 +153,59 @@ std::vector<std::unique_ptr<GraphProbe::ProbeNode>> GraphProbe::followUp(
   return ret;
 }
 
+std::unique_ptr<ProbeSubscription> GraphProbe::subscribe(const std::vector<Output> & outputs,
+                                                        int capacity,
+                                                        int period,
+                                                        bool verbose) const
+{
+  std::unique_ptr<ProbeSubscription> sub(new ProbeSubscription(capacity, period));
+  for(const auto & o : outputs)
+  {
+    // Same lookup order as in addOutputVal
+    auto owner = o.owner.value;
+    auto it = outputCopy_.find({log_.getPromotedType(o.owner).hash_code(), o.id});
+    if(it == outputCopy_.end())
+      it = outputCopy_.find({o.owner.type.hash_code(), o.id});
+    if(it != outputCopy_.end())
+    {
+      // The current value gives the size
+      auto M = outputAccessor_.at(it->first)(owner);
+      sub->addEntry(o, nullptr, M.rows(), M.cols(),
+                    [copy = it->second, owner](Eigen::Ref<Eigen::MatrixXd> out) { return copy(owner, out); });
+      continue;
+    }
+    auto itv = varDepOutputCopy_.find({log_.getPromotedType(o.owner).hash_code(), o.id});
+    if(itv == varDepOutputCopy_.end())
+      itv = varDepOutputCopy_.find({o.owner.type.hash_code(), o.id});
+    if(itv != varDepOutputCopy_.end())
+    {
+      for(const auto & p : varDepOutputAccessor_.at(itv->first)(owner))
+      {
+        sub->addEntry(o, p.first, p.second.rows(), p.second.cols(),
+                      [copy = itv->second, owner, var = p.first.get()](Eigen::Ref<Eigen::MatrixXd> out) {
+                        return copy(owner, *var, out);
+                      });
+      }
+      continue;
+    }
+    if(verbose)
+    {
+      std::cout << "No function to retrieve output" << o.name << " for " << log_.getPromotedType(o.owner).name()
+                << "\n";
+    }
+  }
+  sub->allocate();
+  return sub;
+}
+
+std::unique_ptr<ProbeSubscription> GraphProbe::subscribe(const graph::CallGraph * const g,
+                                                        int capacity,
+                                                        int period,
+                                                        bool verbose) const
+{
+  return subscribe(log_.subGraph(g).first, capacity, period, verbose);
+}
+
 void GraphProbe::print(std::ostream & os, const std::unique_ptr<ProbeNode> & node) const { print(os, node, 0); }
 
 void GraphProbe::print(std::ostream & os, const std::vector<std::unique_ptr<ProbeNode>> & roots) const
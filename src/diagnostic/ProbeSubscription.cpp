@@ -0,0 +1,75 @@
+/** Copyright 2017-2021 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/diagnostic/ProbeSubscription.h>
+
+#include <limits>
+#include <stdexcept>
+
+namespace tvm::diagnostic
+{
+ProbeSubscription::ProbeSubscription(int capacity, int period) : capacity_(capacity), period_(period)
+{
+  if(capacity < 1)
+    throw std::runtime_error("[ProbeSubscription]: the capacity must be at least 1.");
+  if(period < 1)
+    throw std::runtime_error("[ProbeSubscription]: the period must be at least 1.");
+}
+
+void ProbeSubscription::addEntry(const GraphProbe::Output & o,
+                                 VariablePtr var,
+                                 Eigen::DenseIndex rows,
+                                 Eigen::DenseIndex cols,
+                                 CopyFunction copy)
+{
+  entries_.push_back({o, var, rows, cols, size_});
+  copies_.push_back(std::move(copy));
+  size_ += rows * cols;
+}
+
+void ProbeSubscription::allocate()
+{
+  buffer_.resize(size_, capacity_);
+  indices_.resize(static_cast<size_t>(capacity_));
+}
+
+bool ProbeSubscription::sample()
+{
+  uint64_t call = calls_++;
+  if(call % static_cast<uint64_t>(period_) != 0)
+    return false;
+
+  uint64_t h = head_.load(std::memory_order_relaxed);
+  if(h - tail_.load(std::memory_order_acquire) == static_cast<uint64_t>(capacity_))
+  {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  auto slot = static_cast<Eigen::DenseIndex>(h % static_cast<uint64_t>(capacity_));
+  auto col = buffer_.col(slot);
+  for(size_t i = 0; i < entries_.size(); ++i)
+  {
+    const auto & e = entries_[i];
+    Eigen::Map<Eigen::MatrixXd> M(col.data() + e.offset, e.rows, e.cols);
+    if(!copies_[i](M))
+      M.setConstant(std::numeric_limits<double>::quiet_NaN());
+  }
+  indices_[static_cast<size_t>(slot)] = call;
+  head_.store(h + 1, std::memory_order_release);
+  return true;
+}
+
+bool ProbeSubscription::next(Sample & s)
+{
+  uint64_t t = tail_.load(std::memory_order_relaxed);
+  if(t == head_.load(std::memory_order_acquire))
+    return false;
+
+  auto slot = static_cast<Eigen::DenseIndex>(t % static_cast<uint64_t>(capacity_));
+  s.index = indices_[static_cast<size_t>(slot)];
+  s.data = buffer_.col(slot);
+  tail_.store(t + 1, std::memory_order_release);
+  return true;
+}
+
+} // namespace tvm::diagnostic
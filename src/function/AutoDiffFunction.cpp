@@ -0,0 +1,191 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/function/abstract/AutoDiffFunction.h>
+
+#include <tvm/Variable.h>
+
+namespace tvm
+{
+
+namespace function
+{
+
+namespace abstract
+{
+
+namespace
+{
+template<typename T>
+void resizeInputs(AutoDiffFunctionBase::Inputs<T> & x, const std::vector<VariablePtr> & vars)
+{
+  x.resize(vars.size());
+  for(size_t i = 0; i < vars.size(); ++i)
+    x[i].resize(vars[i]->size());
+}
+} // namespace
+
+AutoDiffFunctionBase::AutoDiffFunctionBase(int m, const std::vector<VariablePtr> & x) : Function(m)
+{
+  // clang-format off
+  registerUpdates(Update::Value, &AutoDiffFunctionBase::updateValue,
+                  Update::Jacobian, &AutoDiffFunctionBase::updateJacobian,
+                  Update::Velocity, &AutoDiffFunctionBase::updateVelocity,
+                  Update::NormalAcceleration, &AutoDiffFunctionBase::updateNormalAcceleration,
+                  Update::JDot, &AutoDiffFunctionBase::updateJDot);
+  // clang-format on
+  addOutputDependency<AutoDiffFunctionBase>(Output::Value, Update::Value);
+  addOutputDependency<AutoDiffFunctionBase>(Output::Jacobian, Update::Jacobian);
+  addOutputDependency<AutoDiffFunctionBase>(Output::Velocity, Update::Velocity);
+  addOutputDependency<AutoDiffFunctionBase>(Output::NormalAcceleration, Update::NormalAcceleration);
+  addOutputDependency<AutoDiffFunctionBase>(Output::JDot, Update::JDot);
+
+  for(const auto & v : x)
+  {
+    if(!v->space().isEuclidean())
+    {
+      throw std::runtime_error("[AutoDiffFunctionBase] Automatic differentiation is only for Euclidean variables.");
+    }
+    addVariable(v, false);
+  }
+  const auto & vars = variables().variables();
+  for(size_t i = 0; i < vars.size(); ++i)
+  {
+    dx_.push_back(dot(vars[i]));
+    for(int j = 0; j < vars[i]->size(); ++j)
+      columns_.emplace_back(static_cast<int>(i), j);
+  }
+
+  resizeInputs(x_, vars);
+  resizeInputs(x1_, vars);
+  resizeInputs(xN_, vars);
+  resizeInputs(x11_, vars);
+  resizeInputs(xN1_, vars);
+  f1_.resize(m);
+  fN_.resize(m);
+  f11_.resize(m);
+  fN1_.resize(m);
+}
+
+void AutoDiffFunctionBase::updateValue()
+{
+  for(size_t i = 0; i < x_.size(); ++i)
+    x_[i] = variables()[static_cast<int>(i)]->value();
+  evaluate_(x_, value_);
+}
+
+void AutoDiffFunctionBase::updateJacobian()
+{
+  // The jacobian is computed Lanes columns at a time: the derivatives of the
+  // inputs are the unit vectors for the columns of the current chunk.
+  for(size_t i = 0; i < xN_.size(); ++i)
+  {
+    const auto & xi = variables()[static_cast<int>(i)]->value();
+    for(Eigen::Index k = 0; k < xi.size(); ++k)
+      xN_[i][k] = xi[k];
+  }
+  const auto n = static_cast<int>(columns_.size());
+  for(int c = 0; c < n; c += Lanes)
+  {
+    for(int j = 0; j < Lanes; ++j)
+    {
+      if(c > 0)
+      {
+        const auto & prev = columns_[static_cast<size_t>(c - Lanes + j)];
+        xN_[static_cast<size_t>(prev.first)][prev.second].d[j] = 0;
+      }
+      if(c + j < n)
+      {
+        const auto & col = columns_[static_cast<size_t>(c + j)];
+        xN_[static_cast<size_t>(col.first)][col.second].d[j] = 1;
+      }
+    }
+    evaluate_(xN_, fN_);
+    for(int j = 0; j < Lanes && c + j < n; ++j)
+    {
+      const auto & col = columns_[static_cast<size_t>(c + j)];
+      auto & J = jacobian_.at(variables()[col.first].get());
+      for(int r = 0; r < size(); ++r)
+        J(r, col.second) = fN_[r].d[j];
+    }
+  }
+}
+
+void AutoDiffFunctionBase::updateVelocity()
+{
+  for(size_t i = 0; i < x1_.size(); ++i)
+  {
+    const auto & xi = variables()[static_cast<int>(i)]->value();
+    const auto & dxi = dx_[i]->value();
+    for(Eigen::Index k = 0; k < xi.size(); ++k)
+    {
+      x1_[i][k].v = xi[k];
+      x1_[i][k].d[0] = dxi[k];
+    }
+  }
+  evaluate_(x1_, f1_);
+  for(int r = 0; r < size(); ++r)
+    velocity_[r] = f1_[r].d[0];
+}
+
+void AutoDiffFunctionBase::updateNormalAcceleration()
+{
+  // With x + dx e1 + dx e2, the coefficient of e1 e2 is dx^T H dx = JDot dx.
+  for(size_t i = 0; i < x11_.size(); ++i)
+  {
+    const auto & xi = variables()[static_cast<int>(i)]->value();
+    const auto & dxi = dx_[i]->value();
+    for(Eigen::Index k = 0; k < xi.size(); ++k)
+    {
+      x11_[i][k].v.v = xi[k];
+      x11_[i][k].v.d[0] = dxi[k];
+      x11_[i][k].d[0].v = dxi[k];
+    }
+  }
+  evaluate_(x11_, f11_);
+  for(int r = 0; r < size(); ++r)
+    normalAcceleration_[r] = f11_[r].d[0].d[0];
+}
+
+void AutoDiffFunctionBase::updateJDot()
+{
+  // Same as the jacobian computation, with the inner dual numbers seeded by
+  // dx, so that the e1 e2 coefficients of the outputs are the columns of JDot.
+  for(size_t i = 0; i < xN1_.size(); ++i)
+  {
+    const auto & xi = variables()[static_cast<int>(i)]->value();
+    const auto & dxi = dx_[i]->value();
+    for(Eigen::Index k = 0; k < xi.size(); ++k)
+      xN1_[i][k] = Dual1(xi[k], Dual1::Lanes::Constant(dxi[k]));
+  }
+  const auto n = static_cast<int>(columns_.size());
+  for(int c = 0; c < n; c += Lanes)
+  {
+    for(int j = 0; j < Lanes; ++j)
+    {
+      if(c > 0)
+      {
+        const auto & prev = columns_[static_cast<size_t>(c - Lanes + j)];
+        xN1_[static_cast<size_t>(prev.first)][prev.second].d[j].v = 0;
+      }
+      if(c + j < n)
+      {
+        const auto & col = columns_[static_cast<size_t>(c + j)];
+        xN1_[static_cast<size_t>(col.first)][col.second].d[j].v = 1;
+      }
+    }
+    evaluate_(xN1_, fN1_);
+    for(int j = 0; j < Lanes && c + j < n; ++j)
+    {
+      const auto & col = columns_[static_cast<size_t>(c + j)];
+      auto & JDot = JDot_.at(variables()[col.first].get());
+      for(int r = 0; r < size(); ++r)
+        JDot(r, col.second) = fN1_[r].d[j].d[0];
+    }
+  }
+}
+
+} // namespace abstract
+
+} // namespace function
+
+} // namespace tvm
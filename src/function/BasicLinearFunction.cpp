@@ -3,6 +3,7 @@
 #include <tvm/function/BasicLinearFunction.h>
 
 #include <tvm/Variable.h>
+#include <tvm/utils/CloneMap.h>
 
 namespace tvm
 {
@@ -82,6 +83,22 @@ void BasicLinearFunction::b(const VectorConstRef & b, const tvm::internal::Matri
     throw std::runtime_error("Vector b doesn't have the correct size.");
 }
 
+FunctionPtr BasicLinearFunction::clone(utils::CloneMap & map) const
+{
+  const auto & vars = variables();
+  std::vector<VariablePtr> x;
+  for(const auto & v : vars)
+    x.push_back(map.variable(v));
+  auto f = std::make_shared<BasicLinearFunction>(size(), x);
+  for(int i = 0; i < vars.numberOfVariables(); ++i)
+  {
+    auto J = jacobian(*vars[i]);
+    f->A(J, *x[static_cast<size_t>(i)], J.properties());
+  }
+  f->b(b(), b().properties());
+  return f;
+}
+
 } // namespace function
 
 } // namespace tvm
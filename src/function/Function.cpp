@@ -22,6 +22,9 @@ Function::Function(Space image) : FirstOrderProvider(std::move(image))
   resizeJDotCache();
 }
 
+FunctionPtr Function::clone(utils::CloneMap &) const
+{ throw std::runtime_error("[Function::clone] This function does not support cloning."); }
+
 void Function::resizeCache()
 {
   FirstOrderProvider::resizeCache();
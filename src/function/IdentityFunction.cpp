@@ -3,6 +3,7 @@
 #include <tvm/function/IdentityFunction.h>
 
 #include <tvm/Variable.h>
+#include <tvm/utils/CloneMap.h>
 
 namespace tvm
 {
@@ -14,6 +15,9 @@ IdentityFunction::IdentityFunction(VariablePtr x)
 : BasicLinearFunction(Eigen::MatrixXd::Identity(x->size(), x->size()), x)
 { jacobian_.begin()->second.properties({tvm::internal::MatrixProperties::Shape::IDENTITY}); }
 
+FunctionPtr IdentityFunction::clone(utils::CloneMap & map) const
+{ return std::make_shared<IdentityFunction>(map.variable(variables()[0])); }
+
 void IdentityFunction::A(const MatrixConstRef &, const Variable &, const tvm::internal::MatrixProperties &)
 { throw std::runtime_error("You can not change the A matrix on a identity function"); }
 
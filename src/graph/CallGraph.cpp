@@ -37,6 +37,44 @@ void CallGraph::clear()
   plan_.clear();
 }
 
+bool CallGraph::copy(const CallGraph & other,
+                     std::shared_ptr<internal::Inputs> inputs,
+                     const std::function<abstract::Outputs *(const abstract::Outputs *)> & map)
+{
+  clear();
+  inputs_.clear();
+
+  calls_.reserve(other.calls_.size());
+  for(const auto & c : other.calls_)
+  {
+    auto node = map(c.node);
+    if(!node)
+    {
+      clear();
+      return false;
+    }
+    Call cc = {static_cast<internal::AbstractNode *>(node), c.id};
+    callId_[cc] = static_cast<int>(calls_.size());
+    calls_.push_back(cc);
+  }
+  for(const auto & v : other.visited_)
+  {
+    auto source = map(reinterpret_cast<const abstract::Outputs *>(v.first));
+    if(!source)
+    {
+      clear();
+      return false;
+    }
+    visited_[reinterpret_cast<std::intptr_t>(source)] = v.second;
+  }
+  dependencyGraph_ = other.dependencyGraph_;
+  plan_.copy(other.plan_, other, calls_);
+
+  inputs_.push_back(inputs);
+  TVM_GRAPH_LOG_ADD_GRAPH_OUTPUTS(this, inputs)
+  return true;
+}
+
 std::vector<int> CallGraph::addOutput(abstract::Outputs * source, int output)
 {
   std::intptr_t ptr = reinterpret_cast<std::intptr_t>(source);
@@ -116,6 +154,38 @@ void CallGraph::Plan::build(const CallGraph & graph)
 
 void CallGraph::Plan::clear() { plan_.clear(); }
 
+void CallGraph::Plan::copy(const Plan & other, const CallGraph & graph, const std::vector<Call> & calls)
+{
+  plan_.clear();
+  plan_.reserve(other.plan_.size());
+  for(const auto & c : other.plan_)
+  {
+    plan_.push_back(calls[static_cast<size_t>(graph.callId_.at(c))]);
+  }
+}
+
+void CallGraph::Plan::executeTraced() const
+{
+  auto & tracer = utils::Tracer::tracer();
+  // The end of a call is taken as the start of the next one, so as to read the
+  // clock only once per call.
+  int64_t start = utils::Tracer::now();
+  for(auto & c : plan_)
+  {
+    // Updates skipped because of their period are not recorded
+    if(!c.node->isUpdateDue(c.id))
+    {
+      continue;
+    }
+    c.node->update(c.id);
+    int64_t end = utils::Tracer::now();
+    // The graph log identifies the nodes by the address of their most derived object.
+    auto object = reinterpret_cast<std::uintptr_t>(dynamic_cast<const void *>(c.node));
+    tracer.record(nullptr, object, c.id, start, end);
+    start = end;
+  }
+}
+
 } // namespace graph
 
 } // namespace tvm
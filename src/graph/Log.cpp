@@ -605,6 +605,11 @@ const std::type_index & Log::getPromotedType(const Pointer & p) const
     return p.type;
 }
 
+std::string Log::readableName(const Update & update) const
+{
+  return demangle(getPromotedType(update.owner).name(), true) + "::" + update.name;
+}
+
 std::pair<std::vector<Log::Output>, std::vector<Log::Update>> Log::followUpDependency(
     const std::vector<Output> & allOutputs,
     const std::vector<Output> & startingPoints) const
@@ -28,6 +28,7 @@ void Logger::addGraphOutput(CallGraph * g, Inputs * node)
   if(disabled_)
     return;
 
+  std::lock_guard<std::mutex> lock(mutex_);
   log_.graphOutputs_[g].push_back(node);
 }
 
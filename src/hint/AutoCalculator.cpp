@@ -4,6 +4,7 @@
 #include <tvm/hint/internal/AutoCalculator.h>
 #include <tvm/hint/internal/DiagonalCalculator.h>
 #include <tvm/hint/internal/GenericCalculator.h>
+#include <tvm/hint/internal/LTDLCalculator.h>
 
 namespace tvm
 {
@@ -19,7 +20,24 @@ std::unique_ptr<abstract::SubstitutionCalculatorImpl> AutoCalculator::impl_(
     const std::vector<VariablePtr> & x,
     int rank) const
 {
-  if(cstr.size() > 1 || x.size() > 1)
+  if(cstr.size() > 1)
+  {
+    return GenericCalculator().impl(cstr, x, rank);
+  }
+  std::vector<int> lambda;
+  if(cstr[0]->jacobianParentArray(x, lambda))
+  {
+    int n = 0;
+    for(const auto & xi : x)
+    {
+      n += xi->space().tSize();
+    }
+    if(cstr[0]->tSize() == n && rank == n)
+    {
+      return LTDLCalculator(lambda).impl(cstr, x, rank);
+    }
+  }
+  if(x.size() > 1)
   {
     return GenericCalculator().impl(cstr, x, rank);
   }
@@ -31,6 +49,10 @@ std::unique_ptr<abstract::SubstitutionCalculatorImpl> AutoCalculator::impl_(
     {
       return DiagonalCalculator().impl(cstr, x, rank);
     }
+    if(p.isPositiveDefinite() && jac.rows() == jac.cols() && rank == jac.rows())
+    {
+      return LTDLCalculator().impl(cstr, x, rank);
+    }
     return GenericCalculator().impl(cstr, x, rank);
   }
 }
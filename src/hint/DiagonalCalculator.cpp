@@ -186,9 +186,24 @@ DiagonalCalculator::Impl::Impl(const std::vector<LinearConstraintPtr> & cstr,
   build();
 }
 
+std::unique_ptr<abstract::SubstitutionCalculatorImpl> DiagonalCalculator::Impl::clone(
+    const std::vector<LinearConstraintPtr> & cstr,
+    const std::vector<VariablePtr> & x) const
+{
+  if(first_ >= 0)
+  {
+    return std::unique_ptr<abstract::SubstitutionCalculatorImpl>(
+        new Impl(cstr, x, static_cast<int>(r()), first_, size_));
+  }
+  else
+  {
+    return std::unique_ptr<abstract::SubstitutionCalculatorImpl>(new Impl(cstr, x, static_cast<int>(r()), nnz_, zeros_));
+  }
+}
+
 void DiagonalCalculator::Impl::update_()
 {
-  auto A = constraints_[0]->jacobian(*variables_[0]);
+  auto A = this->A();
   for(size_t i = 0; i < nnz_.size(); ++i)
   {
     inverse_[static_cast<DenseIndex>(i)] = 1. / A(innz_[i], nnz_[i]);
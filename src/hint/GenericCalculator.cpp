@@ -25,14 +25,27 @@ std::unique_ptr<abstract::SubstitutionCalculatorImpl> GenericCalculator::impl_(
 GenericCalculator::Impl::Impl(const std::vector<LinearConstraintPtr> & cstr,
                               const std::vector<VariablePtr> & x,
                               int rank)
-: SubstitutionCalculatorImpl(cstr, x, rank), qr_(m(), n()), invR1R2_(r(), n() - r()), tmp_(m(), 2 * n())
-{}
+: SubstitutionCalculatorImpl(cstr, x, rank), qr_(m(), n()), invR1R2_(r(), n() - r()), tmp_(m(), 2 * n()),
+  explicit_(false)
+{
+  if(constant())
+  {
+    Asharp_.resize(n(), m());
+    St_.resize(m() - r(), m());
+    Im_.setIdentity(m(), m());
+  }
+}
+
+std::unique_ptr<abstract::SubstitutionCalculatorImpl> GenericCalculator::Impl::clone(
+    const std::vector<LinearConstraintPtr> & cstr,
+    const std::vector<VariablePtr> & x) const
+{ return std::unique_ptr<abstract::SubstitutionCalculatorImpl>(new Impl(cstr, x, static_cast<int>(r()))); }
 
 void GenericCalculator::Impl::update_()
 {
   if(isSimple())
   {
-    qr_.compute(constraints_.front()->jacobian(*variables_[0]));
+    qr_.compute(A());
   }
   else
   {
@@ -81,6 +94,15 @@ void GenericCalculator::Impl::update_()
     N_.row(P.coeff(i)).setZero();
     N_(P.coeff(i), i - r()) = 1;
   }
+
+  // For a constant A, this update is only performed once (or when A is
+  // explicitly changed), so that forming A^# and S^T is worth it.
+  explicit_ = false;
+  if(constant())
+  {
+    premultiplyByASharpAndSTranspose_(Asharp_, St_, Im_, false);
+    explicit_ = true;
+  }
 }
 
 void GenericCalculator::Impl::premultiplyByASharpAndSTranspose_(MatrixRef outA,
@@ -88,6 +110,20 @@ void GenericCalculator::Impl::premultiplyByASharpAndSTranspose_(MatrixRef outA,
                                                                 const MatrixConstRef & in,
                                                                 bool minus) const
 {
+  if(explicit_)
+  {
+    if(minus)
+    {
+      outA.noalias() = -Asharp_ * in;
+    }
+    else
+    {
+      outA.noalias() = Asharp_ * in;
+    }
+    outS.noalias() = St_ * in;
+    return;
+  }
+
   // For M = in, and A = | Q1   Q2 | | R1  R2 | | P1^T |
   //                                |  0   0 | | P2^T |
   // we compute | P1 R1^-1   0 | | Q1^T | M
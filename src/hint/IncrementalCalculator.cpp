@@ -0,0 +1,311 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/Variable.h>
+#include <tvm/constraint/abstract/LinearConstraint.h>
+#include <tvm/hint/internal/IncrementalCalculator.h>
+
+#include <Eigen/Jacobi>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+using namespace Eigen;
+
+namespace tvm
+{
+
+namespace hint
+{
+
+namespace internal
+{
+IncrementalCalculator::IncrementalCalculator(int maxRank, int refreshPeriod, double tol)
+: maxRank_(maxRank), refreshPeriod_(refreshPeriod), tol_(tol)
+{
+  if(refreshPeriod < 0)
+  {
+    throw std::runtime_error("[IncrementalCalculator::IncrementalCalculator] The refresh period must be non-negative.");
+  }
+  if(tol <= 0)
+  {
+    throw std::runtime_error("[IncrementalCalculator::IncrementalCalculator] The tolerance must be positive.");
+  }
+}
+
+std::unique_ptr<abstract::SubstitutionCalculatorImpl> IncrementalCalculator::impl_(
+    const std::vector<LinearConstraintPtr> & cstr,
+    const std::vector<VariablePtr> & x,
+    int rank) const
+{
+  return std::unique_ptr<abstract::SubstitutionCalculatorImpl>(
+      new IncrementalCalculator::Impl(cstr, x, rank, maxRank_, refreshPeriod_, tol_));
+}
+
+IncrementalCalculator::Impl::Impl(const std::vector<LinearConstraintPtr> & cstr,
+                                  const std::vector<VariablePtr> & x,
+                                  int rank,
+                                  int maxRank,
+                                  int refreshPeriod,
+                                  double tol)
+: SubstitutionCalculatorImpl(cstr, x, rank),
+  maxRank_(maxRank >= 0 ? maxRank : std::max(1, static_cast<int>(m() / 4))), refreshPeriod_(refreshPeriod),
+  tol_(tol), sinceRefresh_(0), factorizations_(0), qr_(m(), n()), Q_(m(), m()), R_(m(), n()), P_(n()), Pinv_(n()),
+  Aprev_(m(), n()), invR1R2_(r(), n() - r()), u_(m()), vp_(n()), w_(m()), work_(m()),
+  checkX_(VectorXd::LinSpaced(n(), 1, 2)), checkY_(m()), checkZ_(m()), tmp_(m(), 2 * n())
+{
+  changed_.reserve(static_cast<size_t>(maxRank_) + 1);
+}
+
+std::unique_ptr<abstract::SubstitutionCalculatorImpl> IncrementalCalculator::Impl::clone(
+    const std::vector<LinearConstraintPtr> & cstr,
+    const std::vector<VariablePtr> & x) const
+{
+  return std::unique_ptr<abstract::SubstitutionCalculatorImpl>(
+      new Impl(cstr, x, static_cast<int>(r()), maxRank_, refreshPeriod_, tol_));
+}
+
+void IncrementalCalculator::Impl::update_()
+{
+  if(!isSimple())
+  {
+    fillA();
+  }
+  const auto & A = this->A();
+
+  if(factorizations_ == 0 || !updateFactorization(A))
+  {
+    factorize(A);
+  }
+  computeN();
+}
+
+void IncrementalCalculator::Impl::factorize(const MatrixConstRef & A)
+{
+  qr_.compute(A);
+
+  if(qr_.rank() != r())
+  {
+    std::stringstream ss;
+    const auto & vars = variables_.variables();
+    ss << "During the substitution of the ";
+    if(vars.size() == 1)
+    {
+      ss << "variable " << vars.front()->name();
+    }
+    else
+    {
+      ss << "variables (";
+      for(size_t i = 0; i < vars.size() - 1; ++i)
+      {
+        ss << vars[i]->name() << ", ";
+      }
+      ss << vars.back()->name() << ")";
+    }
+    ss << ": the rank of the matrix (" << qr_.rank();
+    ss << ") is not the one that was specified (" << r() << ").";
+    throw std::runtime_error(ss.str());
+  }
+
+  qr_.householderQ().evalTo(Q_, work_);
+  R_ = qr_.matrixQR().triangularView<Eigen::Upper>();
+  P_ = qr_.colsPermutation();
+  for(DenseIndex i = 0; i < n(); ++i)
+  {
+    Pinv_[P_.indices()[i]] = static_cast<int>(i);
+  }
+  Aprev_ = A;
+  sinceRefresh_ = 0;
+  ++factorizations_;
+}
+
+bool IncrementalCalculator::Impl::updateFactorization(const MatrixConstRef & A)
+{
+  // The update of R with a fixed permutation is only meaningful if R has no
+  // zero rows, i.e. if A is full row rank.
+  if(r() != m() || sinceRefresh_ >= refreshPeriod_)
+  {
+    return false;
+  }
+
+  // Changed columns
+  bool byCols = true;
+  changed_.clear();
+  for(DenseIndex j = 0; j < n() && static_cast<int>(changed_.size()) <= maxRank_; ++j)
+  {
+    if(A.col(j) != Aprev_.col(j))
+    {
+      changed_.push_back(j);
+    }
+  }
+
+  // Changed rows
+  if(static_cast<int>(changed_.size()) > maxRank_)
+  {
+    byCols = false;
+    changed_.clear();
+    for(DenseIndex i = 0; i < m() && static_cast<int>(changed_.size()) <= maxRank_; ++i)
+    {
+      if(A.row(i) != Aprev_.row(i))
+      {
+        changed_.push_back(i);
+      }
+    }
+    if(static_cast<int>(changed_.size()) > maxRank_)
+    {
+      return false;
+    }
+  }
+
+  if(changed_.empty())
+  {
+    return true;
+  }
+
+  // A = Aprev + sum_k u_k v_k^T
+  if(byCols)
+  {
+    for(auto j : changed_)
+    {
+      u_ = A.col(j) - Aprev_.col(j);
+      vp_.setZero();
+      vp_[Pinv_[j]] = 1;
+      rank1Update(u_, vp_);
+      Aprev_.col(j) = A.col(j);
+    }
+  }
+  else
+  {
+    for(auto i : changed_)
+    {
+      u_.setZero();
+      u_[i] = 1;
+      for(DenseIndex k = 0; k < n(); ++k)
+      {
+        auto j = P_.indices()[k];
+        vp_[k] = A(i, j) - Aprev_(i, j);
+      }
+      rank1Update(u_, vp_);
+      Aprev_.row(i) = A.row(i);
+    }
+  }
+  ++sinceRefresh_;
+
+  return check(A);
+}
+
+void IncrementalCalculator::Impl::rank1Update(const VectorXd & u, const VectorXd & vp)
+{
+  // Q R + u vp^T = Q (R + w vp^T) with w = Q^T u.
+  w_.noalias() = Q_.transpose() * u;
+
+  // Reduce w to ||w|| e1 by a sequence of rotations, turning R into an upper
+  // Hessenberg matrix.
+  JacobiRotation<double> G;
+  for(DenseIndex k = m() - 1; k > 0; --k)
+  {
+    G.makeGivens(w_[k - 1], w_[k]);
+    w_.applyOnTheLeft(k - 1, k, G.adjoint());
+    R_.applyOnTheLeft(k - 1, k, G.adjoint());
+    Q_.applyOnTheRight(k - 1, k, G);
+  }
+
+  // The rank-1 term now only affects the first row.
+  R_.row(0).noalias() += w_[0] * vp.transpose();
+
+  // Restore the triangular structure.
+  for(DenseIndex k = 0; k < m() - 1; ++k)
+  {
+    G.makeGivens(R_(k, k), R_(k + 1, k));
+    R_.applyOnTheLeft(k, k + 1, G.adjoint());
+    Q_.applyOnTheRight(k, k + 1, G);
+    R_(k + 1, k) = 0;
+  }
+}
+
+bool IncrementalCalculator::Impl::check(const MatrixConstRef & A) const
+{
+  // Conditioning of R1
+  const auto d = R_.diagonal().head(r()).cwiseAbs();
+  if(d.minCoeff() <= std::numeric_limits<double>::epsilon() * static_cast<double>(n()) * d.maxCoeff())
+  {
+    return false;
+  }
+
+  // Q R x = A P x for a test vector x.
+  checkY_.noalias() = R_ * checkX_;
+  checkZ_.noalias() = Q_ * checkY_;
+  for(DenseIndex k = 0; k < n(); ++k)
+  {
+    checkZ_.noalias() -= checkX_[k] * A.col(P_.indices()[k]);
+  }
+  return checkZ_.norm() <= tol_ * A.norm() * checkX_.norm();
+}
+
+void IncrementalCalculator::Impl::computeN()
+{
+  const auto & R1 = R_.topLeftCorner(r(), r()).template triangularView<Eigen::Upper>();
+  const auto & P = P_.indices();
+
+  // Compute inv(R1) * R2
+  invR1R2_ = R1.solve(R_.topRightCorner(r(), n() - r()));
+
+  // N = P_2 - P_1 * inv(R1) * R2
+  for(DenseIndex i = 0; i < r(); ++i)
+  {
+    N_.row(P.coeff(i)) = -invR1R2_.row(i);
+  }
+  for(auto i = r(); i < n(); ++i)
+  {
+    N_.row(P.coeff(i)).setZero();
+    N_(P.coeff(i), i - r()) = 1;
+  }
+}
+
+void IncrementalCalculator::Impl::premultiplyByASharpAndSTranspose_(MatrixRef outA,
+                                                                    MatrixRef outS,
+                                                                    const MatrixConstRef & in,
+                                                                    bool minus) const
+{
+  // Same computations as GenericCalculator::Impl, with an explicit Q.
+  tmp_.resize(m(), in.cols());
+  auto T = tmp_.get();
+
+  // T = Q^T M
+  T.noalias() = Q_.transpose() * in;
+
+  // T(1:r,:) = R1^-1 T(1:r,:)
+  const auto & R1 = R_.topLeftCorner(r(), r()).template triangularView<Eigen::Upper>();
+  R1.solveInPlace(T.topRows(r()));
+
+  // outA = - P1 * T(1:r,:)
+  const auto & P = P_.indices();
+  if(minus)
+  {
+    for(DenseIndex i = 0; i < r(); ++i)
+    {
+      outA.row(P.coeff(i)) = -T.row(i);
+    }
+  }
+  else
+  {
+    for(DenseIndex i = 0; i < r(); ++i)
+    {
+      outA.row(P.coeff(i)) = T.row(i);
+    }
+  }
+
+  for(DenseIndex i = r(); i < n(); ++i)
+  {
+    outA.row(P.coeff(i)).setZero();
+  }
+
+  // outS
+  outS = T.bottomRows(m() - r());
+}
+
+} // namespace internal
+
+} // namespace hint
+
+} // namespace tvm
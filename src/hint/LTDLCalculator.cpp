@@ -0,0 +1,142 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/Variable.h>
+#include <tvm/constraint/abstract/LinearConstraint.h>
+#include <tvm/hint/internal/LTDLCalculator.h>
+
+#include <sstream>
+
+using namespace Eigen;
+
+namespace tvm
+{
+
+namespace hint
+{
+
+namespace internal
+{
+LTDLCalculator::LTDLCalculator(const std::vector<int> & lambda) : lambda_(lambda)
+{
+  for(size_t i = 0; i < lambda_.size(); ++i)
+  {
+    if(lambda_[i] < -1 || lambda_[i] >= static_cast<int>(i))
+    {
+      throw std::runtime_error("[LTDLCalculator::LTDLCalculator] Each parent index must be -1 or lower than the "
+                               "index of its child.");
+    }
+  }
+}
+
+std::unique_ptr<abstract::SubstitutionCalculatorImpl> LTDLCalculator::impl_(
+    const std::vector<LinearConstraintPtr> & cstr,
+    const std::vector<VariablePtr> & x,
+    int rank) const
+{ return std::unique_ptr<abstract::SubstitutionCalculatorImpl>(new LTDLCalculator::Impl(cstr, x, rank, lambda_)); }
+
+LTDLCalculator::Impl::Impl(const std::vector<LinearConstraintPtr> & cstr,
+                           const std::vector<VariablePtr> & x,
+                           int rank,
+                           const std::vector<int> & lambda)
+: SubstitutionCalculatorImpl(cstr, x, rank), lambda_(lambda), LD_(m(), n())
+{
+  if(m() != n() || r() != n())
+  {
+    throw std::runtime_error("[LTDLCalculator::Impl] This calculator is only for square, full-rank matrices.");
+  }
+  if(lambda_.empty())
+  {
+    lambda_.resize(static_cast<size_t>(n()));
+    for(int i = 0; i < static_cast<int>(n()); ++i)
+    {
+      lambda_[static_cast<size_t>(i)] = i - 1;
+    }
+  }
+  else if(static_cast<DenseIndex>(lambda_.size()) != n())
+  {
+    throw std::runtime_error("[LTDLCalculator::Impl] The size of the parent array does not match the size of the "
+                             "matrix.");
+  }
+}
+
+std::unique_ptr<abstract::SubstitutionCalculatorImpl> LTDLCalculator::Impl::clone(
+    const std::vector<LinearConstraintPtr> & cstr,
+    const std::vector<VariablePtr> & x) const
+{ return std::unique_ptr<abstract::SubstitutionCalculatorImpl>(new Impl(cstr, x, static_cast<int>(r()), lambda_)); }
+
+void LTDLCalculator::Impl::update_()
+{
+  if(!isSimple())
+  {
+    fillA();
+  }
+  LD_ = A();
+
+  // LTDL factorization, Featherstone's RBDA Table 6.3. Only the lower part of
+  // A is used.
+  for(int k = static_cast<int>(n()) - 1; k >= 0; --k)
+  {
+    if(LD_(k, k) <= 0)
+    {
+      std::stringstream ss;
+      ss << "[LTDLCalculator::Impl::update_] The matrix for the substitution of " << variables_[0]->name();
+      ss << (variables_.numberOfVariables() > 1 ? ", ..." : "") << " is not positive definite.";
+      throw std::runtime_error(ss.str());
+    }
+    for(int i = lambda_[static_cast<size_t>(k)]; i >= 0; i = lambda_[static_cast<size_t>(i)])
+    {
+      double a = LD_(k, i) / LD_(k, k);
+      for(int j = i; j >= 0; j = lambda_[static_cast<size_t>(j)])
+      {
+        LD_(i, j) -= a * LD_(k, j);
+      }
+      LD_(k, i) = a;
+    }
+  }
+}
+
+void LTDLCalculator::Impl::premultiplyByASharpAndSTranspose_(MatrixRef outA,
+                                                             MatrixRef,
+                                                             const MatrixConstRef & in,
+                                                             bool minus) const
+{
+  // outA = A^-1 in = L^-1 D^-1 L^-T in
+  if(minus)
+  {
+    outA = -in;
+  }
+  else
+  {
+    outA = in;
+  }
+
+  // Solve L^T Y = outA
+  for(int i = static_cast<int>(n()) - 1; i >= 0; --i)
+  {
+    for(int j = lambda_[static_cast<size_t>(i)]; j >= 0; j = lambda_[static_cast<size_t>(j)])
+    {
+      outA.row(j) -= LD_(i, j) * outA.row(i);
+    }
+  }
+
+  // Y = D^-1 Y
+  for(DenseIndex i = 0; i < n(); ++i)
+  {
+    outA.row(i) /= LD_(i, i);
+  }
+
+  // Solve L outA = Y
+  for(int i = 0; i < static_cast<int>(n()); ++i)
+  {
+    for(int j = lambda_[static_cast<size_t>(i)]; j >= 0; j = lambda_[static_cast<size_t>(j)])
+    {
+      outA.row(i) -= LD_(i, j) * outA.row(j);
+    }
+  }
+}
+
+} // namespace internal
+
+} // namespace hint
+
+} // namespace tvm
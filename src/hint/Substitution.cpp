@@ -4,8 +4,12 @@
 
 #include <tvm/Variable.h>
 #include <tvm/constraint/abstract/LinearConstraint.h>
+#include <tvm/utils/CloneMap.h>
 
+#include <cassert>
 #include <sstream>
+#include <stdexcept>
+#include <typeinfo>
 
 namespace tvm
 {
@@ -69,6 +73,27 @@ bool Substitution::isSimple() const { return constraints_.size() == 1 && x_.size
 
 std::shared_ptr<abstract::SubstitutionCalculatorImpl> Substitution::calculator() const { return calculator_; }
 
+Substitution Substitution::clone(const std::vector<LinearConstraintPtr> & cstr, utils::CloneMap & map) const
+{
+  assert(cstr.size() == constraints_.size());
+  Substitution s(*this);
+  s.constraints_ = cstr;
+  for(auto & x : s.x_)
+  {
+    x = map.variable(x);
+  }
+  s.check();
+  std::shared_ptr<abstract::SubstitutionCalculatorImpl> calc = calculator_->clone(s.constraints_, s.x_);
+  // A derived class not overriding clone would be sliced by the implementation of its base.
+  if(!calc || typeid(*calc) != typeid(*calculator_))
+  {
+    throw std::runtime_error(std::string("[Substitution::clone] Calculators of type ") + typeid(*calculator_).name()
+                             + " cannot be cloned.");
+  }
+  s.calculator_ = calc;
+  return s;
+}
+
 void Substitution::check() const
 {
   // all constraints need to be equality
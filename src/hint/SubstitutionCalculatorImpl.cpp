@@ -5,6 +5,8 @@
 #include <tvm/Variable.h>
 #include <tvm/constraint/abstract/LinearConstraint.h>
 
+#include <stdexcept>
+
 namespace
 {
 // return true if the buffers for M1 and M2 are disjoint (used in assert code only)
@@ -23,7 +25,7 @@ namespace abstract
 
 void SubstitutionCalculatorImpl::update()
 {
-  if(!constant_ || init_)
+  if(!constant_ || init_ || sourceChanged())
   {
     update_();
     assert(N_.rows() == n_);
@@ -32,7 +34,12 @@ void SubstitutionCalculatorImpl::update()
       throw std::runtime_error("N_ does not have the correct size. Did you specify a correct rank for the "
                                "substitution, or did the rank change (which is not allowed)?");
     }
+    if(constant_)
+    {
+      saveSource();
+    }
     init_ = false;
+    ++updateCount_;
   }
 }
 
@@ -118,17 +125,54 @@ void SubstitutionCalculatorImpl::fillA()
 {
   for(auto & f : fillData_)
   {
-    f.block = f.cstr->jacobian(*f.x);
+    f.block = f.cstr->jacobianAt(f.loc);
+  }
+}
+
+bool SubstitutionCalculatorImpl::sourceChanged() const
+{
+  // Comparing the matrices is O(mn), which is negligible compared to the
+  // computations we want to avoid.
+  if(isSimple())
+  {
+    return constraints_[0]->jacobianAt(loc0_) != A0_;
+  }
+  else
+  {
+    for(const auto & f : fillData_)
+    {
+      if(f.block != f.cstr->jacobianAt(f.loc))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+void SubstitutionCalculatorImpl::saveSource()
+{
+  if(isSimple())
+  {
+    A0_ = constraints_[0]->jacobianAt(loc0_);
+  }
+  else
+  {
+    fillA();
   }
 }
 
 const Eigen::MatrixXd & SubstitutionCalculatorImpl::N() const { return N_; }
 
+std::unique_ptr<SubstitutionCalculatorImpl> SubstitutionCalculatorImpl::clone(const std::vector<LinearConstraintPtr> &,
+                                                                              const std::vector<VariablePtr> &) const
+{ throw std::runtime_error("[SubstitutionCalculatorImpl::clone] This calculator does not support cloning."); }
+
 SubstitutionCalculatorImpl::SubstitutionCalculatorImpl(const std::vector<LinearConstraintPtr> & cstr,
                                                        const std::vector<VariablePtr> & x,
                                                        int rank)
 : constraints_(cstr), variables_(x), m_(0), n_(0), r_(rank), constant_(false), init_(true),
-  simple_(cstr.size() == 1 && x.size() == 1)
+  simple_(cstr.size() == 1 && x.size() == 1), updateCount_(0)
 {
   assert(rank >= 0);
 
@@ -145,7 +189,11 @@ SubstitutionCalculatorImpl::SubstitutionCalculatorImpl(const std::vector<LinearC
   assert(m_ <= n_);
   assert(r_ <= m_);
 
-  if(!isSimple())
+  if(isSimple())
+  {
+    loc0_ = cstr[0]->jacobianLocation(*x[0]);
+  }
+  else
   {
     A_.resize(m_, n_);
     A_.setZero();
@@ -160,7 +208,7 @@ SubstitutionCalculatorImpl::SubstitutionCalculatorImpl(const std::vector<LinearC
         if(c->variables().contains(*v))
         {
           auto cols = v->getMappingIn(variables_);
-          fillData_.push_back({v, c, A_.block(m, cols.start, mi, cols.dim)});
+          fillData_.push_back({v, c, A_.block(m, cols.start, mi, cols.dim), c->jacobianLocation(*v)});
         }
       }
       m += mi;
@@ -180,10 +228,19 @@ SubstitutionCalculatorImpl::SubstitutionCalculatorImpl(const std::vector<LinearC
     }
   }
 
+  constant(constant_);
+
   N_.resize(n_, n_ - r_);
 }
 
-void SubstitutionCalculatorImpl::constant(bool c) { constant_ = c; }
+void SubstitutionCalculatorImpl::constant(bool c)
+{
+  constant_ = c;
+  if(constant_ && isSimple())
+  {
+    A0_.resize(m_, n_);
+  }
+}
 
 bool SubstitutionCalculatorImpl::constant() const { return constant_; }
 
@@ -191,7 +248,7 @@ MatrixConstRef SubstitutionCalculatorImpl::A() const
 {
   if(isSimple())
   {
-    return constraints_[0]->jacobian(*variables_[0]);
+    return constraints_[0]->jacobianAt(loc0_);
   }
   else
   {
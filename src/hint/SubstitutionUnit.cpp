@@ -118,10 +118,11 @@ void SubstitutionUnit::update()
       std::fill(firstZ_.begin(), firstZ_.end(), true);
       const auto & c = constraints_[i];
       auto mki = c->size();
-      for(auto j : constraintsY_[i])
+      for(size_t jj = 0; jj < constraintsY_[i].size(); ++jj)
       {
-        auto r = y_[j]->getMappingIn(y_);
-        B_.block(m + mk, r.start, mki, r.dim) = c->jacobian(*y_[j]);
+        auto j = constraintsY_[i][jj];
+        auto r = y_.rangeOf(j);
+        B_.block(m + mk, r.start, mki, r.dim) = c->jacobianAt(constraintsYLocations_[i][jj]);
         firstY_[j] = false;
       }
       switch(c->rhs())
@@ -139,14 +140,15 @@ void SubstitutionUnit::update()
           cIsZero_[i] = false;
           break;
       }
-      for(auto l : CXdependencies_[i])
+      for(size_t ll = 0; ll < CXdependencies_[i].size(); ++ll)
       {
-        auto rx = x_[l]->getMappingIn(x_);
-        auto A = c->jacobian(*x_[l]);
+        auto l = CXdependencies_[i][ll];
+        auto rx = x_.rangeOf(l);
+        auto A = c->jacobianAt(CXLocations_[i][ll]);
         // B_{ij} += A_{il}*M_{lj} for each y_j on which x_l depends.
         for(auto j : XYdependencies_[l])
         {
-          auto ry = y_[j]->getMappingIn(y_);
+          auto ry = y_.rangeOf(j);
           if(firstY_[j])
           {
             B_.block(m + mk, ry.start, mki, ry.dim).noalias() = A * M_.block(rx.start, ry.start, rx.dim, ry.dim);
@@ -160,7 +162,7 @@ void SubstitutionUnit::update()
         // Z_{ij} += A_{il}*AsZ_{lj} for each z_j on which x_l depends.
         for(auto j : XZdependencies_[l])
         {
-          auto rz = z_[j]->getMappingIn(z_);
+          auto rz = z_.rangeOf(j);
           if(j == static_cast<int>(x2sub_[l]))
           {
             // we handles this dependency in z separately, as it involves N
@@ -189,7 +191,7 @@ void SubstitutionUnit::update()
     // Compute M_{kj} and S_k^T B_{k,j} for y_[j] on which substitutions_[k] depends.
     for(auto j : SYdependencies_[k])
     {
-      auto ry = y_[j]->getMappingIn(y_);
+      auto ry = y_.rangeOf(j);
       calculators_[k]->premultiplyByASharpAndSTranspose(M_.block(rn.start, ry.start, rn.dim, ry.dim),
                                                         StB_[k].middleCols(ry.start, ry.dim),
                                                         B_.block(m, ry.start, mk, ry.dim), true);
@@ -197,7 +199,7 @@ void SubstitutionUnit::update()
     // Compute AsZ_{kj} and S_k^T Z_{k,j} for z_[j] on which substitutions_[k] depends.
     for(auto j : SZdependencies_[k])
     {
-      auto rz = z_[j]->getMappingIn(z_);
+      auto rz = z_.rangeOf(j);
       calculators_[k]->premultiplyByASharpAndSTranspose(AsZ_.block(rn.start, rz.start, rn.dim, rz.dim),
                                                         StZ_[k].middleCols(rz.start, rz.dim),
                                                         Z_.block(m, rz.start, mk, rz.dim), true);
@@ -213,17 +215,17 @@ void SubstitutionUnit::update()
   {
     for(auto i : sub2x_[k])
     {
-      auto rx = x_[static_cast<int>(i)]->getMappingIn(x_);
+      auto rx = x_.rangeOf(static_cast<int>(i));
       for(auto j : SYdependencies_[k])
       {
-        auto ry = y_[j]->getMappingIn(y_);
+        auto ry = y_.rangeOf(j);
         varSubstitutions_[i]->A(M_.block(rx.start, ry.start, rx.dim, ry.dim), *y_[j]);
       }
       for(auto j : SZdependencies_[k])
       {
         if(j == static_cast<int>(k))
           continue;
-        auto rz = z_[j]->getMappingIn(z_);
+        auto rz = z_.rangeOf(j);
         varSubstitutions_[i]->A(AsZ_.block(rx.start, rz.start, rx.dim, rz.dim), *z_[j]);
       }
       // copy N
@@ -243,12 +245,12 @@ void SubstitutionUnit::update()
 
     for(auto j : SYdependencies_[k])
     {
-      auto ry = y_[j]->getMappingIn(y_);
+      auto ry = y_.rangeOf(j);
       remaining_[k]->A(StB_[k].middleCols(ry.start, ry.dim), *y_[j]);
     }
     for(auto j : SZdependencies_[k])
     {
-      auto rz = z_[j]->getMappingIn(z_);
+      auto rz = z_.rangeOf(j);
       remaining_[k]->A(StZ_[k].middleCols(rz.start, rz.dim), *z_[j]);
     }
     remaining_[k]->b(Stc_[k]);
@@ -327,6 +329,8 @@ void SubstitutionUnit::scanSubstitutions()
       constraints_.push_back(c);
       constraintsY_.push_back({});
       CXdependencies_.push_back({});
+      constraintsYLocations_.push_back({});
+      CXLocations_.push_back({});
       mi += c->size();
       for(const auto & v : tvm::internal::VariableVectorPartition(c->variables(), partition))
       {
@@ -341,6 +345,7 @@ void SubstitutionUnit::scanSubstitutions()
           y_.add(v);
           auto ity = std::find_if(y_.variables().begin(), y_.variables().end(), comp);
           constraintsY_.back().push_back(static_cast<int>(ity - y_.variables().begin()));
+          constraintsYLocations_.back().push_back(c->jacobianLocation(*v));
         }
         else if(std::find_if(s.variables().begin(), s.variables().end(),
                              [&v](const auto & it) { return it->contains(*v); })
@@ -348,6 +353,7 @@ void SubstitutionUnit::scanSubstitutions()
         {
           // v is an x variable that is not substituted by s
           CXdependencies_.back().push_back(static_cast<int>(it - x_.variables().begin()));
+          CXLocations_.back().push_back(c->jacobianLocation(*v));
         }
       }
     }
@@ -392,12 +398,12 @@ void SubstitutionUnit::initializeMatrices()
     }
     for(auto i : SYdependencies_[k])
     {
-      auto ry = y_[i]->getMappingIn(y_);
+      auto ry = y_.rangeOf(i);
       B_.block(m, ry.start, mk, ry.dim).setZero();
     }
     for(auto i : SZdependencies_[k])
     {
-      auto rz = z_[i]->getMappingIn(z_);
+      auto rz = z_.rangeOf(i);
       Z_.block(m, rz.start, mk, rz.dim).setZero();
     }
     m += mk;
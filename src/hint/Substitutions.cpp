@@ -24,6 +24,30 @@ static bool dependsOn(const Substitution & s, const Substitution & t)
   return false;
 }
 
+/** Identify the unit made of the substitutions of \p pool with indices in
+ * \p groups[i] for \p i in \p order.
+ */
+static std::vector<const void *> unitKey(const std::vector<Substitution> & pool,
+                                         const std::vector<std::vector<size_t>> & groups,
+                                         const std::vector<size_t> & order)
+{
+  std::vector<const void *> key;
+  for(auto i : order)
+  {
+    for(auto j : groups[i])
+    {
+      const auto & s = pool[j];
+      for(const auto & c : s.constraints())
+        key.push_back(c.get());
+      for(const auto & x : s.variables())
+        key.push_back(x.get());
+      key.push_back(s.calculator().get());
+    }
+  }
+  std::sort(key.begin(), key.end());
+  return key;
+}
+
 void Substitutions::add(const Substitution & s)
 {
   auto i = dependencies_.addNode();
@@ -80,16 +104,33 @@ void Substitutions::finalize()
   // in each group. Indices in orderedGroups are relative to scc.
   auto orderedGroups = g.groupedOrder();
 
-  // We create a unit for each group
+  // We create a unit for each group, reusing the previous one if the group did
+  // not change.
+  std::vector<SubstitutionUnit> previousUnits = std::move(units_);
+  std::vector<std::vector<const void *>> previousKeys = std::move(unitKeys_);
   units_.clear();
+  unitKeys_.clear();
+  firstUpdate_ = true;
   for(const auto & g : orderedGroups)
   {
-    units_.emplace_back(substitutions_, scc, g);
+    auto key = unitKey(substitutions_, scc, g);
+    auto it = std::find(previousKeys.begin(), previousKeys.end(), key);
+    if(it != previousKeys.end())
+    {
+      units_.push_back(std::move(previousUnits[static_cast<size_t>(it - previousKeys.begin())]));
+      it->clear();
+    }
+    else
+    {
+      units_.emplace_back(substitutions_, scc, g);
+    }
+    unitKeys_.push_back(std::move(key));
   }
 
   // Retrieve all the variables, functions and constraints
   variables_.clear();
   varSubstitutions_.clear();
+  additionalVariables_.clear();
   additionalConstraints_.clear();
   otherVariables_.clear();
   for(const auto & u : units_)
@@ -127,12 +168,40 @@ void Substitutions::finalize()
 
 void Substitutions::updateSubstitutions()
 {
-  for(auto & u : units_)
+  // The first update is made serially as it fills the caches of the variables
+  // mappings, which can be shared by several units.
+  if(pool_ && units_.size() > 1 && !firstUpdate_)
+  {
+    pool_->run(units_.size(), [this](size_t i) { units_[i].update(); });
+  }
+  else
+  {
+    for(auto & u : units_)
+    {
+      u.update();
+    }
+  }
+  firstUpdate_ = false;
+}
+
+void Substitutions::threads(int n)
+{
+  if(n == threads())
   {
-    u.update();
+    return;
+  }
+  if(n > 1)
+  {
+    pool_ = std::make_shared<tvm::utils::internal::ThreadPool>(n);
+  }
+  else
+  {
+    pool_.reset();
   }
 }
 
+int Substitutions::threads() const { return pool_ ? pool_->size() : 1; }
+
 void Substitutions::updateVariableValues() const
 {
   for(size_t i = 0; i < variables_.size(); ++i)
@@ -155,17 +224,21 @@ const std::vector<std::shared_ptr<constraint::BasicLinearConstraint>> & Substitu
 const std::vector<VariablePtr> & Substitutions::otherVariables() const { return otherVariables_; }
 
 VariableVector Substitutions::substitute(const VariablePtr & x) const
+{ return substitute(x, variables_, varSubstitutions_); }
+
+VariableVector Substitutions::substitute(const VariablePtr & x,
+                                         const std::vector<VariablePtr> & xs,
+                                         const std::vector<std::shared_ptr<function::BasicLinearFunction>> & fs)
 {
-  auto it =
-      std::find_if(variables_.begin(), variables_.end(), [&x](const VariablePtr & v) { return v->intersects(*x); });
-  if(it == variables_.end()) // no substitution of var
+  auto it = std::find_if(xs.begin(), xs.end(), [&x](const VariablePtr & v) { return v->intersects(*x); });
+  if(it == xs.end()) // no substitution of var
   {
     VariableVector v({x});
     return v;
   }
   else // substitution of var
   {
-    const auto & f = varSubstitutions_[static_cast<size_t>(it - variables_.begin())];
+    const auto & f = fs[static_cast<size_t>(it - xs.begin())];
     if(*x == **it) // substitution by a full variable
     {
       return f->variables();
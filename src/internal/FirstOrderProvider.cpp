@@ -4,6 +4,8 @@
 
 #include <tvm/exception/exceptions.h>
 
+#include <stdexcept>
+
 namespace tvm
 {
 
@@ -16,6 +18,11 @@ FirstOrderProvider::FirstOrderProvider(Space image) : imageSpace_(std::move(imag
   resizeCache(); // resize value_
 }
 
+bool FirstOrderProvider::jacobianParentArray(const std::vector<VariablePtr> &, std::vector<int> &) const
+{
+  return false;
+}
+
 void FirstOrderProvider::resizeCache()
 {
   resizeValueCache();
@@ -32,8 +39,16 @@ void FirstOrderProvider::resizeJacobianCache()
 {
   if(isOutputEnabled((int)Output::Jacobian))
   {
-    for(auto v : variables_.variables())
-      jacobian_[v.get()].resize(imageSpace_.tSize(), v->space().tSize());
+    if(flat_)
+    {
+      computeJacobianOffsets();
+      jacobianMatrix_.resize(imageSpace_.tSize(), jacobianOffsets_.back());
+    }
+    else
+    {
+      for(auto v : variables_.variables())
+        jacobian_[v.get()].resize(imageSpace_.tSize(), v->space().tSize());
+    }
   }
 }
 
@@ -41,7 +56,18 @@ void FirstOrderProvider::addVariable(VariablePtr v, bool linear)
 {
   if(variables_.add(v))
   {
-    jacobian_[v.get()].resize(imageSpace_.tSize(), v->space().tSize());
+    if(flat_)
+    {
+      // Keep the existing jacobian matrices, the new one is appended on the right.
+      auto n = jacobianOffsets_.back() + static_cast<Eigen::DenseIndex>(v->space().tSize());
+      jacobianMatrix_.conservativeResize(imageSpace_.tSize(), n);
+      jacobianOffsets_.push_back(n);
+      jacobianProperties_.emplace_back();
+    }
+    else
+    {
+      jacobian_[v.get()].resize(imageSpace_.tSize(), v->space().tSize());
+    }
     linear_[v.get()] = linear;
 
     addVariable_(v);
@@ -58,6 +84,25 @@ void FirstOrderProvider::addVariable(const VariableVector & vv, bool linear)
 
 void FirstOrderProvider::removeVariable(VariablePtr v)
 {
+  if(flat_)
+  {
+    int i = variables_.indexOf(*v);
+    if(i >= 0)
+    {
+      auto k = static_cast<size_t>(i);
+      auto start = jacobianOffsets_[k];
+      auto n = jacobianOffsets_[k + 1] - start;
+      auto right = jacobianMatrix_.cols() - start - n;
+      // Shift the jacobian matrices of the next variables to the left.
+      for(Eigen::DenseIndex c = 0; c < right; ++c)
+        jacobianMatrix_.col(start + c) = jacobianMatrix_.col(start + n + c);
+      jacobianMatrix_.conservativeResize(Eigen::NoChange, jacobianMatrix_.cols() - n);
+      jacobianProperties_.erase(jacobianProperties_.begin() + i);
+      jacobianOffsets_.erase(jacobianOffsets_.begin() + i + 1);
+      for(size_t j = k + 1; j < jacobianOffsets_.size(); ++j)
+        jacobianOffsets_[j] -= n;
+    }
+  }
   variables_.remove(*v);
   jacobian_.erase(v.get());
   linear_.erase(v.get());
@@ -78,6 +123,33 @@ void FirstOrderProvider::splitJacobian(const MatrixConstRef & J,
                                        const std::vector<VariablePtr> & vars,
                                        bool keepProperties)
 {
+  if(flat_)
+  {
+    if(vars == variables_.variables())
+    {
+      // J has the same layout as jacobianMatrix_: a single copy is needed.
+      jacobianMatrix_ = J;
+      if(!keepProperties)
+        std::fill(jacobianProperties_.begin(), jacobianProperties_.end(), MatrixProperties());
+    }
+    else
+    {
+      Eigen::DenseIndex s = 0;
+      for(const auto & v : vars)
+      {
+        auto n = static_cast<Eigen::DenseIndex>(v->space().tSize());
+        // v can be a subvariable of one of variables_
+        auto loc = jacobianLocation(*v);
+        auto k = static_cast<size_t>(loc.first);
+        slice_matrix::Type Jv{jacobianMatrix_.middleCols(jacobianOffsets_[k] + loc.second.start, loc.second.dim),
+                              jacobianProperties_[k]};
+        Jv.keepProperties(keepProperties) = J.middleCols(s, n);
+        s += n;
+      }
+    }
+    return;
+  }
+
   Eigen::DenseIndex s = 0;
   for(const auto & v : vars)
   {
@@ -87,6 +159,72 @@ void FirstOrderProvider::splitJacobian(const MatrixConstRef & J,
   }
 }
 
+void FirstOrderProvider::useFlatJacobian()
+{
+  if(flat_)
+    return;
+
+  computeJacobianOffsets();
+  jacobianProperties_.clear();
+  jacobianProperties_.reserve(static_cast<size_t>(variables_.numberOfVariables()));
+  jacobianMatrix_.resize(imageSpace_.tSize(), jacobianOffsets_.back());
+  for(int i = 0; i < variables_.numberOfVariables(); ++i)
+  {
+    auto it = jacobian_.find(variables_[i].get());
+    auto k = static_cast<size_t>(i);
+    if(it != jacobian_.end() && it->second.rows() == jacobianMatrix_.rows()
+       && it->second.cols() == jacobianOffsets_[k + 1] - jacobianOffsets_[k])
+    {
+      jacobianMatrix_.middleCols(jacobianOffsets_[k], it->second.cols()) = it->second;
+      jacobianProperties_.push_back(it->second.properties());
+    }
+    else
+    {
+      jacobianProperties_.emplace_back();
+    }
+  }
+  jacobian_.clear();
+  flat_ = true;
+}
+
+MatrixConstRefWithProperties FirstOrderProvider::flatJacobian(const Variable & x) const
+{
+  auto loc = jacobianLocation(x);
+  auto k = static_cast<size_t>(loc.first);
+  auto start = jacobianOffsets_[k];
+  if(*variables_[loc.first] == x)
+    return {jacobianMatrix_.middleCols(start, jacobianOffsets_[k + 1] - start), jacobianProperties_[k]};
+  return {jacobianMatrix_.middleCols(start + loc.second.start, loc.second.dim),
+          slice_matrix::slice(jacobianProperties_[k])};
+}
+
+std::pair<int, Range> FirstOrderProvider::jacobianLocation(const Variable & x) const
+{
+  const auto & vars = variables_.variables();
+  for(size_t k = 0; k < vars.size(); ++k)
+  {
+    const auto & v = *vars[k];
+    if(v.contains(x))
+    {
+      if(v == x)
+        return {static_cast<int>(k), Range(0, v.space().tSize())};
+      return {static_cast<int>(k), v.tSubvariableRange().relativeRange(x.tSubvariableRange())};
+    }
+  }
+  throw std::out_of_range("[FirstOrderProvider::jacobian] Variable " + x.name() + " is not a variable of this object.");
+}
+
+void FirstOrderProvider::computeJacobianOffsets()
+{
+  jacobianOffsets_.resize(static_cast<size_t>(variables_.numberOfVariables()) + 1);
+  jacobianOffsets_[0] = 0;
+  for(int i = 0; i < variables_.numberOfVariables(); ++i)
+  {
+    auto k = static_cast<size_t>(i);
+    jacobianOffsets_[k + 1] = jacobianOffsets_[k] + static_cast<Eigen::DenseIndex>(variables_[i]->space().tSize());
+  }
+}
+
 void FirstOrderProvider::resize(int m)
 {
   assert(imageSpace_.isEuclidean());
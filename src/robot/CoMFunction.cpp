@@ -2,6 +2,8 @@
 
 #include <tvm/robot/CoMFunction.h>
 
+#include <tvm/utils/CloneMap.h>
+
 namespace tvm
 {
 
@@ -31,6 +33,13 @@ CoMFunction::CoMFunction(RobotPtr robot) : function::abstract::Function(3), robo
   addInputDependency<CoMFunction>(Update::JDot, robot_, Robot::Output::NormalAcceleration);
 }
 
+FunctionPtr CoMFunction::clone(utils::CloneMap & map) const
+{
+  auto f = std::make_shared<CoMFunction>(map.robot(robot_));
+  f->com(com_);
+  return f;
+}
+
 void CoMFunction::reset() { com_ = robot_->com(); }
 
 void CoMFunction::updateValue() { value_ = robot_->com() - com_; }
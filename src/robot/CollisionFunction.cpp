@@ -19,6 +19,8 @@ CollisionFunction::CollisionFunction(Clock & clock)
                   &CollisionFunction::updateTimeDependency, Update::NormalAcceleration,
                   &CollisionFunction::updateNormalAcceleration);
 
+  useFlatJacobian();
+
   addOutputDependency<CollisionFunction>(Output::Value, Update::Value);
   addOutputDependency<CollisionFunction>(Output::Velocity, Update::Velocity);
   addOutputDependency<CollisionFunction>(Output::Jacobian, Update::Jacobian);
@@ -63,8 +65,11 @@ CollisionFunction::CollisionData::CollisionData(CollisionFunction & fn, ConvexHu
       fn.addInputDependency<CollisionFunction>(Update::Value, *ch_[i], ConvexHull::Output::Position);
       fn.addInputDependency<CollisionFunction>(Update::Jacobian, r, Robot::Output::FV);
       fn.addInputDependency<CollisionFunction>(Update::NormalAcceleration, r, Robot::Output::NormalAcceleration);
-      objects_.push_back({Eigen::Vector3d::Zero(), ch_[i]->frame().rbdJacobian()});
       fn.addVariable(r.q(), false);
+      // Variables are only appended, so that these indices stay valid when other collisions are added.
+      int ffSlot = r.qFreeFlyer()->space().tSize() ? fn.variables().indexOf(*r.qFreeFlyer()) : -1;
+      int jointsSlot = r.qJoints()->space().tSize() ? fn.variables().indexOf(*r.qJoints()) : -1;
+      objects_.push_back({Eigen::Vector3d::Zero(), ch_[i]->frame().rbdJacobian(), ffSlot, jointsSlot});
     }
   }
 }
@@ -95,10 +100,7 @@ void CollisionFunction::updateValue()
 
 void CollisionFunction::updateJacobian()
 {
-  for(int i = 0; i < variables_.numberOfVariables(); ++i)
-  {
-    jacobian_[variables_[i].get()].setZero();
-  }
+  jacobianMatrix_.setZero();
   Eigen::DenseIndex i = 0;
   for(auto & col : colls_)
   {
@@ -115,11 +117,11 @@ void CollisionFunction::updateJacobian()
       int jSize = r.qJoints()->space().tSize();
       if(ffSize)
       {
-        jacobian_[r.qFreeFlyer().get()].block(i, 0, 1, ffSize) += fullJac_.block(0, 0, 1, ffSize);
+        jacobianSlot(o.ffSlot_).block(i, 0, 1, ffSize) += fullJac_.block(0, 0, 1, ffSize);
       }
       if(jSize)
       {
-        jacobian_[r.qJoints().get()].block(i, 0, 1, jSize) += fullJac_.block(0, ffSize, 1, jSize);
+        jacobianSlot(o.jointsSlot_).block(i, 0, 1, jSize) += fullJac_.block(0, ffSize, 1, jSize);
       }
       sign *= -1.;
     }
@@ -208,6 +208,28 @@ void DynamicFunction::updateJacobian()
   }
 }
 
+bool DynamicFunction::jacobianParentArray(const std::vector<VariablePtr> & x, std::vector<int> & lambda) const
+{
+  // Compare the non-empty variables only (the free-flyer is empty for a fixed-base robot)
+  auto nonEmpty = [](const std::vector<VariablePtr> & vars) {
+    std::vector<const Variable *> ret;
+    for(const auto & v : vars)
+    {
+      if(v->size() > 0)
+      {
+        ret.push_back(v.get());
+      }
+    }
+    return ret;
+  };
+  if(nonEmpty(x) != nonEmpty(dot(robot_->q(), 2).variables()))
+  {
+    return false;
+  }
+  lambda = robot_->dofParents();
+  return true;
+}
+
 std::vector<DynamicFunction::ForceContact>::iterator DynamicFunction::getContact(const Contact::Id & id)
 {
   return std::find_if(contacts_.begin(), contacts_.end(), [&id](const ForceContact & in) { return in.id_ == id; });
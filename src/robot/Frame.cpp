@@ -3,6 +3,7 @@
 #include <tvm/robot/Frame.h>
 
 #include <tvm/Robot.h>
+#include <tvm/utils/CloneMap.h>
 
 namespace
 {
@@ -24,6 +25,25 @@ Frame::Frame(std::string name, RobotPtr robot, const std::string & body, sva::PT
 : name_(std::move(name)), robot_(robot), bodyId_(robot->mb().bodyIndexByName(body)), jac_(robot->mb(), body),
   X_b_f_(std::move(X_b_f)), jacTmp_(6, jac_.dof()),
   jacobian_(6, robot->mb().nrDof()) // FIXME Don't allocate until needed?
+{
+  registerUpdatesAndDependencies();
+
+  /** Initialize all data */
+  updatePosition();
+  updateJacobian();
+  updateVelocity();
+  updateNormalAcceleration();
+}
+
+Frame::Frame(const Frame & other, RobotPtr robot)
+: name_(other.name_), robot_(robot), bodyId_(other.bodyId_), jac_(other.jac_), X_b_f_(other.X_b_f_),
+  position_(other.position_), jacTmp_(other.jacTmp_), jacobian_(other.jacobian_), velocity_(other.velocity_),
+  normalAcceleration_(other.normalAcceleration_)
+{
+  registerUpdatesAndDependencies();
+}
+
+void Frame::registerUpdatesAndDependencies()
 {
   registerUpdates(Update::Position, &Frame::updatePosition, Update::Jacobian, &Frame::updateJacobian, Update::Velocity,
                   &Frame::updateVelocity, Update::NormalAcceleration, &Frame::updateNormalAcceleration);
@@ -40,12 +60,6 @@ Frame::Frame(std::string name, RobotPtr robot, const std::string & body, sva::PT
 
   addOutputDependency(Output::NormalAcceleration, Update::NormalAcceleration);
   addInputDependency(Update::NormalAcceleration, robot_, Robot::Output::NormalAcceleration);
-
-  /** Initialize all data */
-  updatePosition();
-  updateJacobian();
-  updateVelocity();
-  updateNormalAcceleration();
 }
 
 void Frame::updatePosition()
@@ -74,4 +88,23 @@ const std::string & Frame::body() const { return robot_->mb().body(bodyId_).name
 
 } // namespace robot
 
+namespace utils
+{
+
+robot::FramePtr CloneMap::frame(const robot::FramePtr & f)
+{
+  auto it = frames_.find(f.get());
+  if(it != frames_.end())
+  {
+    return it->second;
+  }
+
+  robot::FramePtr c(new robot::Frame(*f, robot(f->robot_)));
+  frames_[f.get()] = c;
+  source(*f, *c);
+  return c;
+}
+
+} // namespace utils
+
 } // namespace tvm
@@ -3,6 +3,7 @@
 #include <tvm/robot/JointsSelector.h>
 
 #include <tvm/exception/exceptions.h>
+#include <tvm/utils/CloneMap.h>
 
 namespace tvm
 {
@@ -120,6 +121,9 @@ JointsSelector::JointsSelector(FunctionPtr f,
   }
 }
 
+FunctionPtr JointsSelector::clone(utils::CloneMap & map) const
+{ return FunctionPtr(new JointsSelector(map.function(f_), map.robot(robot_), ffActive_, activeIndex_)); }
+
 void JointsSelector::updateJacobian()
 {
   if(ffActive_)
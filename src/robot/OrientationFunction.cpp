@@ -2,6 +2,7 @@
 
 #include <tvm/Robot.h>
 #include <tvm/robot/OrientationFunction.h>
+#include <tvm/utils/CloneMap.h>
 
 namespace tvm
 {
@@ -30,6 +31,13 @@ OrientationFunction::OrientationFunction(FramePtr frame) : function::abstract::F
   addInputDependency<OrientationFunction>(Update::NormalAcceleration, frame_, Frame::Output::NormalAcceleration);
 }
 
+FunctionPtr OrientationFunction::clone(utils::CloneMap & map) const
+{
+  auto f = std::make_shared<OrientationFunction>(map.frame(frame_));
+  f->orientation(ori_);
+  return f;
+}
+
 void OrientationFunction::reset() { ori_ = frame_->position().rotation(); }
 
 void OrientationFunction::updateValue() { value_ = sva::rotationError(ori_, frame_->position().rotation()); }
@@ -2,6 +2,7 @@
 
 #include <tvm/Robot.h>
 #include <tvm/robot/PositionFunction.h>
+#include <tvm/utils/CloneMap.h>
 
 namespace tvm
 {
@@ -30,6 +31,13 @@ PositionFunction::PositionFunction(FramePtr frame) : function::abstract::Functio
   addInputDependency<PositionFunction>(Update::NormalAcceleration, frame_, Frame::Output::NormalAcceleration);
 }
 
+FunctionPtr PositionFunction::clone(utils::CloneMap & map) const
+{
+  auto f = std::make_shared<PositionFunction>(map.frame(frame_));
+  f->position(pos_);
+  return f;
+}
+
 void PositionFunction::reset() { pos_ = frame_->position().translation(); }
 
 void PositionFunction::updateValue() { value_ = frame_->position().translation() - pos_; }
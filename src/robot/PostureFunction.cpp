@@ -2,6 +2,8 @@
 
 #include <tvm/robot/PostureFunction.h>
 
+#include <tvm/utils/CloneMap.h>
+
 namespace tvm
 {
 
@@ -30,6 +32,13 @@ PostureFunction::PostureFunction(RobotPtr robot)
   reset();
 }
 
+FunctionPtr PostureFunction::clone(utils::CloneMap & map) const
+{
+  auto f = std::make_shared<PostureFunction>(map.robot(robot_));
+  f->posture(posture_);
+  return f;
+}
+
 void PostureFunction::reset() { posture_ = robot_->mbc().q; }
 
 void PostureFunction::posture(const std::string & j, const std::vector<double> & q)
@@ -15,15 +15,14 @@ using constraint::RHS;
 using constraint::Type;
 using constraint::abstract::LinearConstraint;
 
-double Assignment::big_ = constant::big_number;
-
 Assignment::Assignment(LinearConstraintPtr source,
                        SolvingRequirementsPtr req,
                        const AssignmentTarget & target,
                        const VariableVector & variables,
                        const hint::internal::Substitutions * const substitutions,
-                       double scalarizationWeight)
-: source_(source), target_(target), scalarizationWeight_(scalarizationWeight), requirements_(req),
+                       double scalarizationWeight,
+                       double big)
+: source_(source), target_(target), scalarizationWeight_(scalarizationWeight), big_(big), requirements_(req),
   substitutedVariables_(substitutions ? substitutions->variables() : VariableVector()),
   variableSubstitutions_(substitutions ? substitutions->variableSubstitutions()
                                        : std::vector<std::shared_ptr<function::BasicLinearFunction>>()),
@@ -38,9 +37,10 @@ Assignment::Assignment(LinearConstraintPtr source,
 Assignment::Assignment(LinearConstraintPtr source,
                        const AssignmentTarget & target,
                        const VariablePtr & variable,
-                       bool first)
-: source_(source), target_(target), requirements_(nullptr), useDefaultScalarWeight_(true),
-  useDefaultAnisotropicWeight_(true), data_(new ReferenceableData())
+                       bool first,
+                       double big)
+: source_(source), target_(target), big_(big), requirements_(nullptr), useDefaultScalarWeight_(true),
+  useDefaultAnisotropicWeight_(true), bound_(true), first_(first), data_(new ReferenceableData())
 {
   checkBounds();
   assert(source->variables()[0] == variable);
@@ -50,10 +50,13 @@ Assignment::Assignment(LinearConstraintPtr source,
 Assignment Assignment::reprocess(const Assignment & other,
                                  const VariableVector & variables,
                                  const hint::internal::Substitutions * const subs)
-{ return Assignment(other.source_, other.requirements_, other.target_, variables, subs, other.scalarizationWeight_); }
+{
+  return Assignment(other.source_, other.requirements_, other.target_, variables, subs, other.scalarizationWeight_,
+                    other.big_);
+}
 
 Assignment Assignment::reprocess(const Assignment & other, const VariablePtr & x, bool first)
-{ return Assignment(other.source_, other.target_, x, first); }
+{ return Assignment(other.source_, other.target_, x, first, other.big_); }
 
 AssignmentTarget & Assignment::target(IWontForgetToCallUpdates) { return target_; }
 
@@ -114,6 +117,12 @@ void Assignment::onUpdateWeights(bool scalar, bool vector)
 
 void Assignment::run()
 {
+  if(!source_->isEnabled())
+  {
+    runDisabled();
+    return;
+  }
+
   for(auto & a : matrixAssignments_)
     a.assignment.run();
 
@@ -125,10 +134,121 @@ void Assignment::run()
 
   for(auto & a : vectorSubstitutionAssignments_)
     a.assignment.run();
+
+  if(!source_->isLowerEnabled() || !source_->isUpperEnabled())
+    relaxDisabledSides();
+}
+
+void Assignment::runDisabled()
+{
+  assert(target_.targetType() == TargetType::Linear && "Quadratic targets are rejected by checkTarget");
+
+  if(bound_)
+  {
+    // Only the first assignment for a variable sets the bounds, the following
+    // ones are taking min/max with it.
+    if(!first_)
+      return;
+    switch(target_.constraintType())
+    {
+      case Type::GREATER_THAN:
+        target_.b().setConstant(-big_);
+        break;
+      case Type::LOWER_THAN:
+        target_.b().setConstant(+big_);
+        break;
+      case Type::DOUBLE_SIDED:
+        target_.l().setConstant(-big_);
+        target_.u().setConstant(+big_);
+        break;
+      default:
+        assert(false);
+    }
+    return;
+  }
+
+  // 0 = 0, 0 >= -big, 0 <= big or -big <= 0 <= big, depending on the
+  // conventions of the target.
+  target_.A().setZero();
+  const double s = target_.constraintRhs() == RHS::OPPOSITE ? -1 : 1;
+  switch(target_.constraintType())
+  {
+    case Type::EQUAL:
+      if(target_.constraintRhs() != RHS::ZERO)
+        target_.b().setZero();
+      break;
+    case Type::GREATER_THAN:
+      if(target_.constraintRhs() != RHS::ZERO)
+        target_.b().setConstant(-s * big_);
+      break;
+    case Type::LOWER_THAN:
+      if(target_.constraintRhs() != RHS::ZERO)
+        target_.b().setConstant(s * big_);
+      break;
+    case Type::DOUBLE_SIDED:
+      target_.l().setConstant(-s * big_);
+      target_.u().setConstant(s * big_);
+      break;
+  }
+}
+
+void Assignment::relaxDisabledSides()
+{
+  assert(source_->type() == Type::DOUBLE_SIDED);
+  const bool lower = source_->isLowerEnabled();
+  const bool upper = source_->isUpperEnabled();
+
+  if(bound_)
+  {
+    // The disabled side of the source is infinite, so that the min/max taken
+    // by the following assignments leave the bounds unchanged. Only the first
+    // assignment needs to replace it by a finite value.
+    if(!first_ || target_.constraintType() != Type::DOUBLE_SIDED)
+      return;
+    if(!lower)
+      target_.l().setConstant(-big_);
+    if(!upper)
+      target_.u().setConstant(+big_);
+    return;
+  }
+
+  // Same conventions as in runDisabled. For single-sided targets, the rows
+  // l <= Ax have been written in one half of the target, and Ax <= u in the
+  // other one (see build).
+  const double s = target_.constraintRhs() == RHS::OPPOSITE ? -1 : 1;
+  switch(target_.constraintType())
+  {
+    case Type::GREATER_THAN:
+      if(!lower)
+        target_.bFirstHalf().setConstant(-s * big_);
+      if(!upper)
+        target_.bSecondHalf().setConstant(-s * big_);
+      break;
+    case Type::LOWER_THAN:
+      if(!upper)
+        target_.bFirstHalf().setConstant(s * big_);
+      if(!lower)
+        target_.bSecondHalf().setConstant(s * big_);
+      break;
+    case Type::DOUBLE_SIDED:
+      if(!lower)
+        target_.l().setConstant(-s * big_);
+      if(!upper)
+        target_.u().setConstant(s * big_);
+      break;
+    default:
+      assert(false);
+  }
 }
 
 void Assignment::checkTarget()
 {
+  // Assigning to a quadratic target would require to accumulate the
+  // contributions of all the sources in Q and q, and to take them out when a
+  // source is disabled.
+  if(target_.targetType() == TargetType::Quadratic)
+    throw std::runtime_error("Assignment to a quadratic target is not implemented.");
+
   // check the type convention
   if(source_->type() == Type::EQUAL)
   {
@@ -413,9 +533,16 @@ void Assignment::processRequirements()
 
 void Assignment::addMatrixAssignment(Variable & x, MatrixFunction M, const Range & range, bool flip)
 {
-  MatrixConstRef from = source_->jacobian(x);
+  auto J = source_->jacobian(x);
+  MatrixConstRef from = J;
   const MatrixRef & to = (target_.*M)(range.start, range.dim);
-  auto w = createAssignment<Eigen::MatrixXd, AssignType::COPY>(from, to, flip);
+  CompiledAssignmentWrapper<Eigen::MatrixXd> w;
+  // For (multiple of) identity or diagonal jacobians, e.g. coming from utils::AffineExpr, we only write the diagonal
+  // instead of copying the dense matrix.
+  if(J.properties().isDiagonal() && from.rows() == from.cols())
+    w = createDiagonalAssignment<AssignType::COPY>(from, to, flip);
+  else
+    w = createAssignment<Eigen::MatrixXd, AssignType::COPY>(from, to, flip);
 
   matrixAssignments_.push_back({w, &x, range, M});
 }
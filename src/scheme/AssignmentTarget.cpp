@@ -70,6 +70,9 @@ MatrixRef AssignmentTarget::A(int colStart, int colDim) const
   return MatrixRef(static_cast<MatrixRef>(A_).block(range_->start, colStart, range_->dim, colDim));
 }
 
+MatrixRef AssignmentTarget::A() const
+{ return MatrixRef(static_cast<MatrixRef>(A_).middleRows(range_->start, range_->dim)); }
+
 MatrixRef AssignmentTarget::Q() const { return Q_; }
 
 VectorRef AssignmentTarget::l() const
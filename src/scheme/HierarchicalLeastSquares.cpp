@@ -166,9 +166,6 @@ void HierarchicalLeastSquares::processProblem(const LinearizedControlProblem & p
     nIneq.push_back(0);
   }
 
-  // configure assignments. FIXME: can we find a better way ?
-  Assignment::big_ = big_number_;
-
   // allocating memory for the solver
   solver.startBuild(memory->variables(), nEq, nIneq, bounds.size() > 0, &subs);
 
@@ -47,13 +47,14 @@ void WeightedLeastSquares::updateComputationData_(const LinearizedControlProblem
   {
     Memory * memory = static_cast<Memory *>(data);
 
-    // If some events require to rebuild the data, we skip all other events.
+    // Changes of the substitutions are processed first, so that the other events
+    // are processed with the current substitutions.
     for(const auto & e : memory->events())
     {
       if(e.type() == EventType::SubstitutionAddition || e.type() == EventType::SubstitutionRemoval)
       {
-        resetComputationData(problem, memory);
-        return;
+        updateSubstitutions(problem, memory, se);
+        break;
       }
     }
     while(memory->hasEvents())
@@ -85,6 +86,9 @@ void WeightedLeastSquares::updateComputationData_(const LinearizedControlProblem
         case EventType::TaskRemoval:
           removeTask(problem, memory, e.typedEmitter<EventType::TaskRemoval>(), se);
           break;
+        case EventType::SubstitutionAddition:
+        case EventType::SubstitutionRemoval:
+          break; // Already processed by updateSubstitutions
         default:
           throw std::runtime_error("[WeightedLeastSquares::updateComputationData_] Unimplemented event handling.");
       }
@@ -113,6 +117,8 @@ void WeightedLeastSquares::resetComputationData(const LinearizedControlProblem &
 void WeightedLeastSquares::processProblem(const LinearizedControlProblem & problem, Memory * memory) const
 {
   auto & solver = *memory->solver;
+  if(options_.recorder())
+    solver.recorder(options_.recorder().value());
 
   const auto & constraints = problem.constraints();
   const auto & subs = problem.substitutions();
@@ -173,9 +179,6 @@ void WeightedLeastSquares::processProblem(const LinearizedControlProblem & probl
     autoMinNorm = true;
   }
 
-  // configure assignments. FIXME: can we find a better way ?
-  Assignment::big_ = big_number_;
-
   // allocating memory for the solver
   solver.startBuild(memory->variables(), nObj, nEq, nIneq, bounds.size() > 0, &subs);
   // memory->assignments.reserve(constr.size() + bounds.size()); //TODO something equivalent
@@ -216,6 +219,7 @@ void WeightedLeastSquares::processProblem(const LinearizedControlProblem & probl
   }
 
   solver.finalizeBuild();
+  memory->saveSubstitutions(subs);
 }
 
 void WeightedLeastSquares::addTask(const LinearizedControlProblem & problem,
@@ -235,6 +239,10 @@ void WeightedLeastSquares::addTask(const LinearizedControlProblem & problem,
   memory->addConstraint(task, c);
   const auto & subs = problem.substitutions();
 
+  // A constraint used by a substitution is not passed to the solver.
+  if(subs.uses(c.constraint))
+    return;
+
   abilities_.check(c.constraint, c.requirements);
   for(const auto & xi : c.constraint->variables())
   {
@@ -313,6 +321,138 @@ void WeightedLeastSquares::removeTask(const LinearizedControlProblem & problem,
   memory->removeConstraint(task);
 }
 
+void WeightedLeastSquares::updateSubstitutions(const LinearizedControlProblem & problem,
+                                               Memory * memory,
+                                               solver::internal::SolverEvents & se) const
+{
+  const auto & subs = problem.substitutions();
+  const auto & oldX = memory->substitutedVariables;
+  const auto & oldF = memory->substitutionFunctions;
+  const auto & oldUses = memory->substitutionUses;
+
+  // The function used to substitute (part of) x, or nullptr if x is not substituted.
+  auto substitutionFunction = [](const VariablePtr & x, const auto & xs, const auto & fs) {
+    auto it = std::find_if(xs.begin(), xs.end(), [&x](const VariablePtr & v) { return v->intersects(*x); });
+    return it == xs.end() ? nullptr : fs[static_cast<size_t>(it - xs.begin())].get();
+  };
+
+  enum class Kind
+  {
+    None,
+    Bound,
+    Constraint,
+    Objective
+  };
+
+  for(const auto & tc : memory->constraintMap())
+  {
+    const auto & c = tc.second;
+    bool wasUsed = std::find(oldUses.begin(), oldUses.end(), c.constraint) != oldUses.end();
+    bool isUsed = subs.uses(c.constraint);
+    bool affected = false;
+    for(const auto & xi : c.constraint->variables())
+    {
+      if(substitutionFunction(xi, oldX, oldF) != substitutionFunction(xi, subs.variables(), subs.variableSubstitutions()))
+      {
+        affected = true;
+        break;
+      }
+    }
+    if(!affected && wasUsed == isUsed)
+      continue;
+
+    // Variables
+    if(!wasUsed)
+    {
+      for(const auto & xi : c.constraint->variables())
+      {
+        for(const auto & si : hint::internal::Substitutions::substitute(xi, oldX, oldF))
+        {
+          if(memory->removeVariable(si.get()))
+            se.removeVariable(si);
+        }
+      }
+    }
+    if(!isUsed)
+    {
+      for(const auto & xi : c.constraint->variables())
+      {
+        for(const auto & si : subs.substitute(xi))
+        {
+          if(memory->addVariable(si))
+            se.addVariable(si);
+        }
+      }
+    }
+
+    // Constraint
+    int p = c.requirements->priorityLevel().value();
+    auto kind = [p](bool used, bool bound) {
+      if(used)
+        return Kind::None;
+      if(p > 0)
+        return Kind::Objective;
+      return bound ? Kind::Bound : Kind::Constraint;
+    };
+    Kind oldKind = kind(wasUsed, canBeUsedAsBound(c.constraint, oldX, oldF, constraint::Type::DOUBLE_SIDED));
+    Kind newKind = kind(isUsed, canBeUsedAsBound(c.constraint, subs, constraint::Type::DOUBLE_SIDED));
+    if(oldKind == newKind)
+    {
+      if(newKind == Kind::Constraint)
+        se.reprocessConstraint(c.constraint);
+      else if(newKind == Kind::Objective)
+        se.reprocessObjective(
+            {c.constraint, c.requirements, std::pow(*options_.scalarizationWeight(), memory->maxp - p)});
+      continue;
+    }
+    switch(oldKind)
+    {
+      case Kind::Bound:
+        se.removeBound(c.constraint);
+        break;
+      case Kind::Constraint:
+        se.removeConstraint(c.constraint);
+        break;
+      case Kind::Objective:
+        se.removeObjective(c.constraint);
+        break;
+      default:
+        break;
+    }
+    switch(newKind)
+    {
+      case Kind::Bound:
+        se.addBound(c.constraint);
+        break;
+      case Kind::Constraint:
+        se.addConstraint(c.constraint);
+        break;
+      case Kind::Objective:
+        se.addObjective({c.constraint, c.requirements, std::pow(*options_.scalarizationWeight(), memory->maxp - p)});
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Additional constraints. The ones of the substitution groups that did not
+  // change are kept.
+  const auto & oldC = memory->substitutionConstraints;
+  const auto & newC = subs.additionalConstraints();
+  for(const auto & c : oldC)
+  {
+    if(std::find(newC.begin(), newC.end(), c) == newC.end())
+      se.removeConstraint(c);
+  }
+  for(const auto & c : newC)
+  {
+    if(std::find(oldC.begin(), oldC.end(), c) == oldC.end())
+      se.addConstraint(c);
+  }
+
+  memory->saveSubstitutions(subs);
+}
+
 WeightedLeastSquares::Memory::Memory(int solverId, std::unique_ptr<solver::abstract::LeastSquareSolver> solver)
 : LinearizedProblemComputationData(solverId), solver(std::move(solver))
 {}
@@ -322,6 +462,22 @@ void WeightedLeastSquares::Memory::reset(std::unique_ptr<solver::abstract::Least
   LinearizedProblemComputationData::reset();
   this->solver = std::move(solver);
   maxp = 0;
+  substitutedVariables.clear();
+  substitutionFunctions.clear();
+  substitutionConstraints.clear();
+  substitutionUses.clear();
+}
+
+void WeightedLeastSquares::Memory::saveSubstitutions(const hint::internal::Substitutions & subs)
+{
+  substitutedVariables = subs.variables();
+  substitutionFunctions = subs.variableSubstitutions();
+  substitutionConstraints = subs.additionalConstraints();
+  substitutionUses.clear();
+  for(const auto & s : subs.substitutions())
+  {
+    substitutionUses.insert(substitutionUses.end(), s.constraints().begin(), s.constraints().end());
+  }
 }
 
 void WeightedLeastSquares::Memory::setVariablesToSolution_(tvm::internal::VariableCountingVector & x)
@@ -0,0 +1,602 @@
+/* Copyright 2022 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/solver/EigenHierarchicalLeastSquareSolver.h>
+
+#include <tvm/scheme/internal/AssignmentTarget.h>
+
+#include <Eigen/QR>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+/** Minimum tolerance used for the resolutions in single precision.*/
+constexpr double singlePrecisionTolerance = 1e-5;
+
+/** Write in the first columns of \p N a basis of the nullspace of \p M,
+ * obtained from the rank-revealing QR decomposition \p qr of M^T, and return
+ * its dimension.
+ */
+template<typename Scalar, typename Derived>
+Eigen::DenseIndex nullspace(const Eigen::MatrixBase<Derived> & M,
+                            Eigen::ColPivHouseholderQR<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>> & qr,
+                            Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> & N)
+{
+  const auto c = M.cols();
+  if(M.rows() == 0)
+  {
+    N.topLeftCorner(c, c).setIdentity();
+    return c;
+  }
+  qr.compute(M.transpose());
+  const auto d = c - qr.rank();
+  auto B = N.topLeftCorner(c, d);
+  B.topRows(c - d).setZero();
+  B.bottomRows(d).setIdentity();
+  B.applyOnTheLeft(qr.householderQ());
+  return d;
+}
+} // namespace
+
+namespace tvm
+{
+
+namespace solver
+{
+EigenHierarchicalLeastSquareSolver::EigenHierarchicalLeastSquareSolver(const EigenHLSSolverOptions & options)
+: HierarchicalLeastSquareSolver(options.verbose().value(), options.reuseUnchangedLevels().value()), data_(),
+  noBounds_(), xl_(noBounds_), xu_(noBounds_), A_(), l_(), u_(), x_(), success_(false), autoMinNorm_(false),
+  big_number_(options.big_number().value()), maxIterations_(options.maxIterations().value()),
+  refineSolution_(options.refineSolution().value()), reuseUnchangedLevels_(options.reuseUnchangedLevels().value()),
+  singlePrecision_(options.singlePrecision().value()), tol_(options.tolerance().value()),
+  warmStart_(options.warmStart().value())
+{}
+
+void EigenHierarchicalLeastSquareSolver::initializeBuild_(const std::vector<int> & nEq,
+                                                          const std::vector<int> & nIneq,
+                                                          bool useBounds)
+{
+  autoMinNorm_ = false;
+  resize_(nEq, nIneq, useBounds);
+}
+
+EigenHierarchicalLeastSquareSolver::ImpactFromChanges EigenHierarchicalLeastSquareSolver::resize_(
+    const std::vector<int> & nEq,
+    const std::vector<int> & nIneq,
+    bool useBounds)
+{
+  int n = variables().totalSize();
+  int nLvl = static_cast<int>(nEq.size());
+  ImpactFromChanges impact(nLvl);
+
+  // Create data for the new levels, before resizing and referencing
+  impact.newLevels_ = nLvl - static_cast<int>(data_.size());
+  Eigen::MatrixXd dummy(1, 1);
+  for(size_t i = data_.size(); i < static_cast<size_t>(nLvl); ++i)
+  {
+    data_.emplace_back();
+    A_.emplace_back(dummy.leftCols(1));
+    l_.emplace_back(dummy.col(0));
+    u_.emplace_back(dummy.col(0));
+  }
+
+  if(!useBounds)
+  {
+    new(&xl_) VectorRef(noBounds_);
+    new(&xu_) VectorRef(noBounds_);
+  }
+
+  for(int i = 0; i < nLvl; ++i)
+  {
+    int m = nEq[i] + nIneq[i];
+    if(i == 0 && useBounds)
+    {
+      impact.equalityConstraints_[i] = ImpactFromChanges::willReallocate(data_[i], m + n, n + 2);
+      data_[i].resize(m + n, n + 2);
+      new(&xl_) VectorRef(data_[i].col(n).head(n));
+      new(&xu_) VectorRef(data_[i].col(n + 1).head(n));
+      data_[i].topLeftCorner(n, n).setIdentity();
+      xl_.setConstant(-big_number_);
+      xu_.setConstant(+big_number_);
+      new(&A_[i]) MatrixRef(data_[i].leftCols(n).bottomRows(m));
+      new(&l_[i]) VectorRef(data_[i].col(n).tail(m));
+      new(&u_[i]) VectorRef(data_[i].col(n + 1).tail(m));
+    }
+    else
+    {
+      impact.equalityConstraints_[i] = ImpactFromChanges::willReallocate(data_[i], m, n + 2);
+      data_[i].resize(m, n + 2);
+      new(&A_[i]) MatrixRef(data_[i].leftCols(n));
+      new(&l_[i]) VectorRef(data_[i].col(n));
+      new(&u_[i]) VectorRef(data_[i].col(n + 1));
+    }
+    A_[i].setZero();
+    l_[i].setConstant(-big_number_);
+    u_[i].setConstant(+big_number_);
+
+    impact.inequalityConstraints_[i] = impact.equalityConstraints_[i];
+  }
+
+  if(autoMinNorm_)
+  {
+    A_.back().setIdentity();
+    l_.back().setZero();
+    u_.back().setZero();
+  }
+
+  Eigen::DenseIndex maxRows = 0;
+  Eigen::DenseIndex totalRows = 0;
+  for(const auto & D : data_)
+  {
+    maxRows = std::max(maxRows, D.rows());
+    totalRows += D.rows();
+  }
+  if(!singlePrecision_ || refineSolution_)
+    workspaceD_.resize(n, maxRows, totalRows);
+  if(singlePrecision_)
+    workspaceF_.resize(n, maxRows, totalRows);
+
+  x_ = Eigen::VectorXd::Zero(n);
+  states_.clear();
+  activeSets_.assign(static_cast<size_t>(nLvl), {});
+  iterations_.assign(static_cast<size_t>(nLvl), 0);
+  refinementIterations_.assign(static_cast<size_t>(nLvl), 0);
+  success_ = false;
+
+  return impact;
+}
+
+void EigenHierarchicalLeastSquareSolver::addBound_(LinearConstraintPtr bound, RangePtr range, bool first)
+{
+  scheme::internal::AssignmentTarget target(range, xl_, xu_);
+  addAssignement(bound, target, bound->variables()[0], first, big_number_);
+}
+
+void EigenHierarchicalLeastSquareSolver::addEqualityConstraint_(LinearConstraintPtr cstr, SolvingRequirementsPtr req)
+{
+  int lvl = req->priorityLevel().value();
+  RangePtr r = std::make_shared<Range>(nextEqualityConstraintRange_(lvl, *cstr));
+  scheme::internal::AssignmentTarget target(r, A_[lvl], l_[lvl], u_[lvl], constraint::RHS::AS_GIVEN);
+  addAssignement(cstr, req, target, variables(), substitutions(), 1., big_number_);
+}
+
+void EigenHierarchicalLeastSquareSolver::addIneqalityConstraint_(LinearConstraintPtr cstr, SolvingRequirementsPtr req)
+{
+  int lvl = req->priorityLevel().value();
+  RangePtr r = std::make_shared<Range>(nextInequalityConstraintRange_(lvl, *cstr));
+  scheme::internal::AssignmentTarget target(r, A_[lvl], l_[lvl], u_[lvl], constraint::RHS::AS_GIVEN);
+  addAssignement(cstr, req, target, variables(), substitutions(), 1., big_number_);
+}
+
+void EigenHierarchicalLeastSquareSolver::setMinimumNorm_()
+{
+  autoMinNorm_ = true;
+  A_.back().setIdentity();
+  l_.back().setZero();
+  u_.back().setZero();
+}
+
+void EigenHierarchicalLeastSquareSolver::resetBounds_()
+{
+  xl_.setConstant(-big_number_);
+  xu_.setConstant(+big_number_);
+}
+
+bool EigenHierarchicalLeastSquareSolver::solve_()
+{
+  int n = variables().totalSize();
+  int nLvl = static_cast<int>(data_.size());
+
+  int start = 0;
+  if(reuseUnchangedLevels_ && success_ && static_cast<int>(states_.size()) == nLvl)
+    start = firstChangedLevel();
+  else
+    states_.resize(static_cast<size_t>(nLvl));
+
+  State<double> s;
+  if(start == 0)
+  {
+    s.x = Eigen::VectorXd::Zero(n);
+    s.Z = Eigen::MatrixXd::Identity(n, n);
+  }
+  else
+  {
+    s = states_[static_cast<size_t>(start - 1)];
+  }
+  std::fill(iterations_.begin(), iterations_.begin() + start, 0);
+  std::fill(refinementIterations_.begin(), refinementIterations_.end(), 0);
+
+  success_ = true;
+  if(singlePrecision_)
+  {
+    auto sf = s.cast<float>();
+    double tol = std::max(tol_, singlePrecisionTolerance);
+    for(int i = start; i < nLvl && success_; ++i)
+    {
+      success_ = solveLevel(i, sf, tol, warmStart_, iterations_[static_cast<size_t>(i)]);
+      if(success_ && reuseUnchangedLevels_ && !refineSolution_)
+        states_[static_cast<size_t>(i)] = sf.cast<double>();
+    }
+    if(!success_ || !refineSolution_)
+    {
+      x_ = sf.x.cast<double>();
+      return success_;
+    }
+  }
+
+  // In single precision mode, this is the refinement, warm started with the
+  // active sets found in single precision.
+  for(int i = start; i < nLvl && success_; ++i)
+  {
+    auto & it = singlePrecision_ ? refinementIterations_ : iterations_;
+    success_ = solveLevel(i, s, tol_, warmStart_ || singlePrecision_, it[static_cast<size_t>(i)]);
+    if(success_ && reuseUnchangedLevels_)
+      states_[static_cast<size_t>(i)] = s;
+  }
+  x_ = s.x;
+
+  return success_;
+}
+
+template<typename Scalar>
+void EigenHierarchicalLeastSquareSolver::Workspace<Scalar>::resize(Eigen::DenseIndex n,
+                                                                   Eigen::DenseIndex maxRows,
+                                                                   Eigen::DenseIndex totalRows)
+{
+  // The unknowns of a level are the variables and the violations of its
+  // inequality rows. Each row of the problem yields at most two constraints.
+  const auto nz = n + maxRows;
+  const auto nc = 2 * totalRows;
+  if constexpr(!std::is_same_v<Scalar, double>)
+    A.resize(maxRows, n);
+  AZ.resize(maxRows, n);
+  M.resize(maxRows, nz);
+  q.resize(maxRows);
+  res.resize(maxRows);
+  G.resize(nc, nz);
+  beta.reserve(static_cast<size_t>(nc));
+  ids.reserve(static_cast<size_t>(nc));
+  W.reserve(static_cast<size_t>(nc));
+  GW.resize(nc, nz);
+  z.resize(nz);
+  dz.resize(nz);
+  lambda.resize(nc);
+  g.resize(nz);
+  ah.resize(n);
+  N.resize(nz, nz);
+  MN.resize(maxRows, nz);
+  FZ.resize(maxRows, n);
+  t.resize(nz);
+  rhs.resize(nz);
+  eq.reserve(static_cast<size_t>(maxRows));
+  ineq.reserve(static_cast<size_t>(maxRows));
+  fixed.reserve(static_cast<size_t>(maxRows));
+}
+
+template<typename Scalar>
+EigenHierarchicalLeastSquareSolver::Workspace<Scalar> & EigenHierarchicalLeastSquareSolver::workspace()
+{
+  if constexpr(std::is_same_v<Scalar, double>)
+    return workspaceD_;
+  else
+    return workspaceF_;
+}
+
+template<typename Scalar>
+bool EigenHierarchicalLeastSquareSolver::solveLevel(int lvl,
+                                                    State<Scalar> & s,
+                                                    double tol,
+                                                    bool warmStart,
+                                                    int & iterations)
+{
+  using MatrixX = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  auto & ws = workspace<Scalar>();
+
+  // The bounds are kept in double precision, as the infinite ones may not be
+  // representable in single precision. A is copied only in single precision.
+  const auto & D = data_[static_cast<size_t>(lvl)];
+  const auto m = D.rows();
+  const auto n = D.cols() - 2;
+  const Eigen::Ref<const MatrixX> A = [&]() -> Eigen::Ref<const MatrixX> {
+    if constexpr(std::is_same_v<Scalar, double>)
+      return D.leftCols(n);
+    else
+    {
+      ws.A.topRows(m) = D.leftCols(n).template cast<Scalar>();
+      return ws.A.topRows(m);
+    }
+  }();
+  const auto l = D.col(n);
+  const auto u = D.col(n + 1);
+  const auto k = s.Z.cols();
+  auto AZ = ws.AZ.topLeftCorner(m, k);
+  AZ.noalias() = A * s.Z;
+
+  // Sort the rows of the level. Rows without finite bounds are ignored.
+  auto & eq = ws.eq;
+  auto & ineq = ws.ineq;
+  eq.clear();
+  ineq.clear();
+  for(int r = 0; r < static_cast<int>(m); ++r)
+  {
+    bool lf = l[r] > -big_number_;
+    bool uf = u[r] < big_number_;
+    if(lf && uf && u[r] - l[r] <= tol)
+      eq.push_back(r);
+    else if(lf || uf)
+      ineq.push_back(r);
+  }
+  const auto p = static_cast<Eigen::DenseIndex>(ineq.size());
+  const auto nz = k + p;
+
+  // The unknowns are z = (y, w_ineq), with x = s.x + Z y. The objective is
+  // ||M z - q||^2: the equality rows and the violations of the inequality rows.
+  auto M = ws.M.topLeftCorner(static_cast<Eigen::DenseIndex>(eq.size()) + p, nz);
+  auto q = ws.q.head(M.rows());
+  M.setZero();
+  q.setZero();
+  for(size_t i = 0; i < eq.size(); ++i)
+  {
+    auto r = eq[i];
+    M.row(static_cast<Eigen::DenseIndex>(i)).head(k) = AZ.row(r);
+    q[static_cast<Eigen::DenseIndex>(i)] = static_cast<Scalar>(l[r]) - A.row(r).dot(s.x);
+  }
+  M.bottomRightCorner(p, p).setIdentity();
+
+  // Constraints G z >= beta, with their origin.
+  auto & ids = ws.ids;
+  auto & beta = ws.beta;
+  ids.clear();
+  beta.clear();
+  auto g = ws.g.head(nz);
+  auto addConstraint = [&](const RowBound & id, Scalar sign, Scalar b) {
+    ws.G.row(static_cast<Eigen::DenseIndex>(ids.size())).head(nz) = sign * g.transpose();
+    ids.push_back(id);
+    beta.push_back(b);
+  };
+  auto z = ws.z.head(nz);
+  z.setZero();
+  for(Eigen::DenseIndex j = 0; j < p; ++j)
+  {
+    auto r = ineq[static_cast<size_t>(j)];
+    Scalar ax = A.row(r).dot(s.x);
+    auto lr = static_cast<Scalar>(l[r]);
+    auto ur = static_cast<Scalar>(u[r]);
+    g.setZero();
+    g.head(k) = AZ.row(r).transpose();
+    g[k + j] = 1;
+    if(l[r] > -big_number_)
+      addConstraint({lvl, r, false}, 1, lr - ax);
+    if(u[r] < big_number_)
+      addConstraint({lvl, r, true}, -1, ax - ur);
+
+    // Initial violation: minimal, or such that the row is at the bound it was
+    // active on at the previous resolution.
+    const auto & prev = activeSets_[static_cast<size_t>(lvl)];
+    if(warmStart && std::find(prev.begin(), prev.end(), RowBound{lvl, r, false}) != prev.end())
+      z[k + j] = lr - ax;
+    else if(warmStart && std::find(prev.begin(), prev.end(), RowBound{lvl, r, true}) != prev.end())
+      z[k + j] = ur - ax;
+    else if(ax < l[r])
+      z[k + j] = lr - ax;
+    else if(ax > u[r])
+      z[k + j] = ur - ax;
+  }
+  auto ah = ws.ah.head(n);
+  for(const auto & h : s.inequalities)
+  {
+    const auto & Dh = data_[static_cast<size_t>(h.first)];
+    ah = Dh.row(h.second).head(n).transpose().template cast<Scalar>();
+    g.setZero();
+    g.head(k).noalias() = s.Z.transpose() * ah;
+    // Constraints that Z cannot change anymore remain satisfied.
+    if(g.norm() <= tol)
+      continue;
+    Scalar ax = ah.dot(s.x);
+    double lh = Dh(h.second, n);
+    double uh = Dh(h.second, n + 1);
+    if(lh > -big_number_)
+      addConstraint({h.first, h.second, false}, 1, static_cast<Scalar>(lh) - ax);
+    if(uh < big_number_)
+      addConstraint({h.first, h.second, true}, -1, ax - static_cast<Scalar>(uh));
+  }
+  const auto G = ws.G.topLeftCorner(static_cast<Eigen::DenseIndex>(ids.size()), nz);
+
+  // Initial working set
+  auto & W = ws.W;
+  W.clear();
+  if(warmStart)
+  {
+    const auto & prev = activeSets_[static_cast<size_t>(lvl)];
+    for(size_t c = 0; c < ids.size(); ++c)
+    {
+      if(std::find(prev.begin(), prev.end(), ids[c]) != prev.end()
+         && std::abs(G.row(static_cast<Eigen::DenseIndex>(c)).dot(z) - beta[c]) <= tol)
+        W.push_back(c);
+    }
+  }
+
+  // Primal active-set iterations
+  auto res = ws.res.head(M.rows());
+  auto dz = ws.dz.head(nz);
+  int it = 0;
+  bool optimal = false;
+  for(; it < maxIterations_; ++it)
+  {
+    auto GW = ws.GW.topLeftCorner(static_cast<Eigen::DenseIndex>(W.size()), nz);
+    for(size_t i = 0; i < W.size(); ++i)
+      GW.row(static_cast<Eigen::DenseIndex>(i)) = G.row(static_cast<Eigen::DenseIndex>(W[i]));
+
+    // Minimize the objective on the working set: z + N t
+    res.noalias() = M * z;
+    res -= q;
+    const auto d = nullspace(GW, ws.qr, ws.N);
+    const auto N = ws.N.topLeftCorner(nz, d);
+    dz.setZero();
+    if(d > 0 && M.rows() > 0)
+    {
+      auto MN = ws.MN.topLeftCorner(M.rows(), d);
+      MN.noalias() = M * N;
+      ws.cod.compute(MN);
+      ws.t.head(d) = ws.cod.solve(-res);
+      dz.noalias() = N * ws.t.head(d);
+    }
+
+    if(dz.template lpNorm<Eigen::Infinity>() <= tol)
+    {
+      // Multipliers: G_W^T lambda = M^T res
+      if(W.empty())
+      {
+        optimal = true;
+        break;
+      }
+      auto lambda = ws.lambda.head(GW.rows());
+      ws.rhs.head(nz).noalias() = M.transpose() * res;
+      ws.qr.compute(GW.transpose());
+      lambda = ws.qr.solve(ws.rhs.head(nz));
+      Eigen::DenseIndex iMin;
+      if(lambda.minCoeff(&iMin) >= -tol)
+      {
+        optimal = true;
+        break;
+      }
+      W.erase(W.begin() + iMin);
+    }
+    else
+    {
+      // Step until the first blocking constraint
+      Scalar alpha = 1;
+      int blocking = -1;
+      for(size_t c = 0; c < ids.size(); ++c)
+      {
+        if(std::find(W.begin(), W.end(), c) != W.end())
+          continue;
+        Scalar dc = G.row(static_cast<Eigen::DenseIndex>(c)).dot(dz);
+        if(dc < -std::numeric_limits<Scalar>::epsilon())
+        {
+          Scalar slack = std::max(G.row(static_cast<Eigen::DenseIndex>(c)).dot(z) - beta[c], Scalar(0));
+          Scalar a = slack / -dc;
+          if(a < alpha)
+          {
+            alpha = a;
+            blocking = static_cast<int>(c);
+          }
+        }
+      }
+      z += alpha * dz;
+      if(blocking >= 0)
+        W.push_back(static_cast<size_t>(blocking));
+    }
+  }
+  iterations = it;
+  if(!optimal)
+    return false;
+
+  auto & active = activeSets_[static_cast<size_t>(lvl)];
+  active.clear();
+  for(auto c : W)
+    active.push_back(ids[c]);
+
+  // Update the solution set for the lower levels: the equality rows and the
+  // violated inequality rows are fixed, the other inequality rows must remain
+  // satisfied.
+  s.x += s.Z * z.head(k);
+  auto & fixed = ws.fixed;
+  fixed = eq;
+  for(Eigen::DenseIndex j = 0; j < p; ++j)
+  {
+    auto r = ineq[static_cast<size_t>(j)];
+    if(std::abs(z[k + j]) > tol)
+      fixed.push_back(r);
+    else
+      s.inequalities.emplace_back(lvl, r);
+  }
+  if(!fixed.empty() && k > 0)
+  {
+    auto FZ = ws.FZ.topLeftCorner(static_cast<Eigen::DenseIndex>(fixed.size()), k);
+    for(size_t i = 0; i < fixed.size(); ++i)
+      FZ.row(static_cast<Eigen::DenseIndex>(i)) = AZ.row(fixed[i]);
+    const auto d = nullspace(FZ, ws.qr, ws.N);
+    s.Z = s.Z * ws.N.topLeftCorner(k, d);
+  }
+
+  return true;
+}
+
+const Eigen::VectorXd & EigenHierarchicalLeastSquareSolver::result_() const { return x_; }
+
+Range EigenHierarchicalLeastSquareSolver::nextEqualityConstraintRange_(
+    int lvl,
+    const constraint::abstract::LinearConstraint & cstr) const
+{
+  assert(eqSize_[lvl] + ineqSize_[lvl] + cstr.size() <= nEq_[lvl] + nIneq_[lvl]
+         && "Not enough rows were allocated to add this constraints at this level.");
+  return {eqSize_[lvl] + ineqSize_[lvl], cstr.size()};
+}
+
+Range EigenHierarchicalLeastSquareSolver::nextInequalityConstraintRange_(
+    int lvl,
+    const constraint::abstract::LinearConstraint & cstr) const
+{
+  assert(eqSize_[lvl] + ineqSize_[lvl] + cstr.size() <= nEq_[lvl] + nIneq_[lvl]
+         && "Not enough rows were allocated to add this constraints at this level.");
+  return {eqSize_[lvl] + ineqSize_[lvl], cstr.size()};
+}
+
+void EigenHierarchicalLeastSquareSolver::removeBounds_(const Range & r)
+{
+  xl_.segment(r.start, r.dim).setConstant(-big_number_);
+  xu_.segment(r.start, r.dim).setConstant(+big_number_);
+}
+
+void EigenHierarchicalLeastSquareSolver::updateEqualityTargetData(int lvl, scheme::internal::AssignmentTarget & target)
+{ target.changeData(A_[lvl], l_[lvl], u_[lvl]); }
+
+void EigenHierarchicalLeastSquareSolver::updateInequalityTargetData(int lvl,
+                                                                    scheme::internal::AssignmentTarget & target)
+{ target.changeData(A_[lvl], l_[lvl], u_[lvl]); }
+
+void EigenHierarchicalLeastSquareSolver::updateBoundTargetData(scheme::internal::AssignmentTarget & target)
+{ target.changeData(VectorRef(xl_), xu_); }
+
+void EigenHierarchicalLeastSquareSolver::applyImpactLogic(ImpactFromChanges & impact)
+{
+  for(size_t i = 0; i < impact.equalityConstraints_.size(); ++i)
+  {
+    if(impact.equalityConstraints_[i])
+      impact.inequalityConstraints_[i] = true;
+    if(impact.inequalityConstraints_[i])
+      impact.equalityConstraints_[i] = true;
+  }
+}
+
+void EigenHierarchicalLeastSquareSolver::printProblemData_() const
+{
+  for(size_t i = 0; i < data_.size(); ++i)
+    std::cout << "Level " << i << " [A l u]:\n" << data_[i] << std::endl;
+}
+
+void EigenHierarchicalLeastSquareSolver::printDiagnostic_() const
+{
+  std::cout << "[EigenHierarchicalLeastSquareSolver] ";
+  std::cout << (success_ ? "problem solved" : "resolution failed") << "\niterations:";
+  for(auto it : iterations_)
+    std::cout << " " << it;
+  std::cout << "\nx: " << x_.transpose() << std::endl;
+}
+
+EigenHLSSolverFactory::EigenHLSSolverFactory(const EigenHLSSolverOptions & options)
+: HLSSolverFactory("Eigen"), options_(options)
+{}
+
+std::unique_ptr<abstract::HLSSolverFactory> EigenHLSSolverFactory::clone() const
+{ return std::make_unique<EigenHLSSolverFactory>(*this); }
+
+std::unique_ptr<abstract::HierarchicalLeastSquareSolver> EigenHLSSolverFactory::createSolver() const
+{ return std::make_unique<EigenHierarchicalLeastSquareSolver>(options_); }
+} // namespace solver
+
+} // namespace tvm
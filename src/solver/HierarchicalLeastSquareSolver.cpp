@@ -2,7 +2,9 @@
 
 #include <tvm/VariableVector.h>
 #include <tvm/solver/abstract/HierarchicalLeastSquareSolver.h>
+#include <tvm/utils/Tracer.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace
@@ -38,8 +40,9 @@ private:
 
 namespace tvm::solver::abstract
 {
-HierarchicalLeastSquareSolver::HierarchicalLeastSquareSolver(bool verbose)
-: eqSize_(), ineqSize_(), buildInProgress_(false), verbose_(verbose), variables_(nullptr), subs_(nullptr)
+HierarchicalLeastSquareSolver::HierarchicalLeastSquareSolver(bool verbose, bool trackLevelChanges)
+: eqSize_(), ineqSize_(), buildInProgress_(false), verbose_(verbose), variables_(nullptr), subs_(nullptr),
+  trackLevelChanges_(trackLevelChanges)
 {}
 
 void HierarchicalLeastSquareSolver::startBuild(const VariableVector & x,
@@ -74,6 +77,10 @@ void HierarchicalLeastSquareSolver::startBuild(const VariableVector & x,
   eqSize_.resize(nEq_.size(), 0);
   ineqSize_.resize(nEq_.size(), 0);
   useBounds_ = useBounds;
+
+  structuralChanges_.assign(nLvl, true);
+  changedLevels_.assign(nLvl, true);
+  previousLevelData_.resize(nLvl);
 }
 
 void HierarchicalLeastSquareSolver::finalizeBuild()
@@ -92,6 +99,7 @@ void HierarchicalLeastSquareSolver::addBound(LinearConstraintPtr bound)
 
   AutoMap autoMap(bound, assignments_, boundToAssignments_);
   addBound_(bound, range, false);
+  markLevelChanged(0);
 }
 
 void HierarchicalLeastSquareSolver::addConstraint(LinearConstraintPtr cstr, SolvingRequirementsPtr req)
@@ -113,6 +121,7 @@ void HierarchicalLeastSquareSolver::addConstraint(LinearConstraintPtr cstr, Solv
     addIneqalityConstraint_(cstr, req);
     ineqSize_[lvl] += constraintSize(*cstr);
   }
+  markLevelChanged(lvl);
 }
 
 void HierarchicalLeastSquareSolver::setMinimumNorm()
@@ -125,6 +134,7 @@ void HierarchicalLeastSquareSolver::setMinimumNorm()
   }
   setMinimumNorm_();
   eqSize_.back() = variables_->totalSize();
+  markLevelChanged(static_cast<int>(nEq_.size()) - 1);
 }
 
 bool HierarchicalLeastSquareSolver::solve()
@@ -134,16 +144,25 @@ bool HierarchicalLeastSquareSolver::solve()
     throw std::runtime_error("[HierarchicalLeastSquareSolver]: attempting to solve while in build mode");
   }
 
-  resetBounds_();
-  preAssignmentProcess_();
-  for(auto & a : assignments_)
-    a->assignment.run();
-  postAssignmentProcess_();
+  TVM_TRACE_SCOPE("HierarchicalLeastSquareSolver::solve");
+  {
+    TVM_TRACE_SCOPE("HierarchicalLeastSquareSolver::assignments");
+    resetBounds_();
+    preAssignmentProcess_();
+    for(auto & a : assignments_)
+      a->assignment.run();
+    postAssignmentProcess_();
+    updateChangedLevels();
+  }
 
   if(verbose_)
     printProblemData_();
 
-  bool b = solve_();
+  bool b;
+  {
+    TVM_TRACE_SCOPE("HierarchicalLeastSquareSolver::backend");
+    b = solve_();
+  }
 
   if(verbose_ || !b)
   {
@@ -171,6 +190,45 @@ int HierarchicalLeastSquareSolver::constraintSize(const constraint::abstract::Li
   }
 }
 
+int HierarchicalLeastSquareSolver::firstChangedLevel() const
+{
+  auto it = std::find(changedLevels_.begin(), changedLevels_.end(), true);
+  return static_cast<int>(it - changedLevels_.begin());
+}
+
+MatrixConstRef HierarchicalLeastSquareSolver::levelData_(int) const
+{
+  static const Eigen::MatrixXd empty;
+  return empty;
+}
+
+void HierarchicalLeastSquareSolver::markLevelChanged(int lvl)
+{
+  if(lvl >= 0 && static_cast<size_t>(lvl) < structuralChanges_.size())
+    structuralChanges_[static_cast<size_t>(lvl)] = true;
+}
+
+void HierarchicalLeastSquareSolver::updateChangedLevels()
+{
+  if(!trackLevelChanges_)
+  {
+    std::fill(changedLevels_.begin(), changedLevels_.end(), true);
+    return;
+  }
+
+  for(size_t i = 0; i < changedLevels_.size(); ++i)
+  {
+    auto data = levelData_(static_cast<int>(i));
+    auto & prev = previousLevelData_[i];
+    bool changed = structuralChanges_[i] || data.size() == 0 || data.rows() != prev.rows()
+                   || data.cols() != prev.cols() || data != prev;
+    if(changed)
+      prev = data;
+    changedLevels_[i] = changed;
+    structuralChanges_[i] = false;
+  }
+}
+
 void HierarchicalLeastSquareSolver::process(const internal::SolverEvents & se)
 { throw std::runtime_error("[HierarchicalLeastSquareSolver::process] Not implemented yet"); }
 
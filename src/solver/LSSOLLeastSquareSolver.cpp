@@ -3,7 +3,9 @@
 #include <tvm/solver/LSSOLLeastSquareSolver.h>
 
 #include <tvm/scheme/internal/AssignmentTarget.h>
+#include <tvm/solver/QPRecorder.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace tvm
@@ -13,7 +15,7 @@ namespace solver
 {
 LSSOLLeastSquareSolver::LSSOLLeastSquareSolver(const LSSOLLSSolverOptions & options)
 : LeastSquareSolver(options.verbose().value()), cl_(l_.tail(0)), cu_(u_.tail(0)), autoMinNorm_(false),
-  big_number_(options.big_number().value())
+  big_number_(options.big_number().value()), lssolDims_({-1, -1, -1})
 {
   TVM_PROCESS_OPTION(crashTol, ls_)
   TVM_PROCESS_OPTION(feasibilityMaxIter, ls_)
@@ -52,11 +54,16 @@ LSSOLLeastSquareSolver::LSSOLLeastSquareSolver(const LSSOLLSSolverOptions & opti
     ls_.optimalityMaxIter(4 * ls_.optimalityMaxIter());
     fp_.optimalityMaxIter(4 * fp_.optimalityMaxIter());
   }
+  if(options.reserveObjectives().value() > 0 || options.reserveConstraints().value() > 0)
+    reserve(options.reserveObjectives().value(), options.reserveConstraints().value());
 }
 
 void LSSOLLeastSquareSolver::initializeBuild_(int nObj, int nEq, int nIneq, bool)
 {
   resize_(nObj, nEq, nIneq, true);
+  // The data might be kept from a previous build.
+  resetObjectiveRows_(0);
+  resetConstraintRows(0);
 
   autoMinNorm_ = false;
 }
@@ -64,26 +71,42 @@ void LSSOLLeastSquareSolver::initializeBuild_(int nObj, int nEq, int nIneq, bool
 LSSOLLeastSquareSolver::ImpactFromChanges LSSOLLeastSquareSolver::resize_(int nObj, int nEq, int nIneq, bool)
 {
   int n = variables().totalSize();
-  int nCstr = nEq + nIneq;
+  // Allocated sizes, possibly larger than the actual ones if some capacity was
+  // reserved. The extra rows are zero objectives and unbounded constraints.
+  int nObjRows = objectiveRows(nObj);
+  int nCstrRows = constraintRows(nEq + nIneq);
   ImpactFromChanges impact;
 
-  impact.objectives_ = ImpactFromChanges::willReallocate(A_, nObj, n);
-  A_.resize(nObj, n);
-  A_.setZero();
-  b_.resize(nObj);
-  b_.setZero();
-  impact.equalityConstraints_ = ImpactFromChanges::willReallocate(C_, nCstr, n);
-  C_.resize(nCstr, n);
-  C_.setZero();
-  impact.bounds_ = ImpactFromChanges::willReallocate(l_, nCstr + n);
-  l_ = Eigen::VectorXd::Constant(nCstr + n, -big_number_);
-  u_ = Eigen::VectorXd::Constant(nCstr + n, +big_number_);
-  new(&cl_) VectorXdTail(l_.tail(nCstr));
-  new(&cu_) VectorXdTail(u_.tail(nCstr));
-  if(nObj > 0)
-    ls_.resize(n, nCstr, Eigen::lssol::eType::LS1);
-  else
-    fp_.resize(n, nCstr);
+  // The data are only reset when their layout changes. Otherwise, the rows
+  // whose content changes are reset by the reset*Rows_ methods.
+  impact.objectives_ = A_.rows() != nObjRows || A_.cols() != n;
+  if(impact.objectives_)
+  {
+    A_.resize(nObjRows, n);
+    A_.setZero();
+    b_.setZero(nObjRows);
+  }
+  impact.equalityConstraints_ = C_.rows() != nCstrRows || C_.cols() != n;
+  if(impact.equalityConstraints_)
+  {
+    C_.resize(nCstrRows, n);
+    C_.setZero();
+  }
+  // The split of l_ and u_ between the bounds and the general constraints
+  // changes with n or nCstrRows, even if their sum does not.
+  impact.bounds_ = l_.size() != nCstrRows + n || cl_.size() != nCstrRows;
+  if(impact.bounds_)
+  {
+    l_.setConstant(nCstrRows + n, -big_number_);
+    u_.setConstant(nCstrRows + n, +big_number_);
+    new(&cl_) VectorXdTail(l_.tail(nCstrRows));
+    new(&cu_) VectorXdTail(u_.tail(nCstrRows));
+  }
+  if(nObj > 0 && (lssolDims_[0] != n || lssolDims_[1] != nCstrRows || lssolDims_[2] != 1))
+    ls_.resize(n, nCstrRows, Eigen::lssol::eType::LS1);
+  else if(nObj == 0 && (lssolDims_[0] != n || lssolDims_[1] != nCstrRows || lssolDims_[2] != 0))
+    fp_.resize(n, nCstrRows);
+  lssolDims_ = {n, nCstrRows, nObj > 0 ? 1 : 0};
 
   impact.inequalityConstraints_ = impact.equalityConstraints_;
   impact.bounds_ = impact.bounds_ || impact.inequalityConstraints_;
@@ -93,21 +116,21 @@ LSSOLLeastSquareSolver::ImpactFromChanges LSSOLLeastSquareSolver::resize_(int nO
 void LSSOLLeastSquareSolver::addBound_(LinearConstraintPtr bound, RangePtr range, bool first)
 {
   scheme::internal::AssignmentTarget target(range, l_, u_);
-  addAssignement(bound, target, bound->variables()[0], first);
+  addAssignement(bound, target, bound->variables()[0], first, big_number_);
 }
 
 void LSSOLLeastSquareSolver::addEqualityConstraint_(LinearConstraintPtr cstr)
 {
   RangePtr r = std::make_shared<Range>(nextEqualityConstraintRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, C_, cl_, cu_, constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, nullptr, target, variables(), substitutions());
+  addAssignement(cstr, nullptr, target, variables(), substitutions(), 1., big_number_);
 }
 
 void LSSOLLeastSquareSolver::addIneqalityConstraint_(LinearConstraintPtr cstr)
 {
   RangePtr r = std::make_shared<Range>(nextInequalityConstraintRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, C_, cl_, cu_, constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, nullptr, target, variables(), substitutions());
+  addAssignement(cstr, nullptr, target, variables(), substitutions(), 1., big_number_);
 }
 
 void LSSOLLeastSquareSolver::addObjective_(LinearConstraintPtr cstr,
@@ -116,7 +139,7 @@ void LSSOLLeastSquareSolver::addObjective_(LinearConstraintPtr cstr,
 {
   RangePtr r = std::make_shared<Range>(nextObjectiveRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, A_, b_, constraint::Type::EQUAL, constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, req, target, variables(), substitutions(), additionalWeight);
+  addAssignement(cstr, req, target, variables(), substitutions(), additionalWeight, big_number_);
 }
 
 void LSSOLLeastSquareSolver::setMinimumNorm_()
@@ -189,6 +212,25 @@ void LSSOLLeastSquareSolver::updateBoundTargetData(scheme::internal::AssignmentT
 void LSSOLLeastSquareSolver::updateObjectiveTargetData(scheme::internal::AssignmentTarget & target)
 { target.changeData(MatrixRef(A_), b_); }
 
+void LSSOLLeastSquareSolver::resetObjectiveRows_(int start)
+{
+  auto s = std::min(Eigen::Index(start), b_.size());
+  A_.middleRows(s, b_.size() - s).setZero();
+  b_.tail(b_.size() - s).setZero();
+}
+
+void LSSOLLeastSquareSolver::resetEqualityConstraintRows_(int start) { resetConstraintRows(start); }
+
+void LSSOLLeastSquareSolver::resetInequalityConstraintRows_(int start) { resetConstraintRows(start); }
+
+void LSSOLLeastSquareSolver::resetConstraintRows(int start)
+{
+  auto s = std::min(Eigen::Index(start), cl_.size());
+  C_.middleRows(s, cl_.size() - s).setZero();
+  cl_.tail(cl_.size() - s).setConstant(-big_number_);
+  cu_.tail(cu_.size() - s).setConstant(+big_number_);
+}
+
 void LSSOLLeastSquareSolver::applyImpactLogic(ImpactFromChanges & impact)
 {
   if(impact.equalityConstraints_)
@@ -206,6 +248,28 @@ void LSSOLLeastSquareSolver::printProblemData_() const
   std::cout << "u = " << u_.transpose() << std::endl;
 }
 
+void LSSOLLeastSquareSolver::exportProblem_(QPRecord & record) const
+{
+  int n = variables().totalSize();
+  int nCstr = nEq_ + nIneq_;
+  if(autoMinNorm_)
+  {
+    // A is set to the identity in postAssignmentProcess_
+    record.A.setIdentity(n, n);
+    record.b.setZero(n);
+  }
+  else
+  {
+    record.A = A_.topRows(nObj_);
+    record.b = b_.head(nObj_);
+  }
+  record.C = C_.topRows(nCstr);
+  record.l = cl_.head(nCstr);
+  record.u = cu_.head(nCstr);
+  record.xl = l_.head(n);
+  record.xu = u_.head(n);
+}
+
 void LSSOLLeastSquareSolver::printDiagnostic_() const
 {
   if(nObj_)
@@ -1,8 +1,11 @@
 /* Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
 
 #include <tvm/VariableVector.h>
+#include <tvm/solver/QPRecorder.h>
 #include <tvm/solver/abstract/LeastSquareSolver.h>
+#include <tvm/utils/Tracer.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace
@@ -40,7 +43,7 @@ namespace tvm::solver::abstract
 {
 LeastSquareSolver::LeastSquareSolver(bool verbose)
 : objSize_(-1), eqSize_(-1), ineqSize_(-1), buildInProgress_(false), verbose_(verbose), variables_(nullptr),
-  subs_(nullptr)
+  subs_(nullptr), objCapacity_(-1), cstrCapacity_(-1), reallocations_(0)
 {}
 
 void LeastSquareSolver::startBuild(const VariableVector & x,
@@ -80,6 +83,7 @@ void LeastSquareSolver::finalizeBuild()
   assert(nEq_ == eqSize_);
   assert(nIneq_ == ineqSize_);
   buildInProgress_ = false;
+  reserveRecords();
 }
 
 void LeastSquareSolver::addBound(LinearConstraintPtr bound)
@@ -143,16 +147,43 @@ bool LeastSquareSolver::solve()
     throw std::runtime_error("[LeastSquareSolver]: attempting to solve while in build mode");
   }
 
-  resetBounds_();
-  preAssignmentProcess_();
-  for(auto & a : assignments_)
-    a->assignment.run();
-  postAssignmentProcess_();
+  TVM_TRACE_SCOPE("LeastSquareSolver::solve");
+  QPRecord * record = nullptr;
+  bool b;
+  try
+  {
+    {
+      TVM_TRACE_SCOPE("LeastSquareSolver::assignments");
+      resetBounds_();
+      preAssignmentProcess_();
+      for(auto & a : assignments_)
+        a->assignment.run();
+      record = recorder_ ? recorder_->acquire() : nullptr;
+      if(record)
+        exportProblem_(*record);
+      postAssignmentProcess_();
+    }
+
+    if(verbose_)
+      printProblemData_();
 
-  if(verbose_)
-    printProblemData_();
+    TVM_TRACE_SCOPE("LeastSquareSolver::backend");
+    b = solve_();
+  }
+  catch(...)
+  {
+    // The slot reserved in the recorder must be handed back.
+    if(record)
+      recorder_->discard(record);
+    throw;
+  }
 
-  bool b = solve_();
+  if(record)
+  {
+    record->x = result_();
+    record->success = b;
+    recorder_->commit(record);
+  }
 
   if(verbose_ || !b)
   {
@@ -168,6 +199,28 @@ bool LeastSquareSolver::solve()
 
 const Eigen::VectorXd & LeastSquareSolver::result() const { return result_(); }
 
+void LeastSquareSolver::recorder(std::shared_ptr<QPRecorder> recorder)
+{
+  recorder_ = std::move(recorder);
+  if(variables_ && !buildInProgress_)
+    reserveRecords();
+}
+
+void LeastSquareSolver::reserveRecords()
+{
+  if(!recorder_)
+    return;
+  // Only the sizes of the exported data matter here.
+  QPRecord prototype;
+  exportProblem_(prototype);
+  recorder_->reserve(prototype);
+}
+
+void LeastSquareSolver::exportProblem_(QPRecord &) const
+{
+  throw std::runtime_error("[LeastSquareSolver]: this solver does not support recording its problems");
+}
+
 int LeastSquareSolver::constraintSize(const constraint::abstract::LinearConstraint & c) const
 {
   if(c.type() != constraint::Type::DOUBLE_SIDED || handleDoubleSidedConstraint_())
@@ -183,10 +236,15 @@ int LeastSquareSolver::constraintSize(const constraint::abstract::LinearConstrai
 void LeastSquareSolver::process(const internal::SolverEvents & se)
 {
   updateWeights(se);
-  auto impactRemove = processRemovedConstraints(se);
+  ChangedRows changedRows;
+  auto impactRemove = processRemovedConstraints(se, changedRows);
   bool needMappingUpdate = updateVariables(se);
   auto impactAdd = previewAddedConstraints(se);
   auto impactResize = resize_(nObj_, nEq_, nIneq_, boundToAssignments_.size() > 0 || se.addedBounds().size() > 0);
+  if(impactResize.any())
+    ++reallocations_;
+  // Categories whose target data changed, so that all their assignments need to be re-targeted.
+  applyImpactLogic(impactResize);
 
   if(needMappingUpdate)
   {
@@ -198,13 +256,24 @@ void LeastSquareSolver::process(const internal::SolverEvents & se)
   // We could be much more fine grain as added constraints could be placed last,
   // and not update existing constraints if only constraints are added but this
   // makes things much more complex.
+  // Only the assignments whose range actually moved are marked, and the first
+  // row they move to is recorded.
   auto impact = impactRemove || impactAdd;
-  auto updateTargetRange = [](const auto & map, int & cumSize, auto rangeProvider, auto sizeProvider) {
+  auto updateTargetRange = [](const auto & map, int & cumSize, int & firstChangedRow, auto rangeProvider,
+                              auto sizeProvider) {
     for(const auto & ca : map)
     {
       Range r = rangeProvider(*ca.first);
       for(auto & a : ca.second)
-        a->assignment.target().range().start = r.start;
+      {
+        auto & range = a->assignment.target().range();
+        if(range.start != r.start)
+        {
+          range.start = r.start;
+          a->rangeChanged = true;
+          firstChangedRow = std::min(firstChangedRow, r.start);
+        }
+      }
       cumSize += sizeProvider(*ca.first);
     }
   };
@@ -219,24 +288,25 @@ void LeastSquareSolver::process(const internal::SolverEvents & se)
 
   if(impact.equalityConstraints_)
     updateTargetRange(
-        equalityConstraintToAssignments_, eqSize_, [&](const auto & c) { return nextEqualityConstraintRange_(c); },
+        equalityConstraintToAssignments_, eqSize_, changedRows.equalityConstraints,
+        [&](const auto & c) { return nextEqualityConstraintRange_(c); },
         [&](const auto & c) { return constraintSize(c); });
 
   if(impact.inequalityConstraints_)
     updateTargetRange(
-        inequalityConstraintToAssignments_, ineqSize_,
+        inequalityConstraintToAssignments_, ineqSize_, changedRows.inequalityConstraints,
         [&](const auto & c) { return nextInequalityConstraintRange_(c); },
         [&](const auto & c) { return constraintSize(c); });
 
-  int dummy;
+  int dummy, dummyRow;
   if(impact.bounds_ || needMappingUpdate) // needMappingUpdate because a variable might have been added or removed
     updateTargetRange(
-        boundToAssignments_, dummy, [&](const auto & b) { return b.variables()[0]->getMappingIn(variables()); },
+        boundToAssignments_, dummy, dummyRow, [&](const auto & b) { return b.variables()[0]->getMappingIn(variables()); },
         [](const auto &) { return 0; });
 
   if(impact.objectives_)
     updateTargetRange(
-        objectiveToAssignments_, objSize_, [&](const auto & c) { return nextObjectiveRange_(c); },
+        objectiveToAssignments_, objSize_, changedRows.objectives, [&](const auto & c) { return nextObjectiveRange_(c); },
         [&](const auto & c) { return c.size(); });
 
   // Update the matrices and vectors of the target when needed
@@ -248,47 +318,99 @@ void LeastSquareSolver::process(const internal::SolverEvents & se)
     }
   };
 
-  impact.orAssign(impactResize); // There are case where no resize are necessary (e.g. a constraint was removed and
-  applyImpactLogic(impact);      // another added with same size) but the target need to change.
-  if(impact.equalityConstraints_)
+  if(impactResize.equalityConstraints_)
     updateTargetData(equalityConstraintToAssignments_, [&](auto & target) { updateEqualityTargetData(target); });
 
-  if(impact.inequalityConstraints_)
+  if(impactResize.inequalityConstraints_)
     updateTargetData(inequalityConstraintToAssignments_, [&](auto & target) { updateInequalityTargetData(target); });
 
-  if(impact.bounds_)
+  if(impactResize.bounds_)
     updateTargetData(boundToAssignments_, [&](auto & target) { updateBoundTargetData(target); });
 
-  if(impact.objectives_)
+  if(impactResize.objectives_)
     updateTargetData(objectiveToAssignments_, [&](auto & target) { updateObjectiveTargetData(target); });
 
-  // Final update of the impacted mappings
+  // Final update of the impacted mappings: all the assignments of a category
+  // whose data changed, only the moved ones otherwise.
+  auto updateMapping = [](const auto & map, bool all) {
+    for(const auto & ca : map)
+    {
+      for(auto & a : ca.second)
+      {
+        if(all || a->rangeChanged)
+          a->assignment.onUpdatedTarget();
+        a->rangeChanged = false;
+      }
+    }
+  };
   if(needMappingUpdate)
   {
     for(auto & a : assignments_)
+    {
       a->assignment.onUpdatedTarget(); // onUpdateTarget also takes into account the mapping change due to variable.
+      a->rangeChanged = false;
+    }
   }
   else
   {
-    auto updateMapping = [](const auto & map) {
-      for(const auto & ca : map)
-      {
-        for(auto & a : ca.second)
-          a->assignment.onUpdatedTarget();
-      }
-    };
-
-    if(impact.equalityConstraints_)
-      updateMapping(equalityConstraintToAssignments_);
-    if(impact.inequalityConstraints_)
-      updateMapping(inequalityConstraintToAssignments_);
-    if(impact.bounds_)
-      updateMapping(boundToAssignments_);
-    if(impact.objectives_)
-      updateMapping(objectiveToAssignments_);
+    updateMapping(equalityConstraintToAssignments_, impactResize.equalityConstraints_);
+    updateMapping(inequalityConstraintToAssignments_, impactResize.inequalityConstraints_);
+    updateMapping(boundToAssignments_, impactResize.bounds_);
+    updateMapping(objectiveToAssignments_, impactResize.objectives_);
   }
 
+  // Reset the rows whose content changes. The added constraints are written
+  // after the existing ones, in rows that might have been used for something
+  // else (e.g. QLD inequality rows becoming equality rows). A change of the
+  // variables moves the columns of all the rows.
+  if(impactAdd.objectives_)
+    changedRows.objectives = std::min(changedRows.objectives, objSize_);
+  if(impactAdd.equalityConstraints_)
+    changedRows.equalityConstraints = std::min(changedRows.equalityConstraints, eqSize_);
+  if(impactAdd.inequalityConstraints_)
+    changedRows.inequalityConstraints = std::min(changedRows.inequalityConstraints, ineqSize_);
+  if(needMappingUpdate || impactResize.objectives_)
+    changedRows.objectives = 0;
+  if(needMappingUpdate || impactResize.equalityConstraints_)
+    changedRows.equalityConstraints = 0;
+  if(needMappingUpdate || impactResize.inequalityConstraints_)
+    changedRows.inequalityConstraints = 0;
+  if(changedRows.objectives < ChangedRows::none)
+    resetObjectiveRows_(changedRows.objectives);
+  if(changedRows.equalityConstraints < ChangedRows::none)
+    resetEqualityConstraintRows_(changedRows.equalityConstraints);
+  if(changedRows.inequalityConstraints < ChangedRows::none)
+    resetInequalityConstraintRows_(changedRows.inequalityConstraints);
+
   processAddedConstraints(se);
+  if(impact.any() || impactResize.any() || needMappingUpdate)
+    reserveRecords();
+}
+
+void LeastSquareSolver::reserve(int nObj, int nCstr)
+{
+  if(nObj < 0 || nCstr < 0)
+  {
+    throw std::runtime_error("[LeastSquareSolver::reserve] Capacities must be non-negative.");
+  }
+  objCapacity_ = std::max(objCapacity_, nObj);
+  cstrCapacity_ = std::max(cstrCapacity_, nCstr);
+}
+
+int LeastSquareSolver::objectiveRows(int nObj)
+{
+  if(objCapacity_ < 0)
+    return nObj;
+  objCapacity_ = std::max(objCapacity_, nObj);
+  return objCapacity_;
+}
+
+int LeastSquareSolver::constraintRows(int nCstr)
+{
+  if(cstrCapacity_ < 0)
+    return nCstr;
+  cstrCapacity_ = std::max(cstrCapacity_, nCstr);
+  return cstrCapacity_;
 }
 
 void LeastSquareSolver::updateWeights(const internal::SolverEvents & se)
@@ -327,36 +449,47 @@ void LeastSquareSolver::updateWeights(const internal::SolverEvents & se)
 bool LeastSquareSolver::updateVariables(const internal::SolverEvents & se)
 { return (!(se.removedVariables().empty() && se.addedVariables().empty())) || se.hasHiddenVariableChange(); }
 
-LeastSquareSolver::ImpactFromChanges LeastSquareSolver::processRemovedConstraints(const internal::SolverEvents & se)
+LeastSquareSolver::ImpactFromChanges LeastSquareSolver::processRemovedConstraints(const internal::SolverEvents & se,
+                                                                                   ChangedRows & changedRows)
 {
-  for(const auto & c : se.removedConstraints())
-  {
+  // Mark the assignments for removal and record the first row they were using.
+  auto markForRemoval = [](const AssignmentPtrVector & assignments, int & firstChangedRow) {
+    for(auto & a : assignments)
+    {
+      a->markedForRemoval = true;
+      firstChangedRow = std::min(firstChangedRow, a->assignment.target().range().start);
+    }
+  };
+  // Reprocessed constraints and objectives are removed, then added again.
+  auto removeConstraint = [&, this](const LinearConstraintPtr & c) {
     if(c->isEquality())
     {
       nEq_ -= constraintSize(*c);
-      const auto & assignments = equalityConstraintToAssignments_[c.get()];
-      for(auto & a : assignments)
-        a->markedForRemoval = true;
+      markForRemoval(equalityConstraintToAssignments_[c.get()], changedRows.equalityConstraints);
       equalityConstraintToAssignments_.erase(c.get());
     }
     else
     {
       nIneq_ -= constraintSize(*c);
-      const auto & assignments = inequalityConstraintToAssignments_[c.get()];
-      for(auto & a : assignments)
-        a->markedForRemoval = true;
+      markForRemoval(inequalityConstraintToAssignments_[c.get()], changedRows.inequalityConstraints);
       inequalityConstraintToAssignments_.erase(c.get());
     }
-  }
-
-  for(const auto & o : se.removedObjectives())
-  {
+  };
+  auto removeObjective = [&, this](const LinearConstraintPtr & o) {
     nObj_ -= o->size();
-    const auto & assignments = objectiveToAssignments_[o.get()];
-    for(auto & a : assignments)
-      a->markedForRemoval = true;
+    markForRemoval(objectiveToAssignments_[o.get()], changedRows.objectives);
     objectiveToAssignments_.erase(o.get());
-  }
+  };
+
+  for(const auto & c : se.removedConstraints())
+    removeConstraint(c);
+  for(const auto & c : se.reprocessedConstraints())
+    removeConstraint(c);
+
+  for(const auto & o : se.removedObjectives())
+    removeObjective(o);
+  for(const auto & o : se.reprocessedObjectives())
+    removeObjective(o.c);
 
   for(const auto & b : se.removedBounds())
   {
@@ -371,8 +504,9 @@ LeastSquareSolver::ImpactFromChanges LeastSquareSolver::processRemovedConstraint
       std::remove_if(assignments_.begin(), assignments_.end(), [](const auto & it) { return it->markedForRemoval; });
   assignments_.erase(it, assignments_.end());
 
-  ImpactFromChanges impact = {!se.removedConstraints().empty(), !se.removedConstraints().empty(),
-                              !se.removedBounds().empty(), !se.removedObjectives().empty()};
+  bool constraints = !se.removedConstraints().empty() || !se.reprocessedConstraints().empty();
+  bool objectives = !se.removedObjectives().empty() || !se.reprocessedObjectives().empty();
+  ImpactFromChanges impact = {constraints, constraints, !se.removedBounds().empty(), objectives};
   applyImpactLogic(impact);
   return impact;
 }
@@ -385,18 +519,24 @@ LeastSquareSolver::ImpactFromChanges LeastSquareSolver::previewAddedConstraints(
   eqSize_ = nEq_;
   ineqSize_ = nIneq_;
   objSize_ = nObj_;
-  for(const auto & c : se.addedConstraints())
-  {
+  auto addConstraint = [this](const LinearConstraintPtr & c) {
     if(c->isEquality())
       nEq_ += constraintSize(*c);
     else
       nIneq_ += constraintSize(*c);
-  }
+  };
+  for(const auto & c : se.addedConstraints())
+    addConstraint(c);
+  for(const auto & c : se.reprocessedConstraints())
+    addConstraint(c);
 
   for(const auto & o : se.addedObjectives())
     nObj_ += o.c->size();
+  for(const auto & o : se.reprocessedObjectives())
+    nObj_ += o.c->size();
 
-  ImpactFromChanges impact = {nEq_ != eqSize_, nIneq_ != ineqSize_, false, !se.addedObjectives().empty()};
+  ImpactFromChanges impact = {nEq_ != eqSize_, nIneq_ != ineqSize_, false,
+                              !se.addedObjectives().empty() || !se.reprocessedObjectives().empty()};
   applyImpactLogic(impact);
   return impact;
 }
@@ -406,12 +546,16 @@ void LeastSquareSolver::processAddedConstraints(const internal::SolverEvents & s
   buildInProgress_ = true;
   for(const auto & c : se.addedConstraints())
     addConstraint(c);
+  for(const auto & c : se.reprocessedConstraints())
+    addConstraint(c);
 
   for(const auto & b : se.addedBounds())
     addBound(b);
 
   for(const auto & o : se.addedObjectives())
     addObjective(o.c, o.req, o.scalarizationWeight);
+  for(const auto & o : se.reprocessedObjectives())
+    addObjective(o.c, o.req, o.scalarizationWeight);
 
   assert(nObj_ == objSize_);
   assert(nEq_ == eqSize_);
@@ -157,7 +157,7 @@ LexLSHierarchicalLeastSquareSolver::ImpactFromChanges LexLSHierarchicalLeastSqua
 void LexLSHierarchicalLeastSquareSolver::addBound_(LinearConstraintPtr bound, RangePtr range, bool first)
 {
   scheme::internal::AssignmentTarget target(range, xl_, xu_);
-  addAssignement(bound, target, bound->variables()[0], first);
+  addAssignement(bound, target, bound->variables()[0], first, big_number_);
 }
 
 void LexLSHierarchicalLeastSquareSolver::addEqualityConstraint_(LinearConstraintPtr cstr, SolvingRequirementsPtr req)
@@ -165,7 +165,7 @@ void LexLSHierarchicalLeastSquareSolver::addEqualityConstraint_(LinearConstraint
   int lvl = req->priorityLevel().value();
   RangePtr r = std::make_shared<Range>(nextEqualityConstraintRange_(lvl, *cstr));
   scheme::internal::AssignmentTarget target(r, A_[lvl], l_[lvl], u_[lvl], constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, req, target, variables(), substitutions());
+  addAssignement(cstr, req, target, variables(), substitutions(), 1., big_number_);
 }
 
 void LexLSHierarchicalLeastSquareSolver::addIneqalityConstraint_(LinearConstraintPtr cstr, SolvingRequirementsPtr req)
@@ -173,7 +173,7 @@ void LexLSHierarchicalLeastSquareSolver::addIneqalityConstraint_(LinearConstrain
   int lvl = req->priorityLevel().value();
   RangePtr r = std::make_shared<Range>(nextInequalityConstraintRange_(lvl, *cstr));
   scheme::internal::AssignmentTarget target(r, A_[lvl], l_[lvl], u_[lvl], constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, req, target, variables(), substitutions());
+  addAssignement(cstr, req, target, variables(), substitutions(), 1., big_number_);
 }
 
 void LexLSHierarchicalLeastSquareSolver::setMinimumNorm_()
@@ -196,6 +196,8 @@ void LexLSHierarchicalLeastSquareSolver::preAssignmentProcess_() {}
 
 void LexLSHierarchicalLeastSquareSolver::postAssignmentProcess_()
 {
+  // data_ and boundData_ are already in the layout used by LexLS, but setData
+  // copies them into LexLS' own storage, to which we have no access.
   solver_.reset();
   int i0 = 0;
   if(useBounds_ && feasibleFirstLevel_)
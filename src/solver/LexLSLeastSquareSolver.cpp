@@ -3,6 +3,7 @@
 #include <tvm/solver/LexLSLeastSquareSolver.h>
 
 #include <tvm/scheme/internal/AssignmentTarget.h>
+#include <tvm/solver/QPRecorder.h>
 
 #include <iostream>
 #include <numeric> // for std::iota
@@ -116,21 +117,21 @@ LexLSLeastSquareSolver::ImpactFromChanges LexLSLeastSquareSolver::resize_(int nO
 void LexLSLeastSquareSolver::addBound_(LinearConstraintPtr bound, RangePtr range, bool first)
 {
   scheme::internal::AssignmentTarget target(range, xl_, xu_);
-  addAssignement(bound, target, bound->variables()[0], first);
+  addAssignement(bound, target, bound->variables()[0], first, big_number_);
 }
 
 void LexLSLeastSquareSolver::addEqualityConstraint_(LinearConstraintPtr cstr)
 {
   RangePtr r = std::make_shared<Range>(nextEqualityConstraintRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, A1_, l1_, u1_, constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, nullptr, target, variables(), substitutions());
+  addAssignement(cstr, nullptr, target, variables(), substitutions(), 1., big_number_);
 }
 
 void LexLSLeastSquareSolver::addIneqalityConstraint_(LinearConstraintPtr cstr)
 {
   RangePtr r = std::make_shared<Range>(nextInequalityConstraintRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, A1_, l1_, u1_, constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, nullptr, target, variables(), substitutions());
+  addAssignement(cstr, nullptr, target, variables(), substitutions(), 1., big_number_);
 }
 
 void LexLSLeastSquareSolver::addObjective_(LinearConstraintPtr cstr,
@@ -139,7 +140,7 @@ void LexLSLeastSquareSolver::addObjective_(LinearConstraintPtr cstr,
 {
   RangePtr r = std::make_shared<Range>(nextObjectiveRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, A2_, l2_, u2_, constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, req, target, variables(), substitutions(), additionalWeight);
+  addAssignement(cstr, req, target, variables(), substitutions(), additionalWeight, big_number_);
 }
 
 void LexLSLeastSquareSolver::setMinimumNorm_()
@@ -238,6 +239,18 @@ void LexLSLeastSquareSolver::applyImpactLogic(ImpactFromChanges & impact)
 
 void LexLSLeastSquareSolver::printProblemData_() const { solver_.print("data"); }
 
+void LexLSLeastSquareSolver::exportProblem_(QPRecord & record) const
+{
+  // The objectives are assigned with l2 = u2
+  record.A = A2_;
+  record.b = l2_;
+  record.C = A1_;
+  record.l = l1_;
+  record.u = u1_;
+  record.xl = xl_;
+  record.xu = xu_;
+}
+
 void LexLSLeastSquareSolver::printDiagnostic_() const
 {
   solver_.print("nIterations");
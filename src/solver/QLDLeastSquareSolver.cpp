@@ -3,7 +3,9 @@
 #include <tvm/solver/QLDLeastSquareSolver.h>
 
 #include <tvm/scheme/internal/AssignmentTarget.h>
+#include <tvm/solver/QPRecorder.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace tvm
@@ -14,12 +16,21 @@ namespace solver
 QLDLeastSquareSolver::QLDLeastSquareSolver(const QLDLSSolverOptions & options)
 : LeastSquareSolver(options.verbose().value()), Aineq_(A_.bottomRows(0)), bineq_(b_.tail(0)), autoMinNorm_(false),
   big_number_(options.big_number().value()), eps_(options.eps().value()), cholesky_(options.cholesky().value()),
-  choleskyDamping_(options.choleskyDamping().value())
-{}
+  choleskyDamping_(options.choleskyDamping().value()), usePresolve_(options.presolve().value()),
+  presolve_(options.big_number().value()), presolved_(false), qldDims_({-1, -1, -1, -1})
+{
+  if(options.reserveObjectives().value() > 0 || options.reserveConstraints().value() > 0)
+    reserve(options.reserveObjectives().value(), options.reserveConstraints().value());
+}
 
 void QLDLeastSquareSolver::initializeBuild_(int nObj, int nEq, int nIneq, bool)
 {
   resize_(nObj, nEq, nIneq, true);
+  // The data might be kept from a previous build.
+  resetObjectiveRows_(0);
+  A_.topRows(nEq).setZero();
+  b_.head(nEq).setZero();
+  resetInequalityConstraintRows_(0);
 
   autoMinNorm_ = false;
 }
@@ -28,62 +39,76 @@ QLDLeastSquareSolver::ImpactFromChanges QLDLeastSquareSolver::resize_(int nObj,
 {
   int n = variables().totalSize();
   int nCstr = nEq + nIneq;
+  // Allocated sizes, possibly larger than the actual ones if some capacity was
+  // reserved. The extra objective rows are zero and the extra inequality
+  // constraints are trivially satisfied.
+  int nObjRows = objectiveRows(nObj);
+  int nCstrRows = constraintRows(nCstr);
+  int nIneqRows = nCstrRows - nEq;
   underspecifiedObj_ = nObj < n;
   ImpactFromChanges impact;
 
-  if(cholesky_ && underspecifiedObj_)
+  // The data are only reset when their layout changes. Otherwise, the rows
+  // whose content changes are reset by the reset*Rows_ methods.
+  int nDRows = (cholesky_ && underspecifiedObj_) ? nObjRows + n : nObjRows;
+  impact.objectives_ = D_.rows() != nDRows || D_.cols() != n || e_.size() != nObjRows;
+  if(impact.objectives_)
   {
-    impact.objectives_ = ImpactFromChanges::willReallocate(D_, nObj + n, n);
-    D_.resize(nObj + n, n);
-    D_.setZero();
-    D_.bottomRows(n).diagonal().setConstant(choleskyDamping_);
-  }
-  else
-  {
-    impact.objectives_ = ImpactFromChanges::willReallocate(D_, nObj, n);
-    D_.resize(nObj, n);
+    D_.resize(nDRows, n);
     D_.setZero();
+    if(nDRows > nObjRows)
+      D_.bottomRows(n).diagonal().setConstant(choleskyDamping_);
+    e_.setZero(nObjRows);
+    if(cholesky_)
+      qr_ = Eigen::HouseholderQR<Eigen::MatrixXd>(nDRows, n);
   }
-  e_.resize(nObj);
   if(!cholesky_)
     Q_.resize(n, n);
   c_.resize(n);
-  impact.equalityConstraints_ = ImpactFromChanges::willReallocate(A_, nCstr, n);
-  A_.resize(nCstr, n);
-  A_.setZero();
-  b_.resize(nCstr);
+  impact.equalityConstraints_ = A_.rows() != nCstrRows || A_.cols() != n;
+  if(impact.equalityConstraints_)
+  {
+    A_.resize(nCstrRows, n);
+    A_.setZero();
+    b_.resize(nCstrRows);
+    b_.tail(nCstrRows - nCstr).setConstant(+big_number_);
+  }
+  // A change of the number of equality constraints shifts the inequality ones,
+  // whose rows are then all reset.
+  impact.inequalityConstraints_ = impact.equalityConstraints_ || Aineq_.rows() != nIneqRows;
+  if(impact.inequalityConstraints_)
+  {
+    new(&Aineq_) MatrixXdBottom(A_.bottomRows(nIneqRows));
+    new(&bineq_) VectorXdTail(b_.tail(nIneqRows));
+  }
   impact.bounds_ = ImpactFromChanges::willReallocate(xl_, n);
-  xl_ = Eigen::VectorXd::Constant(n, -big_number_);
-  xu_ = Eigen::VectorXd::Constant(n, +big_number_);
-  new(&Aineq_) MatrixXdBottom(A_.bottomRows(nIneq));
-  new(&bineq_) VectorXdTail(b_.tail(nIneq));
-  if(underspecifiedObj_)
-    qld_.problem(n, nEq, nIneq, n + nObj);
-  else
-    qld_.problem(n, nEq, nIneq, cholesky_ ? nObj : n);
-  if(cholesky_)
+  if(impact.bounds_)
   {
-    if(underspecifiedObj_)
-      new(&qr_) Eigen::HouseholderQR<Eigen::MatrixXd>(nObj + n, n);
-    else
-      new(&qr_) Eigen::HouseholderQR<Eigen::MatrixXd>(nObj, n);
+    xl_.setConstant(n, -big_number_);
+    xu_.setConstant(n, +big_number_);
   }
+  if(underspecifiedObj_)
+    ldq_ = n + nObjRows;
+  else
+    ldq_ = cholesky_ ? nObjRows : n;
+  setupQLD(n, nEq, nIneqRows, ldq_);
+  if(usePresolve_)
+    presolve_.reserve(nCstrRows, n);
 
-  impact.inequalityConstraints_ = impact.equalityConstraints_;
   return impact;
 }
 
 void QLDLeastSquareSolver::addBound_(LinearConstraintPtr bound, RangePtr range, bool first)
 {
   scheme::internal::AssignmentTarget target(range, xl_, xu_);
-  addAssignement(bound, target, bound->variables()[0], first);
+  addAssignement(bound, target, bound->variables()[0], first, big_number_);
 }
 
 void QLDLeastSquareSolver::addEqualityConstraint_(LinearConstraintPtr cstr)
 {
   RangePtr r = std::make_shared<Range>(nextEqualityConstraintRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, A_, b_, constraint::Type::EQUAL, constraint::RHS::OPPOSITE);
-  addAssignement(cstr, nullptr, target, variables(), substitutions());
+  addAssignement(cstr, nullptr, target, variables(), substitutions(), 1., big_number_);
 }
 
 void QLDLeastSquareSolver::addIneqalityConstraint_(LinearConstraintPtr cstr)
@@ -91,14 +116,14 @@ void QLDLeastSquareSolver::addIneqalityConstraint_(LinearConstraintPtr cstr)
   RangePtr r = std::make_shared<Range>(nextInequalityConstraintRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, Aineq_, bineq_, constraint::Type::GREATER_THAN,
                                             constraint::RHS::OPPOSITE);
-  addAssignement(cstr, nullptr, target, variables(), substitutions());
+  addAssignement(cstr, nullptr, target, variables(), substitutions(), 1., big_number_);
 }
 
 void QLDLeastSquareSolver::addObjective_(LinearConstraintPtr cstr, SolvingRequirementsPtr req, double additionalWeight)
 {
   RangePtr r = std::make_shared<Range>(nextObjectiveRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, D_, e_, constraint::Type::EQUAL, constraint::RHS::OPPOSITE);
-  addAssignement(cstr, req, target, variables(), substitutions(), additionalWeight);
+  addAssignement(cstr, req, target, variables(), substitutions(), additionalWeight, big_number_);
 }
 
 void QLDLeastSquareSolver::setMinimumNorm_()
@@ -124,7 +149,7 @@ void QLDLeastSquareSolver::postAssignmentProcess_()
   if(!autoMinNorm_)
   {
     // c = D^T e
-    c_.noalias() = D_.topRows(nObj_).transpose() * e_;
+    c_.noalias() = D_.topRows(nObj_).transpose() * e_.head(nObj_);
 
     if(cholesky_)
     {
@@ -142,6 +167,23 @@ void QLDLeastSquareSolver::postAssignmentProcess_()
 
 bool QLDLeastSquareSolver::solve_()
 {
+  presolved_ = false;
+  if(usePresolve_)
+  {
+    // When working with the Cholesky factor of Q, removing variables would
+    // require a new factorization, so that only constraints are removed.
+    presolved_ = presolve_.analyze(A_, b_, xl_, xu_, nEq_, !cholesky_ || autoMinNorm_);
+    // The rows added for the reserved capacity are not counted.
+    int padding = static_cast<int>(A_.rows()) - nEq_ - nIneq_;
+    presolveStatistics_.removedConstraints = presolve_.removedConstraints() - padding;
+    presolveStatistics_.removedVariables = presolve_.removedVariables();
+  }
+
+  if(presolved_)
+  {
+    return solvePresolved();
+  }
+
   if(cholesky_ && !autoMinNorm_)
   {
     int n = variables().totalSize();
@@ -153,7 +195,55 @@ bool QLDLeastSquareSolver::solve_()
   }
 }
 
-const Eigen::VectorXd & QLDLeastSquareSolver::result_() const { return qld_.result(); }
+bool QLDLeastSquareSolver::solvePresolved()
+{
+  presolve_.reduceConstraints(A_, b_, xl_, xu_);
+  int nEq = presolve_.nEq();
+  bool success;
+
+  if(cholesky_ && !autoMinNorm_)
+  {
+    int n = variables().totalSize();
+    success = qld_.solve(qr_.matrixQR().topRows(n), c_, presolve_.A(), presolve_.b(), presolve_.xl(), presolve_.xu(),
+                         nEq, true, eps_);
+  }
+  else
+  {
+    if(presolve_.freeVariables() == 0)
+    {
+      // All the variables are fixed. The remaining constraints, if any, are
+      // violated.
+      return presolve_.constraints() == 0;
+    }
+    presolve_.reduceObjective(Q_, c_);
+    success = qld_.solve(presolve_.Q(), presolve_.c(), presolve_.A(), presolve_.b(), presolve_.xl(), presolve_.xu(),
+                         nEq, false, eps_);
+  }
+
+  // qld_ is set up for the unreduced problem, only the first values of its
+  // result correspond to the reduced one.
+  if(success)
+    presolve_.expand(qld_.result().head(presolve_.freeVariables()));
+  return success;
+}
+
+void QLDLeastSquareSolver::setupQLD(int n, int nEq, int nIneq, int ldq)
+{
+  std::array<int, 4> dims = {n, nEq, nIneq, ldq};
+  if(dims != qldDims_)
+  {
+    qld_.problem(n, nEq, nIneq, ldq);
+    qldDims_ = dims;
+  }
+}
+
+const Eigen::VectorXd & QLDLeastSquareSolver::result_() const
+{
+  if(presolved_)
+    return presolve_.x();
+  else
+    return qld_.result();
+}
 
 Range QLDLeastSquareSolver::nextEqualityConstraintRange_(const constraint::abstract::LinearConstraint & cstr) const
 { return {eqSize_, cstr.size()}; }
@@ -170,6 +260,27 @@ void QLDLeastSquareSolver::removeBounds_(const Range & range)
   xu_.segment(range.start, range.dim).setConstant(+big_number_);
 }
 
+void QLDLeastSquareSolver::resetObjectiveRows_(int start)
+{
+  auto s = std::min(Eigen::Index(start), e_.size());
+  D_.middleRows(s, e_.size() - s).setZero();
+  e_.tail(e_.size() - s).setZero();
+}
+
+void QLDLeastSquareSolver::resetEqualityConstraintRows_(int start)
+{
+  int s = std::min(start, nEq_);
+  A_.middleRows(s, nEq_ - s).setZero();
+  b_.segment(s, nEq_ - s).setZero();
+}
+
+void QLDLeastSquareSolver::resetInequalityConstraintRows_(int start)
+{
+  auto s = std::min(Eigen::Index(start), bineq_.size());
+  Aineq_.bottomRows(bineq_.size() - s).setZero();
+  bineq_.tail(bineq_.size() - s).setConstant(+big_number_);
+}
+
 void QLDLeastSquareSolver::updateEqualityTargetData(scheme::internal::AssignmentTarget & target)
 { target.changeData(MatrixRef(A_), b_); }
 
@@ -205,6 +316,31 @@ void QLDLeastSquareSolver::printProblemData_() const
   std::cout << "xu = " << xu_.transpose() << std::endl;
 }
 
+void QLDLeastSquareSolver::exportProblem_(QPRecord & record) const
+{
+  int n = variables().totalSize();
+  int nCstr = nEq_ + nIneq_;
+  if(autoMinNorm_)
+  {
+    record.A.setIdentity(n, n);
+    record.b.setZero(n);
+  }
+  else
+  {
+    // D x + e = 0
+    record.A = D_.topRows(nObj_);
+    record.b = -e_.head(nObj_);
+  }
+  // A x + b = 0 for the equality constraints, A x + b >= 0 for the inequality ones
+  record.C = A_.topRows(nCstr);
+  record.l = -b_.head(nCstr);
+  record.u.resize(nCstr);
+  record.u.head(nEq_) = record.l.head(nEq_);
+  record.u.tail(nIneq_).setConstant(+big_number_);
+  record.xl = xl_;
+  record.xu = xu_;
+}
+
 void QLDLeastSquareSolver::printDiagnostic_() const
 { std::cout << "QLD fail code = " << qld_.fail() << " (0 is success)" << std::endl; }
 
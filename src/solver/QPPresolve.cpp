@@ -0,0 +1,182 @@
+/* Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/solver/internal/QPPresolve.h>
+
+#include <cmath>
+
+using namespace Eigen;
+
+namespace tvm
+{
+
+namespace solver
+{
+
+namespace internal
+{
+QPPresolve::QPPresolve(double bigNumber, double eps)
+: bigNumber_(bigNumber), eps_(eps), nEq_(0), removedConstraints_(0)
+{}
+
+namespace
+{
+/** Make sure \p v has at least \p size elements.*/
+void ensureSize(VectorXd & v, DenseIndex size)
+{
+  if(v.size() < size)
+  {
+    v.resize(size);
+  }
+}
+} // namespace
+
+void QPPresolve::reserve(int m, int n)
+{
+  free_.reserve(static_cast<size_t>(n));
+  fixed_.reserve(static_cast<size_t>(n));
+  rows_.reserve(static_cast<size_t>(m));
+  ensureSize(Q_, n * n);
+  ensureSize(c_, n);
+  ensureSize(A_, m * n);
+  ensureSize(b_, m);
+  ensureSize(xl_, n);
+  ensureSize(xu_, n);
+  x_.resize(n);
+}
+
+bool QPPresolve::analyze(const MatrixConstRef & A,
+                         const VectorConstRef & b,
+                         const VectorConstRef & xl,
+                         const VectorConstRef & xu,
+                         int nEq,
+                         bool fixedVariables)
+{
+  assert(A.rows() == b.size());
+  assert(A.cols() == xl.size() && A.cols() == xu.size());
+
+  const DenseIndex n = A.cols();
+  free_.clear();
+  fixed_.clear();
+  x_.resize(n);
+  for(DenseIndex j = 0; j < n; ++j)
+  {
+    if(fixedVariables && xl[j] == xu[j])
+    {
+      fixed_.push_back(j);
+      x_[j] = xl[j];
+    }
+    else
+    {
+      free_.push_back(j);
+    }
+  }
+
+  rows_.clear();
+  nEq_ = 0;
+  for(DenseIndex i = 0; i < A.rows(); ++i)
+  {
+    bool eq = i < nEq;
+    if(!eq && b[i] >= bigNumber_)
+    {
+      continue;
+    }
+
+    bool empty = true;
+    for(auto j : free_)
+    {
+      if(A(i, j) != 0)
+      {
+        empty = false;
+        break;
+      }
+    }
+    if(empty)
+    {
+      double r = b[i];
+      for(auto j : fixed_)
+      {
+        r += A(i, j) * x_[j];
+      }
+      if(eq ? std::abs(r) <= eps_ : r >= -eps_)
+      {
+        continue;
+      }
+    }
+
+    rows_.push_back(i);
+    if(eq)
+    {
+      ++nEq_;
+    }
+  }
+  removedConstraints_ = static_cast<int>(A.rows() - static_cast<DenseIndex>(rows_.size()));
+
+  return removedConstraints_ > 0 || !fixed_.empty();
+}
+
+void QPPresolve::reduceConstraints(const MatrixConstRef & A,
+                                   const VectorConstRef & b,
+                                   const VectorConstRef & xl,
+                                   const VectorConstRef & xu)
+{
+  const auto m = static_cast<DenseIndex>(rows_.size());
+  const auto n = static_cast<DenseIndex>(free_.size());
+  ensureSize(A_, m * n);
+  ensureSize(b_, m);
+  for(DenseIndex k = 0; k < m; ++k)
+  {
+    auto i = rows_[static_cast<size_t>(k)];
+    for(DenseIndex l = 0; l < n; ++l)
+    {
+      A_[l * m + k] = A(i, free_[static_cast<size_t>(l)]);
+    }
+    b_[k] = b[i];
+    for(auto j : fixed_)
+    {
+      b_[k] += A(i, j) * x_[j];
+    }
+  }
+
+  ensureSize(xl_, n);
+  ensureSize(xu_, n);
+  for(DenseIndex l = 0; l < n; ++l)
+  {
+    xl_[l] = xl[free_[static_cast<size_t>(l)]];
+    xu_[l] = xu[free_[static_cast<size_t>(l)]];
+  }
+}
+
+void QPPresolve::reduceObjective(const MatrixConstRef & Q, const VectorConstRef & c)
+{
+  const auto n = static_cast<DenseIndex>(free_.size());
+  ensureSize(Q_, n * n);
+  ensureSize(c_, n);
+  for(DenseIndex k = 0; k < n; ++k)
+  {
+    auto i = free_[static_cast<size_t>(k)];
+    for(DenseIndex l = 0; l < n; ++l)
+    {
+      Q_[l * n + k] = Q(i, free_[static_cast<size_t>(l)]);
+    }
+    c_[k] = c[i];
+    for(auto j : fixed_)
+    {
+      c_[k] += Q(i, j) * x_[j];
+    }
+  }
+}
+
+void QPPresolve::expand(const VectorConstRef & y)
+{
+  assert(y.size() >= static_cast<DenseIndex>(free_.size()));
+  for(size_t k = 0; k < free_.size(); ++k)
+  {
+    x_[free_[k]] = y[static_cast<DenseIndex>(k)];
+  }
+}
+
+} // namespace internal
+
+} // namespace solver
+
+} // namespace tvm
@@ -0,0 +1,437 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/solver/QPRecorder.h>
+
+#include <tvm/Space.h>
+#include <tvm/Variable.h>
+#include <tvm/VariableVector.h>
+#include <tvm/constraint/BasicLinearConstraint.h>
+#include <tvm/requirements/SolvingRequirements.h>
+#include <tvm/solver/abstract/LeastSquareSolver.h>
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+const char magic[8] = {'T', 'V', 'M', 'Q', 'P', 'L', 'O', 'G'};
+const int64_t version = 1;
+
+void writeInt(std::ofstream & f, int64_t i) { f.write(reinterpret_cast<const char *>(&i), sizeof(int64_t)); }
+
+void writeData(std::ofstream & f, const Eigen::MatrixXd & M)
+{
+  f.write(reinterpret_cast<const char *>(M.data()), static_cast<std::streamsize>(M.size() * sizeof(double)));
+}
+
+void writeData(std::ofstream & f, const Eigen::VectorXd & v)
+{
+  f.write(reinterpret_cast<const char *>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(double)));
+}
+
+bool readInt(std::ifstream & f, int64_t & i)
+{
+  f.read(reinterpret_cast<char *>(&i), sizeof(int64_t));
+  return static_cast<bool>(f);
+}
+
+template<typename T>
+void readData(std::ifstream & f, T & M)
+{
+  f.read(reinterpret_cast<char *>(M.data()), static_cast<std::streamsize>(M.size() * sizeof(double)));
+}
+} // namespace
+
+namespace tvm
+{
+
+namespace solver
+{
+
+QPRecorder::QPRecorder(const std::string & path, int capacity)
+: file_(path, std::ios::binary | std::ios::trunc), tick_(0), reserved_(0), tail_(0), recorded_(0), dropped_(0),
+  failed_(false), stop_(false)
+{
+  if(!file_)
+  {
+    throw std::runtime_error("[QPRecorder::QPRecorder] Unable to open " + path + " for writing.");
+  }
+  if(capacity < 1)
+  {
+    throw std::runtime_error("[QPRecorder::QPRecorder] The capacity must be at least 1.");
+  }
+  file_.write(magic, sizeof(magic));
+  writeInt(file_, version);
+  if(!file_.flush())
+  {
+    throw std::runtime_error("[QPRecorder::QPRecorder] Unable to write the header of " + path + ".");
+  }
+  slots_.resize(static_cast<size_t>(capacity));
+  states_.resize(static_cast<size_t>(capacity), SlotState::Discarded);
+  writer_ = std::thread(static_cast<void (QPRecorder::*)()>(&QPRecorder::write), this);
+}
+
+QPRecorder::~QPRecorder()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  pending_.notify_one();
+  writer_.join();
+}
+
+QPRecord * QPRecorder::acquire()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t tick = tick_++;
+  if(reserved_ - tail_ == slots_.size())
+  {
+    ++dropped_;
+    return nullptr;
+  }
+  size_t i = reserved_++ % slots_.size();
+  states_[i] = SlotState::Filling;
+  QPRecord * record = &slots_[i];
+  record->tick = tick;
+  return record;
+}
+
+void QPRecorder::commit(QPRecord * record)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    states_[slotIndex(record)] = SlotState::Committed;
+    ++recorded_;
+  }
+  pending_.notify_one();
+}
+
+void QPRecorder::discard(QPRecord * record)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    states_[slotIndex(record)] = SlotState::Discarded;
+  }
+  pending_.notify_one();
+}
+
+void QPRecorder::reserve(const QPRecord & prototype)
+{
+  const auto n = prototype.xl.size();
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The slots in [tail_, reserved_) are being filled or written.
+  for(uint64_t k = reserved_; k < tail_ + slots_.size(); ++k)
+  {
+    auto & r = slots_[k % slots_.size()];
+    r.A.resize(prototype.A.rows(), n);
+    r.b.resize(prototype.b.size());
+    r.C.resize(prototype.C.rows(), n);
+    r.l.resize(prototype.l.size());
+    r.u.resize(prototype.u.size());
+    r.xl.resize(n);
+    r.xu.resize(n);
+    r.x.resize(n);
+  }
+}
+
+void QPRecorder::flush()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  written_.wait(lock, [this] { return tail_ == reserved_ || states_[tail_ % slots_.size()] == SlotState::Filling; });
+  if(failed_)
+  {
+    throw std::runtime_error("[QPRecorder::flush] Error while writing the log.");
+  }
+}
+
+int64_t QPRecorder::recorded() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return recorded_;
+}
+
+int64_t QPRecorder::dropped() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_;
+}
+
+bool QPRecorder::failed() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return failed_;
+}
+
+size_t QPRecorder::slotIndex(const QPRecord * record) const
+{
+  assert(record >= slots_.data() && record < slots_.data() + slots_.size());
+  return static_cast<size_t>(record - slots_.data());
+}
+
+void QPRecorder::write()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto handedBack = [this] { return tail_ != reserved_ && states_[tail_ % slots_.size()] != SlotState::Filling; };
+  while(true)
+  {
+    pending_.wait(lock, [&] { return stop_ || handedBack(); });
+    if(!handedBack())
+    {
+      // stop_ is true and everything that was handed back was written
+      return;
+    }
+    size_t i = tail_ % slots_.size();
+    if(states_[i] == SlotState::Committed)
+    {
+      bool ok = false;
+      if(!failed_)
+      {
+        // The slot at tail_ is not touched by the solving threads until tail_
+        // is incremented, so that it can be written without holding the lock.
+        lock.unlock();
+        ok = write(slots_[i]);
+        lock.lock();
+      }
+      if(!ok)
+      {
+        failed_ = true;
+        --recorded_;
+        ++dropped_;
+      }
+    }
+    ++tail_;
+    written_.notify_all();
+  }
+}
+
+bool QPRecorder::write(const QPRecord & r)
+{
+  int64_t n = r.xl.size();
+  int64_t nObj = r.A.rows();
+  int64_t nCstr = r.C.rows();
+  int64_t size = static_cast<int64_t>(sizeof(int64_t)) * 6
+                 + static_cast<int64_t>(sizeof(double)) * ((nObj + nCstr) * (n + 1) + 2 * nCstr + 3 * n);
+  writeInt(file_, size);
+  writeInt(file_, r.tick);
+  writeInt(file_, n);
+  writeInt(file_, nObj);
+  writeInt(file_, nCstr);
+  writeInt(file_, r.success ? 1 : 0);
+  writeData(file_, r.A);
+  writeData(file_, r.b);
+  writeData(file_, r.C);
+  writeData(file_, r.l);
+  writeData(file_, r.u);
+  writeData(file_, r.xl);
+  writeData(file_, r.xu);
+  writeData(file_, r.x);
+  return static_cast<bool>(file_.flush());
+}
+
+QPLogReader::QPLogReader(const std::string & path) : file_(path, std::ios::binary)
+{
+  if(!file_)
+  {
+    throw std::runtime_error("[QPLogReader::QPLogReader] Unable to open " + path + ".");
+  }
+  char m[sizeof(magic)];
+  int64_t v;
+  file_.read(m, sizeof(m));
+  if(!file_ || std::memcmp(m, magic, sizeof(magic)) != 0 || !readInt(file_, v))
+  {
+    throw std::runtime_error("[QPLogReader::QPLogReader] " + path + " is not a QP log.");
+  }
+  if(v != version)
+  {
+    throw std::runtime_error("[QPLogReader::QPLogReader] Unsupported version of the QP log " + path + ".");
+  }
+}
+
+bool QPLogReader::next(QPRecord & record)
+{
+  int64_t size, n, nObj, nCstr, success;
+  if(!readInt(file_, size))
+  {
+    if(file_.eof() && file_.gcount() == 0)
+    {
+      return false;
+    }
+    throw std::runtime_error("[QPLogReader::next] Unable to read the next record.");
+  }
+  if(!readInt(file_, record.tick) || !readInt(file_, n) || !readInt(file_, nObj) || !readInt(file_, nCstr)
+     || !readInt(file_, success))
+  {
+    throw std::runtime_error("[QPLogReader::next] Truncated record.");
+  }
+  if(n < 0 || nObj < 0 || nCstr < 0
+     || size
+            != static_cast<int64_t>(sizeof(int64_t)) * 6
+                   + static_cast<int64_t>(sizeof(double)) * ((nObj + nCstr) * (n + 1) + 2 * nCstr + 3 * n))
+  {
+    throw std::runtime_error("[QPLogReader::next] Corrupted record.");
+  }
+  record.success = success != 0;
+  record.A.resize(nObj, n);
+  record.b.resize(nObj);
+  record.C.resize(nCstr, n);
+  record.l.resize(nCstr);
+  record.u.resize(nCstr);
+  record.xl.resize(n);
+  record.xu.resize(n);
+  record.x.resize(n);
+  readData(file_, record.A);
+  readData(file_, record.b);
+  readData(file_, record.C);
+  readData(file_, record.l);
+  readData(file_, record.u);
+  readData(file_, record.xl);
+  readData(file_, record.xu);
+  readData(file_, record.x);
+  if(!file_)
+  {
+    throw std::runtime_error("[QPLogReader::next] Truncated record.");
+  }
+  return true;
+}
+
+/** The problem built from a record, and the solver solving it.*/
+struct QPReplay::Problem
+{
+  VariablePtr x;
+  VariableVector variables;
+  std::unique_ptr<abstract::LeastSquareSolver> solver;
+  std::shared_ptr<constraint::BasicLinearConstraint> objective;
+  std::shared_ptr<constraint::BasicLinearConstraint> equality;
+  std::shared_ptr<constraint::BasicLinearConstraint> inequality;
+  std::shared_ptr<constraint::BasicLinearConstraint> bounds;
+  std::vector<Eigen::DenseIndex> eqRows;
+  std::vector<Eigen::DenseIndex> ineqRows;
+
+  // Temporaries for the data of the constraints
+  Eigen::MatrixXd M;
+  Eigen::VectorXd l;
+  Eigen::VectorXd u;
+};
+
+QPReplay::QPReplay(const abstract::LSSolverFactory & factory, double big) : factory_(factory.clone()), big_(big) {}
+
+QPReplay::~QPReplay() = default;
+
+bool QPReplay::solve(const QPRecord & record)
+{
+  const auto n = record.xl.size();
+  std::vector<Eigen::DenseIndex> eqRows;
+  std::vector<Eigen::DenseIndex> ineqRows;
+  for(Eigen::DenseIndex i = 0; i < record.C.rows(); ++i)
+  {
+    if(record.l[i] == record.u[i])
+      eqRows.push_back(i);
+    else
+      ineqRows.push_back(i);
+  }
+  bool useBounds = (record.xl.array() > -big_).any() || (record.xu.array() < big_).any();
+
+  bool rebuild = !pb_ || pb_->x->size() != n || pb_->eqRows != eqRows || pb_->ineqRows != ineqRows
+                 || static_cast<bool>(pb_->bounds) != useBounds
+                 || (pb_->objective ? pb_->objective->size() : 0) != record.A.rows();
+
+  auto rows = [](const auto & src, const std::vector<Eigen::DenseIndex> & idx, auto & dst) {
+    dst.resize(static_cast<Eigen::DenseIndex>(idx.size()), src.cols());
+    for(size_t k = 0; k < idx.size(); ++k)
+      dst.row(static_cast<Eigen::DenseIndex>(k)) = src.row(idx[k]);
+  };
+
+  if(rebuild)
+  {
+    using constraint::BasicLinearConstraint;
+    using constraint::Type;
+    pb_ = std::make_unique<Problem>();
+    pb_->x = Space(static_cast<int>(n)).createVariable("x");
+    pb_->variables = VariableVector(pb_->x);
+    pb_->solver = factory_->createSolver();
+    pb_->eqRows = eqRows;
+    pb_->ineqRows = ineqRows;
+    if(record.A.rows() > 0)
+      pb_->objective = std::make_shared<BasicLinearConstraint>(record.A, pb_->x, record.b, Type::EQUAL);
+    if(!eqRows.empty())
+    {
+      rows(record.C, eqRows, pb_->M);
+      rows(record.u, eqRows, pb_->u);
+      pb_->equality = std::make_shared<BasicLinearConstraint>(pb_->M, pb_->x, pb_->u, Type::EQUAL);
+    }
+    if(!ineqRows.empty())
+    {
+      rows(record.C, ineqRows, pb_->M);
+      rows(record.l, ineqRows, pb_->l);
+      rows(record.u, ineqRows, pb_->u);
+      pb_->inequality = std::make_shared<BasicLinearConstraint>(pb_->M, pb_->x, pb_->l, pb_->u);
+    }
+    if(useBounds)
+    {
+      pb_->bounds =
+          std::make_shared<BasicLinearConstraint>(Eigen::MatrixXd::Identity(n, n), pb_->x, record.xl, record.xu);
+      pb_->bounds->A(Eigen::MatrixXd::Identity(n, n), tvm::internal::MatrixProperties::IDENTITY);
+    }
+
+    auto & s = *pb_->solver;
+    int nEq = pb_->equality ? s.constraintSize(*pb_->equality) : 0;
+    int nIneq = pb_->inequality ? s.constraintSize(*pb_->inequality) : 0;
+    s.startBuild(pb_->variables, static_cast<int>(record.A.rows()), nEq, nIneq, useBounds);
+    if(pb_->bounds)
+      s.addBound(pb_->bounds);
+    if(pb_->equality)
+      s.addConstraint(pb_->equality);
+    if(pb_->inequality)
+      s.addConstraint(pb_->inequality);
+    if(pb_->objective)
+      s.addObjective(pb_->objective,
+                     std::make_shared<requirements::SolvingRequirementsWithCallbacks>(requirements::PriorityLevel(1)));
+    s.finalizeBuild();
+  }
+  else
+  {
+    if(pb_->objective)
+    {
+      pb_->objective->A(record.A);
+      pb_->objective->b(record.b);
+    }
+    if(pb_->equality)
+    {
+      rows(record.C, eqRows, pb_->M);
+      rows(record.u, eqRows, pb_->u);
+      pb_->equality->A(pb_->M);
+      pb_->equality->b(pb_->u);
+    }
+    if(pb_->inequality)
+    {
+      rows(record.C, ineqRows, pb_->M);
+      rows(record.l, ineqRows, pb_->l);
+      rows(record.u, ineqRows, pb_->u);
+      pb_->inequality->A(pb_->M);
+      pb_->inequality->l(pb_->l);
+      pb_->inequality->u(pb_->u);
+    }
+    if(pb_->bounds)
+    {
+      pb_->bounds->l(record.xl);
+      pb_->bounds->u(record.xu);
+    }
+  }
+
+  return pb_->solver->solve();
+}
+
+const Eigen::VectorXd & QPReplay::result() const
+{
+  if(!pb_)
+  {
+    throw std::runtime_error("[QPReplay::result] No problem was solved yet.");
+  }
+  return pb_->solver->result();
+}
+
+} // namespace solver
+
+} // namespace tvm
@@ -3,6 +3,7 @@
 #include <tvm/solver/QuadprogLeastSquareSolver.h>
 
 #include <tvm/scheme/internal/AssignmentTarget.h>
+#include <tvm/solver/QPRecorder.h>
 
 #include <iostream>
 
@@ -79,6 +80,8 @@ QuadprogLeastSquareSolver::ImpactFromChanges QuadprogLeastSquareSolver::resize_(
     new(&xl_) VectorXdSeg(b_.segment(nCstr, 0));
     new(&xu_) VectorXdSeg(b_.segment(nCstr, 0));
   }
+  // The inequality and bound views move with the number of constraints.
+  bool viewsMoved = Aineq_.startRow() != nEq || Aineq_.rows() != nIneq;
   new(&Aineq_) MatrixXdRows(A_.middleRows(nEq, nIneq));
   new(&bineq_) VectorXdSeg(b_.segment(nEq, nIneq));
   if(useBounds)
@@ -93,8 +96,8 @@ QuadprogLeastSquareSolver::ImpactFromChanges QuadprogLeastSquareSolver::resize_(
       new(&qr_) Eigen::HouseholderQR<Eigen::MatrixXd>(nObj, n);
   }
 
-  impact.inequalityConstraints_ = impact.equalityConstraints_;
-  impact.bounds_ = impact.equalityConstraints_;
+  impact.inequalityConstraints_ = impact.equalityConstraints_ || viewsMoved;
+  impact.bounds_ = impact.equalityConstraints_ || viewsMoved;
   return impact;
 }
 
@@ -107,21 +110,21 @@ void QuadprogLeastSquareSolver::addBound_(LinearConstraintPtr bound, RangePtr ra
   // to -I in initializeBuild_
   // TODO: extend Assignment for that.
   scheme::internal::AssignmentTarget target(range, xl_, xu_);
-  addAssignement(bound, target, bound->variables()[0], first);
+  addAssignement(bound, target, bound->variables()[0], first, big_number_);
 }
 
 void QuadprogLeastSquareSolver::addEqualityConstraint_(LinearConstraintPtr cstr)
 {
   RangePtr r = std::make_shared<Range>(nextEqualityConstraintRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, A_, b_, constraint::Type::EQUAL, constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, nullptr, target, variables(), substitutions());
+  addAssignement(cstr, nullptr, target, variables(), substitutions(), 1., big_number_);
 }
 
 void QuadprogLeastSquareSolver::addIneqalityConstraint_(LinearConstraintPtr cstr)
 {
   RangePtr r = std::make_shared<Range>(nextInequalityConstraintRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, Aineq_, bineq_, constraint::Type::LOWER_THAN, constraint::RHS::AS_GIVEN);
-  addAssignement(cstr, nullptr, target, variables(), substitutions());
+  addAssignement(cstr, nullptr, target, variables(), substitutions(), 1., big_number_);
 }
 
 void QuadprogLeastSquareSolver::addObjective_(LinearConstraintPtr cstr,
@@ -130,7 +133,7 @@ void QuadprogLeastSquareSolver::addObjective_(LinearConstraintPtr cstr,
 {
   RangePtr r = std::make_shared<Range>(nextObjectiveRange_(*cstr));
   scheme::internal::AssignmentTarget target(r, D_, e_, constraint::Type::EQUAL, constraint::RHS::OPPOSITE);
-  addAssignement(cstr, req, target, variables(), substitutions(), additionalWeight);
+  addAssignement(cstr, req, target, variables(), substitutions(), additionalWeight, big_number_);
 }
 
 void QuadprogLeastSquareSolver::setMinimumNorm_()
@@ -266,6 +269,40 @@ void QuadprogLeastSquareSolver::printProblemData_() const
   std::cout << "b = " << b_.transpose() << std::endl;
 }
 
+void QuadprogLeastSquareSolver::exportProblem_(QPRecord & record) const
+{
+  int n = variables().totalSize();
+  int nCstr = nEq_ + nIneq_;
+  if(autoMinNorm_)
+  {
+    record.A.setIdentity(n, n);
+    record.b.setZero(n);
+  }
+  else
+  {
+    // D x + e = 0. D has not yet been overwritten by postAssignmentProcess_.
+    record.A = D_.topRows(nObj_);
+    record.b = -e_.head(nObj_);
+  }
+  // A x = b for the equality constraints, A x <= b for the inequality ones
+  record.C = A_.topRows(nCstr);
+  record.u = b_.head(nCstr);
+  record.l.resize(nCstr);
+  record.l.head(nEq_) = record.u.head(nEq_);
+  record.l.tail(nIneq_).setConstant(-big_number_);
+  // The sign of xl is not yet changed by postAssignmentProcess_.
+  if(xl_.size() > 0)
+  {
+    record.xl = xl_;
+    record.xu = xu_;
+  }
+  else
+  {
+    record.xl.setConstant(n, -big_number_);
+    record.xu.setConstant(n, +big_number_);
+  }
+}
+
 void QuadprogLeastSquareSolver::printDiagnostic_() const
 { std::cout << "Quadprog fail code = " << qpd_.fail() << " (0 is success)" << std::endl; }
 
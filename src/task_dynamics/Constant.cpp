@@ -25,6 +25,9 @@ Constant::Impl::Impl(FunctionPtr f, constraint::Type t, const Eigen::VectorXd &
 : TaskDynamicsImpl(Order::Zero, f, t, rhs)
 { value_ = rhs; }
 
+std::unique_ptr<abstract::TaskDynamicsImpl> Constant::Impl::clone(FunctionPtr f, utils::CloneMap &) const
+{ return std::make_unique<Impl>(f, type(), rhs()); }
+
 void Constant::Impl::updateValue() { value_ = rhs(); }
 
 } // namespace task_dynamics
@@ -31,6 +31,9 @@ None::Impl::Impl(FunctionPtr f, constraint::Type t, const Eigen::VectorXd & rhs)
   addInputDependency<Impl>(Update::UpdateValue, std::static_pointer_cast<LinearFunction>(f), LinearFunction::Output::B);
 }
 
+std::unique_ptr<abstract::TaskDynamicsImpl> None::Impl::clone(FunctionPtr f, utils::CloneMap &) const
+{ return std::make_unique<Impl>(f, type(), rhs()); }
+
 void None::Impl::updateValue() { value_ = rhs() - lf_->b(); }
 
 } // namespace task_dynamics
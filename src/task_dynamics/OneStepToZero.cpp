@@ -49,6 +49,9 @@ OneStepToZero::Impl::Impl(FunctionPtr f, constraint::Type t, const Eigen::Vector
 : TaskDynamicsImpl(d, f, t, rhs), dt_(dt)
 { OneStepToZero::checkParam(d, dt); }
 
+std::unique_ptr<abstract::TaskDynamicsImpl> OneStepToZero::Impl::clone(FunctionPtr f, utils::CloneMap &) const
+{ return std::make_unique<Impl>(f, type(), rhs(), order(), dt_); }
+
 void OneStepToZero::Impl::updateValue()
 {
   value_ = (rhs() - function().value()) / dt_;
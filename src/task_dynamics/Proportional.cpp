@@ -36,6 +36,9 @@ Proportional::Impl::Impl(FunctionPtr f, constraint::Type t, const Eigen::VectorX
   }
 }
 
+std::unique_ptr<abstract::TaskDynamicsImpl> Proportional::Impl::clone(FunctionPtr f, utils::CloneMap &) const
+{ return std::make_unique<Impl>(f, type(), rhs(), kp_); }
+
 void Proportional::Impl::updateValue()
 {
   // \internal The code below would be cleaner using std::visit. Unfortunately
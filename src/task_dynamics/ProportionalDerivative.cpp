@@ -81,6 +81,9 @@ ProportionalDerivative::Impl::Impl(FunctionPtr f,
          && "Gain kv and function have incompatible sizes");
 }
 
+std::unique_ptr<abstract::TaskDynamicsImpl> ProportionalDerivative::Impl::clone(FunctionPtr f, utils::CloneMap &) const
+{ return std::make_unique<Impl>(f, type(), rhs(), kp_, kv_); }
+
 void ProportionalDerivative::Impl::updateValue()
 {
   switch(kv_.index())
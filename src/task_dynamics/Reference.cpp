@@ -5,6 +5,7 @@
 #include <tvm/task_dynamics/Reference.h>
 
 #include <tvm/function/abstract/Function.h>
+#include <tvm/utils/CloneMap.h>
 #include <tvm/task_dynamics/Reference.h>
 
 namespace tvm::task_dynamics
@@ -22,6 +23,9 @@ Reference::Impl::Impl(FunctionPtr f, constraint::Type t, const Eigen::VectorXd &
 : TaskDynamicsImpl(order, f, t, rhs)
 { setReference(ref); }
 
+std::unique_ptr<abstract::TaskDynamicsImpl> Reference::Impl::clone(FunctionPtr f, utils::CloneMap & map) const
+{ return std::make_unique<Impl>(f, type(), rhs(), order(), map.function(ref_)); }
+
 void Reference::Impl::updateValue() { value_ = ref_->value(); }
 
 void Reference::Impl::ref(const FunctionPtr &)
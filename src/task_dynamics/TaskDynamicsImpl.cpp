@@ -30,6 +30,9 @@ TaskDynamicsImpl::TaskDynamicsImpl(Order order, FunctionPtr f, constraint::Type
   addOutputDependency(Output::Value, Update::UpdateValue);
 }
 
+std::unique_ptr<TaskDynamicsImpl> TaskDynamicsImpl::clone(FunctionPtr, utils::CloneMap &) const
+{ throw std::runtime_error("[TaskDynamicsImpl::clone] This task dynamics does not support cloning."); }
+
 void TaskDynamicsImpl::setFunction(FunctionPtr f)
 {
   if(f)
@@ -202,6 +202,16 @@ VelocityDamper::Impl::Impl(FunctionPtr f,
   }
 }
 
+std::unique_ptr<abstract::TaskDynamicsImpl> VelocityDamper::Impl::clone(FunctionPtr f, utils::CloneMap &) const
+{
+  Eigen::VectorXd xsi = autoXsi_ ? xsiOff_ : Eigen::VectorXd(axsi_.cwiseQuotient(a_));
+  if(order() == Order::One)
+  {
+    return std::make_unique<Impl>(f, type(), rhs(), autoXsi_, di_, ds_, xsi, big_);
+  }
+  return std::make_unique<Impl>(f, type(), rhs(), dt_, autoXsi_, di_, ds_, xsi, big_);
+}
+
 void VelocityDamper::Impl::updateValue()
 {
   if(type() == constraint::Type::LOWER_THAN)
@@ -0,0 +1,95 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/utils/CloneMap.h>
+
+#include <tvm/Clock.h>
+#include <tvm/ControlProblem.h>
+#include <tvm/Variable.h>
+#include <tvm/function/abstract/Function.h>
+
+#include <stdexcept>
+#include <typeinfo>
+
+namespace tvm
+{
+
+namespace utils
+{
+
+VariablePtr CloneMap::variable(const VariablePtr & x)
+{
+  auto it = variables_.find(x.get());
+  if(it != variables_.end())
+  {
+    return it->second;
+  }
+
+  VariablePtr c;
+  if(!x->isBasePrimitive())
+  {
+    c = dot(variable(x->primitive()));
+  }
+  else if(x->isSubvariable())
+  {
+    c = variable(x->superVariable())->subvariable(x->space(), x->name(), x->spaceShift());
+  }
+  else
+  {
+    c = x->space().createVariable(x->name());
+  }
+  c->set(x->value());
+  variables_[x.get()] = c;
+  return c;
+}
+
+FunctionPtr CloneMap::function(const FunctionPtr & f)
+{
+  auto it = functions_.find(f.get());
+  if(it != functions_.end())
+  {
+    return it->second;
+  }
+
+  auto c = f->clone(*this);
+  // A derived class not overriding clone would be sliced by the implementation of its base.
+  if(!c || typeid(*c) != typeid(*f))
+  {
+    throw std::runtime_error(std::string("[CloneMap::function] Functions of type ") + typeid(*f).name()
+                             + " cannot be cloned.");
+  }
+  functions_[f.get()] = c;
+  source(*f, *c);
+  return c;
+}
+
+Clock & CloneMap::clock(const Clock & c)
+{
+  auto it = clocks_.find(&c);
+  if(it != clocks_.end())
+  {
+    return *it->second;
+  }
+
+  ClockPtr clone(new Clock(c));
+  clocks_[&c] = clone;
+  source(c, *clone);
+  return *clone;
+}
+
+const std::shared_ptr<TaskWithRequirements> & CloneMap::task(const TaskWithRequirements & tr) const
+{ return tasks_.at(&tr); }
+
+void CloneMap::task(const TaskWithRequirements & tr, std::shared_ptr<TaskWithRequirements> clone)
+{ tasks_[&tr] = std::move(clone); }
+
+graph::abstract::Outputs * CloneMap::source(const graph::abstract::Outputs & s) const
+{
+  auto it = sources_.find(&s);
+  return it != sources_.end() ? it->second : nullptr;
+}
+
+void CloneMap::source(const graph::abstract::Outputs & s, graph::abstract::Outputs & clone) { sources_[&s] = &clone; }
+
+} // namespace utils
+
+} // namespace tvm
@@ -0,0 +1,118 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/utils/internal/ThreadPool.h>
+
+#include <stdexcept>
+
+namespace tvm::utils::internal
+{
+
+ThreadPool::ThreadPool(int n) : job_(nullptr), n_(0), next_(0), busy_(0), batch_(0), stop_(false)
+{
+  if(n < 1)
+  {
+    throw std::runtime_error("[ThreadPool::ThreadPool] The number of threads must be at least 1.");
+  }
+  for(int i = 1; i < n; ++i)
+  {
+    workers_.emplace_back(&ThreadPool::work, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for(auto & w : workers_)
+  {
+    w.join();
+  }
+}
+
+int ThreadPool::size() const { return static_cast<int>(workers_.size()) + 1; }
+
+void ThreadPool::run(size_t n, const std::function<void(size_t)> & job)
+{
+  if(workers_.empty() || n <= 1)
+  {
+    for(size_t i = 0; i < n; ++i)
+    {
+      job(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    n_ = n;
+    next_ = 0;
+    busy_ = workers_.size();
+    error_ = nullptr;
+    ++batch_;
+  }
+  start_.notify_all();
+
+  process();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this]() { return busy_ == 0; });
+  job_ = nullptr;
+  if(error_)
+  {
+    std::rethrow_exception(error_);
+  }
+}
+
+void ThreadPool::work()
+{
+  uint64_t batch = 0;
+  while(true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [this, batch]() { return stop_ || batch_ != batch; });
+      if(stop_)
+      {
+        return;
+      }
+      batch = batch_;
+    }
+
+    process();
+
+    bool last;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      last = (--busy_ == 0);
+    }
+    if(last)
+    {
+      done_.notify_one();
+    }
+  }
+}
+
+void ThreadPool::process()
+{
+  for(size_t i = next_++; i < n_; i = next_++)
+  {
+    try
+    {
+      (*job_)(i);
+    }
+    catch(...)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if(!error_)
+      {
+        error_ = std::current_exception();
+      }
+    }
+  }
+}
+
+} // namespace tvm::utils::internal
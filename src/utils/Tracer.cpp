@@ -0,0 +1,162 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/utils/Tracer.h>
+
+#include <tvm/graph/internal/Logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+/** Small integer id of the calling thread.*/
+int threadId()
+{
+  static std::atomic<int> count{0};
+  thread_local int id = count.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+/** Write s as a JSON string.*/
+void writeString(std::ostream & os, const std::string & s)
+{
+  os << '"';
+  for(char c : s)
+  {
+    if(c == '"' || c == '\\')
+      os << '\\';
+    os << c;
+  }
+  os << '"';
+}
+} // namespace
+
+namespace tvm
+{
+
+namespace utils
+{
+
+Tracer & Tracer::tracer()
+{
+  static Tracer tracer_;
+  return tracer_;
+}
+
+void Tracer::enable(int capacity)
+{
+  if(capacity < 1)
+  {
+    throw std::runtime_error("[Tracer::enable] The capacity must be at least 1.");
+  }
+  uint64_t size = 1;
+  while(size < static_cast<uint64_t>(capacity))
+    size <<= 1;
+  buffer_.resize(size);
+  mask_ = size - 1;
+  next_.store(0, std::memory_order_relaxed);
+  enabled_.store(true, std::memory_order_release);
+}
+
+void Tracer::disable() { enabled_.store(false, std::memory_order_release); }
+
+void Tracer::clear() { next_.store(0, std::memory_order_relaxed); }
+
+void Tracer::record(const char * name, std::uintptr_t object, int id, int64_t start, int64_t end)
+{
+  if(!enabled())
+    return;
+
+  uint64_t i = next_.fetch_add(1, std::memory_order_relaxed);
+  buffer_[i & mask_] = {name, object, id, threadId(), start, end - start};
+}
+
+std::vector<TraceEvent> Tracer::events() const
+{
+  uint64_t n = next_.load(std::memory_order_acquire);
+  uint64_t first = n > buffer_.size() ? n - buffer_.size() : 0;
+  std::vector<TraceEvent> events;
+  events.reserve(n - first);
+  for(uint64_t i = first; i < n; ++i)
+    events.push_back(buffer_[i & mask_]);
+  return events;
+}
+
+uint64_t Tracer::overwritten() const
+{
+  uint64_t n = next_.load(std::memory_order_acquire);
+  return n > buffer_.size() ? n - buffer_.size() : 0;
+}
+
+void Tracer::writeChromeTrace(std::ostream & os) const
+{
+  // Names of the updates, as registered in the graph log
+  std::map<std::pair<std::uintptr_t, int>, std::string> names;
+  const auto & log = graph::internal::Logger::logger().log();
+  for(const auto & u : log.updates_)
+    names[{u.owner.value, u.id.value}] = log.readableName(u);
+
+  auto events = this->events();
+  int64_t origin = events.empty() ? 0 : events.front().start;
+  for(const auto & e : events)
+    origin = std::min(origin, e.start);
+
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  for(const auto & e : events)
+  {
+    os << (first ? "\n" : ",\n");
+    first = false;
+    os << "{\"name\":";
+    if(e.name)
+    {
+      writeString(os, e.name);
+      os << ",\"cat\":\"solver\"";
+    }
+    else
+    {
+      auto it = names.find({e.object, e.id});
+      if(it != names.end())
+      {
+        writeString(os, it->second);
+      }
+      else
+      {
+        std::stringstream ss;
+        ss << "0x" << std::hex << e.object << "::update" << std::dec << e.id;
+        writeString(os, ss.str());
+      }
+      os << ",\"cat\":\"graph\"";
+    }
+    os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.thread << std::fixed << std::setprecision(3)
+       << ",\"ts\":" << static_cast<double>(e.start - origin) * 1e-3
+       << ",\"dur\":" << static_cast<double>(e.duration) * 1e-3 << std::defaultfloat << "}";
+  }
+  os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void Tracer::writeChromeTrace(const std::string & path) const
+{
+  std::ofstream f(path);
+  if(!f)
+  {
+    throw std::runtime_error("[Tracer::writeChromeTrace] Unable to open " + path + " for writing.");
+  }
+  writeChromeTrace(f);
+}
+
+int64_t Tracer::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace utils
+
+} // namespace tvm
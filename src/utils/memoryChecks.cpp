@@ -7,7 +7,8 @@
 namespace tvm::utils::internal
 {
 
-std::stack<bool> malloc_is_allowed_override_;
+// One stack per thread, so that problems can be solved concurrently.
+thread_local std::stack<bool> malloc_is_allowed_override_;
 
 bool is_malloc_allowed_()
 {
@@ -1173,3 +1173,203 @@ TEST_CASE("Change weights")
     }
   }
 }
+
+TEST_CASE("Disabled source")
+{
+  Constraints cstr = buildConstraints(3, 7);
+  VariableVector vv(cstr.Ax_eq_0->variables());
+  auto req = std::make_shared<SolvingRequirementsWithCallbacks>();
+  auto enabled = std::make_shared<bool>(true);
+  auto range = std::make_shared<Range>(2, 3);
+  Memory mem(6, 7);
+
+  // target Ax = b
+  {
+    cstr.Ax_eq_b->enabledFlag(enabled);
+    AssignmentTarget at(range, mem.A, mem.b, Type::EQUAL, RHS::AS_GIVEN);
+    Assignment a(cstr.Ax_eq_b, req, at, vv);
+    mem.randomize();
+    Memory ref = mem;
+
+    *enabled = false;
+    a.run();
+    FAST_CHECK_UNARY(mem.A.middleRows(2, 3).isZero());
+    FAST_CHECK_UNARY(mem.b.segment(2, 3).isZero());
+    FAST_CHECK_EQ(mem.A.topRows(2), ref.A.topRows(2));
+    FAST_CHECK_EQ(mem.A.bottomRows(1), ref.A.bottomRows(1));
+
+    *enabled = true;
+    a.run();
+    FAST_CHECK_EQ(mem.A.middleRows(2, 3), cstr.Ax_eq_b->jacobian(*vv[0]));
+    FAST_CHECK_EQ(mem.b.segment(2, 3), cstr.Ax_eq_b->e());
+    cstr.Ax_eq_b->enabledFlag(nullptr);
+  }
+
+  // target Ax + b >= 0
+  {
+    cstr.Ax_geq_b->enabledFlag(enabled);
+    AssignmentTarget at(range, mem.A, mem.b, Type::GREATER_THAN, RHS::OPPOSITE);
+    Assignment a(cstr.Ax_geq_b, req, at, vv);
+    mem.randomize();
+
+    *enabled = false;
+    a.run();
+    FAST_CHECK_UNARY(mem.A.middleRows(2, 3).isZero());
+    FAST_CHECK_EQ(mem.b.segment(2, 3), VectorXd::Constant(3, large));
+    *enabled = true;
+  }
+
+  // target l <= Ax <= u
+  {
+    cstr.l_leq_Ax_leq_u->enabledFlag(enabled);
+    AssignmentTarget at(range, mem.A, mem.l, mem.u, RHS::AS_GIVEN);
+    Assignment a(cstr.l_leq_Ax_leq_u, req, at, vv);
+    mem.randomize();
+
+    *enabled = false;
+    a.run();
+    FAST_CHECK_UNARY(mem.A.middleRows(2, 3).isZero());
+    FAST_CHECK_EQ(mem.l.segment(2, 3), VectorXd::Constant(3, -large));
+    FAST_CHECK_EQ(mem.u.segment(2, 3), VectorXd::Constant(3, large));
+    *enabled = true;
+  }
+
+  // bounds l <= x <= u
+  {
+    Constraints bnd = buildSimpleConstraints();
+    bnd.l_leq_Ax_leq_u->enabledFlag(enabled);
+    auto bRange = std::make_shared<Range>(0, 1);
+    Memory bMem(1, 1);
+    AssignmentTarget at(bRange, VectorRef(bMem.l), bMem.u);
+    Assignment a1(bnd.l_leq_Ax_leq_u, at, bnd.l_leq_Ax_leq_u->variables()[0], true);
+    Assignment a2(bnd.Ax_geq_0, at, bnd.Ax_geq_0->variables()[0], false);
+
+    // The first assignment relaxes the bounds, the following ones apply on top of it.
+    *enabled = false;
+    a1.run();
+    a2.run();
+    FAST_CHECK_EQ(bMem.l[0], 0);
+    FAST_CHECK_EQ(bMem.u[0], large);
+
+    *enabled = true;
+    a1.run();
+    a2.run();
+    checkSimple(bnd.l_leq_Ax_leq_u, bnd.Ax_geq_0, bMem);
+
+    // A following assignment does nothing when disabled.
+    bnd.l_leq_Ax_leq_u->enabledFlag(nullptr);
+    bnd.Ax_geq_0->enabledFlag(enabled);
+    *enabled = false;
+    a1.run();
+    a2.run();
+    checkSimple(bnd.l_leq_Ax_leq_u, bMem, Type::DOUBLE_SIDED, RHS::AS_GIVEN, true);
+  }
+
+  // Quadratic targets, for which a disabled source could not be taken out of
+  // the accumulated data, are rejected.
+  {
+    MatrixXd Q = MatrixXd::Zero(7, 7);
+    VectorXd q = VectorXd::Zero(7);
+    AssignmentTarget at(Q, q, RHS::AS_GIVEN);
+    CHECK_THROWS_AS(Assignment(cstr.Ax_eq_b, req, at, vv), std::runtime_error);
+  }
+}
+
+TEST_CASE("Disabled side of a double-sided source")
+{
+  Constraints cstr = buildConstraints(3, 7);
+  VariableVector vv(cstr.l_leq_Ax_leq_u->variables());
+  auto req = std::make_shared<SolvingRequirementsWithCallbacks>();
+  auto lower = std::make_shared<bool>(false);
+  auto upper = std::make_shared<bool>(true);
+  cstr.l_leq_Ax_leq_u->boundsEnabledFlags(lower, upper);
+  const double big = 1e10;
+
+  // target l <= Ax <= u
+  {
+    auto range = std::make_shared<Range>(2, 3);
+    Memory mem(6, 7);
+    AssignmentTarget at(range, mem.A, mem.l, mem.u, RHS::AS_GIVEN);
+    Assignment a(cstr.l_leq_Ax_leq_u, req, at, vv, nullptr, 1, big);
+    a.run();
+    FAST_CHECK_EQ(mem.A.middleRows(2, 3), cstr.l_leq_Ax_leq_u->jacobian(*vv[0]));
+    FAST_CHECK_EQ(mem.l.segment(2, 3), VectorXd::Constant(3, -big));
+    FAST_CHECK_EQ(mem.u.segment(2, 3), cstr.l_leq_Ax_leq_u->u());
+  }
+
+  // target Ax + b >= 0, the first half is for the lower bound
+  {
+    auto range = std::make_shared<Range>(2, 6);
+    Memory mem(8, 7);
+    AssignmentTarget at(range, mem.A, mem.b, Type::GREATER_THAN, RHS::OPPOSITE);
+    Assignment a(cstr.l_leq_Ax_leq_u, req, at, vv, nullptr, 1, big);
+    a.run();
+    FAST_CHECK_EQ(mem.b.segment(2, 3), VectorXd::Constant(3, big));
+    FAST_CHECK_EQ(mem.b.segment(5, 3), cstr.l_leq_Ax_leq_u->u());
+
+    *lower = true;
+    *upper = false;
+    a.run();
+    FAST_CHECK_EQ(mem.b.segment(2, 3), -cstr.l_leq_Ax_leq_u->l());
+    FAST_CHECK_EQ(mem.b.segment(5, 3), VectorXd::Constant(3, big));
+    *lower = false;
+    *upper = true;
+  }
+
+  // bounds l <= x <= u
+  {
+    Constraints bnd = buildSimpleConstraints();
+    bnd.l_leq_Ax_leq_u->boundsEnabledFlags(lower, upper);
+    auto bRange = std::make_shared<Range>(0, 1);
+    Memory bMem(1, 1);
+    AssignmentTarget at(bRange, VectorRef(bMem.l), bMem.u);
+    Assignment a(bnd.l_leq_Ax_leq_u, at, bnd.l_leq_Ax_leq_u->variables()[0], true, big);
+    a.run();
+    FAST_CHECK_EQ(bMem.l[0], -big);
+    FAST_CHECK_EQ(bMem.u[0], bnd.l_leq_Ax_leq_u->u()[0]);
+  }
+}
+
+TEST_CASE("Assignment of diagonal jacobians")
+{
+  VariablePtr x = Space(3).createVariable("x");
+  VariablePtr y = Space(3).createVariable("y");
+  VariablePtr z = Space(2).createVariable("z");
+  VariableVector vv(x, y, z);
+  MatrixXd Az = MatrixXd::Random(3, 2);
+
+  // -2 x + diag(d) y + Az z >= b. The jacobian matrices for x and y are only read on their diagonal
+  std::vector<VariablePtr> xs = {x, y, z};
+  auto c = std::make_shared<BasicLinearConstraint>(3, xs, Type::GREATER_THAN);
+  MatrixXd Ax = -2 * MatrixXd::Identity(3, 3);
+  MatrixXd Ay = Vector3d(1, 2, 3).asDiagonal();
+  c->A(Ax, *x, {tvm::internal::MatrixProperties::MULTIPLE_OF_IDENTITY});
+  c->A(Ay, *y, {tvm::internal::MatrixProperties::DIAGONAL});
+  c->A(Az, *z);
+  c->b(Vector3d::Random());
+
+  auto range = std::make_shared<Range>(1, 3);
+  Memory mem(8, 8);
+  AssignmentTarget at(range, mem.A, mem.b, Type::LOWER_THAN, RHS::AS_GIVEN);
+  Vector3d aW(1., 4., 9.);
+  auto req = std::make_shared<SolvingRequirementsWithCallbacks>(AnisotropicWeight{aW});
+  Assignment a(c, req, at, vv);
+  mem.randomize();
+  Memory ref = mem;
+  a.run();
+
+  // -W(-2 x + diag(d) y + Az z) <= -W b, with W = diag(1, 2, 3)
+  Matrix3d W = Vector3d(1, 2, 3).asDiagonal();
+  FAST_CHECK_EQ(mem.A.block(1, 0, 3, 3), APPROX_I386(-W * Ax));
+  FAST_CHECK_EQ(mem.A.block(1, 3, 3, 3), APPROX_I386(-W * Ay));
+  FAST_CHECK_EQ(mem.A.block(1, 6, 3, 2), APPROX_I386(-W * Az));
+  FAST_CHECK_EQ(mem.b.segment(1, 3), APPROX_I386(-W * c->l()));
+  FAST_CHECK_EQ(mem.A.topRows(1), ref.A.topRows(1));
+  FAST_CHECK_EQ(mem.A.bottomRows(4), ref.A.bottomRows(4));
+
+  // Changes of the diagonal values are taken into account
+  Ay.diagonal() << 4, 5, 6;
+  c->A(Ay, *y, {tvm::internal::MatrixProperties::DIAGONAL});
+  a.run();
+  FAST_CHECK_EQ(mem.A.block(1, 3, 3, 3), APPROX_I386(-W * Ay));
+}
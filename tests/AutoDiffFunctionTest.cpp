@@ -0,0 +1,175 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include "SolverTestFunctions.h"
+
+#include <tvm/Variable.h>
+#include <tvm/function/abstract/AutoDiffFunction.h>
+#include <tvm/utils/checkFunction.h>
+#include <tvm/utils/graph.h>
+
+#include <cmath>
+
+using namespace tvm;
+using namespace Eigen;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+namespace
+{
+/** Same as Simple2dRobotEE, without any hand-written derivative.*/
+class AutoDiff2dRobotEE : public function::abstract::AutoDiffFunction<AutoDiff2dRobotEE>
+{
+public:
+  AutoDiff2dRobotEE(VariablePtr x, const Vector2d & base, const VectorXd & lengths)
+  : AutoDiffFunction(2, {x}), base_(base), lengths_(lengths)
+  {}
+
+  template<typename T>
+  void evaluate(const Inputs<T> & x, Vector<T> & f) const
+  {
+    T a = 0;
+    f = base_.cast<T>();
+    for(Index i = 0; i < lengths_.size(); ++i)
+    {
+      a += x[0][i];
+      f[0] += lengths_[i] * cos(a);
+      f[1] += lengths_[i] * sin(a);
+    }
+  }
+
+private:
+  Vector2d base_;
+  VectorXd lengths_;
+};
+
+/** f(x,y) = (x^T A y, sin(x0) exp(y1), sqrt(1 + ||x||^2))*/
+class Mixed : public function::abstract::AutoDiffFunction<Mixed>
+{
+public:
+  Mixed(VariablePtr x, VariablePtr y, const MatrixXd & A) : AutoDiffFunction(3, {x, y}), A_(A) {}
+
+  template<typename T>
+  void evaluate(const Inputs<T> & x, Vector<T> & f) const
+  {
+    f[0] = x[0].dot(A_.cast<T>() * x[1]);
+    f[1] = sin(x[0][0]) * exp(x[1][1]);
+    f[2] = sqrt(1 + x[0].squaredNorm());
+  }
+
+private:
+  MatrixXd A_;
+};
+
+template<typename F>
+void updateAll(const std::shared_ptr<F> & f)
+{
+  using Output = typename F::Output;
+  auto g = utils::generateUpdateGraph(f, Output::Value, Output::Jacobian, Output::Velocity, Output::NormalAcceleration,
+                                      Output::JDot);
+  g->execute();
+}
+} // namespace
+
+TEST_CASE("Dual numbers")
+{
+  using D = utils::Dual<2>;
+  D a(0.7, Vector2d(1, 0));
+  D b(1.3, Vector2d(0, 1));
+  D f = sin(a) * b / sqrt(a * a + b) - 2. * atan2(b, a) + exp(-a) * pow(b, 3.) + log(a + 1);
+
+  auto value = [](double a, double b) {
+    return std::sin(a) * b / std::sqrt(a * a + b) - 2. * std::atan2(b, a) + std::exp(-a) * std::pow(b, 3.)
+           + std::log(a + 1);
+  };
+  const double h = 1e-6;
+  FAST_CHECK_EQ(f.v, doctest::Approx(value(0.7, 1.3)));
+  FAST_CHECK_EQ(f.d[0], doctest::Approx((value(0.7 + h, 1.3) - value(0.7 - h, 1.3)) / (2 * h)).epsilon(1e-6));
+  FAST_CHECK_EQ(f.d[1], doctest::Approx((value(0.7, 1.3 + h) - value(0.7, 1.3 - h)) / (2 * h)).epsilon(1e-6));
+
+  // Nested dual numbers give the second derivative: (x^2 exp(x))'' = (x^2 + 4x + 2) exp(x)
+  using D1 = utils::Dual<1>;
+  using D11 = utils::Dual<1, D1>;
+  D11 x(D1(0.5, Matrix<double, 1, 1>(1)), Matrix<D1, 1, 1>(D1(1)));
+  D11 g = x * x * exp(x);
+  FAST_CHECK_EQ(g.v.v, doctest::Approx(0.25 * std::exp(0.5)));
+  FAST_CHECK_EQ(g.v.d[0], doctest::Approx(1.25 * std::exp(0.5)));
+  FAST_CHECK_EQ(g.d[0].v, doctest::Approx(1.25 * std::exp(0.5)));
+  FAST_CHECK_EQ(g.d[0].d[0], doctest::Approx(4.25 * std::exp(0.5)));
+}
+
+TEST_CASE("Automatic differentiation of a 2d robot")
+{
+  // 7 joints: the jacobian is computed with a full chunk of columns and a partial one
+  VectorXd l(7);
+  l << 1, 0.5, 0.8, 1.2, 0.3, 0.7, 1;
+  Vector2d base(0.2, -0.4);
+  VariablePtr x = Space(7).createVariable("x");
+  x->set(VectorXd::LinSpaced(7, -1, 1));
+  dot(x)->set(VectorXd::LinSpaced(7, 2, -0.5));
+
+  auto ad = std::make_shared<AutoDiff2dRobotEE>(x, base, l);
+  auto ref = std::make_shared<Simple2dRobotEE>(x, base, l);
+  updateAll(ad);
+  auto g = utils::generateUpdateGraph(ref, Simple2dRobotEE::Output::Value, Simple2dRobotEE::Output::Jacobian,
+                                      Simple2dRobotEE::Output::Velocity, Simple2dRobotEE::Output::NormalAcceleration);
+  g->execute();
+
+  FAST_CHECK_UNARY(ad->value().isApprox(ref->value()));
+  FAST_CHECK_UNARY(ad->jacobian(*x).isApprox(ref->jacobian(*x)));
+  FAST_CHECK_UNARY(ad->velocity().isApprox(ref->velocity()));
+  FAST_CHECK_UNARY(ad->normalAcceleration().isApprox(ref->normalAcceleration()));
+  FAST_CHECK_UNARY(ad->normalAcceleration().isApprox(ad->JDot(*x) * dot(x)->value()));
+
+  // Updating again after a change of the variables
+  x->set(VectorXd::LinSpaced(7, 0.5, -0.2));
+  updateAll(ad);
+  g->execute();
+  FAST_CHECK_UNARY(ad->jacobian(*x).isApprox(ref->jacobian(*x)));
+  FAST_CHECK_UNARY(ad->normalAcceleration().isApprox(ref->normalAcceleration()));
+}
+
+TEST_CASE("Automatic differentiation with several variables")
+{
+  VariablePtr x = Space(5).createVariable("x");
+  VariablePtr y = Space(3).createVariable("y");
+  MatrixXd A = MatrixXd::Random(5, 3);
+
+  auto f = std::make_shared<Mixed>(x, y, A);
+  FAST_CHECK_UNARY_FALSE(f->linearIn(*x));
+  FAST_CHECK_UNARY(utils::checkFunction(f));
+
+  x->set(VectorXd::LinSpaced(5, 0.3, -0.6));
+  y->set(Vector3d(0.5, -0.2, 0.4));
+  dot(x)->set(VectorXd::LinSpaced(5, -1, 1));
+  dot(y)->set(Vector3d(0.3, 0.6, -0.9));
+  updateAll(f);
+  FAST_CHECK_EQ(f->value()[0], doctest::Approx(x->value().dot(A * y->value())));
+  FAST_CHECK_UNARY(f->jacobian(*x).row(0).isApprox((A * y->value()).transpose()));
+  FAST_CHECK_UNARY(f->jacobian(*y).row(0).isApprox(x->value().transpose() * A));
+
+  // JDot against a finite difference of the jacobian along the velocity
+  const double h = 1e-6;
+  auto jacobianAt = [&](double t) {
+    x->set(VectorXd::LinSpaced(5, 0.3, -0.6) + t * dot(x)->value());
+    y->set(Vector3d(0.5, -0.2, 0.4) + t * dot(y)->value());
+    f->updateJacobian();
+    MatrixXd J(3, 8);
+    J << f->jacobian(*x), f->jacobian(*y);
+    return J;
+  };
+  MatrixXd JDot(3, 8);
+  JDot << f->JDot(*x), f->JDot(*y);
+  MatrixXd JDotFD = (jacobianAt(h) - jacobianAt(-h)) / (2 * h);
+  FAST_CHECK_UNARY(JDot.isApprox(JDotFD, 1e-6));
+  VectorXd v(8);
+  v << dot(x)->value(), dot(y)->value();
+  FAST_CHECK_UNARY(f->normalAcceleration().isApprox(JDot * v));
+}
+
+TEST_CASE("Automatic differentiation requires Euclidean variables")
+{
+  VariablePtr q = Space(Space::Type::SO3).createVariable("q");
+  CHECK_THROWS_AS(std::make_shared<AutoDiff2dRobotEE>(q, Vector2d::Zero(), Vector3d::Ones()), std::runtime_error);
+}
@@ -0,0 +1,87 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/Clock.h>
+#include <tvm/graph/CallGraph.h>
+#include <tvm/graph/abstract/Node.h>
+
+#include <memory>
+
+using namespace tvm;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+namespace
+{
+/** A node counting the runs of its updates.*/
+class Counter : public graph::abstract::Node<Counter>
+{
+public:
+  SET_UPDATES(Counter, Slow, Fast)
+  SET_OUTPUTS(Counter, Slow, Fast)
+
+  Counter()
+  {
+    registerUpdates(Update::Slow, &Counter::updateSlow, Update::Fast, &Counter::updateFast);
+    addOutputDependency(Output::Slow, Update::Slow);
+    addOutputDependency(Output::Fast, Update::Fast);
+    addInternalDependency(Update::Fast, Update::Slow);
+  }
+
+  int slow = 0;
+  int fast = 0;
+  /** Value of slow seen by the last run of the fast update.*/
+  int slowSeen = 0;
+
+private:
+  void updateSlow() { ++slow; }
+  void updateFast()
+  {
+    ++fast;
+    slowSeen = slow;
+  }
+};
+} // namespace
+
+TEST_CASE("Update periods")
+{
+  Clock clock(0.01);
+  auto counter = std::make_shared<Counter>();
+  auto user = std::make_shared<graph::internal::Inputs>();
+  user->addInput(counter, Counter::Output::Fast);
+  graph::CallGraph g;
+  g.add(user);
+  g.update();
+
+  FAST_CHECK_EQ(counter->updatePeriod(Counter::Update::Slow), 1);
+  counter->setUpdatePeriod(Counter::Update::Slow, clock, 3);
+  FAST_CHECK_EQ(counter->updatePeriod(Counter::Update::Slow), 3);
+  FAST_CHECK_EQ(counter->updatePeriod(Counter::Update::Fast), 1);
+
+  for(int i = 0; i < 7; ++i)
+  {
+    g.execute();
+    // The slow update runs at ticks 0, 3 and 6, and its result is reused in between
+    FAST_CHECK_EQ(counter->slow, i / 3 + 1);
+    FAST_CHECK_EQ(counter->fast, i + 1);
+    FAST_CHECK_EQ(counter->slowSeen, counter->slow);
+    clock.advance();
+  }
+
+  // Executing several times in the same tick does not run the update again
+  g.execute();
+  g.execute();
+  FAST_CHECK_EQ(counter->slow, 3);
+  FAST_CHECK_EQ(counter->fast, 9);
+
+  // Back to full rate
+  counter->setUpdatePeriod(Counter::Update::Slow, clock, 1);
+  FAST_CHECK_EQ(counter->updatePeriod(Counter::Update::Slow), 1);
+  g.execute();
+  g.execute();
+  FAST_CHECK_EQ(counter->slow, 5);
+
+  CHECK_THROWS(counter->setUpdatePeriod(Counter::Update::Slow, clock, 0));
+  CHECK_THROWS(counter->setUpdatePeriod(static_cast<Counter::Update_>(42), clock, 2));
+}
@@ -561,3 +561,76 @@ TEST_CASE("Test compiled assignments wrapper")
   ma.run();
   FAST_CHECK_EQ(B.middleRows(0, 3), B_ref.middleRows(0, 3) + A1 + A1);
 }
+
+TEST_CASE("Test fixed-size compiled assignments wrapper")
+{
+  typedef CompiledAssignmentWrapper<MatrixXd> MatrixAssignment;
+  MatrixXd A3 = MatrixXd::Random(3, 7);
+  MatrixXd A6 = MatrixXd::Random(6, 7);
+  MatrixXd A4 = MatrixXd::Random(4, 7);
+  MatrixXd B = MatrixXd::Zero(15, 9);
+  VectorXd w = Vector3d(1, 2, 3);
+
+  std::vector<MatrixAssignment> a;
+  a.push_back(MatrixAssignment::makeForSize<COPY, DIAGONAL, IDENTITY, EXTERNAL>(B.block(0, 1, 3, 7), A3, w));
+  a.push_back(MatrixAssignment::makeForSize<COPY, MINUS, IDENTITY, EXTERNAL>(B.block(3, 2, 6, 7), A6));
+  a.push_back(MatrixAssignment::makeForSize<ADD, NONE, IDENTITY, EXTERNAL>(B.block(9, 0, 4, 7), A4));
+
+  // The sources are referenced, not copied
+  A3.setRandom();
+  A6.setRandom();
+  Eigen::internal::set_is_malloc_allowed(false);
+  for(auto & assignment : a)
+    assignment.run();
+  Eigen::internal::set_is_malloc_allowed(true);
+
+  FAST_CHECK_EQ(B.block(0, 1, 3, 7), w.asDiagonal() * A3);
+  FAST_CHECK_EQ(B.block(3, 2, 6, 7), -A6);
+  FAST_CHECK_EQ(B.block(9, 0, 4, 7), A4);
+
+  // Change of source and target, and copy
+  MatrixXd A3b = MatrixXd::Random(3, 7);
+  MatrixXd C(3, 7);
+  MatrixAssignment c = a[0];
+  c.from(A3b);
+  c.to(C);
+  c.run();
+  FAST_CHECK_EQ(C, w.asDiagonal() * A3b);
+}
+
+TEST_CASE("Test diagonal-source compiled assignments wrapper")
+{
+  typedef CompiledAssignmentWrapper<MatrixXd> MatrixAssignment;
+  MatrixXd D = Vector4d(1, 2, 3, 4).asDiagonal();
+  MatrixXd B = MatrixXd::Random(8, 6);
+  MatrixXd B_ref = B;
+  VectorXd w = Vector4d(1, -2, 3, -4);
+  double s = 3;
+
+  std::vector<MatrixAssignment> a;
+  a.push_back(MatrixAssignment::make<COPY, NONE, IDENTITY, EXTERNAL_DIAGONAL>(B.block(0, 0, 4, 4), D));
+  a.push_back(MatrixAssignment::make<COPY, DIAGONAL, IDENTITY, EXTERNAL_DIAGONAL>(B.block(4, 2, 4, 4), D, w));
+  a.push_back(MatrixAssignment::make<ADD, SCALAR, IDENTITY, EXTERNAL_DIAGONAL>(B.block(0, 2, 4, 4), D, s));
+
+  // The source is referenced, not copied
+  D.diagonal() << 5, 6, 7, 8;
+  Eigen::internal::set_is_malloc_allowed(false);
+  for(auto & assignment : a)
+    assignment.run();
+  Eigen::internal::set_is_malloc_allowed(true);
+
+  MatrixXd C_ref = B_ref;
+  C_ref.block(0, 0, 4, 4) = D;
+  C_ref.block(4, 2, 4, 4) = w.asDiagonal() * D;
+  C_ref.block(0, 2, 4, 4) += s * D;
+  FAST_CHECK_EQ(B, C_ref);
+
+  // Only the diagonal of the source is read
+  MatrixXd E = D;
+  E(0, 1) = 10;
+  MatrixXd C = MatrixXd::Random(4, 4);
+  MatrixAssignment c = MatrixAssignment::make<COPY, MINUS, IDENTITY, EXTERNAL_DIAGONAL>(C, D);
+  c.from(E);
+  c.run();
+  FAST_CHECK_EQ(C, -D);
+}
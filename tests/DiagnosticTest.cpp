@@ -8,6 +8,7 @@
 #include <tvm/constraint/abstract/Constraint.h>
 #include <tvm/constraint/internal/LinearizedTaskConstraint.h>
 #include <tvm/diagnostic/GraphProbe.h>
+#include <tvm/diagnostic/ProbeSubscription.h>
 #include <tvm/diagnostic/matrix.h>
 #include <tvm/function/IdentityFunction.h>
 #include <tvm/graph/CallGraph.h>
@@ -16,6 +17,11 @@
 #include <tvm/task_dynamics/None.h>
 #include <tvm/task_dynamics/Proportional.h>
 #include <tvm/task_dynamics/VelocityDamper.h>
+#include <tvm/utils/memoryChecks.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
@@ -133,3 +139,106 @@ TEST_CASE("GraphProbe")
     FAST_CHECK_EQ(t->children.size(), 1);
   }
 }
+
+TEST_CASE("GraphProbe subscription")
+{
+  Space s1(2);
+  VariablePtr x = s1.createVariable("x");
+  x << Vector2d(0.5, 0.5);
+
+  Space s2(3);
+  VariablePtr q = s2.createVariable("q");
+  q->set(Vector3d(0.4, -0.6, -0.1));
+
+  auto sf = make_shared<SphereFunction>(x, Vector2d(0, 0), 1);
+  auto rf = make_shared<Simple2dRobotEE>(q, Vector2d(-3, 0), Vector3d(1, 1, 1));
+  auto idx = make_shared<function::IdentityFunction>(x);
+  auto df = make_shared<Difference>(rf, idx);
+
+  LinearizedControlProblem lpb;
+  lpb.add(sf == 0., task_dynamics::P(2), {PriorityLevel(0)});
+  lpb.add(df == 0., task_dynamics::P(2), {PriorityLevel(0)});
+  lpb.add(dot(q) == 0., task_dynamics::None(), {PriorityLevel(1)});
+
+  scheme::WeightedLeastSquares solver(solver::DefaultLSSolverOptions{});
+  solver.solve(lpb);
+
+  GraphProbe gp;
+  gp.registerTVMFunction<SphereFunction>();
+  gp.registerTVMFunction<Simple2dRobotEE>();
+  gp.registerTVMFunction<Difference>();
+
+  // The graph log is global and still holds the entries of the previous test, so we look for the
+  // outputs of the objects of this test explicitly.
+  const auto & log = tvm::graph::internal::Logger::logger().log();
+  auto output = [&](const void * owner, const std::string & name) {
+    auto it = std::find_if(log.outputs_.rbegin(), log.outputs_.rend(), [&](const GraphProbe::Output & o) {
+      return o.owner.value == reinterpret_cast<std::uintptr_t>(owner) && o.name == name;
+    });
+    REQUIRE(it != log.outputs_.rend());
+    return *it;
+  };
+  auto sfValue = output(sf.get(), "Value");
+
+  {
+    auto sub = gp.subscribe({sfValue, output(sf.get(), "Jacobian"), output(df.get(), "Value")});
+    FAST_REQUIRE_EQ(sub->entries().size(), 3);
+    FAST_CHECK_EQ(sub->entries()[1].variable, x);
+    FAST_CHECK_EQ(sub->sampleSize(), 1 + 2 + 2);
+    FAST_REQUIRE_UNARY(sub->sample());
+    ProbeSubscription::Sample s;
+    FAST_REQUIRE_UNARY(sub->next(s));
+    FAST_CHECK_EQ(s.index, 0);
+    FAST_CHECK_EQ(s.data.size(), sub->sampleSize());
+    FAST_CHECK_UNARY(sub->value(s, 0) == sf->value());
+    FAST_CHECK_UNARY(sub->value(s, 1) == sf->jacobian(*x));
+    FAST_CHECK_UNARY(sub->value(s, 2) == df->value());
+    FAST_CHECK_UNARY(!sub->next(s));
+  }
+
+  // Sampling the value of the sphere function every other tick, with a logger thread
+  const int N = 200;
+  auto sub = gp.subscribe({sfValue}, 4, 2);
+  FAST_REQUIRE_EQ(sub->entries().size(), 1);
+  FAST_CHECK_EQ(sub->sampleSize(), 1);
+
+  std::vector<std::pair<uint64_t, double>> logged;
+  std::atomic<bool> done{false};
+  std::thread logger([&]() {
+    ProbeSubscription::Sample s;
+    while(true)
+    {
+      bool finished = done.load();
+      while(sub->next(s))
+        logged.emplace_back(s.index, sub->value(s, 0)(0, 0));
+      if(finished)
+        break;
+      std::this_thread::yield();
+    }
+  });
+  std::vector<double> values;
+  for(int i = 0; i < N; ++i)
+  {
+    x << Vector2d(0.5 + i, 0.5);
+    lpb.update();
+    values.push_back(sf->value()[0]);
+    tvm::utils::set_is_malloc_allowed(false);
+    sub->sample();
+    tvm::utils::set_is_malloc_allowed(true);
+  }
+  done = true;
+  logger.join();
+
+  FAST_CHECK_EQ(logged.size() + sub->dropped(), N / 2);
+  uint64_t previous = 0;
+  for(size_t k = 0; k < logged.size(); ++k)
+  {
+    auto i = logged[k].first;
+    FAST_CHECK_EQ(i % 2, 0);
+    FAST_CHECK_UNARY(k == 0 || i > previous);
+    FAST_CHECK_EQ(logged[k].second, values[i]);
+    previous = i;
+  }
+
+  CHECK_THROWS(gp.subscribe({sfValue}, 0));
+}
@@ -3,8 +3,10 @@
 #include <tvm/ControlProblem.h>
 #include <tvm/LinearizedControlProblem.h>
 #include <tvm/Variable.h>
+#include <tvm/constraint/BasicLinearConstraint.h>
 #include <tvm/function/abstract/LinearFunction.h>
 #include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/solver/internal/SolverEvents.h>
 #include <tvm/supported_solvers.h>
 
 #include <array>
@@ -125,6 +127,242 @@ TEST_CASE("Simple add/Remove constraint")
   FAST_CHECK_UNARY(x->value().isApprox(Vector2d(1. / 2, 3. / 2)));
 }
 
+TEST_CASE("Enable/Disable task")
+{
+  Space R2(2);
+  VariablePtr x = R2.createVariable("x");
+  RowVector2d e(1, 1);
+
+  LinearizedControlProblem pb;
+  auto t1 = pb.add(x == -3., {PriorityLevel(1)});
+  auto t2 = pb.add(x == Vector2d(1, 3), {PriorityLevel(1), Weight(1)});
+  auto c1 = pb.add(e * x <= 2., {PriorityLevel(0)});
+  auto b1 = pb.add(x >= 0., {PriorityLevel(0)});
+
+  scheme::WeightedLeastSquares solver(solver::DefaultLSSolverOptions{});
+
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isZero(1e-8));
+
+  t1->disable();
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(0, 2)));
+
+  c1->disable();
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(1, 3)));
+
+  t1->enable();
+  b1->disable();
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(-1, 0)));
+
+  c1->enable();
+  b1->enable();
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isZero(1e-8));
+  FAST_CHECK_UNARY(t2->isEnabled());
+}
+
+TEST_CASE("Disable a task used by a substitution")
+{
+  Space R2(2);
+  VariablePtr x = R2.createVariable("x");
+  VariablePtr y = R2.createVariable("y");
+
+  LinearizedControlProblem pb;
+  auto t1 = pb.add(x - y == 0., {PriorityLevel(0)});
+  auto t2 = pb.add(y == Vector2d(1, 2), {PriorityLevel(1)});
+  hint::Substitution s(pb.constraint(*t1), x);
+  pb.add(s);
+
+  scheme::WeightedLeastSquares solver(solver::DefaultLSSolverOptions{});
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(1, 2)));
+
+  CHECK_THROWS_AS(t1->disable(), std::runtime_error);
+  FAST_CHECK_UNARY(t1->isEnabled());
+  t2->disable(); // Not used by the substitution
+
+  // Once the substitution is removed, the task can be disabled, but not used
+  // in a new substitution.
+  pb.remove(pb.substitutions().substitutions()[0]);
+  t1->disable();
+  CHECK_THROWS_AS(pb.add(hint::Substitution(pb.constraint(*t1), x)), std::runtime_error);
+  t1->enable();
+  pb.add(hint::Substitution(pb.constraint(*t1), x));
+  CHECK_THROWS_AS(t1->disable(), std::runtime_error);
+
+  // Removing the task removes the substitution
+  pb.remove(*t1);
+  t1->disable();
+}
+
+#if defined(TVM_USE_LSSOL) || defined(TVM_USE_QLD)
+template<typename Options>
+void reservedCapacityThroughScheme(const Options & options)
+{
+  using Memory = scheme::WeightedLeastSquares::ComputationDataType;
+
+  Space R2(2);
+  VariablePtr x = R2.createVariable("x");
+  RowVector2d e(1, 1);
+
+  LinearizedControlProblem pb;
+  auto t1 = pb.add(x == -1., {PriorityLevel(1)});
+  auto t2 = pb.add(x == Vector2d(1, 3), {PriorityLevel(1), Weight(1)});
+  auto c1 = pb.add(e * x <= 10., {PriorityLevel(0)});
+
+  scheme::WeightedLeastSquares solver(options);
+
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(0, 1)));
+  const auto & lsSolver = *static_cast<Memory *>(scheme::internal::getComputationData(pb, solver))->solver;
+  int reallocations = lsSolver.reallocations();
+
+  // Changes within the reserved capacity
+  pb.remove(*t1);
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(1, 3)));
+
+  auto c2 = pb.add(e * x <= 2., {PriorityLevel(0)});
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(0, 2)));
+
+  pb.add(t1);
+  auto t3 = pb.add(x == 0., {PriorityLevel(1)});
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(0, 2. / 3)));
+
+  pb.remove(*c2);
+  pb.remove(*t3);
+  solver.solve(pb);
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(0, 1)));
+  FAST_CHECK_EQ(lsSolver.reallocations(), reallocations);
+
+  // Going beyond the reserved capacity
+  pb.add(x == 0., {PriorityLevel(1)});
+  pb.add(x == 0., {PriorityLevel(1)});
+  solver.solve(pb);
+  FAST_CHECK_GT(lsSolver.reallocations(), reallocations);
+}
+
+template<typename Options>
+void reservedCapacityWithoutAllocation(const Options & options)
+{
+  using constraint::Type;
+  using Objective = solver::internal::SolverEvents::Objective;
+
+  VariablePtr x = Space(2).createVariable("x");
+  VariableVector vars(x);
+  RowVector2d e(1, 1);
+  auto req = std::make_shared<requirements::SolvingRequirementsWithCallbacks>(PriorityLevel(1));
+
+  auto o1 = std::make_shared<constraint::BasicLinearConstraint>(Matrix2d::Identity(), x, Vector2d(1, 3), Type::EQUAL);
+  auto o2 = std::make_shared<constraint::BasicLinearConstraint>(Matrix2d::Identity(), x, Vector2d(1, 1), Type::EQUAL);
+  auto c1 = std::make_shared<constraint::BasicLinearConstraint>(e, x, VectorXd::Constant(1, 10), Type::LOWER_THAN);
+  auto c2 = std::make_shared<constraint::BasicLinearConstraint>(e, x, VectorXd::Constant(1, 2), Type::LOWER_THAN);
+  auto c3 = std::make_shared<constraint::BasicLinearConstraint>(RowVector2d(1, 0), x, VectorXd::Constant(1, 0), Type::EQUAL);
+
+  auto solver = typename Options::Factory(options).createSolver();
+  solver->startBuild(vars, 2, 0, 1);
+  solver->addObjective(o1, req);
+  solver->addConstraint(c1);
+  solver->finalizeBuild();
+  REQUIRE(solver->solve());
+  FAST_CHECK_UNARY(solver->result().isApprox(Vector2d(1, 3)));
+
+  // All the changes below are within the reserved capacity
+  auto processAndSolve = [&](const solver::internal::SolverEvents & se) {
+    tvm::utils::set_is_malloc_allowed(false);
+    solver->process(se);
+    bool b = solver->solve();
+    tvm::utils::set_is_malloc_allowed(true);
+    return b;
+  };
+
+  {
+    // New rows after the existing ones
+    solver::internal::SolverEvents se;
+    se.addConstraint(c2);
+    se.addConstraint(c3);
+    REQUIRE(processAndSolve(se));
+    FAST_CHECK_UNARY(solver->result().isApprox(Vector2d(0, 2)));
+  }
+  {
+    // Removing the first rows shifts the others
+    solver::internal::SolverEvents se;
+    se.removeConstraint(c1);
+    se.removeConstraint(c3);
+    se.addObjective(Objective{o2, req, 1});
+    REQUIRE(processAndSolve(se));
+    FAST_CHECK_UNARY(solver->result().isApprox(Vector2d(0.5, 1.5)));
+  }
+  {
+    // The rows that are not used anymore do not constrain the problem
+    solver::internal::SolverEvents se;
+    se.removeConstraint(c2);
+    se.removeObjective(o1);
+    REQUIRE(processAndSolve(se));
+    FAST_CHECK_UNARY(solver->result().isApprox(Vector2d(1, 1)));
+  }
+}
+
+TEST_CASE("Add/Remove constraint with reserved capacity")
+{
+  IF_USE_LSSOL(reservedCapacityThroughScheme(solver::LSSOLLSSolverOptions().reserveObjectives(6).reserveConstraints(3)));
+  IF_USE_QLD(reservedCapacityThroughScheme(solver::QLDLSSolverOptions().reserveObjectives(6).reserveConstraints(3)));
+  IF_USE_QLD(reservedCapacityThroughScheme(
+      solver::QLDLSSolverOptions().cholesky(true).reserveObjectives(6).reserveConstraints(3)));
+
+  IF_USE_LSSOL(
+      reservedCapacityWithoutAllocation(solver::LSSOLLSSolverOptions().reserveObjectives(4).reserveConstraints(3)));
+  IF_USE_QLD(reservedCapacityWithoutAllocation(solver::QLDLSSolverOptions().reserveObjectives(4).reserveConstraints(3)));
+  IF_USE_QLD(reservedCapacityWithoutAllocation(
+      solver::QLDLSSolverOptions().cholesky(true).reserveObjectives(4).reserveConstraints(3)));
+}
+
+template<typename Options>
+void swapVariablesAndConstraintRows(const Options & options)
+{
+  VariablePtr x = Space(2).createVariable("x");
+  VariablePtr y = Space(1).createVariable("y");
+  RowVector2d e(1, 1);
+
+  LinearizedControlProblem pb;
+  pb.add(x == Vector2d(1, 3), {PriorityLevel(1)});
+  pb.add(e * x <= 10., {PriorityLevel(0)});
+  auto c2 = pb.add(RowVector2d(1, -1) * x <= 5., {PriorityLevel(0)});
+
+  scheme::WeightedLeastSquares solver(options);
+  REQUIRE(solver.solve(pb));
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(1, 3)));
+
+  // One more variable and one less constraint row: the total size of the
+  // bounds and constraints rhs is the same, but its layout changes.
+  pb.remove(*c2);
+  pb.add(y == 5., {PriorityLevel(1)});
+  pb.add(y <= 2., {PriorityLevel(0)});
+  REQUIRE(solver.solve(pb));
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(1, 3)));
+  FAST_CHECK_EQ(y->value()[0], doctest::Approx(2));
+
+  // And back
+  pb.add(c2);
+  pb.add(RowVector2d(1, 1) * x >= 5., {PriorityLevel(0)});
+  REQUIRE(solver.solve(pb));
+  FAST_CHECK_UNARY(x->value().isApprox(Vector2d(1.5, 3.5)));
+  FAST_CHECK_EQ(y->value()[0], doctest::Approx(2));
+}
+
+TEST_CASE("Change the number of variables and of constraint rows with the same total")
+{
+  IF_USE_LSSOL(swapVariablesAndConstraintRows(solver::LSSOLLSSolverOptions()));
+  IF_USE_QLD(swapVariablesAndConstraintRows(solver::QLDLSSolverOptions()));
+  IF_USE_QLD(swapVariablesAndConstraintRows(solver::QLDLSSolverOptions().cholesky(true)));
+}
+#endif
+
 TEST_CASE("Add/Remove variables from problem")
 {
   Space R2(2);
@@ -313,6 +551,58 @@ TEST_CASE("Add/Remove constraint with substitutions")
   }
 }
 
+TEST_CASE("Remove tasks and substitution at the same time")
+{
+  Space R(1);
+  VariablePtr x = R.createVariable("x");
+  VariablePtr y = R.createVariable("y");
+  VariablePtr w = R.createVariable("w");
+
+  LinearizedControlProblem pb;
+
+  auto t1 = pb.add(x + y == 0.);
+  auto t2 = pb.add(x + w == 1.);
+  auto t3 = pb.add(x - w == 0., {PriorityLevel(1)});
+  auto t4 = pb.add(y == 2., {PriorityLevel(1)});
+  auto t5 = pb.add(x + 2 * w == 1., {PriorityLevel(1), Weight(0.1)});
+  pb.add(hint::Substitution(pb.constraint(*t1), x));
+
+  scheme::WeightedLeastSquares solver(solver::DefaultLSSolverOptions{});
+  FAST_CHECK_UNARY(solver.solve(pb));
+
+  auto check = [&]() {
+    Vector3d s(x->value()[0], y->value()[0], w->value()[0]);
+    scheme::WeightedLeastSquares groundTruth(solver::DefaultLSSolverOptions{});
+    FAST_CHECK_UNARY(groundTruth.solve(pb));
+    FAST_CHECK_UNARY(s.isApprox(Vector3d(x->value()[0], y->value()[0], w->value()[0]), 1e-6));
+  };
+
+  // t2 and t3 depend on the substitution of x, and are removed in the same
+  // tick as the substitution and the constraint it uses.
+  pb.removeSubstitutionFor(*pb.constraint(*t1));
+  pb.remove(*t1);
+  pb.remove(*t2);
+  pb.remove(*t3);
+  FAST_CHECK_UNARY(solver.solve(pb));
+  FAST_CHECK_EQ(y->value()[0], doctest::Approx(2));
+  check();
+
+  // Same with the substitution added back, then removed with the tasks
+  // depending on it, and one of these tasks added back.
+  pb.add(t1);
+  pb.add(t2);
+  pb.add(hint::Substitution(pb.constraint(*t1), x));
+  FAST_CHECK_UNARY(solver.solve(pb));
+  check();
+  pb.removeSubstitutionFor(*pb.constraint(*t1));
+  pb.remove(*t2);
+  pb.remove(*t5);
+  pb.add(t5);
+  FAST_CHECK_UNARY(solver.solve(pb));
+  FAST_CHECK_EQ(x->value()[0], doctest::Approx(-2));
+  check();
+}
+
 // Skip if more than one type of constraints/objective is added more than once
 bool skip(const std::bitset<12> & a)
 {
@@ -2,6 +2,7 @@
 
 #include <tvm/Variable.h>
 #include <tvm/function/BasicLinearFunction.h>
+#include <tvm/function/abstract/Function.h>
 #include <tvm/utils/memoryChecks.h>
 
 #include <Eigen/Core>
@@ -66,3 +67,121 @@ TEST_CASE("Test subvariable JDot")
   CHECK_THROWS(f.JDot(*w));
   tvm::utils::set_is_malloc_allowed(true);
 }
+
+namespace
+{
+/** A function giving access to the management of its jacobian matrices.*/
+class JacobianStorageFunction : public function::abstract::Function
+{
+public:
+  JacobianStorageFunction(int m, bool flat) : Function(m)
+  {
+    if(flat)
+      useFlatJacobian();
+  }
+
+  using Function::addVariable;
+  using Function::jacobianSlot;
+  using Function::removeVariable;
+  using Function::splitJacobian;
+  using Function::useFlatJacobian;
+};
+} // namespace
+
+TEST_CASE("Test flat jacobian storage")
+{
+  VariablePtr x = Space(3).createVariable("x");
+  VariablePtr y = Space(4).createVariable("y");
+  VariablePtr z = Space(2).createVariable("z");
+  VariablePtr w = Space(2).createVariable("w");
+  VariablePtr y1 = y->subvariable(2, "y1", 1);
+
+  JacobianStorageFunction f(2, true);
+  f.addVariable(x, true);
+  f.addVariable(y, true);
+  FAST_CHECK_UNARY(f.hasFlatJacobian());
+  FAST_CHECK_EQ(f.flatJacobian().rows(), 2);
+  FAST_CHECK_EQ(f.flatJacobian().cols(), 7);
+
+  MatrixXd J = MatrixXd::Random(2, 7);
+  f.splitJacobian(J, f.variables());
+  FAST_CHECK_UNARY(f.flatJacobian() == J);
+
+  tvm::utils::set_is_malloc_allowed(false);
+  FAST_CHECK_UNARY(f.jacobian(*x) == J.leftCols(3));
+  FAST_CHECK_UNARY(f.jacobian(*y) == J.rightCols(4));
+  FAST_CHECK_UNARY(f.jacobian(*y1) == J.middleCols(4, 2));
+  FAST_CHECK_UNARY(f.jacobianAt(0) == J.leftCols(3));
+  FAST_CHECK_UNARY(f.jacobianAt(1) == J.rightCols(4));
+  tvm::utils::set_is_malloc_allowed(true);
+  CHECK_THROWS(f.jacobian(*w));
+
+  // Precomputed locations, including for a subvariable
+  auto loc = f.jacobianLocation(*y1);
+  FAST_CHECK_EQ(loc.first, 1);
+  FAST_CHECK_UNARY(loc.second == Range(1, 2));
+  FAST_CHECK_UNARY(f.jacobianAt(loc) == J.middleCols(4, 2));
+  FAST_CHECK_UNARY(f.jacobianAt(f.jacobianLocation(*x)) == J.leftCols(3));
+  CHECK_THROWS(f.jacobianLocation(*w));
+
+  // Split with a layout different from the one of the variables
+  MatrixXd Jy = MatrixXd::Random(2, 4);
+  MatrixXd Jx = MatrixXd::Random(2, 3);
+  MatrixXd Jyx(2, 7);
+  Jyx << Jy, Jx;
+  f.jacobianSlot(1).properties({tvm::internal::MatrixProperties::Constness(true)});
+  f.splitJacobian(Jyx, std::vector<VariablePtr>{y, x}, true);
+  FAST_CHECK_UNARY(f.jacobian(*x) == Jx);
+  FAST_CHECK_UNARY(f.jacobian(*y) == Jy);
+  FAST_CHECK_UNARY(f.jacobian(*y).properties().isConstant());
+  FAST_CHECK_UNARY(!f.jacobian(*x).properties().isConstant());
+
+  // Split with a subvariable: only its columns are written
+  MatrixXd Jy1x(2, 5);
+  Jy1x << MatrixXd::Random(2, 2), Jx;
+  MatrixXd Jyy1 = Jy;
+  Jyy1.middleCols(1, 2) = Jy1x.leftCols(2);
+  f.splitJacobian(Jy1x, std::vector<VariablePtr>{y1, x}, true);
+  FAST_CHECK_UNARY(f.jacobian(*y1) == Jy1x.leftCols(2));
+  FAST_CHECK_UNARY(f.jacobian(*y) == Jyy1);
+  FAST_CHECK_UNARY(f.jacobian(*x) == Jx);
+  Jy = Jyy1;
+  CHECK_THROWS(f.splitJacobian(Jx.leftCols(2), std::vector<VariablePtr>{w}));
+
+  // Adding and removing variables keeps the other jacobian matrices
+  f.addVariable(z, false);
+  FAST_CHECK_EQ(f.flatJacobian().cols(), 9);
+  FAST_CHECK_UNARY(f.jacobian(*x) == Jx);
+  FAST_CHECK_UNARY(f.jacobian(*y) == Jy);
+  MatrixXd Jz = MatrixXd::Random(2, 2);
+  f.jacobianSlot(2) = Jz;
+  f.removeVariable(x);
+  FAST_CHECK_EQ(f.flatJacobian().cols(), 6);
+  FAST_CHECK_UNARY(f.jacobianAt(0) == Jy);
+  FAST_CHECK_UNARY(f.jacobianAt(1) == Jz);
+  FAST_CHECK_UNARY(f.jacobian(*z) == Jz);
+  FAST_CHECK_UNARY(f.jacobian(*y).properties().isConstant());
+  CHECK_THROWS(f.jacobian(*x));
+}
+
+TEST_CASE("Test switching to flat jacobian storage")
+{
+  VariablePtr x = Space(3).createVariable("x");
+  VariablePtr y = Space(4).createVariable("y");
+
+  JacobianStorageFunction f(2, false);
+  f.addVariable(x, true);
+  f.addVariable(y, true);
+  FAST_CHECK_UNARY(!f.hasFlatJacobian());
+  MatrixXd J = MatrixXd::Random(2, 7);
+  f.splitJacobian(J, f.variables());
+  f.jacobianSlot(0).properties({tvm::internal::MatrixProperties::Constness(true)});
+  FAST_CHECK_UNARY(f.jacobianAt(1) == J.rightCols(4));
+  FAST_CHECK_UNARY(f.jacobianAt(f.jacobianLocation(*y->subvariable(2, "y1", 1))) == J.middleCols(4, 2));
+
+  f.useFlatJacobian();
+  FAST_CHECK_UNARY(f.hasFlatJacobian());
+  FAST_CHECK_UNARY(f.flatJacobian() == J);
+  FAST_CHECK_UNARY(f.jacobian(*x).properties().isConstant());
+  FAST_CHECK_UNARY(!f.jacobian(*y).properties().isConstant());
+}
@@ -9,6 +9,8 @@
 #include <tvm/function/IdentityFunction.h>
 #include <tvm/scheme/HierarchicalLeastSquares.h>
 #include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/scheme/internal/AssignmentTarget.h>
+#include <tvm/solver/EigenHierarchicalLeastSquareSolver.h>
 #include <tvm/task_dynamics/None.h>
 
 #include <Eigen/SVD>
@@ -32,6 +34,383 @@ MatrixXd pinv(const MatrixConstRef & M, double eps = 1e-10)
          * svd.matrixU().leftCols(r).transpose();
 }
 
+/** A solver only storing the data of each level, to test the tracking of the
+ * changes of the levels.
+ */
+class LevelDataSolver : public solver::abstract::HierarchicalLeastSquareSolver
+{
+public:
+  LevelDataSolver() : HierarchicalLeastSquareSolver(false, true), x_(0) {}
+
+protected:
+  void initializeBuild_(const std::vector<int> & nEq, const std::vector<int> & nIneq, bool useBounds) override
+  {
+    resize_(nEq, nIneq, useBounds);
+  }
+  ImpactFromChanges resize_(const std::vector<int> & nEq, const std::vector<int> & nIneq, bool) override
+  {
+    int n = variables().totalSize();
+    data_.resize(nEq.size());
+    for(size_t i = 0; i < nEq.size(); ++i)
+      data_[i] = MatrixXd::Zero(nEq[i] + nIneq[i], n + 2);
+    bounds_ = MatrixXd::Zero(n, 2);
+    x_ = VectorXd::Zero(n);
+    return {static_cast<int>(nEq.size())};
+  }
+  void addBound_(LinearConstraintPtr bound, RangePtr range, bool first) override
+  {
+    scheme::internal::AssignmentTarget target(range, bounds_.col(0), bounds_.col(1));
+    addAssignement(bound, target, bound->variables()[0], first);
+  }
+  void addEqualityConstraint_(LinearConstraintPtr cstr, SolvingRequirementsPtr req) override
+  {
+    int lvl = req->priorityLevel().value();
+    int n = variables().totalSize();
+    RangePtr r = std::make_shared<Range>(nextEqualityConstraintRange_(lvl, *cstr));
+    auto & d = data_[static_cast<size_t>(lvl)];
+    scheme::internal::AssignmentTarget target(r, d.leftCols(n), d.col(n), d.col(n + 1), constraint::RHS::AS_GIVEN);
+    addAssignement(cstr, req, target, variables(), substitutions());
+  }
+  void addIneqalityConstraint_(LinearConstraintPtr cstr, SolvingRequirementsPtr req) override
+  {
+    addEqualityConstraint_(cstr, req);
+  }
+  void setMinimumNorm_() override {}
+  void resetBounds_() override {}
+  bool solve_() override { return true; }
+  const VectorXd & result_() const override { return x_; }
+  bool handleDoubleSidedConstraint_() const override { return true; }
+  Range nextEqualityConstraintRange_(int lvl, const constraint::abstract::LinearConstraint & cstr) const override
+  {
+    return {eqSize_[static_cast<size_t>(lvl)] + ineqSize_[static_cast<size_t>(lvl)], cstr.size()};
+  }
+  Range nextInequalityConstraintRange_(int lvl, const constraint::abstract::LinearConstraint & cstr) const override
+  {
+    return nextEqualityConstraintRange_(lvl, cstr);
+  }
+  void removeBounds_(const Range &) override {}
+  void updateEqualityTargetData(int, scheme::internal::AssignmentTarget &) override {}
+  void updateInequalityTargetData(int, scheme::internal::AssignmentTarget &) override {}
+  void updateBoundTargetData(scheme::internal::AssignmentTarget &) override {}
+  void printProblemData_() const override {}
+  void printDiagnostic_() const override {}
+  MatrixConstRef levelData_(int lvl) const override { return data_[static_cast<size_t>(lvl)]; }
+
+private:
+  std::vector<MatrixXd> data_;
+  MatrixXd bounds_;
+  VectorXd x_;
+};
+
+TEST_CASE("Level changes")
+{
+  VariablePtr x = Space(4).createVariable("x");
+  VariableVector vars(x);
+  std::vector<std::shared_ptr<BasicLinearConstraint>> c;
+  LevelDataSolver solver;
+  solver.startBuild(vars, {2, 2, 2}, {0, 0, 0}, false);
+  for(int i = 0; i < 3; ++i)
+  {
+    c.push_back(std::make_shared<BasicLinearConstraint>(MatrixXd::Random(2, 4), x, VectorXd::Random(2), Type::EQUAL));
+    solver.addConstraint(c.back(),
+                         std::make_shared<requirements::SolvingRequirementsWithCallbacks>(PriorityLevel(i)));
+  }
+  solver.finalizeBuild();
+
+  REQUIRE(solver.trackLevelChanges());
+  solver.solve();
+  FAST_CHECK_EQ(solver.firstChangedLevel(), 0);
+  FAST_CHECK_UNARY(solver.changedLevels() == std::vector<bool>{true, true, true});
+
+  solver.solve();
+  FAST_CHECK_EQ(solver.firstChangedLevel(), 3);
+  FAST_CHECK_UNARY(solver.changedLevels() == std::vector<bool>{false, false, false});
+
+  c[1]->b(VectorXd::Random(2));
+  solver.solve();
+  FAST_CHECK_EQ(solver.firstChangedLevel(), 1);
+  FAST_CHECK_UNARY(solver.changedLevels() == std::vector<bool>{false, true, false});
+
+  c[2]->A(MatrixXd::Random(2, 4));
+  solver.solve();
+  FAST_CHECK_EQ(solver.firstChangedLevel(), 2);
+
+  c[0]->b(VectorXd::Random(2));
+  c[2]->b(VectorXd::Random(2));
+  solver.solve();
+  FAST_CHECK_EQ(solver.firstChangedLevel(), 0);
+  FAST_CHECK_UNARY(solver.changedLevels() == std::vector<bool>{true, false, true});
+
+  // Same values as before: no change
+  c[2]->b(VectorXd(c[2]->e()));
+  solver.solve();
+  FAST_CHECK_EQ(solver.firstChangedLevel(), 3);
+}
+
+TEST_CASE("EigenHierarchicalLeastSquareSolver")
+{
+  VariablePtr x = Space(6).createVariable("x");
+  MatrixXd A0(3, 6), A1(3, 6), A2(3, 6);
+  VectorXd b0(3), b1(3), b2(3);
+  // rank(A0)=2
+  A0 = MatrixXd::Random(3, 2) * MatrixXd::Random(2, 6);
+  // rank(A1) = 3 but rank(A1 projected on the nullspace of A0) = 2
+  A1 << MatrixXd::Random(1, 3) * A0, MatrixXd::Random(2, 6);
+  A1 = MatrixXd::Random(3, 3) * A1;
+  A2.setRandom();
+  b0.setRandom();
+  b1.setRandom();
+  b2.setRandom();
+  auto c0 = std::make_shared<BasicLinearConstraint>(A0, x, b0, constraint::Type::EQUAL);
+  auto c1 = std::make_shared<BasicLinearConstraint>(A1, x, b1, constraint::Type::EQUAL);
+  auto c2 = std::make_shared<BasicLinearConstraint>(A2, x, b2, constraint::Type::EQUAL);
+
+  auto r0 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(0));
+  auto r1 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(1));
+  auto r2 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(2));
+
+  EigenHierarchicalLeastSquareSolver solver(EigenHLSSolverOptions().reuseUnchangedLevels(true));
+  VariableVector vars(x);
+  solver.startBuild(vars, {3, 3, 3}, {0, 0, 0}, false);
+  solver.addConstraint(c0, r0);
+  solver.addConstraint(c1, r1);
+  solver.addConstraint(c2, r2);
+  solver.finalizeBuild();
+
+  // Compute the solution by hand
+  auto solution = [&]() {
+    MatrixXd P0 = MatrixXd::Identity(6, 6) - pinv(A0) * A0;
+    MatrixXd A01(6, 6);
+    A01 << A0, A1;
+    MatrixXd P1 = MatrixXd::Identity(6, 6) - pinv(A01) * A01;
+    VectorXd dx0 = pinv(A0) * b0;
+    VectorXd dx1 = pinv(A1 * P0) * (b1 - A1 * dx0);
+    VectorXd dx2 = pinv(A2 * P1) * (b2 - A2 * (dx0 + dx1));
+    return VectorXd(dx0 + dx1 + dx2);
+  };
+
+  FAST_CHECK_UNARY(solver.solve());
+  FAST_CHECK_EQ(solver.result(), Approx(solution()).epsilon(1e-8));
+
+  // Only the last level changed: the first two are reused.
+  b2.setRandom();
+  c2->b(b2);
+  FAST_CHECK_UNARY(solver.solve());
+  FAST_CHECK_EQ(solver.firstChangedLevel(), 2);
+  FAST_CHECK_EQ(solver.iterations()[0], 0);
+  FAST_CHECK_EQ(solver.iterations()[1], 0);
+  FAST_CHECK_EQ(solver.result(), Approx(solution()).epsilon(1e-8));
+
+  b0.setRandom();
+  c0->b(b0);
+  FAST_CHECK_UNARY(solver.solve());
+  FAST_CHECK_EQ(solver.firstChangedLevel(), 0);
+  FAST_CHECK_EQ(solver.result(), Approx(solution()).epsilon(1e-8));
+}
+
+TEST_CASE("EigenHierarchicalLeastSquareSolver min norm")
+{
+  VariablePtr x = Space(6).createVariable("x");
+  MatrixXd A0(3, 6), A1(3, 6);
+  VectorXd b0(3), b1(3);
+  A0 = MatrixXd::Random(3, 2) * MatrixXd::Random(2, 6);
+  A1 << MatrixXd::Random(1, 3) * A0, MatrixXd::Random(2, 6);
+  A1 = MatrixXd::Random(3, 3) * A1;
+  b0.setRandom();
+  b1.setRandom();
+  auto c0 = std::make_shared<BasicLinearConstraint>(A0, x, b0, constraint::Type::EQUAL);
+  auto c1 = std::make_shared<BasicLinearConstraint>(A1, x, b1, constraint::Type::EQUAL);
+
+  auto r0 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(0));
+  auto r1 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(1));
+
+  EigenHierarchicalLeastSquareSolver solver;
+  VariableVector vars(x);
+  solver.startBuild(vars, {3, 3, 6}, {0, 0, 0}, false);
+  solver.addConstraint(c0, r0);
+  solver.addConstraint(c1, r1);
+  solver.setMinimumNorm(); // Equivalent to A2 = I and b2 = 0
+  solver.finalizeBuild();
+
+  FAST_CHECK_UNARY(solver.solve());
+
+  // Compute the solution by hand
+  MatrixXd P0 = MatrixXd::Identity(6, 6) - pinv(A0) * A0;
+  MatrixXd A01(6, 6);
+  A01 << A0, A1;
+  MatrixXd P1 = MatrixXd::Identity(6, 6) - pinv(A01) * A01;
+  VectorXd dx0 = pinv(A0) * b0;
+  VectorXd dx1 = pinv(A1 * P0) * (b1 - A1 * dx0);
+  VectorXd dx2 = pinv(P1) * (-(dx0 + dx1));
+  VectorXd x0 = dx0 + dx1 + dx2;
+
+  FAST_CHECK_EQ(solver.result(), Approx(x0).epsilon(1e-8));
+}
+
+TEST_CASE("EigenHierarchicalLeastSquareSolver with inequalities")
+{
+  VariablePtr x = Space(2).createVariable("x");
+  VariableVector vars(x);
+  RowVector2d e1(1, 0);
+  double big = constant::big_number;
+
+  // Level 0: x1 <= 1, x1 + x2 >= 3 (bound and general constraint)
+  auto b = std::make_shared<BasicLinearConstraint>(MatrixXd::Identity(2, 2), x, Vector2d(-big, -big),
+                                                   Vector2d(1, big));
+  b->A(MatrixXd::Identity(2, 2), tvm::internal::MatrixProperties::IDENTITY);
+  auto c0 =
+      std::make_shared<BasicLinearConstraint>(RowVector2d(1, 1), x, VectorXd::Constant(1, 3), Type::GREATER_THAN);
+  // Level 1: x1 >= 2 and x1 <= 0 (infeasible)
+  auto c1a = std::make_shared<BasicLinearConstraint>(e1, x, VectorXd::Constant(1, 2), Type::GREATER_THAN);
+  auto c1b = std::make_shared<BasicLinearConstraint>(e1, x, VectorXd::Constant(1, 0), Type::LOWER_THAN);
+  // Level 2: x = (2, 0)
+  auto c2 = std::make_shared<BasicLinearConstraint>(MatrixXd::Identity(2, 2), x, Vector2d(2, 0), Type::EQUAL);
+
+  auto r0 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(0));
+  auto r1 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(1));
+  auto r2 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(2));
+
+  EigenHierarchicalLeastSquareSolver solver;
+  solver.startBuild(vars, {0, 0, 2}, {1, 2, 0}, true);
+  solver.addBound(b);
+  solver.addConstraint(c0, r0);
+  solver.addConstraint(c1a, r1);
+  solver.addConstraint(c1b, r1);
+  solver.addConstraint(c2, r2);
+  solver.finalizeBuild();
+
+  // Level 1 gives x1 = 1 (closest to 2 and 0 with x1 <= 1), level 2 then
+  // minimizes (x2)^2 with x2 >= 2.
+  FAST_CHECK_UNARY(solver.solve());
+  FAST_CHECK_EQ(solver.result(), Approx(Vector2d(1, 2)).epsilon(1e-8));
+
+  // Warm start: the active sets are the same.
+  FAST_CHECK_UNARY(solver.solve());
+  FAST_CHECK_EQ(solver.result(), Approx(Vector2d(1, 2)).epsilon(1e-8));
+  for(auto it : solver.iterations())
+    FAST_CHECK_LE(it, 1);
+}
+
+TEST_CASE("EigenHierarchicalLeastSquareSolver in single precision")
+{
+  VariablePtr x = Space(2).createVariable("x");
+  VariableVector vars(x);
+  RowVector2d e1(1, 0);
+  double big = constant::big_number;
+
+  // Same problem as above
+  auto b = std::make_shared<BasicLinearConstraint>(MatrixXd::Identity(2, 2), x, Vector2d(-big, -big),
+                                                   Vector2d(1, big));
+  b->A(MatrixXd::Identity(2, 2), tvm::internal::MatrixProperties::IDENTITY);
+  auto c0 =
+      std::make_shared<BasicLinearConstraint>(RowVector2d(1, 1), x, VectorXd::Constant(1, 3), Type::GREATER_THAN);
+  auto c1a = std::make_shared<BasicLinearConstraint>(e1, x, VectorXd::Constant(1, 2), Type::GREATER_THAN);
+  auto c1b = std::make_shared<BasicLinearConstraint>(e1, x, VectorXd::Constant(1, 0), Type::LOWER_THAN);
+  auto c2 = std::make_shared<BasicLinearConstraint>(MatrixXd::Identity(2, 2), x, Vector2d(2, 0), Type::EQUAL);
+
+  auto r0 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(0));
+  auto r1 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(1));
+  auto r2 = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(2));
+
+  for(bool refine : {false, true})
+  {
+    EigenHierarchicalLeastSquareSolver solver(EigenHLSSolverOptions().singlePrecision(true).refineSolution(refine));
+    solver.startBuild(vars, {0, 0, 2}, {1, 2, 0}, true);
+    solver.addBound(b);
+    solver.addConstraint(c0, r0);
+    solver.addConstraint(c1a, r1);
+    solver.addConstraint(c1b, r1);
+    solver.addConstraint(c2, r2);
+    solver.finalizeBuild();
+
+    FAST_CHECK_UNARY(solver.solve());
+    FAST_CHECK_EQ(solver.result(), Approx(Vector2d(1, 2)).epsilon(refine ? 1e-8 : 1e-5));
+    // The refinement starts from the active sets found in single precision.
+    for(auto it : solver.refinementIterations())
+      FAST_CHECK_LE(it, refine ? 1 : 0);
+  }
+
+  // Random equality problem: the refined solution matches the one computed in
+  // double precision.
+  VariablePtr y = Space(20).createVariable("y");
+  VariableVector yv(y);
+  MatrixXd A0 = MatrixXd::Random(5, 20);
+  MatrixXd A1 = MatrixXd::Random(10, 20);
+  auto d0 = std::make_shared<BasicLinearConstraint>(A0, y, VectorXd::Random(5), constraint::Type::EQUAL);
+  auto d1 = std::make_shared<BasicLinearConstraint>(A1, y, VectorXd::Random(10), constraint::Type::EQUAL);
+  VectorXd ref;
+  for(bool single : {false, true})
+  {
+    EigenHierarchicalLeastSquareSolver solver(EigenHLSSolverOptions().singlePrecision(single).refineSolution(true));
+    solver.startBuild(yv, {5, 10, 20}, {0, 0, 0}, false);
+    solver.addConstraint(d0, r0);
+    solver.addConstraint(d1, r1);
+    solver.setMinimumNorm();
+    solver.finalizeBuild();
+    FAST_CHECK_UNARY(solver.solve());
+    if(single)
+      FAST_CHECK_EQ(solver.result(), Approx(ref).epsilon(1e-8));
+    else
+      ref = solver.result();
+  }
+}
+
+TEST_CASE("HierarchicalLeastSquares with EigenHierarchicalLeastSquareSolver")
+{
+  SUBCASE("Equality only")
+  {
+    VariablePtr x = Space(6).createVariable("x");
+    MatrixXd A0(3, 6), A1(3, 6), A2(3, 6);
+    VectorXd b0(3), b1(3), b2(3);
+    A0 = MatrixXd::Random(3, 2) * MatrixXd::Random(2, 6);
+    A1 << MatrixXd::Random(1, 3) * A0, MatrixXd::Random(2, 6);
+    A1 = MatrixXd::Random(3, 3) * A1;
+    A2.setRandom();
+    b0.setRandom();
+    b1.setRandom();
+    b2.setRandom();
+
+    LinearizedControlProblem pb;
+    pb.add(A0 * x - b0 == 0., {PriorityLevel(0)});
+    pb.add(A1 * x - b1 == 0., {PriorityLevel(1)});
+    pb.add(A2 * x - b2 == 0., {PriorityLevel(2)});
+
+    scheme::HierarchicalLeastSquares solver(EigenHLSSolverOptions{});
+
+    FAST_CHECK_UNARY(solver.solve(pb));
+
+    // Compute the solution by hand
+    MatrixXd P0 = MatrixXd::Identity(6, 6) - pinv(A0) * A0;
+    MatrixXd A01(6, 6);
+    A01 << A0, A1;
+    MatrixXd P1 = MatrixXd::Identity(6, 6) - pinv(A01) * A01;
+    VectorXd dx0 = pinv(A0) * b0;
+    VectorXd dx1 = pinv(A1 * P0) * (b1 - A1 * dx0);
+    VectorXd dx2 = pinv(A2 * P1) * (b2 - A2 * (dx0 + dx1));
+    VectorXd x0 = dx0 + dx1 + dx2;
+
+    FAST_CHECK_EQ(x->value(), Approx(x0).epsilon(1e-8));
+  }
+
+  SUBCASE("Inequality only")
+  {
+    VariablePtr x = Space(1).createVariable("x");
+    VariablePtr y = Space(1).createVariable("y");
+
+    LinearizedControlProblem pb;
+    pb.add(-1. <= x <= 1., {PriorityLevel(0)});
+    pb.add(2. <= x <= 3., {PriorityLevel(1)});
+    pb.add(-1. <= y <= 1., {PriorityLevel(2)});
+    pb.add(x + y <= 0., {PriorityLevel(4)});
+
+    scheme::HierarchicalLeastSquares solver(EigenHLSSolverOptions{});
+
+    FAST_CHECK_UNARY(solver.solve(pb));
+    FAST_CHECK_EQ(x->value()[0], doctest::Approx(1).epsilon(1e-10));
+    FAST_CHECK_EQ(y->value()[0], doctest::Approx(-1).epsilon(1e-10));
+  }
+}
+
 #if TVM_WITH_LEXLS
 TEST_CASE("LexLSHierarchicalLeastSquareSolver")
 {
@@ -0,0 +1,133 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/LinearizedControlProblem.h>
+#include <tvm/Space.h>
+#include <tvm/Variable.h>
+#include <tvm/function/BasicLinearFunction.h>
+#include <tvm/scheme/HierarchicalLeastSquares.h>
+#include <tvm/solver/EigenHierarchicalLeastSquareSolver.h>
+#include <tvm/supported_solvers.h>
+#include <tvm/task_dynamics/None.h>
+
+#ifdef TVM_USE_LEXLS
+#  include <tvm/solver/LexLSHierarchicalLeastSquareSolver.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Core>
+
+#include <memory>
+
+using namespace tvm;
+using namespace tvm::requirements;
+using namespace Eigen;
+
+/** A problem with 4 priority levels over n variables:
+ *  - level 0: bounds and n/4 inequality constraints,
+ *  - level 1: n/4 equality constraints,
+ *  - level 2: n/4 equality constraints whose right-hand side changes at each
+ *    iteration,
+ *  - level 3: n inequality constraints (most of which are infeasible).
+ *
+ * Only the data of level 2 change between two resolutions, which lets the
+ * solvers that can do so reuse the computations of levels 0 and 1.
+ *
+ * The benchmarks of the single precision modes also report as counter the
+ * distance between their last solution and the one in double precision.
+ */
+class HierarchicalSolver : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State & st) override
+  {
+    int n = static_cast<int>(st.range(0));
+    int m = n / 4;
+    x_ = Space(n).createVariable("x");
+    pb_ = std::make_unique<LinearizedControlProblem>();
+
+    VectorXd L = VectorXd::Constant(n, 10);
+    MatrixXd C0 = MatrixXd::Random(m, n);
+    MatrixXd A1 = MatrixXd::Random(m, n);
+    MatrixXd A2 = MatrixXd::Random(m, n);
+    MatrixXd C3 = MatrixXd::Random(n, n);
+    pb_->add(-L <= x_ <= L, task_dynamics::None(), {PriorityLevel(0)});
+    pb_->add(C0 * x_ <= 1., task_dynamics::None(), {PriorityLevel(0)});
+    pb_->add(A1 * x_ == VectorXd::Random(m), task_dynamics::None(), {PriorityLevel(1)});
+    f2_ = std::make_shared<function::BasicLinearFunction>(A2, x_);
+    pb_->add(f2_ == 0., task_dynamics::None(), {PriorityLevel(2)});
+    pb_->add(C3 * x_ >= 5., task_dynamics::None(), {PriorityLevel(3)});
+    pb_->update();
+  }
+
+  void TearDown(const ::benchmark::State &) override
+  {
+    f2_.reset();
+    pb_.reset();
+    x_.reset();
+  }
+
+  template<typename Options>
+  void run(benchmark::State & st, const Options & options, bool reportError = false)
+  {
+    scheme::HierarchicalLeastSquares solver(options);
+    for(auto _ : st)
+    {
+      st.PauseTiming();
+      f2_->b(VectorXd::Random(f2_->size()));
+      st.ResumeTiming();
+      solver.solve(*pb_);
+    }
+    if(reportError)
+    {
+      VectorXd x = x_->value();
+      scheme::HierarchicalLeastSquares reference(solver::EigenHLSSolverOptions{});
+      reference.solve(*pb_);
+      st.counters["error"] = (x - x_->value()).lpNorm<Infinity>();
+    }
+  }
+
+  VariablePtr x_;
+  std::unique_ptr<LinearizedControlProblem> pb_;
+  std::shared_ptr<function::BasicLinearFunction> f2_;
+};
+
+BENCHMARK_DEFINE_F(HierarchicalSolver, Eigen)(benchmark::State & st)
+{
+  run(st, solver::EigenHLSSolverOptions{});
+}
+
+BENCHMARK_DEFINE_F(HierarchicalSolver, EigenReuse)(benchmark::State & st)
+{
+  run(st, solver::EigenHLSSolverOptions{}.reuseUnchangedLevels(true));
+}
+
+BENCHMARK_DEFINE_F(HierarchicalSolver, EigenSingle)(benchmark::State & st)
+{
+  run(st, solver::EigenHLSSolverOptions{}.singlePrecision(true), true);
+}
+
+BENCHMARK_DEFINE_F(HierarchicalSolver, EigenSingleRefined)(benchmark::State & st)
+{
+  run(st, solver::EigenHLSSolverOptions{}.singlePrecision(true).refineSolution(true), true);
+}
+
+BENCHMARK_REGISTER_F(HierarchicalSolver, Eigen)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(HierarchicalSolver, EigenReuse)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(HierarchicalSolver, EigenSingle)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(HierarchicalSolver, EigenSingleRefined)
+    ->Arg(8)
+    ->Arg(16)
+    ->Arg(32)
+    ->Unit(benchmark::kMicrosecond);
+
+#ifdef TVM_USE_LEXLS
+BENCHMARK_DEFINE_F(HierarchicalSolver, LexLS)(benchmark::State & st)
+{
+  run(st, solver::LexLSHLSSolverOptions{});
+}
+
+BENCHMARK_REGISTER_F(HierarchicalSolver, LexLS)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMicrosecond);
+#endif
+
+BENCHMARK_MAIN();
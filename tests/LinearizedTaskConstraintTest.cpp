@@ -6,8 +6,15 @@
 
 #include "SolverTestFunctions.h"
 
+#include <tvm/LinearizedControlProblem.h>
 #include <tvm/Variable.h>
 #include <tvm/constraint/internal/LinearizedTaskConstraint.h>
+#include <tvm/function/BasicLinearFunction.h>
+#include <tvm/function/IdentityFunction.h>
+#include <tvm/hint/Substitution.h>
+#include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/solver/defaultLeastSquareSolver.h>
+#include <tvm/task_dynamics/None.h>
 #include <tvm/task_dynamics/Proportional.h>
 #include <tvm/task_dynamics/ProportionalDerivative.h>
 #include <tvm/utils/ProtoTask.h>
@@ -76,4 +83,128 @@ TEST_CASE("Value test")
   graph2->execute();
   CHECK_EQ(l2->u()[0], -2 * 9 - (-26) - 28); /*-kp*f - kv*df/dt - d2f/dxdt dx/dt*/
   CHECK_UNARY(l2->jacobian(*ddx).isApprox(Vector3d(0, 4, 6).transpose()));
+
+  // Index-based accesses are forwarded to the function
+  auto loc = l2->jacobianLocation(*ddx);
+  FAST_CHECK_EQ(loc.first, 0);
+  FAST_CHECK_UNARY(loc.second == Range(0, 3));
+  FAST_CHECK_EQ(l2->jacobianAt(0).data(), f->jacobian(*x).data());
+  FAST_CHECK_EQ(l2->jacobianAt(loc).data(), f->jacobian(*x).data());
+}
+
+TEST_CASE("Merged double-sided tasks")
+{
+  VariablePtr x = Space(3).createVariable("x");
+  auto dx = dot(x);
+  x << 1, 2, 3;
+  dx << -1, -2, -3;
+
+  auto f = std::make_shared<SphereFunction>(x, Vector3d(1, 0, 0), 2);
+  task_dynamics::PD td(2, 1);
+
+  LinearizedControlProblem pb;
+  pb.mergeDoubleSidedTasks(true);
+  auto t1 = pb.add(-1. <= f, td);
+  auto t2 = pb.add(f <= 1., td);
+  auto t3 = pb.add(f <= 2., td, {requirements::PriorityLevel(1)});
+  FAST_CHECK_EQ(pb.constraints().size(), 2);
+  FAST_CHECK_EQ(pb.taskRows(), 3);
+  FAST_CHECK_EQ(pb.constraintRows(), 2);
+
+  auto c = pb.constraint(*t1);
+  FAST_CHECK_EQ(c, pb.constraint(*t2));
+  FAST_CHECK_EQ(c->type(), constraint::Type::DOUBLE_SIDED);
+  FAST_CHECK_EQ(pb.constraint(*t3)->type(), constraint::Type::LOWER_THAN);
+
+  auto l = std::make_shared<LTC>(-1. <= f, td);
+  auto u = std::make_shared<LTC>(f <= 1., td);
+  auto graphL = utils::generateUpdateGraph(l, LTC::Output::L);
+  auto graphU = utils::generateUpdateGraph(u, LTC::Output::U);
+  graphL->execute();
+  graphU->execute();
+  pb.update();
+  FAST_CHECK_EQ(c->l()[0], l->l()[0]);
+  FAST_CHECK_EQ(c->u()[0], u->u()[0]);
+
+  // Disabling one of the tasks relaxes the corresponding bound
+  t2->disable();
+  pb.update();
+  FAST_CHECK_EQ(c->l()[0], l->l()[0]);
+  FAST_CHECK_EQ(c->u()[0], std::numeric_limits<double>::infinity());
+  t2->enable();
+
+  // Removing one of the tasks undoes the merge
+  pb.remove(*t1);
+  FAST_CHECK_EQ(pb.constraint(*t2)->type(), constraint::Type::LOWER_THAN);
+  FAST_CHECK_EQ(pb.constraints().size(), 2);
+  pb.add(t1);
+  FAST_CHECK_EQ(pb.constraint(*t1)->type(), constraint::Type::DOUBLE_SIDED);
+  pb.remove(*t2);
+  FAST_CHECK_EQ(pb.constraint(*t1)->type(), constraint::Type::GREATER_THAN);
+  FAST_CHECK_EQ(pb.taskRows(), 2);
+  FAST_CHECK_EQ(pb.constraintRows(), 2);
+}
+
+namespace
+{
+/** Tasks forming double-sided constraints, both general and bounds, with
+ * their variable substituted.
+ */
+struct DoubleSidedProblem
+{
+  DoubleSidedProblem(bool merge)
+  {
+    VariablePtr x = Space(3).createVariable("x");
+    y = Space(3).createVariable("y");
+    Matrix3d A;
+    A << 1, 2, 0, 0, 1, -1, 1, 0, 1;
+    auto f = std::make_shared<function::BasicLinearFunction>(A, x);
+    auto idx = std::make_shared<function::IdentityFunction>(x);
+    task_dynamics::None td;
+
+    pb.mergeDoubleSidedTasks(merge);
+    lower = pb.add(f >= -1., td, {requirements::PriorityLevel(0)});
+    upper = pb.add(f <= 1., td, {requirements::PriorityLevel(0)});
+    pb.add(idx >= -0.8, td, {requirements::PriorityLevel(0)});
+    pb.add(idx <= 0.5, td, {requirements::PriorityLevel(0)});
+    auto link = pb.add(x - y == 0., {requirements::PriorityLevel(0)});
+    pb.add(y == Vector3d(2, -3, 0.5), {requirements::PriorityLevel(1)});
+    pb.add(hint::Substitution(pb.constraint(*link), x));
+  }
+
+  LinearizedControlProblem pb;
+  VariablePtr y;
+  TaskWithRequirementsPtr lower;
+  TaskWithRequirementsPtr upper;
+};
+} // namespace
+
+TEST_CASE("Merged double-sided tasks give the same solution")
+{
+  DoubleSidedProblem merged(true);
+  DoubleSidedProblem unmerged(false);
+  FAST_CHECK_EQ(merged.pb.constraints().size(), 4);
+  FAST_CHECK_EQ(unmerged.pb.constraints().size(), 6);
+
+  scheme::WeightedLeastSquares solver(solver::DefaultLSSolverOptions{});
+  REQUIRE(solver.solve(merged.pb));
+  REQUIRE(solver.solve(unmerged.pb));
+  FAST_CHECK_UNARY(merged.y->value().isApprox(unmerged.y->value(), 1e-6));
+
+  // Both tasks give access to the merged constraint and its requirements
+  FAST_CHECK_EQ(&merged.pb.constraintWithRequirements(*merged.upper),
+                &merged.pb.constraintWithRequirements(*merged.lower));
+
+  // Changing the priority of one of the tasks undoes the merge. The priority
+  // is set back to 0 as WeightedLeastSquares only handles inequality
+  // constraints at level 0.
+  merged.upper->requirements.priorityLevel() = 1;
+  FAST_CHECK_EQ(merged.pb.constraints().size(), 5);
+  FAST_CHECK_EQ(merged.pb.constraint(*merged.upper)->type(), constraint::Type::LOWER_THAN);
+  FAST_CHECK_EQ(merged.pb.constraint(*merged.lower)->type(), constraint::Type::GREATER_THAN);
+  merged.upper->requirements.priorityLevel() = 0;
+  FAST_CHECK_EQ(merged.pb.constraints().size(), 5);
+  merged.y->setZero();
+  REQUIRE(solver.solve(merged.pb));
+  FAST_CHECK_UNARY(merged.y->value().isApprox(unmerged.y->value(), 1e-6));
 }
@@ -0,0 +1,65 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/LinearizedControlProblem.h>
+#include <tvm/Variable.h>
+#include <tvm/function/IdentityFunction.h>
+#include <tvm/task_dynamics/Proportional.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace tvm;
+
+/** A chain of n variables x_i, with tasks x_{i+1} - x_i = 1 and bounds on each
+ * variable given as two tasks, merged into double-sided constraints.
+ */
+std::unique_ptr<LinearizedControlProblem> chain(int n)
+{
+  auto pb = std::make_unique<LinearizedControlProblem>();
+  pb->mergeDoubleSidedTasks(true);
+  std::vector<VariablePtr> x;
+  for(int i = 0; i < n; ++i)
+  {
+    x.push_back(Space(2).createVariable("x" + std::to_string(i)));
+    auto id = std::make_shared<function::IdentityFunction>(x.back());
+    pb->add(id >= -10., task_dynamics::Proportional(1), {requirements::PriorityLevel(0)});
+    pb->add(id <= 10., task_dynamics::Proportional(1), {requirements::PriorityLevel(0)});
+    if(i > 0)
+    {
+      pb->add(x[static_cast<size_t>(i)] - x[static_cast<size_t>(i - 1)] == 1., task_dynamics::Proportional(2),
+              {requirements::PriorityLevel(1)});
+    }
+  }
+  pb->add(x[0] == 0., task_dynamics::Proportional(2), {requirements::PriorityLevel(1)});
+  pb->finalize();
+  return pb;
+}
+
+/** Building and finalizing the problem, to compare with BM_Clone.*/
+static void BM_Build(benchmark::State & st)
+{
+  for(auto _ : st)
+  {
+    auto pb = chain(static_cast<int>(st.range(0)));
+    benchmark::DoNotOptimize(pb);
+  }
+}
+
+/** Cloning a finalized problem, which reuses its update plan.*/
+static void BM_Clone(benchmark::State & st)
+{
+  auto pb = chain(static_cast<int>(st.range(0)));
+  for(auto _ : st)
+  {
+    auto c = pb->clone();
+    benchmark::DoNotOptimize(c);
+  }
+}
+
+BENCHMARK(BM_Build)->ArgName("n")->Arg(20)->Arg(100)->Arg(300)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Clone)->ArgName("n")->Arg(20)->Arg(100)->Arg(300)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
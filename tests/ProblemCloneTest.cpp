@@ -0,0 +1,270 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/LinearizedControlProblem.h>
+#include <tvm/Variable.h>
+#include <tvm/constraint/abstract/LinearConstraint.h>
+#include <tvm/function/BasicLinearFunction.h>
+#include <tvm/function/IdentityFunction.h>
+#include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/supported_solvers.h>
+#include <tvm/task_dynamics/None.h>
+#include <tvm/task_dynamics/Proportional.h>
+#include <tvm/utils/CloneMap.h>
+
+#include <thread>
+#include <vector>
+
+using namespace tvm;
+using namespace Eigen;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+namespace
+{
+/** A derived function not overriding clone.*/
+class Shifted : public function::BasicLinearFunction
+{
+public:
+  Shifted(VariablePtr x) : BasicLinearFunction(MatrixXd::Identity(x->size(), x->size()), x, VectorXd::Ones(x->size()))
+  {}
+};
+
+struct Problem
+{
+  Problem() : x(Space(3).createVariable("x")), y(Space(2).createVariable("y"))
+  {
+    x << 0.5, 0.5, 0.5;
+    MatrixXd A = MatrixXd::Ones(2, 3);
+    f = std::make_shared<function::BasicLinearFunction>(std::vector<MatrixConstRef>{A, MatrixXd::Identity(2, 2)},
+                                                        std::vector<VariablePtr>{x, y}, Vector2d(1, 2));
+    id = std::make_shared<function::IdentityFunction>(x);
+    bounds = pb.add(-1. <= x <= 1., task_dynamics::None(), {requirements::PriorityLevel(0)});
+    t1 = pb.add(f == 0., task_dynamics::None(), {requirements::PriorityLevel(0)});
+    t2 = pb.add(id == Vector3d(2, 0, -2), task_dynamics::Proportional(2), {requirements::PriorityLevel(1)});
+    t3 = pb.add(id >= -0.5, task_dynamics::Proportional(1), {requirements::PriorityLevel(0)});
+  }
+
+  VariablePtr x;
+  VariablePtr y;
+  std::shared_ptr<function::BasicLinearFunction> f;
+  std::shared_ptr<function::IdentityFunction> id;
+  LinearizedControlProblem pb;
+  TaskWithRequirementsPtr bounds, t1, t2, t3;
+};
+
+/** A chain of n variables x_i, with tasks x_{i+1} - x_i = 1 and bounds on each
+ * variable given as two tasks, merged into double-sided constraints.
+ */
+std::unique_ptr<LinearizedControlProblem> chain(int n, std::vector<VariablePtr> & x)
+{
+  auto pb = std::make_unique<LinearizedControlProblem>();
+  pb->mergeDoubleSidedTasks(true);
+  x.clear();
+  for(int i = 0; i < n; ++i)
+  {
+    x.push_back(Space(2).createVariable("x" + std::to_string(i)));
+    auto id = std::make_shared<function::IdentityFunction>(x.back());
+    pb->add(id >= -10., task_dynamics::Proportional(1), {requirements::PriorityLevel(0)});
+    pb->add(id <= 10., task_dynamics::Proportional(1), {requirements::PriorityLevel(0)});
+    if(i > 0)
+    {
+      pb->add(x[static_cast<size_t>(i)] - x[static_cast<size_t>(i - 1)] == 1., task_dynamics::Proportional(2),
+              {requirements::PriorityLevel(1)});
+    }
+  }
+  pb->add(x[0] == 0., task_dynamics::Proportional(2), {requirements::PriorityLevel(1)});
+  pb->finalize();
+  return pb;
+}
+
+/** Solve pb from x = (0.5, 0.5, 0.5), and return the values of x, dx/dt and y.*/
+VectorXd solve(LinearizedControlProblem & pb, const VariablePtr & x, const VariablePtr & y)
+{
+  x->set(Vector3d::Constant(0.5));
+  scheme::WeightedLeastSquares solver(solver::DefaultLSSolverOptions{});
+  REQUIRE(solver.solve(pb));
+  VectorXd v(8);
+  v << x->value(), dot(x)->value(), y->value();
+  return v;
+}
+} // namespace
+
+TEST_CASE("Clone a problem")
+{
+  Problem p;
+  p.pb.update();
+  utils::CloneMap map;
+  auto clone = p.pb.clone(map);
+
+  // Variables
+  auto x = map.variable(p.x);
+  auto y = map.variable(p.y);
+  FAST_CHECK_NE(x.get(), p.x.get());
+  FAST_CHECK_EQ(x->name(), p.x->name());
+  FAST_CHECK_UNARY(x->value().isApprox(p.x->value()));
+  FAST_CHECK_EQ(map.variable(dot(p.x)), dot(x));
+
+  // Functions and tasks
+  FAST_REQUIRE_EQ(clone->size(), p.pb.size());
+  auto f = map.function(p.f);
+  FAST_CHECK_NE(f.get(), p.f.get());
+  FAST_CHECK_UNARY(f->variables()[0] == x);
+  FAST_CHECK_UNARY(f->variables()[1] == y);
+  FAST_CHECK_UNARY(f->b().isApprox(p.f->b()));
+  for(int i = 0; i < p.pb.size(); ++i)
+  {
+    const auto & tr = p.pb.tasks()[static_cast<size_t>(i)];
+    const auto & c = clone->tasks()[static_cast<size_t>(i)];
+    FAST_CHECK_EQ(map.task(*tr), c);
+    FAST_CHECK_EQ(c->task.type(), tr->task.type());
+    FAST_CHECK_EQ(c->requirements.priorityLevel().value(), tr->requirements.priorityLevel().value());
+    FAST_CHECK_EQ(c->requirements.weight().value(), tr->requirements.weight().value());
+  }
+  // Tasks sharing a function in the original share its clone
+  FAST_CHECK_EQ(map.task(*p.t2)->task.function(), map.task(*p.t3)->task.function());
+  FAST_CHECK_EQ(map.task(*p.t2)->task.function(), map.function(p.id));
+  FAST_CHECK_UNARY(map.task(*p.t2)->task.taskDynamics()->checkType<task_dynamics::Proportional::Impl>());
+
+  // Same problem, same solution
+  VectorXd s0 = solve(p.pb, p.x, p.y);
+  VectorXd s1 = solve(*clone, x, y);
+  FAST_CHECK_UNARY(s0.isApprox(s1, 1e-8));
+
+  // Changing the clone does not change the original
+  std::static_pointer_cast<function::BasicLinearFunction>(f)->b(Vector2d(-1, 0));
+  map.task(*p.t2)->task.taskDynamics<task_dynamics::Proportional>()->gain(5.);
+  clone->tasks()[3]->disable();
+  VectorXd s2 = solve(p.pb, p.x, p.y);
+  VectorXd s3 = solve(*clone, x, y);
+  FAST_CHECK_UNARY(s2.isApprox(s0, 1e-8));
+  FAST_CHECK_UNARY(!s3.isApprox(s1, 1e-3));
+  FAST_CHECK_UNARY(p.f->b().isApprox(Vector2d(1, 2)));
+  FAST_CHECK_UNARY(p.t3->isEnabled());
+}
+
+TEST_CASE("Solve clones in parallel")
+{
+  Problem p;
+  const size_t n = 4;
+  std::vector<utils::CloneMap> maps(n);
+  std::vector<std::unique_ptr<LinearizedControlProblem>> clones;
+  for(size_t i = 0; i < n; ++i)
+  {
+    clones.push_back(p.pb.clone(maps[i]));
+    maps[i].function(p.f)->b(Vector2d(static_cast<double>(i), 0));
+  }
+
+  std::vector<VectorXd> results(n);
+  std::vector<std::thread> threads;
+  for(size_t i = 0; i < n; ++i)
+  {
+    threads.emplace_back([&, i]() {
+      auto x = maps[i].variable(p.x);
+      auto y = maps[i].variable(p.y);
+      for(int k = 0; k < 10; ++k)
+        results[i] = solve(*clones[i], x, y);
+    });
+  }
+  for(auto & t : threads)
+    t.join();
+
+  // Same results as a sequential resolution
+  for(size_t i = 0; i < n; ++i)
+  {
+    p.f->b(Vector2d(static_cast<double>(i), 0));
+    FAST_CHECK_UNARY(results[i].isApprox(solve(p.pb, p.x, p.y), 1e-8));
+  }
+  FAST_CHECK_UNARY(!results[0].isApprox(results[n - 1], 1e-3));
+}
+
+TEST_CASE("Clone a problem with merged tasks and substitutions")
+{
+  Problem p;
+  p.pb.mergeDoubleSidedTasks(true);
+  auto g = std::make_shared<function::IdentityFunction>(p.x);
+  auto lower = p.pb.add(g >= -0.8, task_dynamics::Proportional(1), {requirements::PriorityLevel(0)});
+  auto upper = p.pb.add(g <= 0.8, task_dynamics::Proportional(1), {requirements::PriorityLevel(0)});
+  p.pb.add(hint::Substitution(p.pb.constraint(*p.t1), p.y));
+  p.pb.update();
+
+  utils::CloneMap map;
+  auto clone = p.pb.clone(map);
+  auto x = map.variable(p.x);
+  auto y = map.variable(p.y);
+  FAST_CHECK_EQ(clone->constraintRows(), p.pb.constraintRows());
+  FAST_CHECK_EQ(clone->constraint(*map.task(*lower)), clone->constraint(*map.task(*upper)));
+  FAST_CHECK_EQ(clone->constraint(*map.task(*lower))->type(), constraint::Type::DOUBLE_SIDED);
+
+  // The substitution is on the clones of the constraint and variable
+  FAST_REQUIRE_EQ(clone->substitutions().substitutions().size(), 1);
+  const auto & s = clone->substitutions().substitutions()[0];
+  FAST_CHECK_EQ(s.constraints()[0], clone->constraint(*map.task(*p.t1)));
+  FAST_CHECK_EQ(s.variables()[0], y);
+  FAST_CHECK_NE(s.calculator(), p.pb.substitutions().substitutions()[0].calculator());
+  CHECK_THROWS_AS(map.task(*p.t1)->disable(), std::runtime_error);
+
+  VectorXd s0 = solve(p.pb, p.x, p.y);
+  VectorXd s1 = solve(*clone, x, y);
+  FAST_CHECK_UNARY(s0.isApprox(s1, 1e-8));
+
+  // The merge of the clone is undone independently of the original
+  map.task(*upper)->requirements.priorityLevel() = 1;
+  FAST_CHECK_NE(clone->constraint(*map.task(*lower)), clone->constraint(*map.task(*upper)));
+  FAST_CHECK_EQ(p.pb.constraint(*lower), p.pb.constraint(*upper));
+}
+
+TEST_CASE("Clone a problem with a reused update plan")
+{
+  // The clone, with the update plan of the original, gives the same results
+  std::vector<VariablePtr> x;
+  auto pb = chain(20, x);
+  utils::CloneMap map;
+  auto c = pb->clone(map);
+  FAST_CHECK_EQ(c->size(), pb->size());
+  FAST_CHECK_EQ(c->constraintRows(), pb->constraintRows());
+  for(auto & xi : x)
+  {
+    xi->set(Vector2d(0.5, -0.5));
+    map.variable(xi)->set(Vector2d(0.5, -0.5));
+  }
+  pb->update();
+  c->update();
+  auto constraints = pb->constraints();
+  auto cloneConstraints = c->constraints();
+  FAST_REQUIRE_EQ(constraints.size(), cloneConstraints.size());
+  for(size_t i = 0; i < constraints.size(); ++i)
+  {
+    const auto & c0 = *constraints[i].constraint;
+    const auto & c1 = *cloneConstraints[i].constraint;
+    FAST_CHECK_EQ(c0.type(), c1.type());
+    if(c0.type() == constraint::Type::EQUAL)
+      FAST_CHECK_UNARY(c0.e().isApprox(c1.e()));
+    else
+      FAST_CHECK_UNARY(c0.l().isApprox(c1.l()) && c0.u().isApprox(c1.u()));
+  }
+
+  scheme::WeightedLeastSquares solver(solver::DefaultLSSolverOptions{});
+  scheme::WeightedLeastSquares cloneSolver(solver::DefaultLSSolverOptions{});
+  REQUIRE(solver.solve(*pb));
+  REQUIRE(cloneSolver.solve(*c));
+  for(const auto & xi : x)
+    FAST_CHECK_UNARY(dot(map.variable(xi))->value().isApprox(dot(xi)->value(), 1e-8));
+}
+
+TEST_CASE("Cloning errors")
+{
+  VariablePtr x = Space(3).createVariable("x");
+  LinearizedControlProblem pb;
+  pb.add(std::make_shared<Shifted>(x) == 0., task_dynamics::None(), {requirements::PriorityLevel(0)});
+  CHECK_THROWS_AS(pb.clone(), std::runtime_error);
+
+  // A substitution on a constraint that is not the one of a task
+  LinearizedControlProblem pb2;
+  LinearizedControlProblem other;
+  auto t = other.add(x == 0., task_dynamics::None(), {requirements::PriorityLevel(0)});
+  pb2.add(x >= 0., task_dynamics::None(), {requirements::PriorityLevel(0)});
+  pb2.add(hint::Substitution(other.constraint(*t), x));
+  CHECK_THROWS_AS(pb2.clone(), std::runtime_error);
+}
@@ -0,0 +1,180 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/LinearizedControlProblem.h>
+#include <tvm/Variable.h>
+#include <tvm/function/BasicLinearFunction.h>
+#include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/solver/internal/QPPresolve.h>
+#include <tvm/supported_solvers.h>
+#include <tvm/task_dynamics/None.h>
+#include <tvm/utils/memoryChecks.h>
+
+#ifdef TVM_USE_QLD
+#  include <tvm/solver/QLDLeastSquareSolver.h>
+#endif
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+#include <Eigen/LU>
+
+#include <limits>
+
+using namespace Eigen;
+using namespace tvm;
+using tvm::solver::internal::QPPresolve;
+
+namespace
+{
+/** Solve min. 1/2 x^T Q x + c^T x s.t. C x + d = 0 with the KKT system.*/
+VectorXd solveEqQP(const MatrixXd & Q, const VectorXd & c, const MatrixXd & C, const VectorXd & d)
+{
+  auto n = Q.rows();
+  auto m = C.rows();
+  MatrixXd K = MatrixXd::Zero(n + m, n + m);
+  K.topLeftCorner(n, n) = Q;
+  K.topRightCorner(n, m) = C.transpose();
+  K.bottomLeftCorner(m, n) = C;
+  VectorXd r(n + m);
+  r << -c, -d;
+  return K.partialPivLu().solve(r).head(n);
+}
+} // namespace
+
+TEST_CASE("Presolve")
+{
+  MatrixXd M = MatrixXd::Random(4, 4);
+  MatrixXd Q = M.transpose() * M + MatrixXd::Identity(4, 4);
+  VectorXd c = VectorXd::Random(4);
+
+  MatrixXd A(5, 4);
+  VectorXd b(5);
+  A << 1, 1, 2, 1,     // equality, depends on free variables
+      0, 0, 1, 0,      // equality, only on the fixed variable, satisfied
+      1, 2, 3, 4,      // inequality, infinite bound
+      1, -1, 0, 0,     // inequality
+      0, 0, 2, 0;      // inequality, only on the fixed variable, satisfied
+  b << 1, -0.5, constant::big_number, 2, 1;
+  VectorXd xl = VectorXd::Constant(4, -constant::big_number);
+  VectorXd xu = VectorXd::Constant(4, constant::big_number);
+  xl[2] = xu[2] = 0.5;
+
+  QPPresolve presolve;
+  FAST_CHECK_UNARY(presolve.analyze(A, b, xl, xu, 2));
+  FAST_CHECK_EQ(presolve.removedVariables(), 1);
+  FAST_CHECK_EQ(presolve.removedConstraints(), 3);
+  FAST_CHECK_EQ(presolve.freeVariables(), 3);
+  FAST_CHECK_EQ(presolve.constraints(), 2);
+  FAST_CHECK_EQ(presolve.nEq(), 1);
+
+  presolve.reduceConstraints(A, b, xl, xu);
+  presolve.reduceObjective(Q, c);
+  MatrixXd Ar(2, 3);
+  Ar << 1, 1, 1, 1, -1, 0;
+  FAST_CHECK_UNARY(presolve.A().isApprox(Ar));
+  FAST_CHECK_UNARY(presolve.b().isApprox(Vector2d(2, 2)));
+  FAST_CHECK_EQ(presolve.xl().size(), 3);
+  FAST_CHECK_EQ(presolve.Q().rows(), 3);
+
+  // Compare the solutions with the equality constraints only.
+  VectorXd y = solveEqQP(presolve.Q(), presolve.c(), presolve.A().topRows(1), presolve.b().head(1));
+  presolve.expand(y);
+
+  MatrixXd C(2, 4);
+  C << A.row(0), 0, 0, 1, 0;
+  VectorXd x = solveEqQP(Q, c, C, Vector2d(b[0], -0.5));
+  FAST_CHECK_UNARY(presolve.x().isApprox(x));
+  FAST_CHECK_EQ(presolve.x()[2], 0.5);
+}
+
+TEST_CASE("Nothing to remove")
+{
+  MatrixXd A = MatrixXd::Random(3, 4);
+  VectorXd b = VectorXd::Random(3);
+  VectorXd xl = VectorXd::Constant(4, -1);
+  VectorXd xu = VectorXd::Constant(4, 1);
+
+  QPPresolve presolve;
+  FAST_CHECK_UNARY_FALSE(presolve.analyze(A, b, xl, xu, 1));
+  FAST_CHECK_EQ(presolve.removedVariables(), 0);
+  FAST_CHECK_EQ(presolve.removedConstraints(), 0);
+
+  // Variables with equal bounds are kept on demand
+  xl[1] = xu[1] = 0;
+  FAST_CHECK_UNARY_FALSE(presolve.analyze(A, b, xl, xu, 1, false));
+  FAST_CHECK_UNARY(presolve.analyze(A, b, xl, xu, 1));
+}
+
+TEST_CASE("Presolve without allocation")
+{
+  MatrixXd Q = MatrixXd::Identity(4, 4);
+  VectorXd c = VectorXd::Random(4);
+  MatrixXd A = MatrixXd::Random(3, 4);
+  VectorXd b(3);
+  b << 1, constant::big_number, 2;
+  VectorXd xl = VectorXd::Constant(4, -1);
+  VectorXd xu = VectorXd::Constant(4, 1);
+  xl[0] = xu[0] = 0.5;
+  VectorXd y = VectorXd::Zero(3);
+
+  QPPresolve presolve;
+  presolve.reserve(3, 4);
+  tvm::utils::set_is_malloc_allowed(false);
+  FAST_CHECK_UNARY(presolve.analyze(A, b, xl, xu, 1));
+  presolve.reduceConstraints(A, b, xl, xu);
+  presolve.reduceObjective(Q, c);
+  presolve.expand(y);
+  tvm::utils::set_is_malloc_allowed(true);
+  FAST_CHECK_EQ(presolve.A().rows(), 2);
+  FAST_CHECK_EQ(presolve.A().cols(), 3);
+  FAST_CHECK_UNARY(presolve.A().row(1).isApprox(A.row(2).tail(3)));
+  FAST_CHECK_EQ(presolve.b()[1], doctest::Approx(b[2] + A(2, 0) * 0.5));
+}
+
+#ifdef TVM_USE_QLD
+TEST_CASE("Presolve in QLD")
+{
+  VariablePtr x = Space(3).createVariable("x");
+  VariablePtr y = Space(2).createVariable("y");
+  MatrixXd Ax(2, 3);
+  Ax << 1, 2, 1, 0, 1, -1;
+  auto f = std::make_shared<function::BasicLinearFunction>(std::vector<MatrixConstRef>{Ax, MatrixXd::Identity(2, 2)},
+                                                           std::vector<VariablePtr>{x, y}, Vector2d(0.2, -0.1));
+  auto g = std::make_shared<function::BasicLinearFunction>(RowVector3d(1, 1, 1), x);
+
+  LinearizedControlProblem pb;
+  // The bound on x[2] fixes its value.
+  pb.add(Vector3d(-1, -1, 0.3) <= x <= Vector3d(1, 1, 0.3), task_dynamics::None(), {requirements::PriorityLevel(0)});
+  pb.add(f == 0., task_dynamics::None(), {requirements::PriorityLevel(0)});
+  // The lower side of this constraint is trivially satisfied.
+  pb.add(-std::numeric_limits<double>::infinity() <= g <= 0.5, task_dynamics::None(),
+         {requirements::PriorityLevel(0)});
+  pb.add(x == Vector3d(1, 2, -1), task_dynamics::None(), {requirements::PriorityLevel(1)});
+  pb.add(y == Vector2d(0.5, 0.5), task_dynamics::None(), {requirements::PriorityLevel(1), requirements::Weight(0.1)});
+
+  auto solve = [&](bool presolve, bool cholesky) {
+    using Memory = scheme::WeightedLeastSquares::ComputationDataType;
+    scheme::WeightedLeastSquares solver(solver::QLDLSSolverOptions().presolve(presolve).cholesky(cholesky));
+    REQUIRE(solver.solve(pb));
+    VectorXd s(5);
+    s << x->value(), y->value();
+    const auto & lsSolver = *static_cast<Memory *>(scheme::internal::getComputationData(pb, solver))->solver;
+    // The lower side of the constraint on g is removed, and x[2] as well
+    // unless working with the Cholesky factor.
+    FAST_CHECK_EQ(lsSolver.presolveStatistics().removedConstraints, presolve ? 1 : 0);
+    FAST_CHECK_EQ(lsSolver.presolveStatistics().removedVariables, presolve && !cholesky ? 1 : 0);
+    // A second resolution gives the same result.
+    REQUIRE(solver.solve(pb));
+    FAST_CHECK_UNARY(x->value().isApprox(s.head(3)));
+    return s;
+  };
+
+  VectorXd s0 = solve(false, false);
+  VectorXd s1 = solve(true, false);
+  FAST_CHECK_UNARY(solve(true, true).isApprox(s0, 1e-6));
+  FAST_CHECK_EQ(s1[2], doctest::Approx(0.3));
+  FAST_CHECK_UNARY(s1.isApprox(s0, 1e-6));
+  FAST_CHECK_LE(s1.head(3).sum(), 0.5 + 1e-6);
+}
+#endif
@@ -0,0 +1,275 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/LinearizedControlProblem.h>
+#include <tvm/Space.h>
+#include <tvm/Variable.h>
+#include <tvm/VariableVector.h>
+#include <tvm/constraint/BasicLinearConstraint.h>
+#include <tvm/function/BasicLinearFunction.h>
+#include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/solver/QPRecorder.h>
+#include <tvm/supported_solvers.h>
+#include <tvm/task_dynamics/None.h>
+#include <tvm/utils/memoryChecks.h>
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <thread>
+
+using namespace tvm;
+using namespace tvm::requirements;
+using namespace tvm::solver;
+using namespace Eigen;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+namespace
+{
+QPRecord randomRecord(int n, int nObj, int nCstr)
+{
+  QPRecord r;
+  r.A = MatrixXd::Random(nObj, n);
+  r.b = VectorXd::Random(nObj);
+  r.C = MatrixXd::Random(nCstr, n);
+  r.l = VectorXd::Random(nCstr);
+  r.u = r.l + VectorXd::Ones(nCstr);
+  r.xl = VectorXd::Constant(n, -1);
+  r.xu = VectorXd::Constant(n, 1);
+  r.x = VectorXd::Random(n);
+  r.success = true;
+  return r;
+}
+} // namespace
+
+TEST_CASE("Write and read a QP log")
+{
+  const std::string path = "QPRecorderTest.log";
+  std::vector<QPRecord> records = {randomRecord(4, 3, 2), randomRecord(4, 3, 2), randomRecord(6, 2, 0)};
+  records[1].success = false;
+
+  {
+    QPRecorder recorder(path, 2);
+    for(const auto & r : records)
+    {
+      QPRecord * slot = recorder.acquire();
+      while(!slot)
+      {
+        // The buffer is full: wait for the writer thread.
+        recorder.flush();
+        slot = recorder.acquire();
+      }
+      int64_t tick = slot->tick;
+      *slot = r;
+      slot->tick = tick;
+      recorder.commit(slot);
+    }
+    recorder.flush();
+    FAST_CHECK_EQ(recorder.recorded(), 3);
+  }
+
+  QPLogReader reader(path);
+  QPRecord r;
+  int64_t previousTick = -1;
+  for(const auto & ref : records)
+  {
+    FAST_REQUIRE_UNARY(reader.next(r));
+    FAST_CHECK_GT(r.tick, previousTick);
+    previousTick = r.tick;
+    FAST_CHECK_UNARY(r.A.isApprox(ref.A));
+    FAST_CHECK_UNARY(r.b.isApprox(ref.b));
+    FAST_CHECK_EQ(r.C.rows(), ref.C.rows());
+    FAST_CHECK_EQ(r.C.cols(), ref.C.cols());
+    FAST_CHECK_UNARY(r.C == ref.C);
+    FAST_CHECK_UNARY(r.l == ref.l);
+    FAST_CHECK_UNARY(r.u == ref.u);
+    FAST_CHECK_UNARY(r.xl == ref.xl);
+    FAST_CHECK_UNARY(r.xu == ref.xu);
+    FAST_CHECK_UNARY(r.x == ref.x);
+    FAST_CHECK_EQ(r.success, ref.success);
+  }
+  FAST_CHECK_UNARY(!reader.next(r));
+
+  std::remove(path.c_str());
+
+  CHECK_THROWS(QPLogReader("QPRecorderTest.nonexistent"));
+}
+
+TEST_CASE("Share a recorder between threads")
+{
+  const std::string path = "QPRecorderTest_threads.log";
+  const int nRecords = 200;
+  {
+    QPRecorder recorder(path, 8);
+    // Each thread writes records of its own size, filled with a value
+    // identifying the record, so that mixed records can be detected.
+    auto run = [&recorder, nRecords](int t) {
+      QPRecord r = randomRecord(3 + t, 2 + t, 1 + t);
+      for(int k = 0; k < nRecords; ++k)
+      {
+        QPRecord * slot = recorder.acquire();
+        if(!slot)
+          continue;
+        int64_t tick = slot->tick;
+        double v = 1000 * t + k;
+        *slot = r;
+        slot->tick = tick;
+        slot->A.setConstant(v);
+        slot->C.setConstant(v);
+        slot->x.setConstant(v);
+        recorder.commit(slot);
+      }
+    };
+    std::thread t1(run, 1);
+    std::thread t2(run, 2);
+    t1.join();
+    t2.join();
+    recorder.flush();
+    FAST_CHECK_EQ(recorder.recorded() + recorder.dropped(), 2 * nRecords);
+    FAST_CHECK_UNARY_FALSE(recorder.failed());
+  }
+
+  QPLogReader reader(path);
+  QPRecord r;
+  std::set<int64_t> ticks;
+  while(reader.next(r))
+  {
+    FAST_CHECK_UNARY(ticks.insert(r.tick).second);
+    double v = r.x[0];
+    int t = static_cast<int>(v) / 1000;
+    FAST_REQUIRE_UNARY(t == 1 || t == 2);
+    FAST_CHECK_EQ(r.x.size(), 3 + t);
+    FAST_CHECK_EQ(r.A.rows(), 2 + t);
+    FAST_CHECK_EQ(r.C.rows(), 1 + t);
+    FAST_CHECK_UNARY((r.A.array() == v).all());
+    FAST_CHECK_UNARY((r.C.array() == v).all());
+    FAST_CHECK_UNARY((r.x.array() == v).all());
+  }
+  FAST_CHECK_UNARY(!ticks.empty());
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Errors on the log file")
+{
+  const std::string path = "QPRecorderTest_errors.log";
+  {
+    QPRecorder recorder(path);
+    QPRecord * slot = recorder.acquire();
+    int64_t tick = slot->tick;
+    *slot = randomRecord(4, 3, 2);
+    slot->tick = tick;
+    recorder.commit(slot);
+    // A discarded slot is not written and does not block the next ones.
+    recorder.discard(recorder.acquire());
+    slot = recorder.acquire();
+    *slot = randomRecord(4, 3, 2);
+    recorder.commit(slot);
+    recorder.flush();
+    FAST_CHECK_EQ(recorder.recorded(), 2);
+  }
+
+  // Garbage after the valid records
+  {
+    std::ofstream f(path, std::ios::binary | std::ios::app);
+    int64_t garbage[2] = {3, 0};
+    f.write(reinterpret_cast<const char *>(garbage), sizeof(garbage));
+  }
+  {
+    QPLogReader reader(path);
+    QPRecord r;
+    FAST_CHECK_UNARY(reader.next(r));
+    FAST_CHECK_UNARY(reader.next(r));
+    CHECK_THROWS_AS(reader.next(r), std::runtime_error);
+  }
+  std::remove(path.c_str());
+
+#ifdef __linux__
+  // Writing to /dev/full fails
+  CHECK_THROWS_AS(QPRecorder("/dev/full"), std::runtime_error);
+#endif
+}
+
+TEST_CASE("Record and replay")
+{
+  const std::string path = "QPRecorderTest_replay.log";
+  VariablePtr x = Space(4).createVariable("x");
+  VariablePtr y = Space(3).createVariable("y");
+  MatrixXd A = MatrixXd::Random(3, 4);
+  MatrixXd C = MatrixXd::Random(2, 4);
+  auto f = std::make_shared<function::BasicLinearFunction>(MatrixXd::Random(4, 4), x, VectorXd::Random(4));
+
+  LinearizedControlProblem pb;
+  pb.add(A * x + y == 0., task_dynamics::None(), {PriorityLevel(0)});
+  pb.add(C * x <= 1., task_dynamics::None(), {PriorityLevel(0)});
+  pb.add(-1. <= y <= 1., task_dynamics::None(), {PriorityLevel(0)});
+  pb.add(f == 0., task_dynamics::None(), {PriorityLevel(1)});
+  pb.add(y == 0., task_dynamics::None(), {PriorityLevel(1), Weight(0.1)});
+
+  auto recorder = std::make_shared<QPRecorder>(path);
+  scheme::WeightedLeastSquares solver(DefaultLSSolverOptions{},
+                                      scheme::WeightedLeastSquaresOptions{}.recorder(recorder));
+  std::vector<VectorXd> solutions;
+  for(int i = 0; i < 3; ++i)
+  {
+    f->b(VectorXd::Random(4));
+    FAST_REQUIRE_UNARY(solver.solve(pb));
+    solutions.push_back(pb.variables().value());
+  }
+  recorder->flush();
+  FAST_CHECK_EQ(recorder->recorded() + recorder->dropped(), 3);
+
+  QPLogReader reader(path);
+  QPReplay replay(DefaultLSSolverFactory{});
+  QPRecord r;
+  int i = 0;
+  while(reader.next(r))
+  {
+    FAST_CHECK_UNARY(r.success);
+    FAST_REQUIRE_UNARY(replay.solve(r));
+    // The replayed resolution gives the same result as the recorded one
+    FAST_CHECK_UNARY(replay.result().isApprox(r.x, 1e-6));
+    FAST_CHECK_UNARY(r.x.isApprox(solutions[static_cast<size_t>(r.tick)], 1e-6));
+    ++i;
+  }
+  FAST_CHECK_EQ(i, recorder->recorded());
+
+  recorder.reset();
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Recording does not allocate memory")
+{
+  const std::string path = "QPRecorderTest_memory.log";
+  VariablePtr x = Space(4).createVariable("x");
+  VariableVector vars(x);
+  auto o = std::make_shared<constraint::BasicLinearConstraint>(MatrixXd::Random(3, 4), x, constraint::Type::EQUAL);
+  auto c = std::make_shared<constraint::BasicLinearConstraint>(MatrixXd::Random(2, 4), x, VectorXd::Ones(2),
+                                                              constraint::Type::LOWER_THAN);
+  auto req = std::make_shared<SolvingRequirementsWithCallbacks>(PriorityLevel(1));
+
+  auto recorder = std::make_shared<QPRecorder>(path, 4);
+  auto solver = DefaultLSSolverFactory{}.createSolver();
+  solver->startBuild(vars, 3, 0, 2, false);
+  solver->addObjective(o, req);
+  solver->addConstraint(c);
+  solver->finalizeBuild();
+  FAST_REQUIRE_UNARY(solver->solve());
+
+  // The slots are sized when the recorder is set, so that the first fill of
+  // each of them does not allocate.
+  solver->recorder(recorder);
+  for(int i = 0; i < 4; ++i)
+  {
+    tvm::utils::set_is_malloc_allowed(false);
+    bool b = solver->solve();
+    tvm::utils::set_is_malloc_allowed(true);
+    FAST_CHECK_UNARY(b);
+  }
+  recorder->flush();
+  FAST_CHECK_EQ(recorder->recorded() + recorder->dropped(), 4);
+
+  recorder.reset();
+  std::remove(path.c_str());
+}
@@ -0,0 +1,97 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/solver/QPRecorder.h>
+#include <tvm/supported_solvers.h>
+
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace tvm;
+using namespace tvm::solver;
+
+/** Re-solve the problems of a log written by a QPRecorder with every
+ * available backend.
+ *
+ * Usage: QPReplayBenchmark [benchmark options] <log file>
+ *
+ * Each iteration solves the next record of the log, in order, so that the
+ * solvers can reuse their data as they would in the original control loop.
+ * Besides the timings, the benchmarks report as counters the number of
+ * records, the number of failed resolutions and the maximum distance between
+ * the solutions found and the recorded ones.
+ */
+
+namespace
+{
+std::vector<QPRecord> records;
+
+void replay(benchmark::State & st, const abstract::LSSolverFactory & factory)
+{
+  QPReplay replay(factory);
+  size_t i = 0;
+  double maxError = 0;
+  int failures = 0;
+  for(auto _ : st)
+  {
+    const auto & r = records[i];
+    if(replay.solve(r))
+    {
+      maxError = std::max(maxError, (replay.result() - r.x).lpNorm<Eigen::Infinity>());
+    }
+    else
+    {
+      ++failures;
+    }
+    i = (i + 1) % records.size();
+  }
+  st.counters["records"] = static_cast<double>(records.size());
+  st.counters["failures"] = failures;
+  st.counters["maxError"] = maxError;
+}
+} // namespace
+
+int main(int argc, char ** argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if(argc < 2)
+  {
+    std::cout << "Usage: " << argv[0] << " [benchmark options] <log file>" << std::endl;
+    return 0;
+  }
+
+  QPLogReader reader(argv[1]);
+  QPRecord r;
+  while(reader.next(r))
+    records.push_back(r);
+  if(records.empty())
+  {
+    std::cout << "No record in " << argv[1] << std::endl;
+    return 0;
+  }
+
+#ifdef TVM_USE_LSSOL
+  benchmark::RegisterBenchmark("Replay/LSSOL", [](benchmark::State & st) { replay(st, LSSOLLSSolverFactory{}); })
+      ->Unit(benchmark::kMicrosecond);
+#endif
+#ifdef TVM_USE_QLD
+  benchmark::RegisterBenchmark("Replay/QLD", [](benchmark::State & st) { replay(st, QLDLSSolverFactory{}); })
+      ->Unit(benchmark::kMicrosecond);
+#endif
+#ifdef TVM_USE_QUADPROG
+  benchmark::RegisterBenchmark("Replay/Quadprog", [](benchmark::State & st) { replay(st, QuadprogLSSolverFactory{}); })
+      ->Unit(benchmark::kMicrosecond);
+#endif
+#ifdef TVM_USE_LEXLS
+  benchmark::RegisterBenchmark("Replay/LexLS", [](benchmark::State & st) { replay(st, LexLSLSSolverFactory{}); })
+      ->Unit(benchmark::kMicrosecond);
+#endif
+
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -18,16 +18,20 @@
 #include <tvm/ControlProblem.h>
 #include <tvm/LinearizedControlProblem.h>
 #include <tvm/function/IdentityFunction.h>
+#include <tvm/graph/CallGraph.h>
 #include <tvm/hint/Substitution.h>
+#include <tvm/hint/internal/LTDLCalculator.h>
 #include <tvm/scheme/WeightedLeastSquares.h>
 #include <tvm/supported_solvers.h>
 #include <tvm/task_dynamics/None.h>
 #include <tvm/task_dynamics/ProportionalDerivative.h>
 #include <tvm/task_dynamics/VelocityDamper.h>
+#include <tvm/utils/CloneMap.h>
 #include <tvm/utils/sch.h>
 
 #include <RBDyn/parsers/urdf.h>
 
+#include <RBDyn/EulerIntegration.h>
 #include <RBDyn/ID.h>
 
 #include <fstream>
@@ -275,3 +279,179 @@ TEST_CASE("Test a problem with a robot")
   }
 }
 #endif
+
+#if defined(TVM_USE_LSSOL) || defined(TVM_USE_QLD)
+TEST_CASE("Clone a problem with a robot")
+{
+  double dt = 0.005;
+  tvm::Clock clock(dt);
+  std::vector<std::string> jvrc_filtered = {"R_UTHUMB_S",  "R_LTHUMB_S",  "R_UINDEX_S",  "R_LINDEX_S",
+                                            "R_ULITTLE_S", "R_LLITTLE_S", "L_UTHUMB_S",  "L_LTHUMB_S",
+                                            "L_UINDEX_S",  "L_LINDEX_S",  "L_ULITTLE_S", "L_LLITTLE_S"};
+  tvm::RobotPtr jvrc = tvm::robot::fromURDF(clock, "JVRC1", jvrc_urdf, true, jvrc_filtered, {});
+  auto jvrc_lh = std::make_shared<tvm::robot::Frame>("LeftHand", jvrc, "L_WRIST_Y_S", sva::PTransformd::Identity());
+
+  auto posture_fn = std::make_shared<tvm::robot::PostureFunction>(jvrc);
+  posture_fn->posture("NECK_P", {0.5});
+  auto com_fn = std::make_shared<tvm::robot::CoMFunction>(jvrc);
+  com_fn->com(com_fn->com() + Eigen::Vector3d(0, 0, -0.05));
+  auto ori_fn = std::make_shared<tvm::robot::OrientationFunction>(jvrc_lh);
+  auto pos_fn = std::make_shared<tvm::robot::PositionFunction>(jvrc_lh);
+  pos_fn->position(pos_fn->position() + Eigen::Vector3d{0.1, -0.1, 0.1});
+  std::shared_ptr<tvm::robot::JointsSelector> pos_js =
+      tvm::robot::JointsSelector::InactiveJoints(pos_fn, jvrc, {"R_ELBOW_P"});
+
+  tvm::LinearizedControlProblem lpb;
+  lpb.add(posture_fn == 0., tvm::task_dynamics::PD(1.),
+          {tvm::requirements::PriorityLevel(1), tvm::requirements::Weight(1.)});
+  lpb.add(com_fn == 0., tvm::task_dynamics::PD(2.),
+          {tvm::requirements::PriorityLevel(1), tvm::requirements::Weight(100.)});
+  lpb.add(ori_fn == 0., tvm::task_dynamics::PD(2.),
+          {tvm::requirements::PriorityLevel(1), tvm::requirements::Weight(10.)});
+  lpb.add(pos_js == 0., tvm::task_dynamics::PD(1.),
+          {tvm::requirements::PriorityLevel(1), tvm::requirements::Weight(10.)});
+  lpb.add(jvrc->lQBound() <= jvrc->qJoints() <= jvrc->uQBound(),
+          tvm::task_dynamics::VelocityDamper(dt, {0.01, 0.001, 0}, tvm::constant::big_number),
+          {tvm::requirements::PriorityLevel(0)});
+  lpb.finalize();
+
+  tvm::utils::CloneMap map;
+  auto clone = lpb.clone(map);
+  auto jvrc2 = map.robot(jvrc);
+  auto & clock2 = map.clock(clock);
+
+  // The clone has its own state and variables, but shares the model
+  FAST_CHECK_NE(jvrc2.get(), jvrc.get());
+  FAST_CHECK_EQ(&jvrc2->mb(), &jvrc->mb());
+  FAST_CHECK_NE(jvrc2->qJoints().get(), jvrc->qJoints().get());
+  FAST_CHECK_EQ(map.frame(jvrc_lh)->robot().qJoints(), jvrc2->qJoints());
+  FAST_CHECK_UNARY(jvrc2->qJoints()->value().isApprox(jvrc->qJoints()->value()));
+
+  tvm::scheme::WeightedLeastSquares solver(tvm::solver::DefaultLSSolverOptions{});
+  tvm::scheme::WeightedLeastSquares solver2(tvm::solver::DefaultLSSolverOptions{});
+  for(int i = 0; i < 20; ++i)
+  {
+    REQUIRE(solver.solve(lpb));
+    clock.advance();
+    REQUIRE(solver2.solve(*clone));
+    clock2.advance();
+  }
+  FAST_CHECK_UNARY(jvrc2->qJoints()->value().isApprox(jvrc->qJoints()->value(), 1e-8));
+  FAST_CHECK_UNARY(dot(jvrc2->qJoints(), 2)->value().isApprox(dot(jvrc->qJoints(), 2)->value(), 1e-8));
+
+  // Moving the clone does not move the original
+  auto q = jvrc->qJoints()->value();
+  REQUIRE(solver2.solve(*clone));
+  clock2.advance();
+  REQUIRE(solver2.solve(*clone));
+  FAST_CHECK_UNARY(jvrc->qJoints()->value() == q);
+  FAST_CHECK_UNARY_FALSE(jvrc2->qJoints()->value().isApprox(q));
+}
+#endif
+
+#if defined(TVM_USE_LSSOL) || defined(TVM_USE_QLD)
+TEST_CASE("Substitute the accelerations of a robot")
+{
+  double dt = 0.005;
+  tvm::Clock clock(dt);
+  std::vector<std::string> jvrc_filtered = {"R_UTHUMB_S",  "R_LTHUMB_S",  "R_UINDEX_S",  "R_LINDEX_S",
+                                            "R_ULITTLE_S", "R_LLITTLE_S", "L_UTHUMB_S",  "L_LTHUMB_S",
+                                            "L_UINDEX_S",  "L_LINDEX_S",  "L_ULITTLE_S", "L_LLITTLE_S"};
+  tvm::RobotPtr jvrc = tvm::robot::fromURDF(clock, "JVRC1", jvrc_urdf, false, jvrc_filtered, {});
+  REQUIRE(jvrc->qFreeFlyer()->size() > 0);
+
+  auto dyn_fn = std::make_shared<tvm::robot::internal::DynamicFunction>(jvrc);
+  auto posture_fn = std::make_shared<tvm::robot::PostureFunction>(jvrc);
+  posture_fn->posture("NECK_P", {0.5});
+
+  auto ddq = dot(jvrc->q(), 2).variables();
+  std::vector<int> lambda;
+  FAST_CHECK_UNARY(dyn_fn->jacobianParentArray(ddq, lambda));
+  FAST_CHECK_UNARY(lambda == jvrc->dofParents());
+  FAST_CHECK_UNARY_FALSE(dyn_fn->jacobianParentArray({ddq[1], ddq[0]}, lambda));
+  FAST_CHECK_UNARY_FALSE(dyn_fn->jacobianParentArray({ddq[1]}, lambda));
+
+  auto build = [&](tvm::LinearizedControlProblem & lpb) {
+    auto tdyn = lpb.add(dyn_fn == 0., tvm::task_dynamics::None(), {tvm::requirements::PriorityLevel(0)});
+    lpb.add(posture_fn == 0., tvm::task_dynamics::PD(1.),
+            {tvm::requirements::PriorityLevel(1), tvm::requirements::Weight(1.)});
+    lpb.add(jvrc->lTauBound() <= jvrc->tau() <= jvrc->uTauBound(), tvm::task_dynamics::None(),
+            {tvm::requirements::PriorityLevel(0)});
+    return tdyn;
+  };
+
+  tvm::LinearizedControlProblem lpb;
+  tvm::LinearizedControlProblem lpbSubs;
+  build(lpb);
+  auto tdyn = build(lpbSubs);
+
+  // The inertia matrix is split between the free-flyer and the joints, but the
+  // LTDL calculator is still chosen, with the parent array of the robot.
+  tvm::hint::Substitution subs(lpbSubs.constraint(*tdyn), ddq);
+  auto ltdl = std::dynamic_pointer_cast<tvm::hint::internal::LTDLCalculator::Impl>(subs.calculator());
+  REQUIRE(ltdl != nullptr);
+  lpbSubs.add(subs);
+
+  tvm::scheme::WeightedLeastSquares solver(tvm::solver::DefaultLSSolverOptions{});
+  tvm::scheme::WeightedLeastSquares solverSubs(tvm::solver::DefaultLSSolverOptions{});
+  for(int i = 0; i < 10; ++i)
+  {
+    REQUIRE(solver.solve(lpb));
+    Eigen::VectorXd ddq0 = dot(jvrc->q(), 2).value();
+    REQUIRE(solverSubs.solve(lpbSubs));
+    FAST_CHECK_UNARY(dot(jvrc->q(), 2).value().isApprox(ddq0, 1e-6));
+    clock.advance();
+  }
+}
+#endif
+
+TEST_CASE("Integrate the state of a robot")
+{
+  double dt = 0.005;
+  std::map<std::string, std::vector<double>> ref_q = {{"Root", {1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.8275}}};
+  for(auto scheme : {tvm::robot::Integration::Euler, tvm::robot::Integration::SemiImplicitEuler})
+  {
+    tvm::Clock clock(dt);
+    tvm::RobotPtr jvrc = tvm::robot::fromURDF(clock, "JVRC1", jvrc_urdf, false, {}, ref_q);
+    FAST_CHECK_EQ(jvrc->integration(), tvm::robot::Integration::Euler);
+    jvrc->integration(scheme);
+    FAST_CHECK_EQ(jvrc->integration(), scheme);
+
+    // The integration is triggered by the computation of the kinematics
+    auto user = std::make_shared<tvm::graph::internal::Inputs>();
+    user->addInput(jvrc, tvm::Robot::Output::FK);
+    tvm::graph::CallGraph g;
+    g.add(user);
+    g.update();
+
+    // Reference integration, made directly on a copy of the configuration
+    const auto & mb = jvrc->mb();
+    rbd::MultiBodyConfig ref = jvrc->mbc();
+    auto dq = tvm::dot(jvrc->q());
+    auto ddq = tvm::dot(jvrc->q(), 2);
+    for(int i = 0; i < 3; ++i)
+    {
+      Eigen::VectorXd a = Eigen::VectorXd::Random(mb.nrDof());
+      ddq.value(a);
+      if(scheme == tvm::robot::Integration::Euler)
+      {
+        rbd::vectorToParam(a, ref.alphaD);
+      }
+      else
+      {
+        // dot(q) is integrated first, and q with the new velocity
+        Eigen::VectorXd alpha = rbd::dofToVector(mb, ref.alpha) + dt * a;
+        rbd::vectorToParam(alpha, ref.alpha);
+        rbd::vectorToParam(Eigen::VectorXd::Zero(mb.nrDof()), ref.alphaD);
+      }
+      rbd::eulerIntegration(mb, ref, dt);
+
+      clock.advance();
+      g.execute();
+      FAST_CHECK_UNARY(jvrc->q().value().isApprox(rbd::paramToVector(mb, ref.q), 1e-12));
+      FAST_CHECK_UNARY(dq.value().isApprox(rbd::dofToVector(mb, ref.alpha), 1e-12));
+      // The acceleration is left unchanged
+      FAST_CHECK_UNARY(ddq.value() == a);
+    }
+  }
+}
@@ -0,0 +1,293 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/LinearizedControlProblem.h>
+#include <tvm/Space.h>
+#include <tvm/Variable.h>
+#include <tvm/function/BasicLinearFunction.h>
+#include <tvm/hint/Substitution.h>
+#include <tvm/scheme/HierarchicalLeastSquares.h>
+#include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/solver/EigenHierarchicalLeastSquareSolver.h>
+#include <tvm/supported_solvers.h>
+#include <tvm/task_dynamics/None.h>
+
+#ifdef TVM_USE_LEXLS
+#  include <tvm/solver/LexLSHierarchicalLeastSquareSolver.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Core>
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace tvm;
+using namespace tvm::requirements;
+using namespace Eigen;
+
+/** Synthetic problems of scalable size, solved with every available backend.
+ *
+ * The problems are generated from the parameters
+ *  - n: the number of (non-substituted) variables,
+ *  - m: the total number of rows of the objectives,
+ *  - k: the number of rows of general inequality constraints,
+ *  - density: the percentage of non-zero coefficients in the matrices,
+ *  - subs: the number of substitutions,
+ *  - levels: the number of priority levels of the objectives.
+ *
+ * All problems have bounds on the variables and k inequality constraints at
+ * level 0. For each substitution, a variable of size 6 is added, with an
+ * equality constraint at level 0 giving it as a function of the other
+ * variables. The m rows of objectives are split among the levels 1 to
+ * \a levels, and involve all variables.
+ *
+ * Besides the total time of a resolution, each benchmark reports the average
+ * time per iteration of the following phases as counters (in seconds):
+ *  - update: update of the computation graph and of the scheme data,
+ *  - assignment: copy of the problem data into the solver,
+ *  - solve: resolution by the backend itself.
+ *
+ * Use --benchmark_out=<file> --benchmark_out_format=json to get the results as
+ * JSON. This is done by the tvm_benchmarks target.
+ */
+
+namespace
+{
+using clock = std::chrono::steady_clock;
+
+/** Time spent in each phase of the resolution.*/
+struct PhaseTimes
+{
+  clock::time_point start;
+  double assignment = 0;
+  double solve = 0;
+
+  void reset()
+  {
+    assignment = 0;
+    solve = 0;
+  }
+};
+
+double seconds(clock::time_point t0, clock::time_point t1) { return std::chrono::duration<double>(t1 - t0).count(); }
+
+/** A solver that records the time spent in the assignments and in the backend.*/
+template<typename Solver>
+class TimedSolver : public Solver
+{
+public:
+  template<typename Options>
+  TimedSolver(const Options & options, std::shared_ptr<PhaseTimes> times) : Solver(options), times_(times)
+  {}
+
+protected:
+  // resetBounds_ is the first step of solve(), before the assignments.
+  void resetBounds_() override
+  {
+    times_->start = clock::now();
+    Solver::resetBounds_();
+  }
+
+  bool solve_() override
+  {
+    auto t0 = clock::now();
+    times_->assignment += seconds(times_->start, t0);
+    bool b = Solver::solve_();
+    times_->solve += seconds(t0, clock::now());
+    return b;
+  }
+
+private:
+  std::shared_ptr<PhaseTimes> times_;
+};
+
+template<typename Solver>
+constexpr bool isHierarchical = std::is_base_of_v<solver::abstract::HierarchicalLeastSquareSolver, Solver>;
+
+/** A factory for TimedSolver<Solver>.*/
+template<typename Solver, typename Options>
+class TimedFactory : public std::conditional_t<isHierarchical<Solver>,
+                                               solver::abstract::HLSSolverFactory,
+                                               solver::abstract::LSSolverFactory>
+{
+public:
+  using Base = std::conditional_t<isHierarchical<Solver>,
+                                  solver::abstract::HLSSolverFactory,
+                                  solver::abstract::LSSolverFactory>;
+  using SolverBase = std::conditional_t<isHierarchical<Solver>,
+                                        solver::abstract::HierarchicalLeastSquareSolver,
+                                        solver::abstract::LeastSquareSolver>;
+
+  TimedFactory(const Options & options, std::shared_ptr<PhaseTimes> times)
+  : Base("Timed"), options_(options), times_(times)
+  {}
+
+  std::unique_ptr<Base> clone() const override { return std::make_unique<TimedFactory>(*this); }
+
+  std::unique_ptr<SolverBase> createSolver() const override
+  {
+    return std::make_unique<TimedSolver<Solver>>(options_, times_);
+  }
+
+private:
+  Options options_;
+  std::shared_ptr<PhaseTimes> times_;
+};
+
+/** A random matrix with (approximately) \p density percent of non-zero coefficients.*/
+MatrixXd sparseRandom(int rows, int cols, int density)
+{
+  MatrixXd M = MatrixXd::Random(rows, cols);
+  if(density < 100)
+  {
+    ArrayXXd mask = (ArrayXXd::Random(rows, cols) + 1) * 50;
+    M = (mask < density).select(M, 0);
+  }
+  return M;
+}
+} // namespace
+
+class SolverBenchmark : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State & st) override
+  {
+    std::srand(42);
+    int n = static_cast<int>(st.range(0));
+    int m = static_cast<int>(st.range(1));
+    int k = static_cast<int>(st.range(2));
+    int density = static_cast<int>(st.range(3));
+    int subs = static_cast<int>(st.range(4));
+    int levels = static_cast<int>(st.range(5));
+
+    pb_ = std::make_unique<LinearizedControlProblem>();
+    VariablePtr x = Space(n).createVariable("x");
+    VectorXd L = VectorXd::Constant(n, 10);
+    pb_->add(-L <= x <= L, task_dynamics::None(), {PriorityLevel(0)});
+    if(k > 0)
+    {
+      MatrixXd C = sparseRandom(k, n, density);
+      pb_->add(C * x <= 1., task_dynamics::None(), {PriorityLevel(0)});
+    }
+
+    std::vector<VariablePtr> y;
+    for(int i = 0; i < subs; ++i)
+    {
+      y.push_back(Space(6).createVariable("y" + std::to_string(i)));
+      MatrixXd B = MatrixXd::Random(6, 6) + 10 * MatrixXd::Identity(6, 6);
+      MatrixXd D = sparseRandom(6, n, density);
+      auto t = pb_->add(B * y.back() + D * x == VectorXd::Random(6), task_dynamics::None(), {PriorityLevel(0)});
+      pb_->add(hint::Substitution(pb_->constraint(*t), y.back()));
+    }
+
+    for(int p = 0; p < levels; ++p)
+    {
+      int mp = m / levels + (p < m % levels ? 1 : 0);
+      if(mp == 0)
+        continue;
+      std::vector<MatrixXd> A = {sparseRandom(mp, n, density)};
+      std::vector<VariablePtr> v = {x};
+      for(const auto & yi : y)
+      {
+        A.push_back(sparseRandom(mp, 6, density));
+        v.push_back(yi);
+      }
+      auto f = std::make_shared<function::BasicLinearFunction>(std::vector<MatrixConstRef>(A.begin(), A.end()), v,
+                                                               VectorXd::Random(mp));
+      pb_->add(f == 0., task_dynamics::None(), {PriorityLevel(p + 1)});
+    }
+  }
+
+  void TearDown(const ::benchmark::State &) override { pb_.reset(); }
+
+  template<typename Solver, typename Options>
+  void run(benchmark::State & st, const Options & options)
+  {
+    auto times = std::make_shared<PhaseTimes>();
+    TimedFactory<Solver, Options> factory(options, times);
+    using Scheme = std::conditional_t<isHierarchical<Solver>, scheme::HierarchicalLeastSquares,
+                                      scheme::WeightedLeastSquares>;
+    Scheme scheme(factory);
+
+    // First resolution, including the creation of the computation data.
+    scheme.solve(*pb_);
+
+    times->reset();
+    double total = 0;
+    for(auto _ : st)
+    {
+      auto t0 = clock::now();
+      scheme.solve(*pb_);
+      total += seconds(t0, clock::now());
+    }
+    auto avg = benchmark::Counter::kAvgIterations;
+    st.counters["update"] = benchmark::Counter(total - times->assignment - times->solve, avg);
+    st.counters["assignment"] = benchmark::Counter(times->assignment, avg);
+    st.counters["solve"] = benchmark::Counter(times->solve, avg);
+  }
+
+  std::unique_ptr<LinearizedControlProblem> pb_;
+};
+
+/** The problem sizes: {n, m, k, density, subs, levels}.*/
+static void problems(benchmark::internal::Benchmark * b)
+{
+  b->ArgNames({"n", "m", "k", "density", "subs", "levels"});
+  b->Args({10, 10, 5, 100, 0, 1});
+  b->Args({30, 30, 15, 100, 0, 2});
+  b->Args({30, 30, 15, 30, 2, 2});
+  b->Args({60, 60, 30, 20, 2, 3});
+  b->Args({100, 100, 50, 10, 4, 3});
+  b->Unit(benchmark::kMicrosecond);
+}
+
+#ifdef TVM_USE_LSSOL
+BENCHMARK_DEFINE_F(SolverBenchmark, LSSOL)(benchmark::State & st)
+{
+  run<solver::LSSOLLeastSquareSolver>(st, solver::LSSOLLSSolverOptions{});
+}
+BENCHMARK_REGISTER_F(SolverBenchmark, LSSOL)->Apply(problems);
+#endif
+
+#ifdef TVM_USE_QLD
+BENCHMARK_DEFINE_F(SolverBenchmark, QLD)(benchmark::State & st)
+{
+  run<solver::QLDLeastSquareSolver>(st, solver::QLDLSSolverOptions{});
+}
+BENCHMARK_REGISTER_F(SolverBenchmark, QLD)->Apply(problems);
+#endif
+
+#ifdef TVM_USE_QUADPROG
+BENCHMARK_DEFINE_F(SolverBenchmark, Quadprog)(benchmark::State & st)
+{
+  run<solver::QuadprogLeastSquareSolver>(st, solver::QuadprogLSSolverOptions{});
+}
+BENCHMARK_REGISTER_F(SolverBenchmark, Quadprog)->Apply(problems);
+#endif
+
+#ifdef TVM_USE_LEXLS
+BENCHMARK_DEFINE_F(SolverBenchmark, LexLS)(benchmark::State & st)
+{
+  run<solver::LexLSLeastSquareSolver>(st, solver::LexLSLSSolverOptions{});
+}
+BENCHMARK_REGISTER_F(SolverBenchmark, LexLS)->Apply(problems);
+
+BENCHMARK_DEFINE_F(SolverBenchmark, LexLSHierarchical)(benchmark::State & st)
+{
+  run<solver::LexLSHierarchicalLeastSquareSolver>(st, solver::LexLSHLSSolverOptions{});
+}
+BENCHMARK_REGISTER_F(SolverBenchmark, LexLSHierarchical)->Apply(problems);
+#endif
+
+BENCHMARK_DEFINE_F(SolverBenchmark, EigenHierarchical)(benchmark::State & st)
+{
+  run<solver::EigenHierarchicalLeastSquareSolver>(st, solver::EigenHLSSolverOptions{});
+}
+BENCHMARK_REGISTER_F(SolverBenchmark, EigenHierarchical)->Apply(problems);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/Space.h>
+#include <tvm/Variable.h>
+#include <tvm/constraint/BasicLinearConstraint.h>
+#include <tvm/hint/Substitution.h>
+#include <tvm/hint/internal/Substitutions.h>
+
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Core>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace tvm;
+using namespace Eigen;
+
+using BLC = constraint::BasicLinearConstraint;
+
+/** Mimic the substitutions made for a multi-robot dynamic problem: for each
+ * robot, the torque is substituted with the dynamic equation
+ *   H ddq - tau - J^T f = -C
+ * and the contact forces with a contact equation
+ *   J ddq + K f = -dJ dq.
+ * The matrices are not declared constant, as it is the case for real robots.
+ */
+class MultiRobotSubstitutions : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State & st) override
+  {
+    subs_ = std::make_unique<hint::internal::Substitutions>();
+    int K = static_cast<int>(st.range(0));
+    int n = 36; // size of a humanoid's dof
+    int c = 24; // 4 contacts with 6 dof each
+    for(int k = 0; k < K; ++k)
+    {
+      VariablePtr ddq = Space(n).createVariable("ddq" + std::to_string(k));
+      VariablePtr tau = Space(n).createVariable("tau" + std::to_string(k));
+      VariablePtr f = Space(c).createVariable("f" + std::to_string(k));
+      std::vector<VariablePtr> xd = {ddq, tau, f};
+      std::vector<VariablePtr> xc = {ddq, f};
+      dyn_.push_back(std::make_shared<BLC>(n, xd, constraint::Type::EQUAL));
+      cnt_.push_back(std::make_shared<BLC>(c, xc, constraint::Type::EQUAL));
+      dyn_.back()->A(MatrixXd::Random(n, n), *ddq);
+      dyn_.back()->A(-MatrixXd::Identity(n, n), *tau);
+      dyn_.back()->A(MatrixXd::Random(n, c), *f);
+      dyn_.back()->b(VectorXd::Random(n));
+      cnt_.back()->A(MatrixXd::Random(c, n), *ddq);
+      cnt_.back()->A(MatrixXd::Random(c, c), *f);
+      cnt_.back()->b(VectorXd::Random(c));
+      subs_->add(hint::Substitution(dyn_.back(), tau));
+      subs_->add(hint::Substitution(cnt_.back(), f));
+    }
+    subs_->finalize();
+    subs_->threads(static_cast<int>(st.range(1)));
+    subs_->updateSubstitutions();
+  }
+
+  void TearDown(const ::benchmark::State &) override
+  {
+    subs_.reset();
+    dyn_.clear();
+    cnt_.clear();
+  }
+
+  std::unique_ptr<hint::internal::Substitutions> subs_;
+  std::vector<std::shared_ptr<BLC>> dyn_;
+  std::vector<std::shared_ptr<BLC>> cnt_;
+};
+
+BENCHMARK_DEFINE_F(MultiRobotSubstitutions, Update)(benchmark::State & st)
+{
+  for(auto _ : st)
+  {
+    subs_->updateSubstitutions();
+  }
+}
+
+BENCHMARK_REGISTER_F(MultiRobotSubstitutions, Update)
+    ->ArgNames({"robots", "threads"})
+    ->ArgsProduct({{1, 2, 4, 8}, {1, 2, 4}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/LinearizedControlProblem.h>
+#include <tvm/Space.h>
+#include <tvm/Variable.h>
+#include <tvm/hint/Substitution.h>
+#include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/scheme/internal/helpers.h>
+#include <tvm/supported_solvers.h>
+#include <tvm/task_dynamics/None.h>
+
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Core>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace tvm;
+using namespace tvm::requirements;
+using namespace Eigen;
+
+/** A multi-robot problem similar to the one of SubstitutionBenchmark: for each
+ * robot, the torque is substituted with the dynamic equation and the contact
+ * forces with a contact equation. The torques are bounded and the
+ * accelerations and forces are regularized.
+ *
+ * The benchmarks measure the cost of removing then adding back the contact
+ * substitution of one robot, either by updating the computation data or by
+ * recreating it, as was done before the substitution events were processed
+ * incrementally.
+ */
+class SubstitutionEvents : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State & st) override
+  {
+    pb_ = std::make_unique<LinearizedControlProblem>();
+    int K = static_cast<int>(st.range(0));
+    int n = 36; // size of a humanoid's dof
+    int c = 24; // 4 contacts with 6 dof each
+    for(int k = 0; k < K; ++k)
+    {
+      VariablePtr ddq = Space(n).createVariable("ddq" + std::to_string(k));
+      VariablePtr tau = Space(n).createVariable("tau" + std::to_string(k));
+      VariablePtr f = Space(c).createVariable("f" + std::to_string(k));
+      MatrixXd H = MatrixXd::Random(n, n);
+      H = H * H.transpose() + MatrixXd::Identity(n, n);
+      MatrixXd Jt = MatrixXd::Random(n, c);
+      MatrixXd J = MatrixXd::Random(c, n);
+      MatrixXd Kf = MatrixXd::Random(c, c) + 10 * MatrixXd::Identity(c, c);
+      VectorXd C = VectorXd::Random(n);
+      VectorXd d = VectorXd::Random(c);
+      VectorXd L = VectorXd::Constant(n, 100);
+
+      auto dyn = pb_->add(H * ddq - tau + Jt * f + C == 0., task_dynamics::None(), {PriorityLevel(0)});
+      auto cnt = pb_->add(J * ddq + Kf * f + d == 0., task_dynamics::None(), {PriorityLevel(0)});
+      pb_->add(-L <= tau <= L, task_dynamics::None(), {PriorityLevel(0)});
+      pb_->add(ddq == 0., task_dynamics::None(), {PriorityLevel(1)});
+      pb_->add(f == 0., task_dynamics::None(), {PriorityLevel(1), Weight(1e-3)});
+      pb_->add(hint::Substitution(pb_->constraint(*dyn), tau));
+      contact_ = std::make_unique<hint::Substitution>(pb_->constraint(*cnt), f);
+      pb_->add(*contact_);
+    }
+    pb_->update();
+  }
+
+  void TearDown(const ::benchmark::State &) override
+  {
+    contact_.reset();
+    pb_.reset();
+  }
+
+  // Remove the last contact substitution.
+  void removeContact() { pb_->remove(pb_->substitutions().substitutions().back()); }
+  // Add back the last contact substitution.
+  void addContact() { pb_->add(*contact_); }
+
+  std::unique_ptr<LinearizedControlProblem> pb_;
+  std::unique_ptr<hint::Substitution> contact_;
+  scheme::WeightedLeastSquares scheme_{solver::DefaultLSSolverOptions{}};
+};
+
+// Cost of the changes of the substitutions alone, common to both approaches.
+BENCHMARK_DEFINE_F(SubstitutionEvents, Reference)(benchmark::State & st)
+{
+  for(auto _ : st)
+  {
+    removeContact();
+    pb_->update();
+    addContact();
+    pb_->update();
+  }
+}
+
+BENCHMARK_DEFINE_F(SubstitutionEvents, Update)(benchmark::State & st)
+{
+  auto data = scheme::internal::getComputationData(*pb_, scheme_);
+  scheme_.updateComputationData(*pb_, data);
+  for(auto _ : st)
+  {
+    removeContact();
+    pb_->update();
+    scheme_.updateComputationData(*pb_, data);
+    addContact();
+    pb_->update();
+    scheme_.updateComputationData(*pb_, data);
+  }
+}
+
+BENCHMARK_DEFINE_F(SubstitutionEvents, Rebuild)(benchmark::State & st)
+{
+  for(auto _ : st)
+  {
+    removeContact();
+    pb_->update();
+    auto data = scheme_.createComputationData(*pb_);
+    benchmark::DoNotOptimize(data);
+    addContact();
+    pb_->update();
+    data = scheme_.createComputationData(*pb_);
+    benchmark::DoNotOptimize(data);
+  }
+}
+
+BENCHMARK_REGISTER_F(SubstitutionEvents, Reference)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(SubstitutionEvents, Update)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(SubstitutionEvents, Rebuild)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -7,12 +7,16 @@
 #include <tvm/hint/Substitution.h>
 #include <tvm/hint/internal/DiagonalCalculator.h>
 #include <tvm/hint/internal/GenericCalculator.h>
+#include <tvm/hint/internal/IncrementalCalculator.h>
+#include <tvm/hint/internal/LTDLCalculator.h>
 #include <tvm/hint/internal/Substitutions.h>
 #include <tvm/internal/MatrixProperties.h>
 #include <tvm/internal/VariableVectorPartition.h>
+#include <tvm/utils/internal/ThreadPool.h>
 
 #include <Eigen/SVD>
 
+#include <algorithm>
 // #include <iostream>
 #include <vector>
 
@@ -70,6 +74,171 @@ TEST_CASE("GenericCalculator")
   FAST_CHECK_EQ(calc2->N().colPivHouseholderQr().rank(), 3);
 }
 
+TEST_CASE("GenericCalculator with constant matrices")
+{
+  VariablePtr x = Space(5).createVariable("x");
+  VariablePtr y = Space(3).createVariable("y");
+  MatrixXd A = MatrixXd::Random(3, 5);
+  MatrixXd B = MatrixXd::Random(3, 3);
+  VectorXd b = VectorXd::Random(3);
+
+  std::shared_ptr<constraint::BasicLinearConstraint> c(
+      new constraint::BasicLinearConstraint({A, B}, {x, y}, b, constraint::Type::EQUAL));
+  auto calc = GenericCalculator().impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c)}, {x}, 3);
+  FAST_CHECK_EQ(calc->updateCount(), 0);
+
+  // A is constant: the computations are performed only once
+  calc->update();
+  calc->update();
+  calc->update();
+  FAST_CHECK_EQ(calc->updateCount(), 1);
+
+  MatrixXd AsB(5, 3);
+  MatrixXd StB(0, 3);
+  calc->premultiplyByASharpAndSTranspose(AsB, StB, B, true);
+  FAST_CHECK_UNARY(MatrixXd(A * AsB).isApprox(-B));
+  FAST_CHECK_UNARY(MatrixXd(A * calc->N()).isZero(1e-12));
+
+  // Changing the matrix triggers new computations
+  MatrixXd A2 = MatrixXd::Random(3, 5);
+  c->A(A2, *x, {tvm::internal::MatrixProperties::Constness(true)});
+  calc->update();
+  calc->update();
+  FAST_CHECK_EQ(calc->updateCount(), 2);
+  calc->premultiplyByASharpAndSTranspose(AsB, StB, B, false);
+  FAST_CHECK_UNARY(MatrixXd(A2 * AsB).isApprox(B));
+  FAST_CHECK_UNARY(MatrixXd(A2 * calc->N()).isZero(1e-12));
+
+  // Non-constant matrices are always recomputed
+  c->A(A, *x);
+  auto calc2 = GenericCalculator().impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c)}, {x}, 3);
+  calc2->update();
+  calc2->update();
+  FAST_CHECK_EQ(calc2->updateCount(), 2);
+}
+
+/** A constraint declaring that its jacobian matrix w.r.t. some variables taken
+ * together has a branch-induced sparsity pattern.
+ */
+class BranchInducedConstraint : public constraint::BasicLinearConstraint
+{
+public:
+  BranchInducedConstraint(const std::vector<MatrixConstRef> & A,
+                          const std::vector<VariablePtr> & x,
+                          const VectorConstRef & b,
+                          std::vector<VariablePtr> xBranch,
+                          std::vector<int> lambda)
+  : BasicLinearConstraint(A, x, b, constraint::Type::EQUAL), xBranch_(std::move(xBranch)), lambda_(std::move(lambda))
+  {}
+
+  bool jacobianParentArray(const std::vector<VariablePtr> & x, std::vector<int> & lambda) const override
+  {
+    if(x != xBranch_)
+      return false;
+    lambda = lambda_;
+    return true;
+  }
+
+private:
+  std::vector<VariablePtr> xBranch_;
+  std::vector<int> lambda_;
+};
+
+TEST_CASE("LTDLCalculator")
+{
+  // H = L^T D L with a branch-induced sparsity
+  std::vector<int> lambda = {-1, 0, 1, 2, 2, 4, 1, 6};
+  MatrixXd L = MatrixXd::Identity(8, 8);
+  for(int i = 0; i < 8; ++i)
+  {
+    for(int j = lambda[static_cast<size_t>(i)]; j >= 0; j = lambda[static_cast<size_t>(j)])
+    {
+      L(i, j) = VectorXd::Random(1)[0];
+    }
+  }
+  VectorXd D = VectorXd::Random(8).cwiseAbs() + VectorXd::Constant(8, 0.1);
+  MatrixXd H = L.transpose() * D.asDiagonal() * L;
+  MatrixXd B = MatrixXd::Random(8, 3);
+  VectorXd b = VectorXd::Random(8);
+  MatrixXd HinvB = H.llt().solve(B);
+
+  VariablePtr x1 = Space(3).createVariable("x1");
+  VariablePtr x2 = Space(5).createVariable("x2");
+  VariablePtr y = Space(3).createVariable("y");
+  MatrixXd HsB(8, 3);
+  MatrixXd StB(0, 3);
+
+  // Simple case
+  {
+    VariablePtr x = Space(8).createVariable("x");
+    std::shared_ptr<constraint::BasicLinearConstraint> c(
+        new constraint::BasicLinearConstraint({H, B}, {x, y}, b, constraint::Type::EQUAL));
+    auto calc =
+        LTDLCalculator(lambda).impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c)}, {x}, 8);
+    calc->update();
+    calc->premultiplyByASharpAndSTranspose(HsB, StB, B, false);
+    FAST_CHECK_UNARY(HsB.isApprox(HinvB));
+    calc->premultiplyByASharpAndSTranspose(HsB, StB, B, true);
+    FAST_CHECK_UNARY(HsB.isApprox(-HinvB));
+    FAST_CHECK_EQ(calc->N().cols(), 0);
+
+    // Dense version
+    auto calc2 = LTDLCalculator().impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c)}, {x}, 8);
+    calc2->update();
+    calc2->premultiplyByASharpAndSTranspose(HsB, StB, B, false);
+    FAST_CHECK_UNARY(HsB.isApprox(HinvB));
+
+    // Wrong rank or size of the parent array
+    CHECK_THROWS(LTDLCalculator(lambda).impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c)},
+                                             {x}, 7));
+    CHECK_THROWS(LTDLCalculator({-1, 0}).impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c)},
+                                              {x}, 8));
+
+    // Automatic choice for positive definite matrices
+    Substitution s(c, x);
+    FAST_CHECK_UNARY(dynamic_cast<LTDLCalculator::Impl *>(s.calculator().get()) == nullptr);
+    c->A(H, *x, {tvm::internal::MatrixProperties::POSITIVE_DEFINITE});
+    Substitution s2(c, x);
+    FAST_CHECK_UNARY(dynamic_cast<LTDLCalculator::Impl *>(s2.calculator().get()) != nullptr);
+
+    // Non positive-definite matrix
+    c->A(-H, *x);
+    CHECK_THROWS(calc->update());
+  }
+
+  // Several variables
+  {
+    std::shared_ptr<constraint::BasicLinearConstraint> c(new constraint::BasicLinearConstraint(
+        {H.leftCols(3), H.rightCols(5), B}, {x1, x2, y}, b, constraint::Type::EQUAL));
+    auto calc = LTDLCalculator(lambda).impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c)},
+                                            {x1, x2}, 8);
+    calc->update();
+    calc->premultiplyByASharpAndSTranspose(HsB, StB, B, false);
+    FAST_CHECK_UNARY(HsB.isApprox(HinvB));
+
+    // Automatic choice when the matrix split over the variables is declared
+    // positive definite with a branch-induced sparsity
+    std::vector<VariablePtr> x12 = {x1, x2};
+    std::vector<VariablePtr> x21 = {x2, x1};
+    Substitution s(c, x12);
+    FAST_CHECK_UNARY(dynamic_cast<LTDLCalculator::Impl *>(s.calculator().get()) == nullptr);
+    auto cb = std::make_shared<BranchInducedConstraint>(std::vector<MatrixConstRef>{H.leftCols(3), H.rightCols(5), B},
+                                                        std::vector<VariablePtr>{x1, x2, y}, b,
+                                                        std::vector<VariablePtr>{x1, x2}, lambda);
+    Substitution s2(cb, x12);
+    REQUIRE(dynamic_cast<LTDLCalculator::Impl *>(s2.calculator().get()) != nullptr);
+    s2.calculator()->update();
+    s2.calculator()->premultiplyByASharpAndSTranspose(HsB, StB, B, false);
+    FAST_CHECK_UNARY(HsB.isApprox(HinvB));
+    // Only for the declared variables, in the declared order
+    Substitution s3(cb, x21);
+    FAST_CHECK_UNARY(dynamic_cast<LTDLCalculator::Impl *>(s3.calculator().get()) == nullptr);
+  }
+
+  CHECK_THROWS(LTDLCalculator({-1, 1}));
+  CHECK_THROWS(LTDLCalculator({-1, -2}));
+}
+
 TEST_CASE("Diagonal Calculator")
 {
   VariablePtr x = Space(7).createVariable("x");
@@ -390,6 +559,96 @@ void checkEquivalence(const std::vector<std::shared_ptr<constraint::BasicLinearC
   }
 }
 
+TEST_CASE("IncrementalCalculator")
+{
+  VariablePtr x = Space(8).createVariable("x");
+  VariablePtr y = Space(3).createVariable("y");
+  MatrixXd A = MatrixXd::Random(4, 8);
+  MatrixXd B = MatrixXd::Random(4, 3);
+  VectorXd b = VectorXd::Random(4);
+
+  std::shared_ptr<constraint::BasicLinearConstraint> c(
+      new constraint::BasicLinearConstraint({A, B}, {x, y}, b, constraint::Type::EQUAL));
+  c->A(A, *x); // non-constant matrix
+  auto calc =
+      IncrementalCalculator(1, 10).impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c)}, {x}, 4);
+  auto incr = dynamic_cast<IncrementalCalculator::Impl *>(calc.get());
+  REQUIRE(incr);
+
+  MatrixXd AsB(8, 3);
+  MatrixXd StB(0, 3);
+  auto check = [&]() {
+    calc->update();
+    calc->premultiplyByASharpAndSTranspose(AsB, StB, B, true);
+    FAST_CHECK_UNARY(MatrixXd(A * AsB).isApprox(-B));
+    FAST_CHECK_UNARY(MatrixXd(A * calc->N()).isZero(1e-12));
+    FAST_CHECK_EQ(calc->N().colPivHouseholderQr().rank(), 4);
+  };
+
+  check();
+  FAST_CHECK_EQ(incr->factorizations(), 1);
+
+  // Changing one column or one row is handled incrementally
+  for(int i = 0; i < 5; ++i)
+  {
+    A.col(i) += 0.1 * VectorXd::Random(4);
+    c->A(A, *x);
+    check();
+  }
+  for(int i = 0; i < 4; ++i)
+  {
+    A.row(i) += 0.1 * RowVectorXd::Random(8);
+    c->A(A, *x);
+    check();
+  }
+  FAST_CHECK_EQ(incr->factorizations(), 1);
+
+  // The factorization is refreshed after 10 incremental updates
+  A.col(7) += 0.1 * VectorXd::Random(4);
+  c->A(A, *x);
+  check();
+  FAST_CHECK_EQ(incr->factorizations(), 1);
+  A.col(6) += 0.1 * VectorXd::Random(4);
+  c->A(A, *x);
+  check();
+  FAST_CHECK_EQ(incr->factorizations(), 2);
+
+  // Changing more columns and rows than allowed triggers a full factorization
+  A.leftCols(2) += 0.1 * MatrixXd::Random(4, 2);
+  c->A(A, *x);
+  check();
+  FAST_CHECK_EQ(incr->factorizations(), 3);
+
+  // Non full row-rank matrices are always fully factorized
+  MatrixXd C = randM(4, 8, 3);
+  std::shared_ptr<constraint::BasicLinearConstraint> c2(
+      new constraint::BasicLinearConstraint({C, B}, {x, y}, b, constraint::Type::EQUAL));
+  c2->A(C, *x);
+  auto calc2 =
+      IncrementalCalculator().impl({std::static_pointer_cast<constraint::abstract::LinearConstraint>(c2)}, {x}, 3);
+  auto incr2 = dynamic_cast<IncrementalCalculator::Impl *>(calc2.get());
+  MatrixXd CsC(8, 8);
+  MatrixXd StC(1, 8);
+  for(int i = 0; i < 3; ++i)
+  {
+    calc2->update();
+    FAST_CHECK_EQ(incr2->factorizations(), i + 1);
+    calc2->premultiplyByASharpAndSTranspose(CsC, StC, C, false);
+    FAST_CHECK_UNARY(MatrixXd(C * CsC).isApprox(C));
+    FAST_CHECK_UNARY(StC.isZero(1e-12));
+    FAST_CHECK_UNARY(MatrixXd(C * calc2->N()).isZero(1e-12));
+  }
+
+  // Failure of the rank check
+  A.col(0).setZero();
+  A.col(1).setZero();
+  A.col(2).setZero();
+  A.col(3).setZero();
+  A.col(4).setZero();
+  c->A(A, *x);
+  CHECK_THROWS(calc->update());
+}
+
 TEST_CASE("Substitution construction")
 {
   using BLC = constraint::BasicLinearConstraint;
@@ -908,3 +1167,149 @@ TEST_CASE("Substitution with subvariables")
   subs.updateVariableValues();
   FAST_CHECK_UNARY(x->value().isApprox(x0));
 }
+
+TEST_CASE("Substitution units reuse")
+{
+  VariablePtr x = Space(3).createVariable("x");
+  VariablePtr y = Space(4).createVariable("y");
+  VariablePtr z = Space(2).createVariable("z");
+
+  using BLC = constraint::BasicLinearConstraint;
+  auto eq = constraint::Type::EQUAL;
+  auto cx = std::shared_ptr<BLC>(new BLC({randM(3, 3), randM(3, 2)}, {x, z}, eq));
+  auto cy = std::shared_ptr<BLC>(new BLC({randM(4, 4), randM(4, 2)}, {y, z}, eq));
+  Substitution sx(cx, x);
+  Substitution sy(cy, y);
+
+  Substitutions subs;
+  subs.add(sx);
+  subs.finalize();
+  FAST_CHECK_EQ(subs.variableSubstitutions().size(), 1);
+  auto fx = subs.variableSubstitutions()[0];
+
+  // Adding an independent substitution keeps the function computed for x.
+  subs.add(sy);
+  subs.finalize();
+  FAST_CHECK_EQ(subs.variableSubstitutions().size(), 2);
+  auto it = std::find(subs.variables().begin(), subs.variables().end(), x);
+  REQUIRE(it != subs.variables().end());
+  FAST_CHECK_EQ(subs.variableSubstitutions()[static_cast<size_t>(it - subs.variables().begin())], fx);
+  it = std::find(subs.variables().begin(), subs.variables().end(), y);
+  REQUIRE(it != subs.variables().end());
+  auto fy = subs.variableSubstitutions()[static_cast<size_t>(it - subs.variables().begin())];
+
+  // Same when removing it
+  subs.remove(subs.substitutions().back());
+  subs.finalize();
+  FAST_CHECK_EQ(subs.variableSubstitutions().size(), 1);
+  FAST_CHECK_EQ(subs.variableSubstitutions()[0], fx);
+
+  // Adding it again creates a new unit
+  subs.add(sy);
+  subs.finalize();
+  it = std::find(subs.variables().begin(), subs.variables().end(), y);
+  REQUIRE(it != subs.variables().end());
+  FAST_CHECK_NE(subs.variableSubstitutions()[static_cast<size_t>(it - subs.variables().begin())], fy);
+
+  // The reused unit still computes the substitution.
+  subs.updateSubstitutions();
+  z << VectorXd::Random(2);
+  subs.updateVariableValues();
+  FAST_CHECK_UNARY((cx->jacobian(*x) * x->value() + cx->jacobian(*z) * z->value()).isZero(1e-10));
+  FAST_CHECK_UNARY((cy->jacobian(*y) * y->value() + cy->jacobian(*z) * z->value()).isZero(1e-10));
+}
+
+TEST_CASE("Parallel substitutions")
+{
+  using BLC = constraint::BasicLinearConstraint;
+  auto eq = constraint::Type::EQUAL;
+  const int K = 5;
+
+  // K independent groups mimicking the dynamics of K robots:
+  //   H dq - tau - J^T f = b   (substituting tau)
+  //   L dq + M f = c           (substituting f)
+  std::vector<VariablePtr> dq, tau, f;
+  std::vector<std::shared_ptr<BLC>> dyn, cnt;
+  for(int k = 0; k < K; ++k)
+  {
+    dq.push_back(Space(6).createVariable("dq" + std::to_string(k)));
+    tau.push_back(Space(6).createVariable("tau" + std::to_string(k)));
+    f.push_back(Space(3).createVariable("f" + std::to_string(k)));
+    std::vector<VariablePtr> xd = {dq.back(), tau.back(), f.back()};
+    std::vector<VariablePtr> xc = {dq.back(), f.back()};
+    dyn.push_back(std::make_shared<BLC>(6, xd, eq));
+    cnt.push_back(std::make_shared<BLC>(3, xc, eq));
+  }
+
+  auto randomize = [&]() {
+    for(int k = 0; k < K; ++k)
+    {
+      // No constness is given, so that the calculators recompute every time.
+      dyn[k]->A(randM(6, 6), *dq[k]);
+      dyn[k]->A(-MatrixXd::Identity(6, 6), *tau[k]);
+      dyn[k]->A(randM(6, 3), *f[k]);
+      dyn[k]->b(VectorXd::Random(6));
+      cnt[k]->A(randM(3, 6), *dq[k]);
+      cnt[k]->A(randM(3, 3), *f[k]);
+      cnt[k]->b(VectorXd::Random(3));
+    }
+  };
+  randomize();
+
+  Substitutions serial, parallel;
+  for(int k = 0; k < K; ++k)
+  {
+    serial.add(Substitution(dyn[k], tau[k]));
+    serial.add(Substitution(cnt[k], f[k]));
+    parallel.add(Substitution(dyn[k], tau[k]));
+    parallel.add(Substitution(cnt[k], f[k]));
+  }
+  serial.finalize();
+  parallel.finalize();
+  parallel.threads(3);
+  FAST_CHECK_EQ(serial.threads(), 1);
+  FAST_CHECK_EQ(parallel.threads(), 3);
+  FAST_CHECK_EQ(parallel.variableSubstitutions().size(), 2 * K);
+
+  for(int i = 0; i < 4; ++i)
+  {
+    randomize();
+    serial.updateSubstitutions();
+    parallel.updateSubstitutions();
+    for(size_t j = 0; j < serial.variableSubstitutions().size(); ++j)
+    {
+      const auto & fs = serial.variableSubstitutions()[j];
+      const auto & fp = parallel.variableSubstitutions()[j];
+      FAST_CHECK_UNARY(fp->b().isApprox(fs->b()));
+      for(const auto & v : fs->variables())
+      {
+        FAST_CHECK_UNARY(fp->jacobian(*v).isApprox(fs->jacobian(*v)));
+      }
+    }
+  }
+
+  // Check the substitution is actually solving the constraints
+  for(int k = 0; k < K; ++k)
+  {
+    dq[k]->value(VectorXd::Random(6));
+  }
+  parallel.updateVariableValues();
+  for(int k = 0; k < K; ++k)
+  {
+    dyn[k]->updateValue();
+    cnt[k]->updateValue();
+    FAST_CHECK_UNARY(dyn[k]->value().isApprox(dyn[k]->e()));
+    FAST_CHECK_UNARY(cnt[k]->value().isApprox(cnt[k]->e()));
+  }
+
+  parallel.threads(1);
+  FAST_CHECK_EQ(parallel.threads(), 1);
+  CHECK_THROWS(tvm::utils::internal::ThreadPool(0));
+  tvm::utils::internal::ThreadPool pool(2);
+  CHECK_THROWS(pool.run(4, [](size_t i) {
+    if(i == 2)
+    {
+      throw std::runtime_error("Failure");
+    }
+  }));
+}
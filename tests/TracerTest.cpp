@@ -0,0 +1,134 @@
+/** Copyright 2017-2020 CNRS-AIST JRL and CNRS-UM LIRMM */
+
+#include <tvm/LinearizedControlProblem.h>
+#include <tvm/Variable.h>
+#include <tvm/graph/CallGraph.h>
+#include <tvm/graph/abstract/Node.h>
+#include <tvm/scheme/WeightedLeastSquares.h>
+#include <tvm/supported_solvers.h>
+#include <tvm/task_dynamics/None.h>
+#include <tvm/utils/Tracer.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+using namespace tvm;
+using namespace tvm::utils;
+using namespace Eigen;
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+namespace
+{
+class Counter : public graph::abstract::Node<Counter>
+{
+public:
+  SET_UPDATES(Counter, Increment)
+  SET_OUTPUTS(Counter, Value)
+
+  Counter()
+  {
+    registerUpdates(Update::Increment, &Counter::increment);
+    addOutputDependency(Output::Value, Update::Increment);
+  }
+
+  int value = 0;
+
+private:
+  void increment() { ++value; }
+};
+
+size_t count(const std::string & s, const std::string & pattern)
+{
+  size_t n = 0;
+  for(auto i = s.find(pattern); i != std::string::npos; i = s.find(pattern, i + 1))
+    ++n;
+  return n;
+}
+} // namespace
+
+TEST_CASE("Trace the execution of a call graph")
+{
+  auto counter = std::make_shared<Counter>();
+  auto user = std::make_shared<graph::internal::Inputs>();
+  user->addInput(counter, Counter::Output::Value);
+  graph::CallGraph g;
+  g.add(user);
+  g.update();
+
+  auto & tracer = Tracer::tracer();
+
+  // Nothing is recorded while the tracer is disabled
+  tracer.disable();
+  tracer.clear();
+  g.execute();
+  FAST_CHECK_EQ(counter->value, 1);
+  FAST_CHECK_UNARY(tracer.events().empty());
+
+  tracer.enable(4);
+  for(int i = 0; i < 3; ++i)
+    g.execute();
+  tracer.disable();
+  FAST_CHECK_EQ(counter->value, 4);
+  auto events = tracer.events();
+  FAST_REQUIRE_EQ(events.size(), 3);
+  for(size_t i = 0; i < events.size(); ++i)
+  {
+    FAST_CHECK_EQ(events[i].name, nullptr);
+    FAST_CHECK_EQ(events[i].object, reinterpret_cast<std::uintptr_t>(counter.get()));
+    FAST_CHECK_EQ(events[i].id, static_cast<int>(Counter::Update::Increment));
+    FAST_CHECK_GE(events[i].duration, 0);
+    if(i > 0)
+      FAST_CHECK_GE(events[i].start, events[i - 1].start + events[i - 1].duration);
+  }
+
+  std::stringstream ss;
+  tracer.writeChromeTrace(ss);
+  auto json = ss.str();
+  FAST_CHECK_EQ(json.find("{\"traceEvents\":["), 0);
+  FAST_CHECK_EQ(count(json, "Counter::Increment\",\"cat\":\"graph\""), 3);
+
+  // The buffer keeps the last events
+  tracer.enable(4);
+  for(int i = 0; i < 6; ++i)
+    g.execute();
+  tracer.disable();
+  FAST_CHECK_EQ(tracer.events().size(), 4);
+  FAST_CHECK_EQ(tracer.overwritten(), 2);
+  tracer.clear();
+  FAST_CHECK_UNARY(tracer.events().empty());
+
+  CHECK_THROWS(tracer.enable(0));
+}
+
+TEST_CASE("Trace the phases of a solver")
+{
+  VariablePtr x = Space(3).createVariable("x");
+  LinearizedControlProblem pb;
+  pb.add(-1. <= x <= 1., task_dynamics::None(), {requirements::PriorityLevel(0)});
+  pb.add(x == Vector3d(2, 0, 0), task_dynamics::None(), {requirements::PriorityLevel(1)});
+  scheme::WeightedLeastSquares solver(solver::DefaultLSSolverOptions{});
+
+  auto & tracer = Tracer::tracer();
+  tracer.enable();
+  FAST_REQUIRE_UNARY(solver.solve(pb));
+  FAST_REQUIRE_UNARY(solver.solve(pb));
+  tracer.disable();
+
+  auto events = tracer.events();
+  auto phases = [&](const std::string & name) {
+    return std::count_if(events.begin(), events.end(),
+                         [&](const TraceEvent & e) { return e.name && name == e.name; });
+  };
+  FAST_CHECK_EQ(phases("LeastSquareSolver::solve"), 2);
+  FAST_CHECK_EQ(phases("LeastSquareSolver::assignments"), 2);
+  FAST_CHECK_EQ(phases("LeastSquareSolver::backend"), 2);
+
+  std::stringstream ss;
+  tracer.writeChromeTrace(ss);
+  FAST_CHECK_EQ(count(ss.str(), "\"cat\":\"solver\""), 6);
+  tracer.clear();
+}
@@ -310,6 +310,37 @@ TEST_CASE("Test Mapping 3")
   FAST_CHECK_EQ(v2->getMappingIn(vv2), Range(2, 5));
   CHECK_THROWS(v11->getMappingIn(vv2));
   FAST_CHECK_EQ(v12->getMappingIn(vv2), Range(2, 3));
+
+  for(int i = 0; i < vv2.numberOfVariables(); ++i)
+    FAST_CHECK_EQ(vv2.rangeOf(i), vv2[i]->getMappingIn(vv2));
+}
+
+TEST_CASE("Test rangeOf")
+{
+  VariablePtr u = Space(8).createVariable("u");
+  VariablePtr v = Space(10).createVariable("v");
+  VariablePtr w = Space(7).createVariable("w");
+  VariablePtr v1 = v->subvariable(Space(7), "v1", Space(1));
+
+  VariableVector vv(u, v1, w);
+  FAST_CHECK_EQ(vv.rangeOf(0), Range(0, 8));
+  FAST_CHECK_EQ(vv.rangeOf(1), Range(8, 7));
+  FAST_CHECK_EQ(vv.rangeOf(2), Range(15, 7));
+
+  vv.remove(*u);
+  FAST_CHECK_EQ(vv.rangeOf(0), Range(0, 7));
+  FAST_CHECK_EQ(vv.rangeOf(1), Range(7, 7));
+
+  vv.add(u);
+  FAST_CHECK_EQ(vv.rangeOf(2), Range(14, 8));
+  for(int i = 0; i < vv.numberOfVariables(); ++i)
+    FAST_CHECK_EQ(vv.rangeOf(i), vv[i]->getMappingIn(vv));
+
+  VariableVector vv2(vv);
+  vv.clear();
+  vv.add(w);
+  FAST_CHECK_EQ(vv.rangeOf(0), Range(0, 7));
+  FAST_CHECK_EQ(vv2.rangeOf(2), Range(14, 8));
 }
 
 void testDerivation(VariablePtr v1, VariablePtr v2, VariablePtr v3)